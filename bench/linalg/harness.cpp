@@ -0,0 +1,318 @@
+#include "harness.hpp"
+
+#include <dlfcn.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Usage: linalg_harness [element_count]; defaults to 65536 elements per kernel.
+// Runs every linalg kernel from every ISA module the CPU supports against the scalar module on random and
+// edge-case inputs, then prints ULP divergence and throughput side by side. Exits with 1 when a kernel leaves
+// its bound on either input set or disagrees on any NaN or infinity, so a faster path can never silently change
+// results.
+namespace
+{
+    constexpr size_t kDefaultCount = 65536;
+    constexpr double kMinimumSeconds = 0.05;
+    constexpr const char *kReferenceIsa = "scalar";
+
+    struct Module
+    {
+        std::string isa;
+        const HarnessModule *module;
+    };
+
+    struct Divergence
+    {
+        double random;
+        double edge;
+        size_t special;
+    };
+
+    bool supported(const std::string &isa)
+    {
+        if (isa == "scalar")
+        {
+            return true;
+        }
+
+        if (isa == "avx")
+        {
+            return __builtin_cpu_supports("avx");
+        }
+
+        if (isa == "avx2")
+        {
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        }
+
+        return false;
+    }
+
+    // LRE_HARNESS_MODULES lists isa=path pairs separated by commas.
+    std::vector<Module> load_modules()
+    {
+        std::vector<Module> modules;
+        std::stringstream list(LRE_HARNESS_MODULES);
+        std::string entry;
+
+        while (std::getline(list, entry, ','))
+        {
+            const size_t split = entry.find('=');
+            const std::string isa = entry.substr(0, split);
+            const std::string path = entry.substr(split + 1);
+
+            if (!supported(isa))
+            {
+                std::printf("%s: not supported by this CPU, skipped\n", isa.c_str());
+                continue;
+            }
+
+            // RTLD_LOCAL keeps each module bound to its own copy of the library.
+            void *handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+
+            if (handle == nullptr)
+            {
+                std::printf("%s: %s\n", isa.c_str(), dlerror());
+                continue;
+            }
+
+            auto entry_point = reinterpret_cast<const HarnessModule *(*)()>(dlsym(handle, "lre_harness_module"));
+
+            if (entry_point == nullptr)
+            {
+                std::printf("%s: missing lre_harness_module\n", isa.c_str());
+                continue;
+            }
+
+            modules.push_back(Module{isa, entry_point()});
+        }
+
+        return modules;
+    }
+
+    const HarnessKernel *find(const HarnessModule *module, const char *name)
+    {
+        for (size_t k = 0; k < module->kernel_count; k++)
+        {
+            if (std::strcmp(module->kernels[k].name, name) == 0)
+            {
+                return &module->kernels[k];
+            }
+        }
+
+        return nullptr;
+    }
+
+    template <typename Value>
+    std::vector<Value> edge_values()
+    {
+        using Limits = std::numeric_limits<Value>;
+
+        return {Value(0), -Value(0), Value(1), Value(-1), Value(0.5), Value(1) + Limits::epsilon(), Value(1e-6), Value(-1e-7),
+                Value(1e7), Limits::min(), -Limits::min(), Limits::denorm_min(), -Limits::denorm_min(), Limits::max(),
+                -Limits::max(), Limits::infinity(), -Limits::infinity(), Limits::quiet_NaN()};
+    }
+
+    // Uniform values in [-1, 1]; edge inputs replace about half of them with special and extreme values.
+    template <typename Value>
+    std::vector<Value> inputs(const size_t &count, const bool &edge, const uint32_t &seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<Value> uniform(Value(-1), Value(1));
+        const std::vector<Value> special = edge_values<Value>();
+
+        std::vector<Value> values(count);
+
+        for (Value &value : values)
+        {
+            value = edge && generator() % 2 == 0 ? special[generator() % special.size()] : uniform(generator);
+        }
+
+        return values;
+    }
+
+    template <typename Value>
+    double ordered(const Value &value)
+    {
+        using Bits = typename std::conditional<sizeof(Value) == 4, uint32_t, uint64_t>::type;
+        constexpr Bits kSign = Bits(1) << (sizeof(Value) * 8 - 1);
+
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(Value));
+
+        return (bits & kSign) != 0 ? -static_cast<double>(bits & ~kSign) : static_cast<double>(bits);
+    }
+
+    // Divergence of value from reference in ULPs of max(|reference|, floor); infinite when only one is finite.
+    template <typename Value>
+    double ulps(const Value &value, const Value &reference, const double &floor)
+    {
+        if (std::isnan(value) || std::isnan(reference))
+        {
+            return std::isnan(value) && std::isnan(reference) ? 0.0 : std::numeric_limits<double>::infinity();
+        }
+
+        if (std::isinf(value) || std::isinf(reference))
+        {
+            return value == reference ? 0.0 : std::numeric_limits<double>::infinity();
+        }
+
+        if (floor == 0.0)
+        {
+            return std::abs(ordered(value) - ordered(reference));
+        }
+
+        const Value scale = static_cast<Value>(std::max(static_cast<double>(std::abs(reference)), floor));
+        const double ulp = static_cast<double>(std::nextafter(scale, std::numeric_limits<Value>::infinity()) - scale);
+
+        return std::abs(static_cast<double>(value) - static_cast<double>(reference)) / ulp;
+    }
+
+    template <typename Value>
+    void compare(const HarnessKernel &kernel, const HarnessKernel &reference, const size_t &count, const bool &edge,
+                 Divergence &divergence)
+    {
+        const std::vector<Value> input = inputs<Value>(count * kernel.inputs, edge, edge ? 2 : 1);
+        std::vector<Value> expected(count * kernel.outputs);
+        std::vector<Value> actual(count * kernel.outputs);
+
+        reference.run(input.data(), expected.data(), count);
+        kernel.run(input.data(), actual.data(), count);
+
+        double &worst = edge ? divergence.edge : divergence.random;
+
+        for (size_t i = 0; i < actual.size(); i++)
+        {
+            const double distance = ulps(actual[i], expected[i], reference.floor);
+
+            // Random inputs never overflow, so a special mismatch there counts as an unbounded divergence.
+            if (std::isinf(distance) && edge)
+            {
+                divergence.special++;
+            }
+            else
+            {
+                worst = std::max(worst, distance);
+            }
+        }
+    }
+
+    template <typename Value>
+    double throughput(const HarnessKernel &kernel, const size_t &count)
+    {
+        const std::vector<Value> input = inputs<Value>(count * kernel.inputs, false, 3);
+        std::vector<Value> output(count * kernel.outputs);
+
+        size_t runs = 0;
+        const auto start = std::chrono::steady_clock::now();
+        double elapsed = 0.0;
+
+        while (elapsed < kMinimumSeconds)
+        {
+            kernel.run(input.data(), output.data(), count);
+            runs++;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        return static_cast<double>(count * runs) / (elapsed * 1e6);
+    }
+
+    Divergence diverge(const HarnessKernel &kernel, const HarnessKernel &reference, const size_t &count)
+    {
+        Divergence divergence = {0.0, 0.0, 0};
+
+        for (const bool &edge : {false, true})
+        {
+            if (kernel.value_size == 4)
+            {
+                compare<float>(kernel, reference, count, edge, divergence);
+            }
+            else
+            {
+                compare<double>(kernel, reference, count, edge, divergence);
+            }
+        }
+
+        return divergence;
+    }
+
+    double measure(const HarnessKernel &kernel, const size_t &count)
+    {
+        return kernel.value_size == 4 ? throughput<float>(kernel, count) : throughput<double>(kernel, count);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const size_t count = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : kDefaultCount;
+    const std::vector<Module> modules = load_modules();
+
+    const HarnessModule *reference = nullptr;
+
+    for (const Module &module : modules)
+    {
+        if (module.isa == kReferenceIsa)
+        {
+            reference = module.module;
+        }
+    }
+
+    if (reference == nullptr)
+    {
+        std::printf("the %s reference module could not be loaded\n", kReferenceIsa);
+        return 1;
+    }
+
+    std::printf("%zu elements per kernel; ULPs against %s on random / edge inputs, special = NaN or infinity mismatches on edge inputs\n\n", count, kReferenceIsa);
+    std::printf("%-34s %5s", "kernel", "bound");
+
+    for (const Module &module : modules)
+    {
+        std::printf(" | %-8s %9s %9s %7s %9s", module.isa.c_str(), "random", "edge", "special", "M/s");
+    }
+
+    std::printf("\n");
+
+    bool failed = false;
+
+    for (size_t k = 0; k < reference->kernel_count; k++)
+    {
+        const HarnessKernel &expected = reference->kernels[k];
+        bool exceeded = false;
+
+        std::printf("%-34s %5u", expected.name, expected.bound);
+
+        for (const Module &module : modules)
+        {
+            const HarnessKernel *kernel = find(module.module, expected.name);
+
+            if (kernel == nullptr)
+            {
+                std::printf(" | %-8s %9s %9s %7s %9s", "", "-", "-", "-", "-");
+                exceeded = true;
+                continue;
+            }
+
+            const Divergence divergence = diverge(*kernel, expected, count);
+
+            exceeded = exceeded || divergence.random > expected.bound || divergence.edge > expected.bound ||
+                       divergence.special > 0;
+
+            std::printf(" | %-8s %9.3g %9.3g %7zu %9.1f", "", divergence.random, divergence.edge, divergence.special, measure(*kernel, count));
+        }
+
+        std::printf("%s\n", exceeded ? "  FAIL" : "");
+        failed = failed || exceeded;
+    }
+
+    return failed ? 1 : 0;
+}
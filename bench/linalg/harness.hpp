@@ -0,0 +1,43 @@
+#ifndef HARNESS_HPP
+#define HARNESS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Interface between linalg_harness and the kernel modules it loads, one module per ISA level.
+
+// One library entry point applied to count independent elements. Input holds count * inputs values and output
+// count * outputs values, of value_size bytes each; a kernel may read either as planes, as long as every module
+// lays them out the same way.
+struct HarnessKernel
+{
+    const char *name;
+
+    uint32_t value_size;
+
+    uint32_t inputs;
+
+    uint32_t outputs;
+
+    // Largest divergence from the scalar module allowed on random and edge inputs, in ULPs of
+    // max(|reference|, floor). A zero floor measures plain ULP distance; kernels that reassociate sums use the
+    // input scale so cancellation does not blow the bound up. NaN and infinity must always match exactly.
+    uint32_t bound;
+
+    double floor;
+
+    void (*run)(const void *input, void *output, size_t count);
+};
+
+struct HarnessModule
+{
+    const char *isa;
+
+    const HarnessKernel *kernels;
+
+    size_t kernel_count;
+};
+
+extern "C" const HarnessModule *lre_harness_module();
+
+#endif
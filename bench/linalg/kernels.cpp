@@ -0,0 +1,252 @@
+#include "harness.hpp"
+
+#include <LRE/linalg.hpp>
+
+#include <cstring>
+
+// Compiled once per ISA level from the same linalg sources; LRE_HARNESS_ISA names the level.
+namespace
+{
+    Vector4 vector(const float *values)
+    {
+        return Vector4(values[0], values[1], values[2], values[3]);
+    }
+
+    Vector4d vector(const double *values)
+    {
+        return Vector4d(values[0], values[1], values[2], values[3]);
+    }
+
+    Quaternion quaternion(const float *values)
+    {
+        return Quaternion(values[0], values[1], values[2], values[3]);
+    }
+
+    Matrix4 matrix(const float *values)
+    {
+        Matrix4 result;
+
+        for (int32_t e = 0; e < 16; e++)
+        {
+            result[e] = values[e];
+        }
+
+        return result;
+    }
+
+    Matrix4d matrix(const double *values)
+    {
+        Matrix4d result;
+
+        for (int32_t e = 0; e < 16; e++)
+        {
+            result[e] = values[e];
+        }
+
+        return result;
+    }
+
+    template <typename Value, typename Vector>
+    void store(const Vector &vector, Value *output)
+    {
+        for (int32_t c = 0; c < 4; c++)
+        {
+            output[c] = vector[c];
+        }
+    }
+
+    template <typename Value, typename Matrix>
+    void store_matrix(const Matrix &matrix, Value *output)
+    {
+        for (int32_t e = 0; e < 16; e++)
+        {
+            output[e] = matrix[e];
+        }
+    }
+
+    template <typename Value, size_t Inputs, size_t Outputs, typename Function>
+    void each(const void *input, void *output, const size_t &count, Function &&function)
+    {
+        const Value *source = static_cast<const Value *>(input);
+        Value *destination = static_cast<Value *>(output);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            function(source + i * Inputs, destination + i * Outputs);
+        }
+    }
+
+    // Batch kernels read and write element planes: element e of matrix i sits at values[e * count + i].
+    Matrix4Batch batch(const float *planes, const size_t &count, const int32_t &first)
+    {
+        Matrix4Batch result(count);
+
+        for (int32_t e = 0; e < 16; e++)
+        {
+            std::memcpy(result.element(e), planes + (first + e) * count, count * sizeof(float));
+        }
+
+        return result;
+    }
+
+    void store_batch(const Matrix4Batch &batch, float *planes)
+    {
+        for (int32_t e = 0; e < 16; e++)
+        {
+            std::memcpy(planes + e * batch.size(), batch.element(e), batch.size() * sizeof(float));
+        }
+    }
+
+    const Quaternion kRotation = Quaternion::from_axis_angle(Vector4(0.36f, -0.48f, 0.8f), 0.7f);
+
+    const HarnessKernel kKernels[] = {
+        {"vector4.add", 4, 8, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 8, 4>(input, output, count, [](const float *a, float *r)
+                             { store(vector(a) + vector(a + 4), r); }); }},
+        {"vector4.sub", 4, 8, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 8, 4>(input, output, count, [](const float *a, float *r)
+                             { store(vector(a) - vector(a + 4), r); }); }},
+        {"vector4.mul", 4, 8, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 8, 4>(input, output, count, [](const float *a, float *r)
+                             { store(vector(a) * vector(a + 4), r); }); }},
+        {"vector4.scale", 4, 5, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 5, 4>(input, output, count, [](const float *a, float *r)
+                             { store(vector(a) * a[4], r); }); }},
+        // Multiplying by a rounded reciprocal stays within 3 half-ULPs of the quotient, so 2 ULPs from true division.
+        {"vector4.divide", 4, 5, 4, 2, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 5, 4>(input, output, count, [](const float *a, float *r)
+                             { store(vector(a) / a[4], r); }); }},
+        {"vector4.dot", 4, 8, 1, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 8, 1>(input, output, count, [](const float *a, float *r)
+                             { r[0] = Vector4::dot(vector(a), vector(a + 4)); }); }},
+        {"vector4.normalized", 4, 4, 4, 2, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 4, 4>(input, output, count, [](const float *a, float *r)
+                             { store(vector(a).normalized(), r); }); }},
+        {"vector4.lerp", 4, 9, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 9, 4>(input, output, count, [](const float *a, float *r)
+                             { store(Vector4::lerp(vector(a), vector(a + 4), a[8]), r); }); }},
+        {"vector4.project", 4, 8, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 8, 4>(input, output, count, [](const float *a, float *r)
+                             { store(Vector4::project(vector(a), vector(a + 4)), r); }); }},
+        {"matrix4.multiply", 4, 32, 16, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 32, 16>(input, output, count, [](const float *a, float *r)
+                               { store_matrix(matrix(a) * matrix(a + 16), r); }); }},
+        {"matrix4.add", 4, 32, 16, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 32, 16>(input, output, count, [](const float *a, float *r)
+                               { store_matrix(matrix(a) + matrix(a + 16), r); }); }},
+        {"matrix4.sub", 4, 32, 16, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 32, 16>(input, output, count, [](const float *a, float *r)
+                               { store_matrix(matrix(a) - matrix(a + 16), r); }); }},
+        {"matrix4.scale", 4, 17, 16, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 17, 16>(input, output, count, [](const float *a, float *r)
+                               { store_matrix(matrix(a) * a[16], r); }); }},
+        {"matrix4.determinant", 4, 16, 1, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 16, 1>(input, output, count, [](const float *a, float *r)
+                              { r[0] = matrix(a).determinant(); }); }},
+        {"matrix4.inverted", 4, 16, 16, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 16, 16>(input, output, count, [](const float *a, float *r)
+                               { store_matrix(matrix(a).inverted(), r); }); }},
+        {"matrix4_batch.multiply", 4, 32, 16, 0, 0.0, [](const void *input, void *output, size_t count)
+         {
+             const float *planes = static_cast<const float *>(input);
+             store_batch(batch(planes, count, 0) * batch(planes, count, 16), static_cast<float *>(output));
+         }},
+        {"matrix4_batch.inverted", 4, 16, 16, 0, 0.0, [](const void *input, void *output, size_t count)
+         { store_batch(batch(static_cast<const float *>(input), count, 0).inverted(), static_cast<float *>(output)); }},
+        {"matrix4_batch.determinants", 4, 16, 1, 0, 0.0, [](const void *input, void *output, size_t count)
+         {
+             const std::vector<float> determinants = batch(static_cast<const float *>(input), count, 0).determinants();
+             std::memcpy(output, determinants.data(), count * sizeof(float));
+         }},
+        {"quaternion.multiply", 4, 8, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 8, 4>(input, output, count, [](const float *a, float *r)
+                             { store(quaternion(a) * quaternion(a + 4), r); }); }},
+        {"quaternion.conjugate", 4, 4, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 4, 4>(input, output, count, [](const float *a, float *r)
+                             { store(quaternion(a).conjugate(), r); }); }},
+        {"quaternion.normalized", 4, 4, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 4, 4>(input, output, count, [](const float *a, float *r)
+                             { store(quaternion(a).normalized(), r); }); }},
+        {"quaternion.dot", 4, 8, 1, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 8, 1>(input, output, count, [](const float *a, float *r)
+                             { r[0] = Quaternion::dot(quaternion(a), quaternion(a + 4)); }); }},
+        {"quaternion.rotate", 4, 8, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 8, 4>(input, output, count, [](const float *a, float *r)
+                             { store(quaternion(a).rotate(vector(a + 4)), r); }); }},
+        {"quaternion.to_matrix", 4, 4, 16, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 4, 16>(input, output, count, [](const float *a, float *r)
+                              { store_matrix(quaternion(a).to_matrix(), r); }); }},
+        {"quaternion.slerp", 4, 9, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<float, 9, 4>(input, output, count, [](const float *a, float *r)
+                             { store(Quaternion::slerp(quaternion(a), quaternion(a + 4), a[8]), r); }); }},
+        // Point kernels read x, y and z planes.
+        {"quaternion.rotate_points", 4, 3, 3, 0, 0.0, [](const void *input, void *output, size_t count)
+         {
+             const float *in = static_cast<const float *>(input);
+             float *out = static_cast<float *>(output);
+             kRotation.rotate_points(in, in + count, in + 2 * count, out, out + count, out + 2 * count, count);
+         }},
+        {"rigid_transform.transform_points", 4, 3, 3, 0, 0.0, [](const void *input, void *output, size_t count)
+         {
+             const float *in = static_cast<const float *>(input);
+             float *out = static_cast<float *>(output);
+             RigidTransform(kRotation, Vector4(1.5f, -2.0f, 0.25f)).transform_points(in, in + count, in + 2 * count, out, out + count, out + 2 * count, count);
+         }},
+        {"vector4d.add", 8, 8, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 8, 4>(input, output, count, [](const double *a, double *r)
+                              { store(vector(a) + vector(a + 4), r); }); }},
+        {"vector4d.sub", 8, 8, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 8, 4>(input, output, count, [](const double *a, double *r)
+                              { store(vector(a) - vector(a + 4), r); }); }},
+        {"vector4d.mul", 8, 8, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 8, 4>(input, output, count, [](const double *a, double *r)
+                              { store(vector(a) * vector(a + 4), r); }); }},
+        {"vector4d.min", 8, 8, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 8, 4>(input, output, count, [](const double *a, double *r)
+                              { store(Vector4d::min(vector(a), vector(a + 4)), r); }); }},
+        {"vector4d.max", 8, 8, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 8, 4>(input, output, count, [](const double *a, double *r)
+                              { store(Vector4d::max(vector(a), vector(a + 4)), r); }); }},
+        // Narrowing kernels widen their float results back to double, which is exact.
+        {"vector4d.to_float", 8, 4, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 4, 4>(input, output, count, [](const double *a, double *r)
+                              { store(vector(a).to_float(), r); }); }},
+        {"vector4d.scale", 8, 5, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 5, 4>(input, output, count, [](const double *a, double *r)
+                              { store(vector(a) * a[4], r); }); }},
+        {"vector4d.divide", 8, 5, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 5, 4>(input, output, count, [](const double *a, double *r)
+                              { store(vector(a) / a[4], r); }); }},
+        {"vector4d.dot", 8, 8, 1, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 8, 1>(input, output, count, [](const double *a, double *r)
+                              { r[0] = Vector4d::dot(vector(a), vector(a + 4)); }); }},
+        {"matrix4d.multiply", 8, 32, 16, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 32, 16>(input, output, count, [](const double *a, double *r)
+                                { store_matrix(matrix(a) * matrix(a + 16), r); }); }},
+        {"matrix4d.add", 8, 32, 16, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 32, 16>(input, output, count, [](const double *a, double *r)
+                                { store_matrix(matrix(a) + matrix(a + 16), r); }); }},
+        {"matrix4d.sub", 8, 32, 16, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 32, 16>(input, output, count, [](const double *a, double *r)
+                                { store_matrix(matrix(a) - matrix(a + 16), r); }); }},
+        {"matrix4d.scale", 8, 17, 16, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 17, 16>(input, output, count, [](const double *a, double *r)
+                                { store_matrix(matrix(a) * a[16], r); }); }},
+        {"matrix4d.to_float", 8, 16, 16, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 16, 16>(input, output, count, [](const double *a, double *r)
+                                { store_matrix(matrix(a).to_float(), r); }); }},
+        {"matrix4d.transform", 8, 20, 4, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 20, 4>(input, output, count, [](const double *a, double *r)
+                               { store(matrix(a) * vector(a + 16), r); }); }},
+        {"matrix4d.inverted", 8, 16, 16, 0, 0.0, [](const void *input, void *output, size_t count)
+         { each<double, 16, 16>(input, output, count, [](const double *a, double *r)
+                                { store_matrix(matrix(a).inverted(), r); }); }},
+    };
+
+    const HarnessModule kModule = {LRE_HARNESS_ISA, kKernels, sizeof(kKernels) / sizeof(kKernels[0])};
+}
+
+extern "C" __attribute__((visibility("default"))) const HarnessModule *lre_harness_module()
+{
+    return &kModule;
+}
@@ -0,0 +1,143 @@
+#include <LRE/parallel/primitives.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <utility>
+
+#if __has_include(<execution>)
+#include <execution>
+#endif
+
+// Usage: parallel_bench [element_count]; defaults to 100M elements, which needs roughly 4 GB of memory.
+namespace
+{
+    constexpr size_t kDefaultCount = 100000000;
+
+    template <typename Function>
+    double milliseconds(Function &&function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void report(const char *name, const size_t &count, const double &elapsed)
+    {
+        std::printf("%-36s %10.1f ms %10.1f M/s\n", name, elapsed, static_cast<double>(count) / (elapsed * 1000.0));
+    }
+
+    std::vector<uint64_t> random_keys(const size_t &count)
+    {
+        std::mt19937_64 generator(1);
+        std::vector<uint64_t> keys(count);
+
+        for (uint64_t &key : keys)
+        {
+            // 63 significant bits, like a 21-bit-per-axis Morton code.
+            key = generator() >> 1;
+        }
+
+        return keys;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const size_t count = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : kDefaultCount;
+    ThreadPool &pool = ThreadPool::shared();
+
+    std::printf("%zu elements, %zu worker threads\n", count, pool.size());
+
+    const std::vector<uint64_t> source = random_keys(count);
+
+    {
+        std::vector<std::pair<uint64_t, uint32_t>> pairs(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            pairs[i] = std::make_pair(source[i], static_cast<uint32_t>(i));
+        }
+
+        report("std::sort pairs", count, milliseconds([&pairs]()
+                                                      { std::sort(pairs.begin(), pairs.end()); }));
+    }
+
+#if defined(__cpp_lib_parallel_algorithm)
+    {
+        std::vector<std::pair<uint64_t, uint32_t>> pairs(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            pairs[i] = std::make_pair(source[i], static_cast<uint32_t>(i));
+        }
+
+        report("std::sort(par_unseq) pairs", count, milliseconds([&pairs]()
+                                                                 { std::sort(std::execution::par_unseq, pairs.begin(), pairs.end()); }));
+    }
+#else
+    std::printf("std::execution policies are unavailable in this standard library\n");
+#endif
+
+    {
+        std::vector<uint64_t> keys = source;
+        std::vector<uint32_t> values(count);
+        std::iota(values.begin(), values.end(), 0u);
+
+        report("radix_sort 64-bit pairs", count, milliseconds([&keys, &values, &pool]()
+                                                              { ParallelPrimitives::radix_sort(keys, values, pool); }));
+    }
+
+    {
+        std::vector<uint32_t> keys(count);
+        std::vector<uint32_t> values(count);
+        std::iota(values.begin(), values.end(), 0u);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            keys[i] = static_cast<uint32_t>(source[i]);
+        }
+
+        report("radix_sort 32-bit pairs", count, milliseconds([&keys, &values, &pool]()
+                                                              { ParallelPrimitives::radix_sort(keys, values, pool); }));
+    }
+
+    std::vector<uint32_t> small(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        small[i] = static_cast<uint32_t>(source[i] & 0xff);
+    }
+
+    {
+        std::vector<uint32_t> values = small;
+        report("std::exclusive_scan", count, milliseconds([&values]()
+                                                          { std::exclusive_scan(values.begin(), values.end(), values.begin(), 0u); }));
+    }
+
+    {
+        std::vector<uint32_t> values = small;
+        report("exclusive_scan", count, milliseconds([&values, &pool]()
+                                                     { ParallelPrimitives::exclusive_scan(values, pool); }));
+    }
+
+    {
+        std::vector<uint8_t> flags(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            flags[i] = (source[i] & 7) == 0;
+        }
+
+        report("compact (12.5% kept)", count, milliseconds([&flags, &pool]()
+                                                           { ParallelPrimitives::compact(flags, pool); }));
+    }
+
+    report("histogram (256 bins)", count, milliseconds([&small, &pool]()
+                                                       { ParallelPrimitives::histogram(small, 256, pool); }));
+
+    return 0;
+}
@@ -0,0 +1,14 @@
+include(CheckCXXCompilerFlag)
+check_cxx_compiler_flag("-mavx" COMPILER_SUPPORTS_AVX)
+
+if(COMPILER_SUPPORTS_AVX)
+    message(STATUS "AVX is supported by the compiler and will be enabled")
+else()
+    message(STATUS "AVX is not supported by the compiler")
+endif()
+
+function(lre_enable_simd TARGET)
+    if(COMPILER_SUPPORTS_AVX)
+        target_compile_options(${TARGET} PRIVATE -mavx)
+    endif()
+endfunction()
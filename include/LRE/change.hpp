@@ -0,0 +1,3 @@
+#pragma once
+
+#include <LRE/change/m3c2.hpp>
\ No newline at end of file
@@ -0,0 +1,111 @@
+#ifndef M3C2_HPP
+#define M3C2_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/spatial/kd_tree.hpp>
+#include <LRE/outofcore/tile_store.hpp>
+#include <LRE/outofcore/tile_cache.hpp>
+#include <LRE/outofcore/tile_processor.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+
+struct ChangeMeasurement
+{
+    // Compared minus reference mean position along the core normal; NaN when either epoch has too few points.
+    float distance;
+    // 95% level of detection including the registration error.
+    float uncertainty;
+    uint32_t reference_count;
+    uint32_t compared_count;
+    bool significant;
+};
+
+// Multiscale model-to-model cloud comparison between two registered epochs.
+class M3C2
+{
+ public:
+
+    static constexpr float kConfidence = 1.96f;
+
+    static constexpr size_t kQueryBatch = 256;
+
+ private:
+
+    float radius_;
+
+    float depth_;
+
+    size_t min_points_;
+
+    float registration_error_;
+
+    std::vector<ChangeMeasurement> apply_tile(const TileInfo & info, const float & tile_size, const PointCloud & compared,
+                                              const size_t & core_count, const TileStore & reference, TileCache & reference_cache,
+                                              const std::string & index_directory, ThreadPool & pool) const;
+
+ public:
+
+    // Points are projected inside a cylinder of the given radius reaching depth along the normal on both sides.
+    M3C2(const float & radius, const float & depth, const size_t & min_points, const float & registration_error);
+
+    M3C2(const float & radius, const float & depth);
+
+    float radius() const;
+
+    float depth() const;
+
+    size_t min_points() const;
+
+    float registration_error() const;
+
+    // Radius of the sphere enclosing a projection cylinder; tile halos must be at least this wide.
+    float reach() const;
+
+    // Measures the first count points of core, which must carry normals, against both indexed epochs.
+    std::vector<ChangeMeasurement> apply(const PointCloud & core, const size_t & count,
+                                         const PointCloud & compared, const KdTree & compared_tree,
+                                         const PointCloud & reference, const KdTree & reference_tree, ThreadPool & pool) const;
+
+    // Uses every compared point as a core point; reference_tree can be kept across epochs or mapped from an IndexCache.
+    std::vector<ChangeMeasurement> apply(const PointCloud & compared, const PointCloud & reference, const KdTree & reference_tree,
+                                         ThreadPool & pool) const;
+
+    std::vector<ChangeMeasurement> apply(const PointCloud & compared, const PointCloud & reference, const KdTree & reference_tree) const;
+
+    // Streams the compared store tile by tile and calls sink(info, core, measurements) with the core points of each tile.
+    // Reference tile indices are cached in index_directory unless it is empty, so later epochs map them instead of rebuilding.
+    template <typename Function>
+    void apply(TileProcessor & compared, const TileStore & reference, TileCache & reference_cache,
+               const std::string & index_directory, ThreadPool & pool, Function && sink) const;
+
+    // Nearest-neighbour distance to the reference, signed by the reference normal when it has normals.
+    static std::vector<float> cloud_to_cloud(const PointCloud & compared, const PointCloud & reference,
+                                             const KdTree & reference_tree, ThreadPool & pool);
+};
+
+template <typename Function>
+void M3C2::apply(TileProcessor &compared, const TileStore &reference, TileCache &reference_cache,
+                 const std::string &index_directory, ThreadPool &pool, Function &&sink) const
+{
+    if (compared.halo() < reach())
+    {
+        throw std::invalid_argument("M3C2: tile halo is smaller than the cylinder reach");
+    }
+
+    const float tile_size = compared.store().tile_size();
+
+    compared.for_each_tile([this, tile_size, &reference, &reference_cache, &index_directory, &pool, &sink](const TileInfo &info, PointCloud &local, const size_t &core_count)
+                           {
+                               const std::vector<ChangeMeasurement> measurements =
+                                   apply_tile(info, tile_size, local, core_count, reference, reference_cache, index_directory, pool);
+
+                               local.resize(core_count);
+                               sink(info, static_cast<const PointCloud &>(local), measurements); });
+}
+
+#endif
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/cloud/morton.hpp>
+#include <LRE/cloud/compressed_cloud.hpp>
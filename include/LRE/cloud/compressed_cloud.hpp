@@ -0,0 +1,117 @@
+#ifndef COMPRESSED_CLOUD_HPP
+#define COMPRESSED_CLOUD_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/cloud/morton.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+
+enum class CloudEncoding
+{
+    Quantized16,
+    Quantized32,
+    MortonDelta
+};
+
+class CompressedCloud
+{
+ private:
+
+    struct Tile
+    {
+        float origin[3];
+        size_t count;
+        size_t offset;
+        size_t first_block;
+        size_t block_count;
+    };
+
+    struct Block
+    {
+        uint64_t base;
+        size_t word_offset;
+        uint32_t count;
+        uint32_t width;
+    };
+
+    CloudEncoding encoding_;
+
+    float resolution_;
+
+    size_t size_;
+
+    Vector4d origin_;
+
+    std::vector<Tile> tiles_;
+
+    std::vector<Block> blocks_;
+
+    std::vector<uint16_t> codes16_;
+
+    std::vector<uint32_t> codes32_;
+
+    std::vector<uint64_t> packed_;
+
+    void encode_tile(Tile & tile, const PointCloud & cloud, const std::vector<uint32_t> & indices);
+
+    void unpack_tile(const Tile & tile, uint16_t * x, uint16_t * y, uint16_t * z) const;
+
+ public:
+
+    static constexpr size_t kBlockSize = 256;
+
+    CompressedCloud(const PointCloud & cloud, const float & resolution, const CloudEncoding & encoding);
+
+    CompressedCloud();
+
+    size_t size() const;
+
+    size_t tile_count() const;
+
+    size_t tile_size(const size_t & tile) const;
+
+    float resolution() const;
+
+    CloudEncoding encoding() const;
+
+    // Floating origin of the encoded cloud, restored on every decoded cloud.
+    const Vector4d & origin() const;
+
+    size_t memory_usage() const;
+
+    void decode_tile(const size_t & tile, float * x, float * y, float * z) const;
+
+    void decode_tile(const size_t & tile, PointCloud & scratch) const;
+
+    PointCloud decode(ThreadPool & pool) const;
+
+    PointCloud decode() const;
+
+    template <typename Function>
+    void for_each_tile(Function && function, ThreadPool & pool) const;
+};
+
+template <typename Function>
+void CompressedCloud::for_each_tile(Function &&function, ThreadPool &pool) const
+{
+    pool.parallel_for(0, tiles_.size(), 1, [this, &function](const size_t &begin, const size_t &end)
+                      {
+                          PointCloud scratch;
+
+                          for (size_t tile = begin; tile < end; tile++)
+                          {
+                              decode_tile(tile, scratch);
+                              function(tile, static_cast<const PointCloud &>(scratch));
+                          } });
+}
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef MORTON_HPP
+#define MORTON_HPP
+
+#include <cstdint>
+
+class Morton
+{
+ public:
+
+    static uint64_t encode(const uint32_t & x, const uint32_t & y, const uint32_t & z);
+
+    static void decode(const uint64_t & code, uint32_t & x, uint32_t & y, uint32_t & z);
+
+    static uint64_t spread(const uint32_t & value);
+
+    static uint32_t compact(const uint64_t & value);
+};
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef POINT_CLOUD_HPP
+#define POINT_CLOUD_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/linalg/vector4d.hpp>
+#include <LRE/linalg/matrix4d.hpp>
+
+class PointCloud
+{
+ private:
+
+    std::vector<float> x_;
+
+    std::vector<float> y_;
+
+    std::vector<float> z_;
+
+    std::vector<float> timestamps_;
+
+    std::vector<float> normal_x_;
+
+    std::vector<float> normal_y_;
+
+    std::vector<float> normal_z_;
+
+    bool timestamped_;
+
+    bool has_normals_;
+
+    // Coordinates are float offsets from this double-precision origin.
+    Vector4d origin_;
+
+ public:
+
+    PointCloud(const size_t & size);
+
+    PointCloud(const std::vector<Vector4> & points);
+
+    PointCloud();
+
+    size_t size() const;
+
+    bool empty() const;
+
+    bool has_timestamps() const;
+
+    bool has_normals() const;
+
+    void reserve(const size_t & capacity);
+
+    void resize(const size_t & size);
+
+    void clear();
+
+    void enable_timestamps();
+
+    void enable_normals();
+
+    void push_back(const Vector4 & point);
+
+    void push_back(const Vector4 & point, const float & timestamp);
+
+    void append(const PointCloud & other);
+
+    Vector4 point(const size_t & index) const;
+
+    void set_point(const size_t & index, const Vector4 & point);
+
+    Vector4 normal(const size_t & index) const;
+
+    void set_normal(const size_t & index, const Vector4 & normal);
+
+    std::vector<Vector4> to_vectors() const;
+
+    const Vector4d & origin() const;
+
+    // Replaces the origin without touching the stored offsets.
+    void set_origin(const Vector4d & origin);
+
+    // Moves the origin while keeping world positions; offsets are re-expressed in double precision.
+    void rebase(const Vector4d & origin);
+
+    // Applies a world-frame pose and re-expresses the result relative to origin in the same pass.
+    void rebase(const Matrix4d & pose, const Vector4d & origin);
+
+    Vector4d world_point(const size_t & index) const;
+
+    void push_back_world(const Vector4d & point);
+
+    float * x();
+
+    float * y();
+
+    float * z();
+
+    float * timestamps();
+
+    float * normal_x();
+
+    float * normal_y();
+
+    float * normal_z();
+
+    const float * x() const;
+
+    const float * y() const;
+
+    const float * z() const;
+
+    const float * timestamps() const;
+
+    const float * normal_x() const;
+
+    const float * normal_y() const;
+
+    const float * normal_z() const;
+};
+
+#endif
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <LRE/features/descriptor_set.hpp>
+#include <LRE/features/descriptor_tree.hpp>
+#include <LRE/features/fpfh_estimation.hpp>
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef DESCRIPTOR_SET_HPP
+#define DESCRIPTOR_SET_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+class DescriptorSet
+{
+ private:
+
+    size_t dimension_;
+
+    std::vector<float> data_;
+
+ public:
+
+    DescriptorSet(const size_t & count, const size_t & dimension);
+
+    DescriptorSet();
+
+    size_t size() const;
+
+    size_t dimension() const;
+
+    bool empty() const;
+
+    void resize(const size_t & count, const size_t & dimension);
+
+    float * row(const size_t & index);
+
+    const float * row(const size_t & index) const;
+
+    float * data();
+
+    const float * data() const;
+
+    static float sqr_distance(const float * a, const float * b, const size_t & dimension);
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef DESCRIPTOR_TREE_HPP
+#define DESCRIPTOR_TREE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <LRE/features/descriptor_set.hpp>
+
+class DescriptorTree
+{
+ public:
+
+    struct Node
+    {
+        uint32_t begin;
+        uint32_t end;
+        uint32_t left;
+        uint32_t right;
+        float split;
+        int32_t axis;
+    };
+
+ private:
+
+    std::vector<Node> nodes_;
+
+    std::vector<float> data_;
+
+    std::vector<uint32_t> indices_;
+
+    size_t dimension_;
+
+    size_t leaf_size_;
+
+    uint32_t build(const DescriptorSet & descriptors, const uint32_t & begin, const uint32_t & end);
+
+ public:
+
+    DescriptorTree(const DescriptorSet & descriptors, const size_t & leaf_size);
+
+    DescriptorTree(const DescriptorSet & descriptors);
+
+    DescriptorTree();
+
+    size_t size() const;
+
+    size_t dimension() const;
+
+    bool empty() const;
+
+    void knn(const float * query, const size_t & k,
+             std::vector<uint32_t> & indices, std::vector<float> & sqr_distances) const;
+
+    // Stops after visiting max_leaves leaves, trading exactness for speed in high dimensions.
+    void knn(const float * query, const size_t & k, const size_t & max_leaves,
+             std::vector<uint32_t> & indices, std::vector<float> & sqr_distances) const;
+};
+
+#endif
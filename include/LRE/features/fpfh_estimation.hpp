@@ -0,0 +1,51 @@
+#ifndef FPFH_ESTIMATION_HPP
+#define FPFH_ESTIMATION_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/spatial/kd_tree.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+#include <LRE/features/descriptor_set.hpp>
+
+class FpfhEstimation
+{
+ private:
+
+    float radius_;
+
+    size_t max_neighbours_;
+
+    void query_neighbours(const PointCloud & cloud, const KdTree & tree, const uint32_t * points, const size_t & count,
+                          std::vector<uint32_t> & offsets, std::vector<uint32_t> & neighbours, ThreadPool & pool) const;
+
+ public:
+
+    static constexpr size_t kBins = 11;
+
+    static constexpr size_t kDimension = 3 * kBins;
+
+    FpfhEstimation(const float & radius, const size_t & max_neighbours);
+
+    FpfhEstimation(const float & radius);
+
+    float radius() const;
+
+    size_t max_neighbours() const;
+
+    // Requires normals; descriptors row i belongs to keypoints[i].
+    void compute(const PointCloud & cloud, const KdTree & tree, const std::vector<uint32_t> & keypoints,
+                 DescriptorSet & descriptors, ThreadPool & pool) const;
+
+    void compute(const PointCloud & cloud, DescriptorSet & descriptors, ThreadPool & pool) const;
+
+    void compute(const PointCloud & cloud, DescriptorSet & descriptors) const;
+
+    static bool pair_features(const Vector4 & source, const Vector4 & source_normal,
+                              const Vector4 & target, const Vector4 & target_normal, float features[3]);
+};
+
+#endif
@@ -1,4 +1,9 @@
 #pragma once
 
-#include <linalg/vector4.hpp>
-#include <linalg/matrix4.hpp>
\ No newline at end of file
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/linalg/matrix4.hpp>
+#include <LRE/linalg/quaternion.hpp>
+#include <LRE/linalg/rigid_transform.hpp>
+#include <LRE/linalg/vector4d.hpp>
+#include <LRE/linalg/matrix4d.hpp>
+#include <LRE/linalg/matrix4_batch.hpp>
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef MATRIX4_BATCH_HPP
+#define MATRIX4_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+
+#include <LRE/linalg/matrix4.hpp>
+
+// Row-major Matrix4 values stored element by element: element(e)[i] is element e of matrix i.
+// Each element array is padded with zero matrices to a multiple of kLanes so kernels never handle a tail.
+class Matrix4Batch
+{
+ public:
+
+    static constexpr size_t kLanes = 8;
+
+ private:
+
+    size_t size_;
+
+    size_t stride_;
+
+    std::vector<float> data_;
+
+ public:
+
+    Matrix4Batch();
+
+    // Zero matrices.
+    explicit Matrix4Batch(const size_t & size);
+
+    explicit Matrix4Batch(const std::vector<Matrix4> & matrices);
+
+    size_t size() const;
+
+    bool empty() const;
+
+    // Distance between consecutive element arrays.
+    size_t stride() const;
+
+    float *element(const int32_t & index);
+
+    const float *element(const int32_t & index) const;
+
+    Matrix4 matrix(const size_t & index) const;
+
+    void set_matrix(const size_t & index, const Matrix4 & matrix);
+
+    std::vector<Matrix4> to_matrices() const;
+
+    std::vector<float> determinants() const;
+
+    // Singular matrices are returned unchanged, like Matrix4::inverted.
+    Matrix4Batch inverted() const;
+
+    // Pairwise products; both batches must have the same size.
+    Matrix4Batch operator*(const Matrix4Batch& other) const;
+
+    // Every matrix times the same right-hand matrix.
+    Matrix4Batch operator*(const Matrix4& matrix) const;
+
+    // The same left-hand matrix times every matrix, e.g. moving a trajectory into another frame.
+    Matrix4Batch premultiplied(const Matrix4 & matrix) const;
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef MATRIX4D_HPP
+#define MATRIX4D_HPP
+
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <cmath>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+#include <LRE/linalg/matrix4.hpp>
+#include <LRE/linalg/vector4d.hpp>
+
+// Row-major double-precision counterpart of Matrix4; translation sits at indices 3, 7 and 11.
+class Matrix4d
+{
+ private:
+
+    double data_[16];
+
+ public:
+
+    Matrix4d(const Matrix4 & other);
+
+    Matrix4d(const Matrix4d & other);
+
+    Matrix4d();
+
+    double &operator[](const int32_t & index);
+
+    const double &operator[](const int32_t & index) const;
+
+    void identity();
+
+    double determinant() const;
+
+    Matrix4d transposed() const;
+
+    // Returns the matrix unchanged when it is singular, like Matrix4::inverted.
+    Matrix4d inverted() const;
+
+    Matrix4 to_float() const;
+
+    Matrix4d operator*(const Matrix4d& other) const;
+
+    Vector4d operator*(const Vector4d& vector) const;
+
+    Matrix4d operator*(const double& scalar) const;
+
+    Matrix4d operator+(const Matrix4d& other) const;
+
+    Matrix4d operator-(const Matrix4d& other) const;
+
+    Matrix4d& operator=(const Matrix4d& other);
+
+    static Matrix4d translation(const Vector4d & offset);
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef QUATERNION_HPP
+#define QUATERNION_HPP
+
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <cmath>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/linalg/matrix4.hpp>
+
+class Quaternion
+{
+ private:
+
+    float data_[4];
+
+ public:
+
+    Quaternion(const float & x, const float & y, const float & z, const float & w);
+
+    Quaternion(const Quaternion & other);
+
+    Quaternion();
+
+    float & x();
+
+    float & y();
+
+    float & z();
+
+    float & w();
+
+    float& operator[](const int32_t & index);
+
+    const float& operator[](const int32_t & index) const;
+
+    Quaternion& operator=(const Quaternion & other);
+
+    float magnitude() const;
+
+    Quaternion normalized() const;
+
+    Quaternion conjugate() const;
+
+    Quaternion inverted() const;
+
+    Quaternion operator*(const Quaternion & other) const;
+
+    Matrix4 to_matrix() const;
+
+    Vector4 rotate(const Vector4 & point) const;
+
+    void rotate_points(const float * x, const float * y, const float * z,
+                       float * out_x, float * out_y, float * out_z, const size_t & count) const;
+
+    static float dot(const Quaternion & a, const Quaternion & b);
+
+    static Quaternion from_matrix(const Matrix4 & matrix);
+
+    static Quaternion from_axis_angle(const Vector4 & axis, const float & angle);
+
+    static Quaternion slerp(const Quaternion & a, const Quaternion & b, float t);
+};
+
+#endif
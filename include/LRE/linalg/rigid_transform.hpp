@@ -0,0 +1,60 @@
+#ifndef RIGID_TRANSFORM_HPP
+#define RIGID_TRANSFORM_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/linalg/matrix4.hpp>
+#include <LRE/linalg/quaternion.hpp>
+
+class RigidTransform
+{
+ private:
+
+    Quaternion rotation_;
+
+    Vector4 translation_;
+
+ public:
+
+    RigidTransform(const Quaternion & rotation, const Vector4 & translation);
+
+    RigidTransform(const Matrix4 & matrix);
+
+    RigidTransform(const RigidTransform & other);
+
+    RigidTransform();
+
+    Quaternion & rotation();
+
+    Vector4 & translation();
+
+    const Quaternion & rotation() const;
+
+    const Vector4 & translation() const;
+
+    RigidTransform& operator=(const RigidTransform & other);
+
+    RigidTransform operator*(const RigidTransform & other) const;
+
+    RigidTransform inverted() const;
+
+    RigidTransform& renormalize();
+
+    Vector4 transform(const Vector4 & point) const;
+
+    void transform_points(const float * x, const float * y, const float * z,
+                          float * out_x, float * out_y, float * out_z, const size_t & count) const;
+
+    Matrix4 to_matrix() const;
+
+    static RigidTransform interpolate(const RigidTransform & a, const RigidTransform & b, const float & t);
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef VECTOR4D_HPP
+#define VECTOR4D_HPP
+
+#include <cstring>
+#include <stdint.h>
+#include <cmath>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+#include <LRE/linalg/vector4.hpp>
+
+// Double-precision counterpart of Vector4 for georeferenced coordinates.
+class Vector4d
+{
+ private:
+
+    double data_[4];
+
+ public:
+
+    Vector4d(const double & x, const double & y, const double & z, const double & w);
+
+    Vector4d(const double & x, const double & y, const double & z);
+
+    Vector4d(const Vector4 & other);
+
+    Vector4d(const Vector4d & other);
+
+    Vector4d();
+
+    double magnitude() const;
+
+    Vector4d normalized() const;
+
+    double sqr_magnitude() const;
+
+    double & x();
+
+    double & y();
+
+    double & z();
+
+    double & w();
+
+    bool operator==(const Vector4d & other) const;
+
+    bool operator!=(const Vector4d & other) const;
+
+    Vector4d operator+(const Vector4d & other) const;
+
+    Vector4d operator*(const Vector4d & other) const;
+
+    Vector4d operator-(const Vector4d & other) const;
+
+    Vector4d operator*(const double & scalar) const;
+
+    Vector4d operator/(const double & scalar) const;
+
+    Vector4d& operator=(const Vector4d & other);
+
+    double& operator[](const int32_t & index);
+
+    const double& operator[](const int32_t & index) const;
+
+    Vector4d& normalize();
+
+    Vector4 to_float() const;
+
+    static double distance(const Vector4d & a, const Vector4d & b);
+
+    static double dot(const Vector4d & a, const Vector4d & b);
+
+    static Vector4d lerp(const Vector4d & a, const Vector4d & b, double t);
+
+    static Vector4d max(const Vector4d & a, const Vector4d & b);
+
+    static Vector4d min(const Vector4d & a, const Vector4d & b);
+};
+
+#endif
@@ -0,0 +1,4 @@
+#pragma once
+
+#include <LRE/mesh/triangle_mesh.hpp>
+#include <LRE/mesh/quadric_decimation.hpp>
\ No newline at end of file
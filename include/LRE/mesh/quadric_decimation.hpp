@@ -0,0 +1,47 @@
+#ifndef QUADRIC_DECIMATION_HPP
+#define QUADRIC_DECIMATION_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <LRE/mesh/triangle_mesh.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+
+// Garland-Heckbert edge collapse over Morton-ordered partitions simplified in parallel.
+class QuadricDecimation
+{
+ public:
+
+    static constexpr size_t kPartitionTriangles = 65536;
+
+    static constexpr size_t kMaxRounds = 4;
+
+ private:
+
+    size_t target_triangles_;
+
+    float max_error_;
+
+    size_t partition_triangles_;
+
+ public:
+
+    // Collapses stop once the mesh reaches target_triangles or the cheapest collapse costs more than max_error.
+    QuadricDecimation(const size_t & target_triangles, const float & max_error, const size_t & partition_triangles);
+
+    QuadricDecimation(const size_t & target_triangles);
+
+    size_t target_triangles() const;
+
+    float max_error() const;
+
+    size_t partition_triangles() const;
+
+    // Vertices on partition borders stay locked within a round; borders shift between rounds.
+    TriangleMesh apply(const TriangleMesh & mesh, ThreadPool & pool) const;
+
+    TriangleMesh apply(const TriangleMesh & mesh) const;
+};
+
+#endif
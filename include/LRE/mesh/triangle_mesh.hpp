@@ -0,0 +1,61 @@
+#ifndef TRIANGLE_MESH_HPP
+#define TRIANGLE_MESH_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <LRE/linalg/vector4.hpp>
+
+class TriangleMesh
+{
+ private:
+
+    std::vector<float> x_;
+
+    std::vector<float> y_;
+
+    std::vector<float> z_;
+
+    std::vector<uint32_t> indices_;
+
+ public:
+
+    TriangleMesh(const std::vector<Vector4> & vertices, const std::vector<uint32_t> & indices);
+
+    TriangleMesh();
+
+    size_t vertex_count() const;
+
+    size_t triangle_count() const;
+
+    bool empty() const;
+
+    void clear();
+
+    void reserve(const size_t & vertices, const size_t & triangles);
+
+    uint32_t add_vertex(const Vector4 & vertex);
+
+    void add_triangle(const uint32_t & a, const uint32_t & b, const uint32_t & c);
+
+    Vector4 vertex(const size_t & index) const;
+
+    void set_vertex(const size_t & index, const Vector4 & vertex);
+
+    Vector4 normal(const size_t & triangle) const;
+
+    float area(const size_t & triangle) const;
+
+    const uint32_t * triangle(const size_t & index) const;
+
+    const float * x() const;
+
+    const float * y() const;
+
+    const float * z() const;
+
+    const std::vector<uint32_t> & indices() const;
+};
+
+#endif
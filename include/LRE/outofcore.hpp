@@ -0,0 +1,7 @@
+#pragma once
+
+#include <LRE/outofcore/mapped_file.hpp>
+#include <LRE/outofcore/tile_store.hpp>
+#include <LRE/outofcore/tile_cache.hpp>
+#include <LRE/outofcore/tile_processor.hpp>
+#include <LRE/outofcore/index_cache.hpp>
\ No newline at end of file
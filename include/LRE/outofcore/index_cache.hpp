@@ -0,0 +1,57 @@
+#ifndef INDEX_CACHE_HPP
+#define INDEX_CACHE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/spatial/kd_tree.hpp>
+#include <LRE/spatial/octree.hpp>
+
+enum class CacheVerification
+{
+    // Header checksum, section bounds and one structural pass over the node and index arrays; only the coordinate
+    // pages are left for queries to fault in, so a load still reads O(nodes + points) bytes.
+    Header,
+    // Also hashes every section, which reads the whole file once.
+    Full
+};
+
+// Built spatial indices stored as flat, pointer-free arrays that are mapped and queried in place.
+class IndexCache
+{
+ public:
+
+    static constexpr uint32_t kFormatVersion = 1;
+
+    static constexpr size_t kSectionAlignment = 64;
+
+    // Identifies the source cloud so a cache is never reused for different points.
+    static uint64_t fingerprint(const PointCloud & cloud);
+
+    // Writes to a temporary file first and renames it, so readers never observe a partial cache.
+    static void write(const std::string & path, const KdTree & tree, const uint64_t & fingerprint);
+
+    static void write(const std::string & path, const Octree & tree, const uint64_t & fingerprint);
+
+    // Throws std::runtime_error when the file is missing, corrupt, of another version or built from another cloud.
+    static KdTree load_kd_tree(const std::string & path, const uint64_t & fingerprint, const CacheVerification & verification);
+
+    static Octree load_octree(const std::string & path, const uint64_t & fingerprint, const CacheVerification & verification);
+
+    // Maps a matching cache, otherwise rebuilds the index from the cloud and rewrites the cache. The fingerprint hashes
+    // every coordinate of the cloud first, so even a hit costs a full pass; keep the key and call load_* to skip it.
+    static KdTree kd_tree(const std::string & path, const PointCloud & cloud, const size_t & leaf_size,
+                          const CacheVerification & verification);
+
+    static KdTree kd_tree(const std::string & path, const PointCloud & cloud, const size_t & leaf_size);
+
+    static Octree octree(const std::string & path, const PointCloud & cloud, const float & resolution,
+                         const CacheVerification & verification);
+
+    static Octree octree(const std::string & path, const PointCloud & cloud, const float & resolution);
+};
+
+#endif
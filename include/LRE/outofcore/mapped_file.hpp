@@ -0,0 +1,42 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+
+class MappedFile
+{
+ private:
+
+    void * data_;
+
+    size_t size_;
+
+#ifdef _WIN32
+    void * file_handle_;
+
+    void * mapping_handle_;
+#else
+    int descriptor_;
+#endif
+
+ public:
+
+    MappedFile(const std::string & path);
+
+    MappedFile(const MappedFile & other) = delete;
+
+    MappedFile& operator=(const MappedFile & other) = delete;
+
+    ~MappedFile();
+
+    const uint8_t * data() const;
+
+    size_t size() const;
+
+    void touch() const;
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef TILE_CACHE_HPP
+#define TILE_CACHE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <LRE/outofcore/tile_store.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+
+class TileCache
+{
+ private:
+
+    struct Entry
+    {
+        std::shared_future<std::shared_ptr<const TileView>> view;
+        std::list<size_t>::iterator position;
+    };
+
+    const TileStore & store_;
+
+    size_t memory_budget_;
+
+    // Bytes of every loaded view still alive, including evicted views callers hold; shared with the view deleters.
+    std::shared_ptr<std::atomic<size_t>> resident_bytes_;
+
+    size_t hits_;
+
+    size_t misses_;
+
+    std::list<size_t> recency_;
+
+    std::unordered_map<size_t, Entry> entries_;
+
+    std::mutex mutex_;
+
+    ThreadPool io_;
+
+    Entry & load(const size_t & tile, const bool & requested);
+
+    void evict();
+
+ public:
+
+    TileCache(const TileStore & store, const size_t & memory_budget);
+
+    std::shared_ptr<const TileView> acquire(const size_t & tile);
+
+    // Prefetched tiles enter at the least recent end and are skipped when they do not fit the budget.
+    void prefetch(const size_t & tile);
+
+    size_t memory_budget() const;
+
+    size_t resident_bytes();
+
+    size_t hits();
+
+    size_t misses();
+};
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef TILE_PROCESSOR_HPP
+#define TILE_PROCESSOR_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/outofcore/tile_store.hpp>
+#include <LRE/outofcore/tile_cache.hpp>
+#include <LRE/preprocess/voxel_downsample.hpp>
+#include <LRE/preprocess/normal_estimation.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+
+class TileProcessor
+{
+ private:
+
+    const TileStore & store_;
+
+    TileCache & cache_;
+
+    float halo_;
+
+    void prefetch_neighbourhood(const size_t & tile, const float & halo);
+
+ public:
+
+    TileProcessor(const TileStore & store, TileCache & cache, const float & halo);
+
+    const TileStore & store() const;
+
+    float halo() const;
+
+    PointCloud gather(const size_t & tile, const float & halo, size_t & core_count);
+
+    template <typename Function>
+    void for_each_tile(Function && function);
+
+    void downsample(const VoxelDownsample & filter, TileStoreWriter & output, ThreadPool & pool);
+
+    void estimate_normals(const NormalEstimation & estimator, TileStoreWriter & output, ThreadPool & pool);
+};
+
+template <typename Function>
+void TileProcessor::for_each_tile(Function &&function)
+{
+    for (size_t tile = 0; tile < store_.tile_count(); tile++)
+    {
+        if (tile + 1 < store_.tile_count())
+        {
+            prefetch_neighbourhood(tile + 1, halo_);
+        }
+
+        size_t core_count = 0;
+        PointCloud local = gather(tile, halo_, core_count);
+
+        function(store_.tile(tile), local, static_cast<const size_t &>(core_count));
+    }
+}
+
+#endif
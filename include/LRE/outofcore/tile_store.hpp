@@ -0,0 +1,173 @@
+#ifndef TILE_STORE_HPP
+#define TILE_STORE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+#include <memory>
+
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/outofcore/mapped_file.hpp>
+
+struct TileInfo
+{
+    int32_t x;
+    int32_t y;
+    uint64_t count;
+    float minimum[3];
+    float maximum[3];
+};
+
+class TileStoreWriter
+{
+ public:
+
+    static constexpr size_t kDefaultStagingBudget = size_t(64) << 20;
+
+ private:
+
+    struct PendingTile
+    {
+        TileInfo info;
+        std::vector<float> staged;
+    };
+
+    std::string directory_;
+
+    float tile_size_;
+
+    // Fixed by the first batch; later batches are rebased onto it.
+    Vector4d origin_;
+
+    size_t staging_budget_;
+
+    size_t staged_bytes_;
+
+    uint64_t skipped_points_;
+
+    bool has_normals_;
+
+    bool schema_fixed_;
+
+    bool finalized_;
+
+    std::unordered_map<uint64_t, PendingTile> tiles_;
+
+    void flush(PendingTile & tile);
+
+    void spill();
+
+ public:
+
+    // Points staged across all tiles stay within staging_budget bytes; the largest tiles spill to disk first.
+    TileStoreWriter(const std::string & directory, const float & tile_size, const size_t & staging_budget);
+
+    TileStoreWriter(const std::string & directory, const float & tile_size);
+
+    TileStoreWriter(const TileStoreWriter & other) = delete;
+
+    TileStoreWriter& operator=(const TileStoreWriter & other) = delete;
+
+    ~TileStoreWriter();
+
+    // Points with a non-finite coordinate or outside the int32 tile grid are skipped and counted.
+    void append(const PointCloud & cloud);
+
+    size_t staged_bytes() const;
+
+    uint64_t skipped_points() const;
+
+    const Vector4d & origin() const;
+
+    void finalize();
+};
+
+class TileView
+{
+ private:
+
+    MappedFile file_;
+
+    uint64_t count_;
+
+    bool has_normals_;
+
+    const float * channel(const int32_t & index) const;
+
+ public:
+
+    TileView(const std::string & path);
+
+    size_t size() const;
+
+    bool has_normals() const;
+
+    size_t memory_usage() const;
+
+    void touch() const;
+
+    const float * x() const;
+
+    const float * y() const;
+
+    const float * z() const;
+
+    const float * normal_x() const;
+
+    const float * normal_y() const;
+
+    const float * normal_z() const;
+};
+
+class TileStore
+{
+ private:
+
+    std::string directory_;
+
+    float tile_size_;
+
+    Vector4d origin_;
+
+    bool has_normals_;
+
+    std::vector<TileInfo> tiles_;
+
+    std::unordered_map<uint64_t, size_t> lookup_;
+
+ public:
+
+    TileStore(const std::string & directory);
+
+    const std::string & directory() const;
+
+    float tile_size() const;
+
+    // Tile coordinates and point offsets are relative to this origin.
+    const Vector4d & origin() const;
+
+    bool has_normals() const;
+
+    size_t tile_count() const;
+
+    uint64_t point_count() const;
+
+    const TileInfo & tile(const size_t & index) const;
+
+    int64_t find(const int32_t & x, const int32_t & y) const;
+
+    std::string tile_path(const size_t & index) const;
+
+    size_t tile_bytes(const size_t & index) const;
+
+    std::vector<size_t> neighbours(const size_t & index, const float & halo) const;
+
+    static uint64_t tile_key(const int32_t & x, const int32_t & y);
+
+    static std::string tile_filename(const int32_t & x, const int32_t & y);
+};
+
+#endif
@@ -0,0 +1,4 @@
+#pragma once
+
+#include <LRE/parallel/thread_pool.hpp>
+#include <LRE/parallel/primitives.hpp>
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef PRIMITIVES_HPP
+#define PRIMITIVES_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <stdexcept>
+
+#include <LRE/parallel/thread_pool.hpp>
+
+// Data-parallel building blocks shared by ordering, grouping and compaction passes.
+class ParallelPrimitives
+{
+ public:
+
+    static constexpr size_t kRadixBits = 8;
+
+    static constexpr size_t kMinBlock = 16384;
+
+    // Stable LSD radix sort; values are permuted alongside their keys. Passes whose digit is shared by every key are skipped.
+    // Sorting and compaction use 32-bit offsets and throw std::length_error above 2^32 - 1 entries.
+    static void radix_sort(std::vector<uint32_t> & keys, std::vector<uint32_t> & values, ThreadPool & pool);
+
+    static void radix_sort(std::vector<uint32_t> & keys, std::vector<uint32_t> & values);
+
+    static void radix_sort(std::vector<uint64_t> & keys, std::vector<uint32_t> & values, ThreadPool & pool);
+
+    static void radix_sort(std::vector<uint64_t> & keys, std::vector<uint32_t> & values);
+
+    static void radix_sort(std::vector<uint64_t> & keys, ThreadPool & pool);
+
+    static void radix_sort(std::vector<uint64_t> & keys);
+
+    // Replaces every value with the sum of the values before it and returns the total, modulo 2^32.
+    static uint32_t exclusive_scan(std::vector<uint32_t> & values, ThreadPool & pool);
+
+    static uint32_t exclusive_scan(std::vector<uint32_t> & values);
+
+    // Indices of the non-zero flags, in increasing order.
+    static std::vector<uint32_t> compact(const std::vector<uint8_t> & flags, ThreadPool & pool);
+
+    static std::vector<uint32_t> compact(const std::vector<uint8_t> & flags);
+
+    // Throws std::out_of_range when a bin is not below bin_count.
+    static std::vector<uint32_t> histogram(const std::vector<uint32_t> & bins, const size_t & bin_count, ThreadPool & pool);
+
+    static std::vector<uint32_t> histogram(const std::vector<uint32_t> & bins, const size_t & bin_count);
+};
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+ private:
+
+    std::vector<std::thread> workers_;
+
+    std::deque<std::function<void()>> tasks_;
+
+    std::mutex mutex_;
+
+    std::condition_variable condition_;
+
+    bool stopping_;
+
+    void worker_loop();
+
+ public:
+
+    ThreadPool(const size_t & thread_count);
+
+    ThreadPool();
+
+    ThreadPool(const ThreadPool & other) = delete;
+
+    ThreadPool& operator=(const ThreadPool & other) = delete;
+
+    ~ThreadPool();
+
+    size_t size() const;
+
+    void submit(std::function<void()> task);
+
+    template <typename Function>
+    void parallel_for(const size_t & begin, const size_t & end, const size_t & grain, Function && function);
+
+    static ThreadPool & shared();
+};
+
+template <typename Function>
+void ThreadPool::parallel_for(const size_t &begin, const size_t &end, const size_t &grain, Function &&function)
+{
+    if (end <= begin)
+    {
+        return;
+    }
+
+    const size_t chunk_size = std::max<size_t>(1, grain);
+    const size_t chunk_count = (end - begin + chunk_size - 1) / chunk_size;
+
+    if (chunk_count == 1 || workers_.empty())
+    {
+        function(begin, end);
+        return;
+    }
+
+    struct State
+    {
+        std::atomic<size_t> next_chunk{0};
+        std::atomic<size_t> finished_chunks{0};
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+    };
+
+    std::shared_ptr<State> state = std::make_shared<State>();
+
+    // Chunks are claimed dynamically; the caller participates so nested calls cannot starve.
+    auto run_chunks = [state, chunk_count, chunk_size, begin, end, &function]()
+    {
+        size_t chunk;
+
+        while ((chunk = state->next_chunk.fetch_add(1)) < chunk_count)
+        {
+            const size_t chunk_begin = begin + chunk * chunk_size;
+            const size_t chunk_end = std::min(end, chunk_begin + chunk_size);
+
+            try
+            {
+                function(chunk_begin, chunk_end);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->error)
+                {
+                    state->error = std::current_exception();
+                }
+            }
+
+            if (state->finished_chunks.fetch_add(1) + 1 == chunk_count)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->done.notify_all();
+            }
+        }
+    };
+
+    const size_t helper_count = std::min(workers_.size(), chunk_count - 1);
+
+    for (size_t i = 0; i < helper_count; i++)
+    {
+        submit(run_chunks);
+    }
+
+    run_chunks();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state, chunk_count]() { return state->finished_chunks.load() == chunk_count; });
+
+    if (state->error)
+    {
+        std::rethrow_exception(state->error);
+    }
+}
+
+#endif
@@ -0,0 +1,4 @@
+#pragma once
+
+#include <LRE/pipeline/spsc_ring.hpp>
+#include <LRE/pipeline/pipeline.hpp>
@@ -0,0 +1,132 @@
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/pipeline/spsc_ring.hpp>
+
+enum class OverloadPolicy
+{
+    Block,
+    Drop,
+    Coalesce
+};
+
+struct PointBatch
+{
+    PointCloud cloud;
+    uint64_t sequence;
+    size_t merged;
+    std::chrono::steady_clock::time_point created;
+};
+
+struct StageStatistics
+{
+    uint64_t processed;
+    uint64_t rejected;
+    uint64_t dropped;
+    uint64_t coalesced;
+    double mean_latency_us;
+    double max_latency_us;
+    // Time since the batch was pushed when this stage finished it, queueing in every ring included.
+    double mean_age_us;
+    double max_age_us;
+};
+
+class Pipeline
+{
+ private:
+
+    struct Stage
+    {
+        std::string name;
+        std::function<bool(PointBatch &)> function;
+        OverloadPolicy policy;
+        std::thread thread;
+        std::atomic<bool> finished{false};
+        std::atomic<uint64_t> processed{0};
+        std::atomic<uint64_t> rejected{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> coalesced{0};
+        std::atomic<uint64_t> total_latency_ns{0};
+        std::atomic<uint64_t> max_latency_ns{0};
+        std::atomic<uint64_t> total_age_ns{0};
+        std::atomic<uint64_t> max_age_ns{0};
+        // Bumped by every event that may unblock the stage; it parks on the condition until it changes.
+        std::atomic<uint64_t> wakeups{0};
+        std::atomic<bool> parked{false};
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    size_t ring_capacity_;
+
+    size_t batch_capacity_;
+
+    std::vector<std::unique_ptr<Stage>> stages_;
+
+    std::vector<std::unique_ptr<SpscRing<PointBatch>>> rings_;
+
+    std::atomic<bool> running_;
+
+    std::atomic<bool> closed_;
+
+    std::atomic<bool> aborting_;
+
+    std::atomic<uint64_t> next_sequence_;
+
+    std::atomic<uint64_t> rejected_inputs_;
+
+    void run_stage(const size_t & index);
+
+    bool upstream_finished(const size_t & index) const;
+
+    void wake(const size_t & index);
+
+    void park(Stage & stage, const uint64_t & observed);
+
+ public:
+
+    Pipeline(const size_t & ring_capacity, const size_t & batch_capacity);
+
+    Pipeline(const Pipeline & other) = delete;
+
+    Pipeline& operator=(const Pipeline & other) = delete;
+
+    ~Pipeline();
+
+    void add_stage(const std::string & name, std::function<bool(PointBatch &)> function, const OverloadPolicy & policy);
+
+    void start();
+
+    void close();
+
+    bool finished() const;
+
+    void stop();
+
+    bool push(PointCloud & points);
+
+    bool pop(PointBatch & batch);
+
+    size_t stage_count() const;
+
+    const std::string & stage_name(const size_t & index) const;
+
+    StageStatistics statistics(const size_t & index) const;
+
+    uint64_t rejected_inputs() const;
+};
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <vector>
+
+template <typename T>
+class SpscRing
+{
+ private:
+
+    std::vector<T> slots_;
+
+    size_t mask_;
+
+    alignas(64) std::atomic<size_t> head_;
+
+    alignas(64) std::atomic<size_t> tail_;
+
+ public:
+
+    SpscRing(const size_t & capacity);
+
+    SpscRing(const SpscRing & other) = delete;
+
+    SpscRing& operator=(const SpscRing & other) = delete;
+
+    size_t capacity() const;
+
+    size_t size() const;
+
+    bool empty() const;
+
+    bool full() const;
+
+    T * begin_push();
+
+    void commit_push();
+
+    T * front();
+
+    void pop();
+
+    T & slot(const size_t & index);
+};
+
+template <typename T>
+SpscRing<T>::SpscRing(const size_t &capacity) : head_(0), tail_(0)
+{
+    size_t rounded = 2;
+
+    while (rounded < capacity)
+    {
+        rounded <<= 1;
+    }
+
+    slots_.resize(rounded);
+    mask_ = rounded - 1;
+}
+
+template <typename T>
+size_t SpscRing<T>::capacity() const
+{
+    return slots_.size();
+}
+
+template <typename T>
+size_t SpscRing<T>::size() const
+{
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+}
+
+template <typename T>
+bool SpscRing<T>::empty() const
+{
+    return size() == 0;
+}
+
+template <typename T>
+bool SpscRing<T>::full() const
+{
+    return size() >= slots_.size();
+}
+
+template <typename T>
+T *SpscRing<T>::begin_push()
+{
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+
+    if (tail - head_.load(std::memory_order_acquire) >= slots_.size())
+    {
+        return nullptr;
+    }
+
+    return &slots_[tail & mask_];
+}
+
+template <typename T>
+void SpscRing<T>::commit_push()
+{
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template <typename T>
+T *SpscRing<T>::front()
+{
+    const size_t head = head_.load(std::memory_order_relaxed);
+
+    if (head == tail_.load(std::memory_order_acquire))
+    {
+        return nullptr;
+    }
+
+    return &slots_[head & mask_];
+}
+
+template <typename T>
+void SpscRing<T>::pop()
+{
+    head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template <typename T>
+T &SpscRing<T>::slot(const size_t &index)
+{
+    return slots_[index & mask_];
+}
+
+#endif
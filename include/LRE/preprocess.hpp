@@ -0,0 +1,5 @@
+#pragma once
+
+#include <LRE/preprocess/deskew.hpp>
+#include <LRE/preprocess/voxel_downsample.hpp>
+#include <LRE/preprocess/normal_estimation.hpp>
@@ -0,0 +1,62 @@
+#ifndef DESKEW_HPP
+#define DESKEW_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/linalg/matrix4.hpp>
+#include <LRE/linalg/quaternion.hpp>
+#include <LRE/linalg/rigid_transform.hpp>
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+
+class Deskew
+{
+ private:
+
+    std::vector<float> times_;
+
+    std::vector<RigidTransform> keyframes_;
+
+    std::vector<float> keyframe_rotations_[4];
+
+    std::vector<float> keyframe_translations_[3];
+
+    std::vector<float> segment_angles_;
+
+    std::vector<float> segment_inverse_sines_;
+
+    std::vector<float> segment_inverse_durations_;
+
+    void build(const std::vector<Matrix4> & poses);
+
+    size_t segment(const float & time) const;
+
+    float segment_ratio(const size_t & segment, const float & time) const;
+
+    void correct_range(PointCloud & cloud, const size_t & begin, const size_t & end) const;
+
+ public:
+
+    Deskew(const Matrix4 & start_pose, const Matrix4 & end_pose, const float & start_time, const float & end_time);
+
+    Deskew(const std::vector<Matrix4> & poses, const std::vector<float> & times);
+
+    RigidTransform transform_at(const float & time) const;
+
+    Matrix4 pose_at(const float & time) const;
+
+    void apply(PointCloud & cloud) const;
+
+    void apply(PointCloud & cloud, ThreadPool & pool) const;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef NORMAL_ESTIMATION_HPP
+#define NORMAL_ESTIMATION_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/spatial/kd_tree.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+
+class NormalEstimation
+{
+ private:
+
+    size_t neighbours_;
+
+    Vector4 viewpoint_;
+
+ public:
+
+    NormalEstimation(const size_t & neighbours, const Vector4 & viewpoint);
+
+    NormalEstimation(const size_t & neighbours);
+
+    void apply(PointCloud & cloud, const KdTree & tree, const size_t & count, ThreadPool & pool) const;
+
+    void apply(PointCloud & cloud, ThreadPool & pool) const;
+
+    void apply(PointCloud & cloud) const;
+
+    static Vector4 smallest_eigenvector(const float covariance[6]);
+};
+
+#endif
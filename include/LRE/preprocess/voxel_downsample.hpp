@@ -0,0 +1,36 @@
+#ifndef VOXEL_DOWNSAMPLE_HPP
+#define VOXEL_DOWNSAMPLE_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+
+class VoxelDownsample
+{
+ private:
+
+    float voxel_size_;
+
+ public:
+
+    VoxelDownsample(const float & voxel_size);
+
+    float voxel_size() const;
+
+    // Integer voxel coordinates, saturated to +-2^62 so out-of-range and non-finite inputs stay defined.
+    std::array<int64_t, 3> voxel_index(const float & x, const float & y, const float & z) const;
+
+    PointCloud apply(const PointCloud & cloud, ThreadPool & pool) const;
+
+    PointCloud apply(const PointCloud & cloud) const;
+};
+
+#endif
@@ -0,0 +1,3 @@
+#pragma once
+
+#include <LRE/profiling/profiler.hpp>
\ No newline at end of file
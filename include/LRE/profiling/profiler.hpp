@@ -0,0 +1,138 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+enum class Counter : uint32_t
+{
+    PointsProcessed,
+    QueriesIssued,
+    Allocations,
+    Count
+};
+
+// Collects scoped timings and counters into lock-free per-thread buffers.
+class Profiler
+{
+ public:
+
+    static constexpr size_t kRingCapacity = 8192;
+
+    static constexpr size_t kMaxScopes = 256;
+
+    static constexpr size_t kCounterCount = static_cast<size_t>(Counter::Count);
+
+    // Times are nanoseconds since the profiler was created.
+    struct Event
+    {
+        const char *name;
+        uint64_t begin;
+        uint64_t duration;
+        uint32_t thread;
+    };
+
+    struct ScopeStatistics
+    {
+        const char *name;
+        uint64_t calls;
+        uint64_t total;
+        uint64_t maximum;
+    };
+
+ private:
+
+    struct ThreadState;
+
+    struct ThreadOwner;
+
+    std::vector<std::shared_ptr<ThreadState>> threads_;
+
+    // States of exited threads, handed to the next thread that records anything.
+    std::vector<ThreadState *> free_;
+
+    uint64_t retired_counters_[kCounterCount];
+
+    std::vector<ScopeStatistics> retired_scopes_;
+
+    mutable std::mutex mutex_;
+
+    uint64_t epoch_;
+
+    ThreadState & local();
+
+    void retire(ThreadState & state);
+
+    Profiler();
+
+ public:
+
+    Profiler(const Profiler & other) = delete;
+
+    Profiler& operator=(const Profiler & other) = delete;
+
+    static Profiler & instance();
+
+    static const char *counter_name(const Counter & counter);
+
+    uint64_t now() const;
+
+    // Names must outlive the profiler; string literals are expected.
+    void record(const char * name, const uint64_t & begin, const uint64_t & end);
+
+    void add(const Counter & counter, const uint64_t & value);
+
+    uint64_t counter(const Counter & counter) const;
+
+    // Number of per-thread states; exited threads return theirs for reuse.
+    size_t thread_count() const;
+
+    // Returns the events still held in the per-thread rings, oldest first per thread.
+    void events(std::vector<Event> & events) const;
+
+    // Merges statistics of equally named scopes across threads, sorted by total time.
+    void statistics(std::vector<ScopeStatistics> & statistics) const;
+
+    void write_chrome_trace(std::ostream & stream) const;
+
+    void write_summary(std::ostream & stream) const;
+
+    // Must not run concurrently with instrumented code.
+    void reset();
+};
+
+class ScopedTimer
+{
+ private:
+
+    const char *name_;
+
+    uint64_t begin_;
+
+ public:
+
+    ScopedTimer(const char * name);
+
+    ScopedTimer(const ScopedTimer & other) = delete;
+
+    ScopedTimer& operator=(const ScopedTimer & other) = delete;
+
+    ~ScopedTimer();
+};
+
+#define LRE_PROFILE_CONCAT_INNER(a, b) a##b
+#define LRE_PROFILE_CONCAT(a, b) LRE_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef LRE_PROFILING
+#define LRE_PROFILE_SCOPE(name) ScopedTimer LRE_PROFILE_CONCAT(lre_scoped_timer_, __LINE__)(name)
+#define LRE_PROFILE_COUNT(counter, value) Profiler::instance().add(counter, static_cast<uint64_t>(value))
+#else
+#define LRE_PROFILE_SCOPE(name) ((void)0)
+#define LRE_PROFILE_COUNT(counter, value) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,4 @@
+#pragma once
+
+#include <LRE/raycast/bvh.hpp>
+#include <LRE/raycast/ray_caster.hpp>
\ No newline at end of file
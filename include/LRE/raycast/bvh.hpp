@@ -0,0 +1,67 @@
+#ifndef BVH_HPP
+#define BVH_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/mesh/triangle_mesh.hpp>
+
+class Bvh
+{
+ public:
+
+    struct Node
+    {
+        float minimum[3];
+        float maximum[3];
+        uint32_t first;
+        uint32_t count;
+    };
+
+ private:
+
+    std::vector<Node> nodes_;
+
+    std::vector<uint32_t> triangle_ids_;
+
+    std::vector<float> origins_[3];
+
+    std::vector<float> first_edges_[3];
+
+    std::vector<float> second_edges_[3];
+
+    size_t leaf_size_;
+
+    void build(const uint32_t & node, const uint32_t & begin, const uint32_t & end, const int32_t & depth,
+               const std::vector<float> & bounds, const std::vector<float> & centroids);
+
+ public:
+
+    Bvh(const TriangleMesh & mesh, const size_t & leaf_size);
+
+    Bvh(const TriangleMesh & mesh);
+
+    Bvh();
+
+    size_t size() const;
+
+    bool empty() const;
+
+    // distance holds the search limit on entry and the closest hit on return.
+    bool intersect(const Vector4 & origin, const Vector4 & direction, const float & minimum_distance,
+                   float & distance, uint32_t & triangle) const;
+
+    const std::vector<Node> & nodes() const;
+
+    const std::vector<uint32_t> & triangle_ids() const;
+
+    const float * origin(const int32_t & axis) const;
+
+    const float * first_edge(const int32_t & axis) const;
+
+    const float * second_edge(const int32_t & axis) const;
+};
+
+#endif
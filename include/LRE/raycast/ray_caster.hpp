@@ -0,0 +1,58 @@
+#ifndef RAY_CASTER_HPP
+#define RAY_CASTER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/linalg/matrix4.hpp>
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+#include <LRE/spatial/octree.hpp>
+#include <LRE/raycast/bvh.hpp>
+
+struct RayScan
+{
+    PointCloud points;
+
+    std::vector<float> ranges;
+
+    std::vector<int32_t> hits;
+};
+
+class RayCaster
+{
+ private:
+
+    const Octree * octree_;
+
+    const Bvh * bvh_;
+
+    float minimum_range_;
+
+    float maximum_range_;
+
+    void cast_range(const float origin[3], const float rotation[9], const PointCloud & directions,
+                    const size_t & begin, const size_t & end, RayScan & scan) const;
+
+ public:
+
+    RayCaster(const Octree & octree, const float & minimum_range, const float & maximum_range);
+
+    RayCaster(const Bvh & bvh, const float & minimum_range, const float & maximum_range);
+
+    float minimum_range() const;
+
+    float maximum_range() const;
+
+    // Beams are given as sensor-frame directions; hits are returned in the sensor frame, misses get range 0 and hit -1.
+    void cast(const Matrix4 & pose, const PointCloud & directions, RayScan & scan, ThreadPool & pool) const;
+
+    void cast(const Matrix4 & pose, const PointCloud & directions, RayScan & scan) const;
+
+    static PointCloud spinning_pattern(const size_t & rings, const size_t & columns,
+                                       const float & lower_elevation, const float & upper_elevation);
+};
+
+#endif
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <LRE/registration/block_cholesky.hpp>
+#include <LRE/registration/global_registration.hpp>
+#include <LRE/registration/pose_graph.hpp>
\ No newline at end of file
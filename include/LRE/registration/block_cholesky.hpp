@@ -0,0 +1,62 @@
+#ifndef BLOCK_CHOLESKY_HPP
+#define BLOCK_CHOLESKY_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Sparse Cholesky factorization of a symmetric positive definite matrix made of 6x6 blocks.
+class BlockCholesky
+{
+ public:
+
+    static constexpr size_t kBlock = 6;
+
+    static constexpr size_t kBlockSize = kBlock * kBlock;
+
+ private:
+
+    std::vector<uint32_t> order_;
+
+    std::vector<uint32_t> position_;
+
+    std::vector<uint32_t> column_start_;
+
+    std::vector<uint32_t> rows_;
+
+    std::vector<double> diagonal_;
+
+    std::vector<double> blocks_;
+
+    std::vector<double> factor_diagonal_;
+
+    std::vector<double> factor_blocks_;
+
+    double *find(std::vector<double> & blocks, const uint32_t & row, const uint32_t & column);
+
+ public:
+
+    BlockCholesky();
+
+    // Computes a minimum-degree elimination order and the fill pattern of the factor.
+    void analyze(const size_t & size, const std::vector<std::pair<uint32_t, uint32_t>> & couplings);
+
+    size_t size() const;
+
+    size_t block_count() const;
+
+    void clear();
+
+    void add_diagonal(const uint32_t & variable, const double * block);
+
+    // The block couples rows of variable a with columns of variable b.
+    void add(const uint32_t & a, const uint32_t & b, const double * block);
+
+    // Factors A + damping * diag(A); returns false if the matrix is not positive definite.
+    bool factorize(const double & damping);
+
+    void solve(const std::vector<double> & rhs, std::vector<double> & solution) const;
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef GLOBAL_REGISTRATION_HPP
+#define GLOBAL_REGISTRATION_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/linalg/matrix4.hpp>
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+#include <LRE/features/descriptor_set.hpp>
+#include <LRE/features/descriptor_tree.hpp>
+
+enum class RegistrationSolver
+{
+    Ransac,
+    MaxClique
+};
+
+struct Correspondence
+{
+    uint32_t source;
+    uint32_t target;
+    float distance;
+};
+
+struct RegistrationResult
+{
+    Matrix4 transform;
+
+    std::vector<uint32_t> inliers;
+
+    float fitness;
+
+    size_t iterations;
+};
+
+class GlobalRegistration
+{
+ private:
+
+    float inlier_threshold_;
+
+    size_t max_iterations_;
+
+    float edge_similarity_;
+
+    float confidence_;
+
+    RegistrationSolver solver_;
+
+    uint32_t seed_;
+
+    RegistrationResult align_ransac(const std::vector<Vector4> & source, const std::vector<Vector4> & target, ThreadPool & pool) const;
+
+    RegistrationResult align_max_clique(const std::vector<Vector4> & source, const std::vector<Vector4> & target, ThreadPool & pool) const;
+
+    void refine(const std::vector<Vector4> & source, const std::vector<Vector4> & target, RegistrationResult & result) const;
+
+ public:
+
+    GlobalRegistration(const float & inlier_threshold, const size_t & max_iterations, const float & edge_similarity,
+                       const RegistrationSolver & solver, const uint32_t & seed);
+
+    GlobalRegistration(const float & inlier_threshold, const RegistrationSolver & solver);
+
+    GlobalRegistration(const float & inlier_threshold);
+
+    float inlier_threshold() const;
+
+    RegistrationSolver solver() const;
+
+    // Inliers index into the correspondence list; the transform maps source points onto the target.
+    RegistrationResult align(const PointCloud & source, const PointCloud & target,
+                             const std::vector<Correspondence> & correspondences, ThreadPool & pool) const;
+
+    RegistrationResult align(const PointCloud & source, const PointCloud & target,
+                             const DescriptorSet & source_descriptors, const DescriptorSet & target_descriptors, ThreadPool & pool) const;
+
+    RegistrationResult align(const PointCloud & source, const PointCloud & target,
+                             const DescriptorSet & source_descriptors, const DescriptorSet & target_descriptors) const;
+
+    static void match(const DescriptorSet & source, const DescriptorSet & target, const bool & mutual,
+                      std::vector<Correspondence> & correspondences, ThreadPool & pool);
+
+    static Matrix4 estimate_rigid(const std::vector<Vector4> & source, const std::vector<Vector4> & target);
+
+    static Matrix4 estimate_rigid(const std::vector<Vector4> & source, const std::vector<Vector4> & target,
+                                  const uint32_t * indices, const size_t & count, const float * weights);
+};
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef POSE_GRAPH_HPP
+#define POSE_GRAPH_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <LRE/linalg/matrix4.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+#include <LRE/registration/block_cholesky.hpp>
+
+enum class RobustKernel
+{
+    None,
+    Huber,
+    Cauchy
+};
+
+enum class PoseGraphMethod
+{
+    GaussNewton,
+    LevenbergMarquardt
+};
+
+class PoseGraph
+{
+ public:
+
+    // Information is a row-major 6x6 matrix over the (translation, rotation) tangent space.
+    struct Edge
+    {
+        uint32_t from;
+        uint32_t to;
+        Matrix4 measurement;
+        double information[36];
+    };
+
+ private:
+
+    std::vector<Matrix4> poses_;
+
+    std::vector<uint8_t> fixed_;
+
+    std::vector<Edge> edges_;
+
+    RobustKernel kernel_;
+
+    double kernel_width_;
+
+    PoseGraphMethod method_;
+
+ public:
+
+    PoseGraph(const RobustKernel & kernel, const double & kernel_width, const PoseGraphMethod & method);
+
+    PoseGraph(const RobustKernel & kernel, const double & kernel_width);
+
+    PoseGraph();
+
+    size_t add_node(const Matrix4 & pose);
+
+    void set_fixed(const size_t & node, const bool & fixed);
+
+    // The measurement is the pose of node `to` expressed in the frame of node `from`.
+    size_t add_edge(const size_t & from, const size_t & to, const Matrix4 & measurement, const double * information);
+
+    size_t add_edge(const size_t & from, const size_t & to, const Matrix4 & measurement);
+
+    size_t node_count() const;
+
+    size_t edge_count() const;
+
+    const Matrix4 & pose(const size_t & node) const;
+
+    const std::vector<Matrix4> & poses() const;
+
+    const std::vector<Edge> & edges() const;
+
+    double error(ThreadPool & pool) const;
+
+    double error() const;
+
+    // Returns the number of accepted iterations; the first node is held fixed when none are.
+    size_t optimize(const size_t & max_iterations, ThreadPool & pool);
+
+    size_t optimize(const size_t & max_iterations);
+};
+
+#endif
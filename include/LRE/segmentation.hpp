@@ -0,0 +1,4 @@
+#pragma once
+
+#include <LRE/segmentation/polar_grid_ground.hpp>
+#include <LRE/segmentation/scan_line_ground.hpp>
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef POLAR_GRID_GROUND_HPP
+#define POLAR_GRID_GROUND_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+
+class PolarGridGround
+{
+ private:
+
+    size_t rings_;
+
+    size_t sectors_;
+
+    float minimum_range_;
+
+    float maximum_range_;
+
+    float sensor_height_;
+
+    float distance_threshold_;
+
+    float maximum_slope_;
+
+    int32_t bin_of(const float & x, const float & y) const;
+
+    void fit_bin(const PointCloud & cloud, const uint32_t * members, const size_t & count, const float & radius,
+                 std::vector<float> & heights, std::vector<uint32_t> & inliers, uint8_t * ground) const;
+
+ public:
+
+    PolarGridGround(const size_t & rings, const size_t & sectors, const float & minimum_range, const float & maximum_range,
+                    const float & sensor_height, const float & distance_threshold, const float & maximum_slope);
+
+    PolarGridGround(const float & sensor_height);
+
+    size_t bin_count() const;
+
+    // Expects a sensor-frame cloud with z up; ground[i] is set to 1 for ground points and 0 otherwise.
+    void segment(const PointCloud & cloud, std::vector<uint8_t> & ground, ThreadPool & pool) const;
+
+    void segment(const PointCloud & cloud, std::vector<uint8_t> & ground) const;
+
+    static bool fit_plane(const PointCloud & cloud, const uint32_t * indices, const size_t & count, Vector4 & normal, float & offset);
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef SCAN_LINE_GROUND_HPP
+#define SCAN_LINE_GROUND_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+
+class ScanLineGround
+{
+ private:
+
+    size_t columns_;
+
+    float sensor_height_;
+
+    float local_slope_;
+
+    float global_slope_;
+
+    float height_threshold_;
+
+ public:
+
+    ScanLineGround(const size_t & columns, const float & sensor_height, const float & local_slope,
+                   const float & global_slope, const float & height_threshold);
+
+    ScanLineGround(const float & sensor_height);
+
+    // Walks each azimuth column outward across the rings; ground[i] is set to 1 for ground points and 0 otherwise.
+    void segment(const PointCloud & cloud, std::vector<uint8_t> & ground, ThreadPool & pool) const;
+
+    void segment(const PointCloud & cloud, std::vector<uint8_t> & ground) const;
+};
+
+#endif
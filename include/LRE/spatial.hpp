@@ -0,0 +1,6 @@
+#pragma once
+
+#include <LRE/spatial/kd_tree.hpp>
+#include <LRE/spatial/incremental_kd_tree.hpp>
+#include <LRE/spatial/octree.hpp>
+#include <LRE/spatial/culling_volume.hpp>
\ No newline at end of file
@@ -0,0 +1,81 @@
+#ifndef ARRAY_VIEW_HPP
+#define ARRAY_VIEW_HPP
+
+#include <cstddef>
+
+// Read-only window over contiguous elements owned elsewhere, such as a vector or a mapped file.
+template <typename Value>
+class ArrayView
+{
+ private:
+
+    const Value *data_;
+
+    size_t size_;
+
+ public:
+
+    ArrayView(const Value * data, const size_t & size);
+
+    ArrayView();
+
+    const Value * data() const;
+
+    size_t size() const;
+
+    bool empty() const;
+
+    const Value& operator[](const size_t & index) const;
+
+    const Value * begin() const;
+
+    const Value * end() const;
+};
+
+template <typename Value>
+ArrayView<Value>::ArrayView(const Value *data, const size_t &size) : data_(data), size_(size)
+{
+}
+
+template <typename Value>
+ArrayView<Value>::ArrayView() : data_(nullptr), size_(0)
+{
+}
+
+template <typename Value>
+const Value *ArrayView<Value>::data() const
+{
+    return data_;
+}
+
+template <typename Value>
+size_t ArrayView<Value>::size() const
+{
+    return size_;
+}
+
+template <typename Value>
+bool ArrayView<Value>::empty() const
+{
+    return size_ == 0;
+}
+
+template <typename Value>
+const Value &ArrayView<Value>::operator[](const size_t &index) const
+{
+    return data_[index];
+}
+
+template <typename Value>
+const Value *ArrayView<Value>::begin() const
+{
+    return data_;
+}
+
+template <typename Value>
+const Value *ArrayView<Value>::end() const
+{
+    return data_ + size_;
+}
+
+#endif
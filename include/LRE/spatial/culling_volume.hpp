@@ -0,0 +1,96 @@
+#ifndef CULLING_VOLUME_HPP
+#define CULLING_VOLUME_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/linalg/matrix4.hpp>
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+#include <LRE/spatial/octree.hpp>
+
+enum class CullResult : uint8_t
+{
+    Outside,
+    Intersecting,
+    Inside
+};
+
+class CullingVolume
+{
+ public:
+
+    static constexpr size_t kMaxPlanes = 6;
+
+ private:
+
+    enum class Shape
+    {
+        Box,
+        OrientedBox,
+        Planes
+    };
+
+    Shape shape_;
+
+    float minimum_[3];
+
+    float maximum_[3];
+
+    Matrix4 world_to_box_;
+
+    // Each plane is (nx, ny, nz, d) with the inside where n.p + d >= 0.
+    float planes_[kMaxPlanes][4];
+
+    size_t plane_count_;
+
+    bool test(const float & x, const float & y, const float & z) const;
+
+    // Bit k is set when point k of the eight starting at the pointers lies inside.
+    int32_t test8(const float * x, const float * y, const float * z) const;
+
+    // Tests positions [first, first + count) and writes their absolute positions.
+    size_t select_range(const float * x, const float * y, const float * z, const size_t & first, const size_t & count, uint32_t * indices) const;
+
+ public:
+
+    CullingVolume();
+
+    static CullingVolume box(const Vector4 & minimum, const Vector4 & maximum);
+
+    // The pose maps box coordinates to world coordinates; the box spans [-half_extents, half_extents].
+    static CullingVolume oriented_box(const Matrix4 & pose, const Vector4 & half_extents);
+
+    // Extracts the six clip planes of a row-major view-projection matrix with clip coordinates in [-w, w].
+    static CullingVolume frustum(const Matrix4 & view_projection);
+
+    static CullingVolume convex(const Vector4 * planes, const size_t & count);
+
+    size_t plane_count() const;
+
+    bool contains(const Vector4 & point) const;
+
+    // Conservative: boxes near plane corners may be reported as intersecting.
+    CullResult classify(const float minimum[3], const float maximum[3]) const;
+
+    // Writes the positions of inside points in ascending order; indices must hold count entries.
+    size_t select(const float * x, const float * y, const float * z, const size_t & count, uint32_t * indices) const;
+
+    void select(const PointCloud & cloud, std::vector<uint32_t> & indices, ThreadPool & pool) const;
+
+    void select(const PointCloud & cloud, std::vector<uint32_t> & indices) const;
+
+    // One bit per point, least significant bit first within each word.
+    void mask(const PointCloud & cloud, std::vector<uint64_t> & bits, ThreadPool & pool) const;
+
+    void mask(const PointCloud & cloud, std::vector<uint64_t> & bits) const;
+
+    void classify(const Octree & octree, std::vector<CullResult> & results) const;
+
+    // Returns original cloud indices in octree traversal order.
+    void select(const Octree & octree, std::vector<uint32_t> & indices) const;
+};
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef INCREMENTAL_KD_TREE_HPP
+#define INCREMENTAL_KD_TREE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/cloud/point_cloud.hpp>
+
+class IncrementalKdTree
+{
+ public:
+
+    struct Node
+    {
+        float point[3];
+        float minimum[3];
+        float maximum[3];
+        int32_t left;
+        int32_t right;
+        int32_t parent;
+        uint32_t size;
+        uint32_t invalid;
+        int32_t axis;
+        bool deleted;
+        bool tree_deleted;
+    };
+
+ private:
+
+    struct Operation
+    {
+        bool insert;
+        float values[6];
+    };
+
+    std::vector<Node> nodes_;
+
+    std::vector<int32_t> free_nodes_;
+
+    int32_t root_;
+
+    float downsample_resolution_;
+
+    float balance_threshold_;
+
+    float delete_threshold_;
+
+    size_t background_threshold_;
+
+    mutable std::shared_mutex mutex_;
+
+    std::thread worker_;
+
+    std::condition_variable_any job_condition_;
+
+    bool stopping_;
+
+    bool job_pending_;
+
+    int32_t rebuilding_root_;
+
+    std::vector<std::array<float, 3>> job_points_;
+
+    std::vector<Operation> operation_log_;
+
+    static void refresh(std::vector<Node> & nodes, const int32_t & index);
+
+    static int32_t build_nodes(std::vector<Node> & nodes, std::vector<std::array<float, 3>> & points,
+                               const size_t & begin, const size_t & end, const int32_t & parent);
+
+    int32_t allocate();
+
+    void release(const int32_t & index);
+
+    void push_down(const int32_t & index);
+
+    void refresh_ancestors(int32_t index);
+
+    void collect(const int32_t & index, std::vector<std::array<float, 3>> & points) const;
+
+    int32_t splice(std::vector<Node> & local, const int32_t & local_root, const int32_t & old_root);
+
+    bool degraded(const int32_t & index) const;
+
+    bool is_ancestor(const int32_t & ancestor, int32_t index) const;
+
+    bool rebalance(const int32_t & index);
+
+    std::vector<std::array<float, 3>> reduce(const PointCloud & cloud) const;
+
+    void insert_from(const float point[3], std::vector<int32_t> & path);
+
+    uint32_t delete_from(const int32_t & index, const float minimum[3], const float maximum[3], std::vector<int32_t> & visited);
+
+    void insert_point(const float point[3]);
+
+    uint32_t delete_box(const float minimum[3], const float maximum[3]);
+
+    void search_box(const int32_t & index, const float minimum[3], const float maximum[3], std::vector<Vector4> & points) const;
+
+    void worker_loop();
+
+ public:
+
+    IncrementalKdTree(const float & downsample_resolution, const size_t & background_threshold);
+
+    IncrementalKdTree(const float & downsample_resolution);
+
+    IncrementalKdTree();
+
+    IncrementalKdTree(const IncrementalKdTree & other) = delete;
+
+    IncrementalKdTree& operator=(const IncrementalKdTree & other) = delete;
+
+    ~IncrementalKdTree();
+
+    void build(const PointCloud & cloud);
+
+    size_t insert(const PointCloud & cloud);
+
+    size_t remove_box(const Vector4 & minimum, const Vector4 & maximum);
+
+    void knn(const Vector4 & query, const size_t & k, std::vector<Vector4> & points, std::vector<float> & sqr_distances) const;
+
+    void box_search(const Vector4 & minimum, const Vector4 & maximum, std::vector<Vector4> & points) const;
+
+    size_t size() const;
+
+    size_t node_count() const;
+
+    size_t depth() const;
+
+    PointCloud points() const;
+
+    void wait_for_rebuild();
+};
+
+#endif
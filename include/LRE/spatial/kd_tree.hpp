@@ -0,0 +1,95 @@
+#ifndef KD_TREE_HPP
+#define KD_TREE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/spatial/array_view.hpp>
+
+class KdTree
+{
+ public:
+
+    struct Node
+    {
+        uint32_t begin;
+        uint32_t end;
+        uint32_t left;
+        uint32_t right;
+        float split;
+        int32_t axis;
+    };
+
+ private:
+
+    struct Storage
+    {
+        std::vector<Node> nodes;
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+        std::vector<uint32_t> indices;
+    };
+
+    // Keeps the arrays behind the views alive; built trees share it on copy since they are immutable.
+    std::shared_ptr<const void> storage_;
+
+    ArrayView<Node> nodes_;
+
+    ArrayView<float> x_;
+
+    ArrayView<float> y_;
+
+    ArrayView<float> z_;
+
+    ArrayView<uint32_t> indices_;
+
+    size_t leaf_size_;
+
+    uint32_t build(Storage & storage, const uint32_t & begin, const uint32_t & end) const;
+
+ public:
+
+    KdTree(const PointCloud & cloud, const size_t & leaf_size);
+
+    KdTree(const PointCloud & cloud);
+
+    KdTree();
+
+    // Wraps prebuilt arrays, e.g. from a mapped cache file, after checking they form a valid tree.
+    static KdTree from_arrays(const ArrayView<Node> & nodes, const ArrayView<float> & x, const ArrayView<float> & y,
+                              const ArrayView<float> & z, const ArrayView<uint32_t> & indices, const size_t & leaf_size,
+                              const std::shared_ptr<const void> & storage);
+
+    size_t size() const;
+
+    size_t leaf_size() const;
+
+    bool empty() const;
+
+    void knn(const Vector4 & query, const size_t & k,
+             std::vector<uint32_t> & indices, std::vector<float> & sqr_distances) const;
+
+    void radius(const Vector4 & query, const float & radius,
+                std::vector<uint32_t> & indices, std::vector<float> & sqr_distances) const;
+
+    ArrayView<Node> nodes() const;
+
+    ArrayView<uint32_t> indices() const;
+
+    // Coordinates in tree order; entry i belongs to the original point indices()[i].
+    const float * x() const;
+
+    const float * y() const;
+
+    const float * z() const;
+};
+
+#endif
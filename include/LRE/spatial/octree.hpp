@@ -0,0 +1,89 @@
+#ifndef OCTREE_HPP
+#define OCTREE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <memory>
+
+#include <LRE/linalg/vector4.hpp>
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/spatial/array_view.hpp>
+
+class Octree
+{
+ public:
+
+    struct Node
+    {
+        float minimum[3];
+        float maximum[3];
+        uint32_t begin;
+        uint32_t end;
+        uint32_t first_child;
+        uint8_t child_mask;
+        uint8_t depth;
+    };
+
+ private:
+
+    struct Storage
+    {
+        std::vector<Node> nodes;
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+        std::vector<uint32_t> indices;
+    };
+
+    std::shared_ptr<const void> storage_;
+
+    ArrayView<Node> nodes_;
+
+    ArrayView<float> x_;
+
+    ArrayView<float> y_;
+
+    ArrayView<float> z_;
+
+    ArrayView<uint32_t> indices_;
+
+    float resolution_;
+
+    static void build(Storage & storage, const uint32_t & node, std::vector<uint32_t> & scratch);
+
+ public:
+
+    Octree(const PointCloud & cloud, const float & resolution);
+
+    Octree();
+
+    // Wraps prebuilt arrays, e.g. from a mapped cache file, after checking they form a valid tree.
+    static Octree from_arrays(const ArrayView<Node> & nodes, const ArrayView<float> & x, const ArrayView<float> & y,
+                              const ArrayView<float> & z, const ArrayView<uint32_t> & indices, const float & resolution,
+                              const std::shared_ptr<const void> & storage);
+
+    size_t size() const;
+
+    bool empty() const;
+
+    float resolution() const;
+
+    size_t leaf_count() const;
+
+    int32_t child(const uint32_t & node, const int32_t & octant) const;
+
+    int32_t find_leaf(const Vector4 & point) const;
+
+    ArrayView<Node> nodes() const;
+
+    ArrayView<uint32_t> indices() const;
+
+    const float * x() const;
+
+    const float * y() const;
+
+    const float * z() const;
+};
+
+#endif
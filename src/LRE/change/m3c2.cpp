@@ -0,0 +1,350 @@
+#include <LRE/change/m3c2.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <LRE/cloud/morton.hpp>
+#include <LRE/outofcore/index_cache.hpp>
+#include <LRE/parallel/primitives.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+
+namespace
+{
+    constexpr float kMortonMaximum = static_cast<float>((1u << 21) - 1);
+    constexpr size_t kReferenceLeafSize = 16;
+
+    struct Projection
+    {
+        double sum;
+        double sqr_sum;
+        uint32_t count;
+    };
+
+    // Accumulates the offsets along the normal of every neighbour that falls inside the projection cylinder.
+    Projection project(const PointCloud &cloud, const std::vector<uint32_t> &neighbours, const float point[3],
+                       const float normal[3], const float &sqr_radius, const float &depth)
+    {
+        Projection projection = {0.0, 0.0, 0};
+
+        const float *x = cloud.x();
+        const float *y = cloud.y();
+        const float *z = cloud.z();
+
+        for (const uint32_t &index : neighbours)
+        {
+            const float dx = x[index] - point[0];
+            const float dy = y[index] - point[1];
+            const float dz = z[index] - point[2];
+
+            const float along = dx * normal[0] + dy * normal[1] + dz * normal[2];
+            const float sqr_radial = dx * dx + dy * dy + dz * dz - along * along;
+
+            if (std::abs(along) <= depth && sqr_radial <= sqr_radius)
+            {
+                projection.sum += along;
+                projection.sqr_sum += static_cast<double>(along) * along;
+                projection.count++;
+            }
+        }
+
+        return projection;
+    }
+
+    double sample_variance(const Projection &projection)
+    {
+        if (projection.count < 2)
+        {
+            return 0.0;
+        }
+
+        const double mean = projection.sum / projection.count;
+        return std::max(0.0, (projection.sqr_sum - projection.sum * mean) / (projection.count - 1));
+    }
+
+    // Morton order over reach-sized cells, so consecutive queries in a batch touch the same tree leaves.
+    std::vector<uint32_t> query_order(const PointCloud &core, const size_t &count, const float &cell_size, ThreadPool &pool)
+    {
+        float minimum[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+        const float *channels[3] = {core.x(), core.y(), core.z()};
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                minimum[c] = std::min(minimum[c], channels[c][i]);
+            }
+        }
+
+        std::vector<uint64_t> keys(count);
+        std::vector<uint32_t> order(count);
+        const float inverse_cell = 1.0f / cell_size;
+
+        pool.parallel_for(0, count, M3C2::kQueryBatch * 16, [&keys, &order, &channels, &minimum, inverse_cell](const size_t &begin, const size_t &end)
+                          {
+                              for (size_t i = begin; i < end; i++)
+                              {
+                                  uint32_t cell[3];
+
+                                  for (int32_t c = 0; c < 3; c++)
+                                  {
+                                      cell[c] = static_cast<uint32_t>(std::min((channels[c][i] - minimum[c]) * inverse_cell, kMortonMaximum));
+                                  }
+
+                                  keys[i] = Morton::encode(cell[0], cell[1], cell[2]);
+                                  order[i] = static_cast<uint32_t>(i);
+                              } });
+
+        ParallelPrimitives::radix_sort(keys, order, pool);
+        return order;
+    }
+
+    // Reference points inside the rectangle, read from every reference tile that overlaps it.
+    PointCloud gather_region(const TileStore &store, TileCache &cache, const float minimum[2], const float maximum[2])
+    {
+        const float tile_size = store.tile_size();
+        PointCloud region;
+        region.set_origin(store.origin());
+
+        for (int32_t ty = static_cast<int32_t>(std::floor(minimum[1] / tile_size)); ty <= static_cast<int32_t>(std::floor(maximum[1] / tile_size)); ty++)
+        {
+            for (int32_t tx = static_cast<int32_t>(std::floor(minimum[0] / tile_size)); tx <= static_cast<int32_t>(std::floor(maximum[0] / tile_size)); tx++)
+            {
+                const int64_t found = store.find(tx, ty);
+
+                if (found < 0)
+                {
+                    continue;
+                }
+
+                std::shared_ptr<const TileView> view = cache.acquire(static_cast<size_t>(found));
+
+                for (size_t i = 0; i < view->size(); i++)
+                {
+                    const float px = view->x()[i];
+                    const float py = view->y()[i];
+
+                    if (px >= minimum[0] && px < maximum[0] && py >= minimum[1] && py < maximum[1])
+                    {
+                        region.push_back(Vector4(px, py, view->z()[i]));
+                    }
+                }
+            }
+        }
+
+        return region;
+    }
+}
+
+M3C2::M3C2(const float &radius, const float &depth, const size_t &min_points, const float &registration_error)
+    : radius_(radius), depth_(depth), min_points_(std::max<size_t>(1, min_points)), registration_error_(std::max(registration_error, 0.0f))
+{
+    if (!(radius_ > 0.0f) || !(depth_ > 0.0f))
+    {
+        throw std::invalid_argument("M3C2: cylinder radius and depth must be positive");
+    }
+}
+
+M3C2::M3C2(const float &radius, const float &depth) : M3C2(radius, depth, 5, 0.0f)
+{
+}
+
+float M3C2::radius() const
+{
+    return radius_;
+}
+
+float M3C2::depth() const
+{
+    return depth_;
+}
+
+size_t M3C2::min_points() const
+{
+    return min_points_;
+}
+
+float M3C2::registration_error() const
+{
+    return registration_error_;
+}
+
+float M3C2::reach() const
+{
+    return std::sqrt(radius_ * radius_ + depth_ * depth_);
+}
+
+std::vector<ChangeMeasurement> M3C2::apply(const PointCloud &core, const size_t &count,
+                                           const PointCloud &compared, const KdTree &compared_tree,
+                                           const PointCloud &reference, const KdTree &reference_tree, ThreadPool &pool) const
+{
+    LRE_PROFILE_SCOPE("M3C2::apply");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, count);
+
+    if (!core.has_normals())
+    {
+        throw std::invalid_argument("M3C2: core points need normals");
+    }
+
+    if (count > core.size() || compared_tree.size() != compared.size() || reference_tree.size() != reference.size())
+    {
+        throw std::invalid_argument("M3C2: core count or tree sizes do not match their clouds");
+    }
+
+    if (!(core.origin() == reference.origin()) || !(compared.origin() == reference.origin()))
+    {
+        throw std::invalid_argument("M3C2: epochs must share a floating origin");
+    }
+
+    std::vector<ChangeMeasurement> measurements(count);
+    const std::vector<uint32_t> order = query_order(core, count, reach(), pool);
+
+    const float search_radius = reach();
+    const float sqr_radius = radius_ * radius_;
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    pool.parallel_for(0, count, kQueryBatch, [this, &core, &compared, &compared_tree, &reference, &reference_tree, &order, &measurements, search_radius, sqr_radius, nan](const size_t &begin, const size_t &end)
+                      {
+                          std::vector<uint32_t> neighbours;
+                          std::vector<float> sqr_distances;
+
+                          for (size_t s = begin; s < end; s++)
+                          {
+                              const uint32_t i = order[s];
+                              ChangeMeasurement &measurement = measurements[i];
+                              measurement = ChangeMeasurement{nan, nan, 0, 0, false};
+
+                              const float point[3] = {core.x()[i], core.y()[i], core.z()[i]};
+                              float normal[3] = {core.normal_x()[i], core.normal_y()[i], core.normal_z()[i]};
+                              const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+                              if (!(length > 0.0f))
+                              {
+                                  continue;
+                              }
+
+                              for (float &component : normal)
+                              {
+                                  component /= length;
+                              }
+
+                              const Vector4 query(point[0], point[1], point[2]);
+
+                              reference_tree.radius(query, search_radius, neighbours, sqr_distances);
+                              const Projection before = project(reference, neighbours, point, normal, sqr_radius, depth_);
+
+                              compared_tree.radius(query, search_radius, neighbours, sqr_distances);
+                              const Projection after = project(compared, neighbours, point, normal, sqr_radius, depth_);
+
+                              measurement.reference_count = before.count;
+                              measurement.compared_count = after.count;
+
+                              if (before.count < min_points_ || after.count < min_points_)
+                              {
+                                  continue;
+                              }
+
+                              const double distance = after.sum / after.count - before.sum / before.count;
+                              const double spread = std::sqrt(sample_variance(before) / before.count + sample_variance(after) / after.count);
+
+                              measurement.distance = static_cast<float>(distance);
+                              measurement.uncertainty = static_cast<float>(kConfidence * spread + registration_error_);
+                              measurement.significant = std::abs(measurement.distance) > measurement.uncertainty;
+                          } });
+
+    return measurements;
+}
+
+std::vector<ChangeMeasurement> M3C2::apply(const PointCloud &compared, const PointCloud &reference, const KdTree &reference_tree,
+                                           ThreadPool &pool) const
+{
+    const KdTree compared_tree(compared);
+    return apply(compared, compared.size(), compared, compared_tree, reference, reference_tree, pool);
+}
+
+std::vector<ChangeMeasurement> M3C2::apply(const PointCloud &compared, const PointCloud &reference, const KdTree &reference_tree) const
+{
+    return apply(compared, reference, reference_tree, ThreadPool::shared());
+}
+
+std::vector<ChangeMeasurement> M3C2::apply_tile(const TileInfo &info, const float &tile_size, const PointCloud &compared,
+                                                const size_t &core_count, const TileStore &reference, TileCache &reference_cache,
+                                                const std::string &index_directory, ThreadPool &pool) const
+{
+    LRE_PROFILE_SCOPE("M3C2::apply_tile");
+
+    // The rectangle is in the compared frame; the reference store may sit on a different origin.
+    const double halo = reach();
+    const Vector4d shift = compared.origin() - reference.origin();
+    const float minimum[2] = {static_cast<float>(info.x * static_cast<double>(tile_size) - halo + shift[0]),
+                              static_cast<float>(info.y * static_cast<double>(tile_size) - halo + shift[1])};
+    const float maximum[2] = {static_cast<float>((info.x + 1) * static_cast<double>(tile_size) + halo + shift[0]),
+                              static_cast<float>((info.y + 1) * static_cast<double>(tile_size) + halo + shift[1])};
+
+    PointCloud region = gather_region(reference, reference_cache, minimum, maximum);
+
+    if (region.origin() != compared.origin())
+    {
+        region.rebase(compared.origin());
+    }
+    const KdTree compared_tree(compared);
+
+    if (index_directory.empty())
+    {
+        return apply(compared, core_count, compared, compared_tree, region, KdTree(region, kReferenceLeafSize), pool);
+    }
+
+    std::filesystem::create_directories(index_directory);
+
+    const std::string path = index_directory + "/m3c2_" + std::to_string(info.x) + "_" + std::to_string(info.y) + ".idx";
+    const KdTree reference_tree = IndexCache::kd_tree(path, region, kReferenceLeafSize);
+
+    return apply(compared, core_count, compared, compared_tree, region, reference_tree, pool);
+}
+
+std::vector<float> M3C2::cloud_to_cloud(const PointCloud &compared, const PointCloud &reference, const KdTree &reference_tree,
+                                        ThreadPool &pool)
+{
+    LRE_PROFILE_SCOPE("M3C2::cloud_to_cloud");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, compared.size());
+
+    if (reference_tree.size() != reference.size())
+    {
+        throw std::invalid_argument("M3C2: tree size does not match the reference cloud");
+    }
+
+    std::vector<float> distances(compared.size(), std::numeric_limits<float>::quiet_NaN());
+
+    if (reference.empty())
+    {
+        return distances;
+    }
+
+    pool.parallel_for(0, compared.size(), kQueryBatch, [&compared, &reference, &reference_tree, &distances](const size_t &begin, const size_t &end)
+                      {
+                          std::vector<uint32_t> nearest;
+                          std::vector<float> sqr_distances;
+
+                          for (size_t i = begin; i < end; i++)
+                          {
+                              const Vector4 point = compared.point(i);
+                              reference_tree.knn(point, 1, nearest, sqr_distances);
+
+                              float distance = std::sqrt(sqr_distances[0]);
+
+                              if (reference.has_normals())
+                              {
+                                  const uint32_t j = nearest[0];
+                                  const float along = (point[0] - reference.x()[j]) * reference.normal_x()[j] +
+                                                      (point[1] - reference.y()[j]) * reference.normal_y()[j] +
+                                                      (point[2] - reference.z()[j]) * reference.normal_z()[j];
+
+                                  distance = along < 0.0f ? -distance : distance;
+                              }
+
+                              distances[i] = distance;
+                          } });
+
+    return distances;
+}
@@ -0,0 +1,377 @@
+#include <LRE/cloud/compressed_cloud.hpp>
+#include <LRE/profiling/profiler.hpp>
+#include <LRE/parallel/primitives.hpp>
+
+#include <unordered_map>
+
+namespace
+{
+    constexpr uint32_t kMaxCode16 = 65535u;
+    constexpr uint32_t kMaxCode32 = 2147483647u;
+
+    uint32_t quantize(const float &value, const float &origin, const float &inverse_resolution, const uint32_t &max_code)
+    {
+        const double scaled = std::round(static_cast<double>(value - origin) * inverse_resolution);
+        return static_cast<uint32_t>(std::min<double>(std::max(scaled, 0.0), max_code));
+    }
+
+    uint32_t bit_width(uint64_t value)
+    {
+        uint32_t width = 0;
+
+        while (value != 0)
+        {
+            value >>= 1;
+            width++;
+        }
+
+        return width;
+    }
+
+    template <typename Code>
+    void dequantize(const Code *codes, const size_t &count, const float &origin, const float &resolution, float *out)
+    {
+        size_t i = 0;
+
+#ifdef __AVX__
+
+        const __m256 reg_origin = _mm256_set1_ps(origin);
+        const __m256 reg_scale = _mm256_set1_ps(resolution);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i integers;
+
+            if (sizeof(Code) == 2)
+            {
+                __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&codes[i]));
+                __m128i low = _mm_cvtepu16_epi32(raw);
+                __m128i high = _mm_cvtepu16_epi32(_mm_srli_si128(raw, 8));
+                integers = _mm256_insertf128_si256(_mm256_castsi128_si256(low), high, 1);
+            }
+            else
+            {
+                integers = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&codes[i]));
+            }
+
+            __m256 values = _mm256_mul_ps(_mm256_cvtepi32_ps(integers), reg_scale);
+            _mm256_storeu_ps(&out[i], _mm256_add_ps(values, reg_origin));
+        }
+
+#endif
+
+        for (; i < count; i++)
+        {
+            out[i] = static_cast<float>(codes[i]) * resolution + origin;
+        }
+    }
+}
+
+CompressedCloud::CompressedCloud(const PointCloud &cloud, const float &resolution, const CloudEncoding &encoding)
+    : encoding_(encoding), resolution_(std::max(resolution, 1e-6f)), size_(cloud.size()), origin_(cloud.origin())
+{
+    LRE_PROFILE_SCOPE("CompressedCloud::encode");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, cloud.size());
+
+    const uint32_t max_code = encoding_ == CloudEncoding::Quantized32 ? kMaxCode32 : kMaxCode16;
+    const double tile_extent = static_cast<double>(resolution_) * max_code;
+
+    std::unordered_map<uint64_t, size_t> tile_lookup;
+    std::vector<std::vector<uint32_t>> tile_members;
+
+    const float *x = cloud.x();
+    const float *y = cloud.y();
+    const float *z = cloud.z();
+
+    // Tiles are anchored at the cloud minimum so origins stay small relative to the data.
+    float minimum[3] = {0.0f, 0.0f, 0.0f};
+
+    if (!cloud.empty())
+    {
+        minimum[0] = *std::min_element(x, x + cloud.size());
+        minimum[1] = *std::min_element(y, y + cloud.size());
+        minimum[2] = *std::min_element(z, z + cloud.size());
+    }
+
+    for (size_t i = 0; i < cloud.size(); i++)
+    {
+        const int64_t tx = static_cast<int64_t>(std::floor((x[i] - minimum[0]) / tile_extent));
+        const int64_t ty = static_cast<int64_t>(std::floor((y[i] - minimum[1]) / tile_extent));
+        const int64_t tz = static_cast<int64_t>(std::floor((z[i] - minimum[2]) / tile_extent));
+
+        const uint64_t key = (static_cast<uint64_t>(tx) & 0x1fffff) |
+                             ((static_cast<uint64_t>(ty) & 0x1fffff) << 21) |
+                             ((static_cast<uint64_t>(tz) & 0x1fffff) << 42);
+
+        auto found = tile_lookup.find(key);
+
+        if (found == tile_lookup.end())
+        {
+            Tile tile;
+            tile.origin[0] = static_cast<float>(minimum[0] + tx * tile_extent);
+            tile.origin[1] = static_cast<float>(minimum[1] + ty * tile_extent);
+            tile.origin[2] = static_cast<float>(minimum[2] + tz * tile_extent);
+            tile.count = 0;
+            tile.offset = 0;
+            tile.first_block = 0;
+            tile.block_count = 0;
+
+            found = tile_lookup.emplace(key, tiles_.size()).first;
+            tiles_.push_back(tile);
+            tile_members.emplace_back();
+        }
+
+        tile_members[found->second].push_back(static_cast<uint32_t>(i));
+    }
+
+    for (size_t t = 0; t < tiles_.size(); t++)
+    {
+        encode_tile(tiles_[t], cloud, tile_members[t]);
+    }
+}
+
+CompressedCloud::CompressedCloud() : encoding_(CloudEncoding::Quantized16), resolution_(1.0f), size_(0)
+{
+}
+
+void CompressedCloud::encode_tile(Tile &tile, const PointCloud &cloud, const std::vector<uint32_t> &indices)
+{
+    const float inverse_resolution = 1.0f / resolution_;
+    const uint32_t max_code = encoding_ == CloudEncoding::Quantized32 ? kMaxCode32 : kMaxCode16;
+    const float *channels[3] = {cloud.x(), cloud.y(), cloud.z()};
+
+    tile.count = indices.size();
+
+    if (encoding_ == CloudEncoding::Quantized16)
+    {
+        tile.offset = codes16_.size();
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            for (const uint32_t &index : indices)
+            {
+                codes16_.push_back(static_cast<uint16_t>(quantize(channels[c][index], tile.origin[c], inverse_resolution, max_code)));
+            }
+        }
+
+        return;
+    }
+
+    if (encoding_ == CloudEncoding::Quantized32)
+    {
+        tile.offset = codes32_.size();
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            for (const uint32_t &index : indices)
+            {
+                codes32_.push_back(quantize(channels[c][index], tile.origin[c], inverse_resolution, max_code));
+            }
+        }
+
+        return;
+    }
+
+    std::vector<uint64_t> codes;
+    codes.reserve(indices.size());
+
+    for (const uint32_t &index : indices)
+    {
+        codes.push_back(Morton::encode(quantize(channels[0][index], tile.origin[0], inverse_resolution, max_code),
+                                       quantize(channels[1][index], tile.origin[1], inverse_resolution, max_code),
+                                       quantize(channels[2][index], tile.origin[2], inverse_resolution, max_code)));
+    }
+
+    ParallelPrimitives::radix_sort(codes);
+
+    tile.first_block = blocks_.size();
+
+    for (size_t begin = 0; begin < codes.size(); begin += kBlockSize)
+    {
+        const size_t end = std::min(codes.size(), begin + kBlockSize);
+
+        uint64_t largest_delta = 0;
+
+        for (size_t i = begin + 1; i < end; i++)
+        {
+            largest_delta = std::max(largest_delta, codes[i] - codes[i - 1]);
+        }
+
+        Block block;
+        block.base = codes[begin];
+        block.word_offset = packed_.size();
+        block.count = static_cast<uint32_t>(end - begin);
+        block.width = bit_width(largest_delta);
+
+        const size_t total_bits = static_cast<size_t>(block.count - 1) * block.width;
+        packed_.resize(packed_.size() + (total_bits + 63) / 64, 0);
+
+        uint64_t *words = &packed_[block.word_offset];
+
+        for (size_t i = begin + 1; i < end && block.width > 0; i++)
+        {
+            const uint64_t delta = codes[i] - codes[i - 1];
+            const size_t bit = (i - begin - 1) * block.width;
+            const size_t shift = bit & 63;
+
+            words[bit >> 6] |= delta << shift;
+
+            if (shift + block.width > 64)
+            {
+                words[(bit >> 6) + 1] |= delta >> (64 - shift);
+            }
+        }
+
+        blocks_.push_back(block);
+    }
+
+    tile.block_count = blocks_.size() - tile.first_block;
+}
+
+void CompressedCloud::unpack_tile(const Tile &tile, uint16_t *x, uint16_t *y, uint16_t *z) const
+{
+    size_t written = 0;
+
+    for (size_t b = tile.first_block; b < tile.first_block + tile.block_count; b++)
+    {
+        const Block &block = blocks_[b];
+        const uint64_t *words = packed_.data() + block.word_offset;
+        const uint64_t mask = block.width >= 64 ? ~0ull : ((1ull << block.width) - 1);
+
+        uint64_t code = block.base;
+
+        for (uint32_t i = 0; i < block.count; i++)
+        {
+            if (i > 0 && block.width > 0)
+            {
+                const size_t bit = static_cast<size_t>(i - 1) * block.width;
+                const size_t shift = bit & 63;
+
+                uint64_t delta = words[bit >> 6] >> shift;
+
+                if (shift + block.width > 64)
+                {
+                    delta |= words[(bit >> 6) + 1] << (64 - shift);
+                }
+
+                code += delta & mask;
+            }
+
+            uint32_t qx, qy, qz;
+            Morton::decode(code, qx, qy, qz);
+
+            x[written] = static_cast<uint16_t>(qx);
+            y[written] = static_cast<uint16_t>(qy);
+            z[written] = static_cast<uint16_t>(qz);
+            written++;
+        }
+    }
+}
+
+size_t CompressedCloud::size() const
+{
+    return size_;
+}
+
+size_t CompressedCloud::tile_count() const
+{
+    return tiles_.size();
+}
+
+size_t CompressedCloud::tile_size(const size_t &tile) const
+{
+    return tiles_[tile].count;
+}
+
+float CompressedCloud::resolution() const
+{
+    return resolution_;
+}
+
+CloudEncoding CompressedCloud::encoding() const
+{
+    return encoding_;
+}
+
+const Vector4d &CompressedCloud::origin() const
+{
+    return origin_;
+}
+
+size_t CompressedCloud::memory_usage() const
+{
+    return sizeof(*this) + tiles_.size() * sizeof(Tile) + blocks_.size() * sizeof(Block) +
+           codes16_.size() * sizeof(uint16_t) + codes32_.size() * sizeof(uint32_t) +
+           packed_.size() * sizeof(uint64_t);
+}
+
+void CompressedCloud::decode_tile(const size_t &tile, float *x, float *y, float *z) const
+{
+    const Tile &record = tiles_[tile];
+    float *outputs[3] = {x, y, z};
+
+    if (encoding_ == CloudEncoding::Quantized16)
+    {
+        for (int32_t c = 0; c < 3; c++)
+        {
+            dequantize(&codes16_[record.offset + c * record.count], record.count, record.origin[c], resolution_, outputs[c]);
+        }
+
+        return;
+    }
+
+    if (encoding_ == CloudEncoding::Quantized32)
+    {
+        for (int32_t c = 0; c < 3; c++)
+        {
+            dequantize(&codes32_[record.offset + c * record.count], record.count, record.origin[c], resolution_, outputs[c]);
+        }
+
+        return;
+    }
+
+    std::vector<uint16_t> codes(record.count * 3);
+    unpack_tile(record, codes.data(), codes.data() + record.count, codes.data() + 2 * record.count);
+
+    for (int32_t c = 0; c < 3; c++)
+    {
+        dequantize(&codes[c * record.count], record.count, record.origin[c], resolution_, outputs[c]);
+    }
+}
+
+void CompressedCloud::decode_tile(const size_t &tile, PointCloud &scratch) const
+{
+    scratch.resize(tiles_[tile].count);
+    scratch.set_origin(origin_);
+    decode_tile(tile, scratch.x(), scratch.y(), scratch.z());
+}
+
+PointCloud CompressedCloud::decode(ThreadPool &pool) const
+{
+    LRE_PROFILE_SCOPE("CompressedCloud::decode");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, size_);
+
+    PointCloud result(size_);
+    result.set_origin(origin_);
+
+    std::vector<size_t> starts(tiles_.size(), 0);
+
+    for (size_t t = 1; t < tiles_.size(); t++)
+    {
+        starts[t] = starts[t - 1] + tiles_[t - 1].count;
+    }
+
+    pool.parallel_for(0, tiles_.size(), 1, [this, &result, &starts](const size_t &begin, const size_t &end)
+                      {
+                          for (size_t t = begin; t < end; t++)
+                          {
+                              decode_tile(t, result.x() + starts[t], result.y() + starts[t], result.z() + starts[t]);
+                          } });
+
+    return result;
+}
+
+PointCloud CompressedCloud::decode() const
+{
+    return decode(ThreadPool::shared());
+}
@@ -0,0 +1,39 @@
+#include <LRE/cloud/morton.hpp>
+
+uint64_t Morton::spread(const uint32_t &value)
+{
+    uint64_t bits = value & 0x1fffffull;
+
+    bits = (bits | (bits << 32)) & 0x1f00000000ffffull;
+    bits = (bits | (bits << 16)) & 0x1f0000ff0000ffull;
+    bits = (bits | (bits << 8)) & 0x100f00f00f00f00full;
+    bits = (bits | (bits << 4)) & 0x10c30c30c30c30c3ull;
+    bits = (bits | (bits << 2)) & 0x1249249249249249ull;
+
+    return bits;
+}
+
+uint32_t Morton::compact(const uint64_t &value)
+{
+    uint64_t bits = value & 0x1249249249249249ull;
+
+    bits = (bits | (bits >> 2)) & 0x10c30c30c30c30c3ull;
+    bits = (bits | (bits >> 4)) & 0x100f00f00f00f00full;
+    bits = (bits | (bits >> 8)) & 0x1f0000ff0000ffull;
+    bits = (bits | (bits >> 16)) & 0x1f00000000ffffull;
+    bits = (bits | (bits >> 32)) & 0x1fffffull;
+
+    return static_cast<uint32_t>(bits);
+}
+
+uint64_t Morton::encode(const uint32_t &x, const uint32_t &y, const uint32_t &z)
+{
+    return spread(x) | (spread(y) << 1) | (spread(z) << 2);
+}
+
+void Morton::decode(const uint64_t &code, uint32_t &x, uint32_t &y, uint32_t &z)
+{
+    x = compact(code);
+    y = compact(code >> 1);
+    z = compact(code >> 2);
+}
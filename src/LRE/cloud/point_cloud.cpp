@@ -0,0 +1,459 @@
+#include <LRE/cloud/point_cloud.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+namespace
+{
+    // Offsets are widened to double before the shift so large origin moves round only once.
+    void shift_points(float *x, float *y, float *z, const size_t &count, const double delta[3])
+    {
+        size_t i = 0;
+
+#ifdef __AVX__
+
+        const __m256d dx = _mm256_set1_pd(delta[0]);
+        const __m256d dy = _mm256_set1_pd(delta[1]);
+        const __m256d dz = _mm256_set1_pd(delta[2]);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            _mm_storeu_ps(x + i, _mm256_cvtpd_ps(_mm256_add_pd(_mm256_cvtps_pd(_mm_loadu_ps(x + i)), dx)));
+            _mm_storeu_ps(y + i, _mm256_cvtpd_ps(_mm256_add_pd(_mm256_cvtps_pd(_mm_loadu_ps(y + i)), dy)));
+            _mm_storeu_ps(z + i, _mm256_cvtpd_ps(_mm256_add_pd(_mm256_cvtps_pd(_mm_loadu_ps(z + i)), dz)));
+        }
+
+#endif
+
+        for (; i < count; i++)
+        {
+            x[i] = static_cast<float>(static_cast<double>(x[i]) + delta[0]);
+            y[i] = static_cast<float>(static_cast<double>(y[i]) + delta[1]);
+            z[i] = static_cast<float>(static_cast<double>(z[i]) + delta[2]);
+        }
+    }
+
+    void transform_points(float *x, float *y, float *z, const size_t &count, const double rotation[9], const double offset[3])
+    {
+        size_t i = 0;
+
+#ifdef __AVX__
+
+        __m256d r[9];
+
+        for (int32_t k = 0; k < 9; k++)
+        {
+            r[k] = _mm256_set1_pd(rotation[k]);
+        }
+
+        const __m256d ox = _mm256_set1_pd(offset[0]);
+        const __m256d oy = _mm256_set1_pd(offset[1]);
+        const __m256d oz = _mm256_set1_pd(offset[2]);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m256d px = _mm256_cvtps_pd(_mm_loadu_ps(x + i));
+            const __m256d py = _mm256_cvtps_pd(_mm_loadu_ps(y + i));
+            const __m256d pz = _mm256_cvtps_pd(_mm_loadu_ps(z + i));
+
+            const __m256d tx = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(r[0], px), _mm256_mul_pd(r[1], py)), _mm256_mul_pd(r[2], pz)), ox);
+            const __m256d ty = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(r[3], px), _mm256_mul_pd(r[4], py)), _mm256_mul_pd(r[5], pz)), oy);
+            const __m256d tz = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(r[6], px), _mm256_mul_pd(r[7], py)), _mm256_mul_pd(r[8], pz)), oz);
+
+            _mm_storeu_ps(x + i, _mm256_cvtpd_ps(tx));
+            _mm_storeu_ps(y + i, _mm256_cvtpd_ps(ty));
+            _mm_storeu_ps(z + i, _mm256_cvtpd_ps(tz));
+        }
+
+#endif
+
+        for (; i < count; i++)
+        {
+            const double px = x[i];
+            const double py = y[i];
+            const double pz = z[i];
+
+            x[i] = static_cast<float>(rotation[0] * px + rotation[1] * py + rotation[2] * pz + offset[0]);
+            y[i] = static_cast<float>(rotation[3] * px + rotation[4] * py + rotation[5] * pz + offset[1]);
+            z[i] = static_cast<float>(rotation[6] * px + rotation[7] * py + rotation[8] * pz + offset[2]);
+        }
+    }
+}
+
+PointCloud::PointCloud(const size_t &size) : x_(size), y_(size), z_(size), timestamped_(false), has_normals_(false)
+{
+}
+
+PointCloud::PointCloud(const std::vector<Vector4> &points) : timestamped_(false), has_normals_(false)
+{
+    reserve(points.size());
+
+    for (const Vector4 &point : points)
+    {
+        push_back(point);
+    }
+}
+
+PointCloud::PointCloud() : timestamped_(false), has_normals_(false)
+{
+}
+
+size_t PointCloud::size() const
+{
+    return x_.size();
+}
+
+bool PointCloud::empty() const
+{
+    return x_.empty();
+}
+
+bool PointCloud::has_timestamps() const
+{
+    return timestamped_;
+}
+
+bool PointCloud::has_normals() const
+{
+    return has_normals_;
+}
+
+void PointCloud::reserve(const size_t &capacity)
+{
+    if (capacity > x_.capacity())
+    {
+        LRE_PROFILE_COUNT(Counter::Allocations, 1);
+    }
+
+    x_.reserve(capacity);
+    y_.reserve(capacity);
+    z_.reserve(capacity);
+
+    if (has_timestamps())
+    {
+        timestamps_.reserve(capacity);
+    }
+
+    if (has_normals())
+    {
+        normal_x_.reserve(capacity);
+        normal_y_.reserve(capacity);
+        normal_z_.reserve(capacity);
+    }
+}
+
+void PointCloud::resize(const size_t &size)
+{
+    if (size > x_.capacity())
+    {
+        LRE_PROFILE_COUNT(Counter::Allocations, 1);
+    }
+
+    x_.resize(size);
+    y_.resize(size);
+    z_.resize(size);
+
+    if (has_timestamps())
+    {
+        timestamps_.resize(size);
+    }
+
+    if (has_normals())
+    {
+        normal_x_.resize(size);
+        normal_y_.resize(size);
+        normal_z_.resize(size);
+    }
+}
+
+void PointCloud::clear()
+{
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    timestamps_.clear();
+    normal_x_.clear();
+    normal_y_.clear();
+    normal_z_.clear();
+}
+
+void PointCloud::enable_timestamps()
+{
+    timestamped_ = true;
+    timestamps_.reserve(x_.capacity());
+    timestamps_.resize(x_.size(), 0.0f);
+}
+
+void PointCloud::enable_normals()
+{
+    has_normals_ = true;
+    normal_x_.resize(x_.size(), 0.0f);
+    normal_y_.resize(x_.size(), 0.0f);
+    normal_z_.resize(x_.size(), 0.0f);
+}
+
+void PointCloud::push_back(const Vector4 &point)
+{
+    x_.push_back(point[0]);
+    y_.push_back(point[1]);
+    z_.push_back(point[2]);
+
+    if (has_timestamps())
+    {
+        timestamps_.push_back(0.0f);
+    }
+
+    if (has_normals())
+    {
+        normal_x_.push_back(0.0f);
+        normal_y_.push_back(0.0f);
+        normal_z_.push_back(0.0f);
+    }
+}
+
+void PointCloud::push_back(const Vector4 &point, const float &timestamp)
+{
+    if (!has_timestamps())
+    {
+        enable_timestamps();
+    }
+
+    x_.push_back(point[0]);
+    y_.push_back(point[1]);
+    z_.push_back(point[2]);
+    timestamps_.push_back(timestamp);
+
+    if (has_normals())
+    {
+        normal_x_.push_back(0.0f);
+        normal_y_.push_back(0.0f);
+        normal_z_.push_back(0.0f);
+    }
+}
+
+void PointCloud::append(const PointCloud &other)
+{
+    // Inserting a vector's own range into itself is undefined, so a self-append goes through a copy.
+    if (&other == this)
+    {
+        const PointCloud copy(other);
+        append(copy);
+        return;
+    }
+
+    if (other.has_timestamps() && !has_timestamps())
+    {
+        enable_timestamps();
+    }
+
+    if (other.has_normals() && !has_normals())
+    {
+        enable_normals();
+    }
+
+    const size_t previous = size();
+
+    x_.insert(x_.end(), other.x_.begin(), other.x_.end());
+    y_.insert(y_.end(), other.y_.begin(), other.y_.end());
+    z_.insert(z_.end(), other.z_.begin(), other.z_.end());
+
+    if (has_timestamps())
+    {
+        if (other.has_timestamps())
+        {
+            timestamps_.insert(timestamps_.end(), other.timestamps_.begin(), other.timestamps_.end());
+        }
+        else
+        {
+            timestamps_.resize(previous + other.size(), 0.0f);
+        }
+    }
+
+    if (has_normals())
+    {
+        if (other.has_normals())
+        {
+            normal_x_.insert(normal_x_.end(), other.normal_x_.begin(), other.normal_x_.end());
+            normal_y_.insert(normal_y_.end(), other.normal_y_.begin(), other.normal_y_.end());
+            normal_z_.insert(normal_z_.end(), other.normal_z_.begin(), other.normal_z_.end());
+        }
+        else
+        {
+            normal_x_.resize(previous + other.size(), 0.0f);
+            normal_y_.resize(previous + other.size(), 0.0f);
+            normal_z_.resize(previous + other.size(), 0.0f);
+        }
+    }
+
+    if (other.origin_ != origin_)
+    {
+        const Vector4d delta = other.origin_ - origin_;
+        const double shift[3] = {delta[0], delta[1], delta[2]};
+        shift_points(x_.data() + previous, y_.data() + previous, z_.data() + previous, other.size(), shift);
+    }
+}
+
+Vector4 PointCloud::point(const size_t &index) const
+{
+    return Vector4(x_[index], y_[index], z_[index], 1.0f);
+}
+
+void PointCloud::set_point(const size_t &index, const Vector4 &point)
+{
+    x_[index] = point[0];
+    y_[index] = point[1];
+    z_[index] = point[2];
+}
+
+Vector4 PointCloud::normal(const size_t &index) const
+{
+    return Vector4(normal_x_[index], normal_y_[index], normal_z_[index], 0.0f);
+}
+
+void PointCloud::set_normal(const size_t &index, const Vector4 &normal)
+{
+    normal_x_[index] = normal[0];
+    normal_y_[index] = normal[1];
+    normal_z_[index] = normal[2];
+}
+
+std::vector<Vector4> PointCloud::to_vectors() const
+{
+    std::vector<Vector4> result;
+    result.reserve(size());
+
+    for (size_t i = 0; i < size(); i++)
+    {
+        result.push_back(point(i));
+    }
+
+    return result;
+}
+
+const Vector4d &PointCloud::origin() const
+{
+    return origin_;
+}
+
+void PointCloud::set_origin(const Vector4d &origin)
+{
+    origin_ = Vector4d(origin[0], origin[1], origin[2]);
+}
+
+void PointCloud::rebase(const Vector4d &origin)
+{
+    LRE_PROFILE_SCOPE("PointCloud::rebase");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, size());
+
+    const Vector4d delta = origin_ - origin;
+    const double shift[3] = {delta[0], delta[1], delta[2]};
+
+    shift_points(x_.data(), y_.data(), z_.data(), size(), shift);
+    set_origin(origin);
+}
+
+void PointCloud::rebase(const Matrix4d &pose, const Vector4d &origin)
+{
+    LRE_PROFILE_SCOPE("PointCloud::rebase");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, size());
+
+    const double rotation[9] = {pose[0], pose[1], pose[2], pose[4], pose[5], pose[6], pose[8], pose[9], pose[10]};
+
+    // world' = R (origin + p) + t, so the new offset is R p + (R origin + t - origin').
+    double offset[3];
+
+    for (int32_t r = 0; r < 3; r++)
+    {
+        offset[r] = (rotation[r * 3] * origin_[0] + rotation[r * 3 + 1] * origin_[1] + rotation[r * 3 + 2] * origin_[2]) +
+                    (pose[r * 4 + 3] - origin[r]);
+    }
+
+    transform_points(x_.data(), y_.data(), z_.data(), size(), rotation, offset);
+
+    if (has_normals_)
+    {
+        const double zero[3] = {0.0, 0.0, 0.0};
+        transform_points(normal_x_.data(), normal_y_.data(), normal_z_.data(), size(), rotation, zero);
+    }
+
+    set_origin(origin);
+}
+
+Vector4d PointCloud::world_point(const size_t &index) const
+{
+    return Vector4d(origin_[0] + x_[index], origin_[1] + y_[index], origin_[2] + z_[index], 1.0);
+}
+
+void PointCloud::push_back_world(const Vector4d &point)
+{
+    push_back(Vector4(static_cast<float>(point[0] - origin_[0]), static_cast<float>(point[1] - origin_[1]),
+                      static_cast<float>(point[2] - origin_[2])));
+}
+
+float *PointCloud::x()
+{
+    return x_.data();
+}
+
+float *PointCloud::y()
+{
+    return y_.data();
+}
+
+float *PointCloud::z()
+{
+    return z_.data();
+}
+
+float *PointCloud::timestamps()
+{
+    return timestamps_.data();
+}
+
+const float *PointCloud::x() const
+{
+    return x_.data();
+}
+
+const float *PointCloud::y() const
+{
+    return y_.data();
+}
+
+const float *PointCloud::z() const
+{
+    return z_.data();
+}
+
+const float *PointCloud::timestamps() const
+{
+    return timestamps_.data();
+}
+
+float *PointCloud::normal_x()
+{
+    return normal_x_.data();
+}
+
+float *PointCloud::normal_y()
+{
+    return normal_y_.data();
+}
+
+float *PointCloud::normal_z()
+{
+    return normal_z_.data();
+}
+
+const float *PointCloud::normal_x() const
+{
+    return normal_x_.data();
+}
+
+const float *PointCloud::normal_y() const
+{
+    return normal_y_.data();
+}
+
+const float *PointCloud::normal_z() const
+{
+    return normal_z_.data();
+}
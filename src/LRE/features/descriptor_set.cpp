@@ -0,0 +1,87 @@
+#include <LRE/features/descriptor_set.hpp>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+DescriptorSet::DescriptorSet(const size_t &count, const size_t &dimension)
+    : dimension_(dimension), data_(count * dimension, 0.0f)
+{
+}
+
+DescriptorSet::DescriptorSet() : dimension_(0)
+{
+}
+
+size_t DescriptorSet::size() const
+{
+    return dimension_ == 0 ? 0 : data_.size() / dimension_;
+}
+
+size_t DescriptorSet::dimension() const
+{
+    return dimension_;
+}
+
+bool DescriptorSet::empty() const
+{
+    return data_.empty();
+}
+
+void DescriptorSet::resize(const size_t &count, const size_t &dimension)
+{
+    dimension_ = dimension;
+    data_.assign(count * dimension, 0.0f);
+}
+
+float *DescriptorSet::row(const size_t &index)
+{
+    return data_.data() + index * dimension_;
+}
+
+const float *DescriptorSet::row(const size_t &index) const
+{
+    return data_.data() + index * dimension_;
+}
+
+float *DescriptorSet::data()
+{
+    return data_.data();
+}
+
+const float *DescriptorSet::data() const
+{
+    return data_.data();
+}
+
+float DescriptorSet::sqr_distance(const float *a, const float *b, const size_t &dimension)
+{
+    size_t i = 0;
+    float sum = 0.0f;
+
+#ifdef __AVX__
+    __m256 accumulator = _mm256_setzero_ps();
+
+    for (; i + 8 <= dimension; i += 8)
+    {
+        const __m256 difference = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        accumulator = _mm256_add_ps(accumulator, _mm256_mul_ps(difference, difference));
+    }
+
+    float lanes[8];
+    _mm256_storeu_ps(lanes, accumulator);
+
+    for (const float lane : lanes)
+    {
+        sum += lane;
+    }
+#endif
+
+    for (; i < dimension; i++)
+    {
+        const float difference = a[i] - b[i];
+        sum += difference * difference;
+    }
+
+    return sum;
+}
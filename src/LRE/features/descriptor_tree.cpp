@@ -0,0 +1,237 @@
+#include <LRE/features/descriptor_tree.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+namespace
+{
+    constexpr uint32_t kNoChild = 0;
+
+    struct Candidate
+    {
+        float sqr_distance;
+        uint32_t index;
+
+        bool operator<(const Candidate &other) const
+        {
+            return sqr_distance < other.sqr_distance;
+        }
+    };
+
+    struct Branch
+    {
+        float sqr_distance;
+        uint32_t node;
+
+        bool operator<(const Branch &other) const
+        {
+            return sqr_distance > other.sqr_distance;
+        }
+    };
+}
+
+DescriptorTree::DescriptorTree(const DescriptorSet &descriptors, const size_t &leaf_size)
+    : indices_(descriptors.size()),
+      dimension_(descriptors.dimension()),
+      leaf_size_(std::max<size_t>(1, leaf_size))
+{
+    LRE_PROFILE_SCOPE("DescriptorTree::build");
+
+    for (uint32_t i = 0; i < indices_.size(); i++)
+    {
+        indices_[i] = i;
+    }
+
+    if (indices_.empty())
+    {
+        return;
+    }
+
+    nodes_.reserve(2 * indices_.size() / leaf_size_ + 1);
+    build(descriptors, 0, static_cast<uint32_t>(indices_.size()));
+
+    // Store descriptors in tree order so leaves are contiguous in memory.
+    data_.resize(indices_.size() * dimension_);
+
+    for (size_t i = 0; i < indices_.size(); i++)
+    {
+        std::copy(descriptors.row(indices_[i]), descriptors.row(indices_[i]) + dimension_, data_.begin() + i * dimension_);
+    }
+}
+
+DescriptorTree::DescriptorTree(const DescriptorSet &descriptors) : DescriptorTree(descriptors, 16)
+{
+}
+
+DescriptorTree::DescriptorTree() : dimension_(0), leaf_size_(16)
+{
+}
+
+uint32_t DescriptorTree::build(const DescriptorSet &descriptors, const uint32_t &begin, const uint32_t &end)
+{
+    const uint32_t node_index = static_cast<uint32_t>(nodes_.size());
+    nodes_.push_back(Node{begin, end, kNoChild, kNoChild, 0.0f, -1});
+
+    if (end - begin <= leaf_size_)
+    {
+        return node_index;
+    }
+
+    // Split on the dimension of largest variance; descriptor axes differ too much in scale for round robin.
+    std::vector<double> mean(dimension_, 0.0);
+    std::vector<double> variance(dimension_, 0.0);
+
+    for (uint32_t i = begin; i < end; i++)
+    {
+        const float *row = descriptors.row(indices_[i]);
+
+        for (size_t d = 0; d < dimension_; d++)
+        {
+            mean[d] += row[d];
+            variance[d] += static_cast<double>(row[d]) * row[d];
+        }
+    }
+
+    int32_t axis = 0;
+    double best = -1.0;
+
+    for (size_t d = 0; d < dimension_; d++)
+    {
+        const double m = mean[d] / (end - begin);
+        const double v = variance[d] / (end - begin) - m * m;
+
+        if (v > best)
+        {
+            best = v;
+            axis = static_cast<int32_t>(d);
+        }
+    }
+
+    const uint32_t middle = begin + (end - begin) / 2;
+
+    std::nth_element(indices_.begin() + begin, indices_.begin() + middle, indices_.begin() + end,
+                     [&descriptors, axis](const uint32_t &a, const uint32_t &b)
+                     { return descriptors.row(a)[axis] < descriptors.row(b)[axis]; });
+
+    const float split = descriptors.row(indices_[middle])[axis];
+
+    const uint32_t left = build(descriptors, begin, middle);
+    const uint32_t right = build(descriptors, middle, end);
+
+    nodes_[node_index].left = left;
+    nodes_[node_index].right = right;
+    nodes_[node_index].split = split;
+    nodes_[node_index].axis = axis;
+
+    return node_index;
+}
+
+size_t DescriptorTree::size() const
+{
+    return indices_.size();
+}
+
+size_t DescriptorTree::dimension() const
+{
+    return dimension_;
+}
+
+bool DescriptorTree::empty() const
+{
+    return indices_.empty();
+}
+
+void DescriptorTree::knn(const float *query, const size_t &k,
+                         std::vector<uint32_t> &indices, std::vector<float> &sqr_distances) const
+{
+    knn(query, k, std::numeric_limits<size_t>::max(), indices, sqr_distances);
+}
+
+void DescriptorTree::knn(const float *query, const size_t &k, const size_t &max_leaves,
+                         std::vector<uint32_t> &indices, std::vector<float> &sqr_distances) const
+{
+    LRE_PROFILE_COUNT(Counter::QueriesIssued, 1);
+
+    indices.clear();
+    sqr_distances.clear();
+
+    if (nodes_.empty() || k == 0)
+    {
+        return;
+    }
+
+    std::vector<Candidate> heap;
+    heap.reserve(k + 1);
+
+    float worst = std::numeric_limits<float>::max();
+    size_t visited = 0;
+
+    // Best-bin-first: branches are explored in order of their lower-bound distance.
+    std::priority_queue<Branch> branches;
+    branches.push(Branch{0.0f, 0});
+
+    while (!branches.empty() && visited < max_leaves)
+    {
+        const Branch branch = branches.top();
+        branches.pop();
+
+        if (branch.sqr_distance > worst)
+        {
+            break;
+        }
+
+        uint32_t node_index = branch.node;
+
+        while (nodes_[node_index].left != kNoChild)
+        {
+            const Node &node = nodes_[node_index];
+            const float difference = query[node.axis] - node.split;
+            const float bound = std::max(branch.sqr_distance, difference * difference);
+
+            if (bound <= worst)
+            {
+                branches.push(Branch{bound, difference < 0.0f ? node.right : node.left});
+            }
+
+            node_index = difference < 0.0f ? node.left : node.right;
+        }
+
+        const Node &leaf = nodes_[node_index];
+        visited++;
+
+        for (uint32_t i = leaf.begin; i < leaf.end; i++)
+        {
+            const float distance = DescriptorSet::sqr_distance(query, &data_[i * dimension_], dimension_);
+
+            if (heap.size() < k)
+            {
+                heap.push_back(Candidate{distance, indices_[i]});
+                std::push_heap(heap.begin(), heap.end());
+            }
+            else if (distance < heap.front().sqr_distance)
+            {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = Candidate{distance, indices_[i]};
+                std::push_heap(heap.begin(), heap.end());
+            }
+
+            if (heap.size() == k)
+            {
+                worst = heap.front().sqr_distance;
+            }
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+
+    indices.reserve(heap.size());
+    sqr_distances.reserve(heap.size());
+
+    for (const Candidate &candidate : heap)
+    {
+        indices.push_back(candidate.index);
+        sqr_distances.push_back(candidate.sqr_distance);
+    }
+}
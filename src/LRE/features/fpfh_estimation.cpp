@@ -0,0 +1,493 @@
+#include <LRE/features/fpfh_estimation.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    constexpr size_t kPointGrain = 256;
+
+    constexpr float kPi = 3.14159265358979323846f;
+
+    struct PairScratch
+    {
+        std::vector<float> channels[6];
+        std::vector<float> features[3];
+        std::vector<uint8_t> valid;
+
+        void resize(const size_t &count)
+        {
+            for (std::vector<float> &channel : channels)
+            {
+                channel.resize(count);
+            }
+
+            for (std::vector<float> &feature : features)
+            {
+                feature.resize(count);
+            }
+
+            valid.resize(count);
+        }
+    };
+
+    int32_t bin_of(const float &value, const float &lower, const float &upper)
+    {
+        const int32_t bin = static_cast<int32_t>(std::floor(FpfhEstimation::kBins * (value - lower) / (upper - lower)));
+        return std::max(0, std::min(static_cast<int32_t>(FpfhEstimation::kBins) - 1, bin));
+    }
+
+#ifdef __AVX__
+    __m256 abs8(const __m256 &value)
+    {
+        return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value);
+    }
+
+    __m256 dot8(const __m256 a[3], const __m256 b[3])
+    {
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a[0], b[0]), _mm256_mul_ps(a[1], b[1])), _mm256_mul_ps(a[2], b[2]));
+    }
+
+    void cross8(const __m256 a[3], const __m256 b[3], __m256 out[3])
+    {
+        out[0] = _mm256_sub_ps(_mm256_mul_ps(a[1], b[2]), _mm256_mul_ps(a[2], b[1]));
+        out[1] = _mm256_sub_ps(_mm256_mul_ps(a[2], b[0]), _mm256_mul_ps(a[0], b[2]));
+        out[2] = _mm256_sub_ps(_mm256_mul_ps(a[0], b[1]), _mm256_mul_ps(a[1], b[0]));
+    }
+
+    // Minimax arctangent on [-1, 1] with octant folding; absolute error stays below 1e-5 rad.
+    __m256 atan2_8(const __m256 &y, const __m256 &x)
+    {
+        const __m256 ax = abs8(x);
+        const __m256 ay = abs8(y);
+        const __m256 swap = _mm256_cmp_ps(ay, ax, _CMP_GT_OQ);
+
+        const __m256 numerator = _mm256_min_ps(ax, ay);
+        const __m256 denominator = _mm256_max_ps(_mm256_max_ps(ax, ay), _mm256_set1_ps(1e-30f));
+        const __m256 t = _mm256_div_ps(numerator, denominator);
+        const __m256 t2 = _mm256_mul_ps(t, t);
+
+        __m256 polynomial = _mm256_set1_ps(-0.0117212f);
+        polynomial = _mm256_add_ps(_mm256_mul_ps(polynomial, t2), _mm256_set1_ps(0.05265332f));
+        polynomial = _mm256_add_ps(_mm256_mul_ps(polynomial, t2), _mm256_set1_ps(-0.11643287f));
+        polynomial = _mm256_add_ps(_mm256_mul_ps(polynomial, t2), _mm256_set1_ps(0.19354346f));
+        polynomial = _mm256_add_ps(_mm256_mul_ps(polynomial, t2), _mm256_set1_ps(-0.33262347f));
+        polynomial = _mm256_add_ps(_mm256_mul_ps(polynomial, t2), _mm256_set1_ps(0.99997726f));
+
+        __m256 angle = _mm256_mul_ps(polynomial, t);
+        angle = _mm256_blendv_ps(angle, _mm256_sub_ps(_mm256_set1_ps(0.5f * kPi), angle), swap);
+        angle = _mm256_blendv_ps(angle, _mm256_sub_ps(_mm256_set1_ps(kPi), angle), x);
+
+        return _mm256_or_ps(abs8(angle), _mm256_and_ps(_mm256_set1_ps(-0.0f), y));
+    }
+
+    void pair_features8(const float source[3], const float source_normal[3], const float *channels[6], PairScratch &scratch, const size_t &offset)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+
+        __m256 delta[3];
+        __m256 n1[3];
+        __m256 n2[3];
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            delta[c] = _mm256_sub_ps(_mm256_loadu_ps(channels[c] + offset), _mm256_set1_ps(source[c]));
+            n1[c] = _mm256_set1_ps(source_normal[c]);
+            n2[c] = _mm256_loadu_ps(channels[3 + c] + offset);
+        }
+
+        const __m256 length2 = dot8(delta, delta);
+        __m256 valid = _mm256_cmp_ps(length2, zero, _CMP_GT_OQ);
+        const __m256 inverse_length = _mm256_div_ps(one, _mm256_sqrt_ps(_mm256_max_ps(length2, _mm256_set1_ps(1e-30f))));
+
+        const __m256 angle1 = _mm256_mul_ps(dot8(n1, delta), inverse_length);
+        const __m256 angle2 = _mm256_mul_ps(dot8(n2, delta), inverse_length);
+
+        // Pick the source as the point whose normal makes the smaller angle with the connecting line.
+        const __m256 swap = _mm256_cmp_ps(abs8(angle1), abs8(angle2), _CMP_LT_OQ);
+
+        __m256 u[3];
+        __m256 other[3];
+        __m256 line[3];
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            u[c] = _mm256_blendv_ps(n1[c], n2[c], swap);
+            other[c] = _mm256_blendv_ps(n2[c], n1[c], swap);
+            line[c] = _mm256_blendv_ps(delta[c], _mm256_sub_ps(zero, delta[c]), swap);
+        }
+
+        const __m256 f3 = _mm256_blendv_ps(angle1, _mm256_sub_ps(zero, angle2), swap);
+
+        __m256 v[3];
+        cross8(line, u, v);
+
+        const __m256 v_length2 = dot8(v, v);
+        valid = _mm256_and_ps(valid, _mm256_cmp_ps(v_length2, _mm256_set1_ps(1e-30f), _CMP_GT_OQ));
+        const __m256 inverse_v = _mm256_div_ps(one, _mm256_sqrt_ps(_mm256_max_ps(v_length2, _mm256_set1_ps(1e-30f))));
+
+        for (__m256 &component : v)
+        {
+            component = _mm256_mul_ps(component, inverse_v);
+        }
+
+        __m256 w[3];
+        cross8(u, v, w);
+
+        const __m256 f2 = dot8(v, other);
+        const __m256 f1 = atan2_8(dot8(w, other), dot8(u, other));
+
+        _mm256_storeu_ps(scratch.features[0].data() + offset, f1);
+        _mm256_storeu_ps(scratch.features[1].data() + offset, f2);
+        _mm256_storeu_ps(scratch.features[2].data() + offset, f3);
+
+        const int32_t mask = _mm256_movemask_ps(valid);
+
+        for (int32_t lane = 0; lane < 8; lane++)
+        {
+            scratch.valid[offset + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+        }
+    }
+#endif
+
+    // Simplified point feature histogram of one point against its neighbours, each sub-histogram summing to 100.
+    void point_spfh(const PointCloud &cloud, const uint32_t &point, const uint32_t *neighbours, const size_t &count,
+                    PairScratch &scratch, float *histogram)
+    {
+        std::fill(histogram, histogram + FpfhEstimation::kDimension, 0.0f);
+
+        if (count == 0)
+        {
+            return;
+        }
+
+        scratch.resize(count);
+
+        const float *sources[6] = {cloud.x(), cloud.y(), cloud.z(), cloud.normal_x(), cloud.normal_y(), cloud.normal_z()};
+
+        for (int32_t c = 0; c < 6; c++)
+        {
+            float *channel = scratch.channels[c].data();
+
+            for (size_t k = 0; k < count; k++)
+            {
+                channel[k] = sources[c][neighbours[k]];
+            }
+        }
+
+        const float source[3] = {sources[0][point], sources[1][point], sources[2][point]};
+        const float source_normal[3] = {sources[3][point], sources[4][point], sources[5][point]};
+
+        size_t k = 0;
+
+#ifdef __AVX__
+        const float *channels[6] = {scratch.channels[0].data(), scratch.channels[1].data(), scratch.channels[2].data(),
+                                    scratch.channels[3].data(), scratch.channels[4].data(), scratch.channels[5].data()};
+
+        for (; k + 8 <= count; k += 8)
+        {
+            pair_features8(source, source_normal, channels, scratch, k);
+        }
+#endif
+
+        for (; k < count; k++)
+        {
+            float features[3];
+
+            scratch.valid[k] = FpfhEstimation::pair_features(
+                Vector4(source[0], source[1], source[2], 0.0f), Vector4(source_normal[0], source_normal[1], source_normal[2], 0.0f),
+                Vector4(scratch.channels[0][k], scratch.channels[1][k], scratch.channels[2][k], 0.0f),
+                Vector4(scratch.channels[3][k], scratch.channels[4][k], scratch.channels[5][k], 0.0f), features);
+
+            scratch.features[0][k] = features[0];
+            scratch.features[1][k] = features[1];
+            scratch.features[2][k] = features[2];
+        }
+
+        size_t valid = 0;
+
+        for (k = 0; k < count; k++)
+        {
+            if (!scratch.valid[k])
+            {
+                continue;
+            }
+
+            histogram[bin_of(scratch.features[0][k], -kPi, kPi)] += 1.0f;
+            histogram[FpfhEstimation::kBins + bin_of(scratch.features[1][k], -1.0f, 1.0f)] += 1.0f;
+            histogram[2 * FpfhEstimation::kBins + bin_of(scratch.features[2][k], -1.0f, 1.0f)] += 1.0f;
+            valid++;
+        }
+
+        if (valid > 0)
+        {
+            const float scale = 100.0f / static_cast<float>(valid);
+
+            for (size_t b = 0; b < FpfhEstimation::kDimension; b++)
+            {
+                histogram[b] *= scale;
+            }
+        }
+    }
+}
+
+FpfhEstimation::FpfhEstimation(const float &radius, const size_t &max_neighbours)
+    : radius_(std::max(0.0f, radius)), max_neighbours_(std::max<size_t>(1, max_neighbours))
+{
+}
+
+FpfhEstimation::FpfhEstimation(const float &radius) : FpfhEstimation(radius, 100)
+{
+}
+
+float FpfhEstimation::radius() const
+{
+    return radius_;
+}
+
+size_t FpfhEstimation::max_neighbours() const
+{
+    return max_neighbours_;
+}
+
+bool FpfhEstimation::pair_features(const Vector4 &source, const Vector4 &source_normal,
+                                   const Vector4 &target, const Vector4 &target_normal, float features[3])
+{
+    Vector4 line = target - source;
+    line[3] = 0.0f;
+
+    const float length = line.magnitude();
+
+    if (length <= 0.0f)
+    {
+        return false;
+    }
+
+    const float angle1 = Vector4::dot(source_normal, line) / length;
+    const float angle2 = Vector4::dot(target_normal, line) / length;
+
+    Vector4 u = source_normal;
+    Vector4 other = target_normal;
+    features[2] = angle1;
+
+    if (std::abs(angle1) < std::abs(angle2))
+    {
+        u = target_normal;
+        other = source_normal;
+        line = line * -1.0f;
+        features[2] = -angle2;
+    }
+
+    Vector4 v(line[1] * u[2] - line[2] * u[1], line[2] * u[0] - line[0] * u[2], line[0] * u[1] - line[1] * u[0], 0.0f);
+    const float v_length = v.magnitude();
+
+    if (v_length <= 1e-15f)
+    {
+        return false;
+    }
+
+    v = v * (1.0f / v_length);
+
+    const Vector4 w(u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0], 0.0f);
+
+    features[1] = Vector4::dot(v, other);
+    features[0] = std::atan2(Vector4::dot(w, other), Vector4::dot(u, other));
+
+    return true;
+}
+
+void FpfhEstimation::query_neighbours(const PointCloud &cloud, const KdTree &tree, const uint32_t *points, const size_t &count,
+                                      std::vector<uint32_t> &offsets, std::vector<uint32_t> &neighbours, ThreadPool &pool) const
+{
+    const size_t chunk_count = (count + kPointGrain - 1) / kPointGrain;
+
+    std::vector<std::vector<uint32_t>> chunk_neighbours(chunk_count);
+    std::vector<std::vector<uint32_t>> chunk_counts(chunk_count);
+
+    pool.parallel_for(0, count, kPointGrain, [&](const size_t &begin, const size_t &end)
+                      {
+                          const size_t chunk = begin / kPointGrain;
+
+                          std::vector<uint32_t> found;
+                          std::vector<float> sqr_distances;
+                          std::vector<std::pair<float, uint32_t>> ranked;
+
+                          for (size_t i = begin; i < end; i++)
+                          {
+                              const uint32_t point = points[i];
+                              tree.radius(cloud.point(point), radius_, found, sqr_distances);
+
+                              ranked.clear();
+
+                              for (size_t k = 0; k < found.size(); k++)
+                              {
+                                  if (found[k] != point)
+                                  {
+                                      ranked.emplace_back(sqr_distances[k], found[k]);
+                                  }
+                              }
+
+                              if (ranked.size() > max_neighbours_)
+                              {
+                                  std::nth_element(ranked.begin(), ranked.begin() + max_neighbours_, ranked.end());
+                                  ranked.resize(max_neighbours_);
+                              }
+
+                              chunk_counts[chunk].push_back(static_cast<uint32_t>(ranked.size()));
+
+                              for (const std::pair<float, uint32_t> &entry : ranked)
+                              {
+                                  chunk_neighbours[chunk].push_back(entry.second);
+                              }
+                          } });
+
+    for (size_t chunk = 0; chunk < chunk_count; chunk++)
+    {
+        for (const uint32_t neighbour_count : chunk_counts[chunk])
+        {
+            offsets.push_back(offsets.back() + neighbour_count);
+        }
+
+        neighbours.insert(neighbours.end(), chunk_neighbours[chunk].begin(), chunk_neighbours[chunk].end());
+    }
+}
+
+void FpfhEstimation::compute(const PointCloud &cloud, const KdTree &tree, const std::vector<uint32_t> &keypoints,
+                             DescriptorSet &descriptors, ThreadPool &pool) const
+{
+    LRE_PROFILE_SCOPE("FpfhEstimation::compute");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, keypoints.size());
+
+    if (!cloud.has_normals())
+    {
+        throw std::invalid_argument("FpfhEstimation: cloud has no normals");
+    }
+
+    descriptors.resize(keypoints.size(), kDimension);
+
+    if (keypoints.empty())
+    {
+        return;
+    }
+
+    // Every point gets one radius query; its neighbour list then serves both the SPFH and the weighting pass.
+    std::vector<uint32_t> offsets = {0};
+    std::vector<uint32_t> neighbours;
+    query_neighbours(cloud, tree, keypoints.data(), keypoints.size(), offsets, neighbours, pool);
+
+    std::vector<int32_t> slots(cloud.size(), -1);
+    std::vector<uint32_t> needed(keypoints.begin(), keypoints.end());
+
+    for (size_t i = 0; i < keypoints.size(); i++)
+    {
+        slots[keypoints[i]] = static_cast<int32_t>(i);
+    }
+
+    for (const uint32_t neighbour : neighbours)
+    {
+        if (slots[neighbour] < 0)
+        {
+            slots[neighbour] = static_cast<int32_t>(needed.size());
+            needed.push_back(neighbour);
+        }
+    }
+
+    if (needed.size() > keypoints.size())
+    {
+        query_neighbours(cloud, tree, needed.data() + keypoints.size(), needed.size() - keypoints.size(), offsets, neighbours, pool);
+    }
+
+    std::vector<float> spfh(needed.size() * kDimension);
+
+    pool.parallel_for(0, needed.size(), kPointGrain, [&](const size_t &begin, const size_t &end)
+                      {
+                          PairScratch scratch;
+
+                          for (size_t s = begin; s < end; s++)
+                          {
+                              point_spfh(cloud, needed[s], neighbours.data() + offsets[s], offsets[s + 1] - offsets[s],
+                                         scratch, spfh.data() + s * kDimension);
+                          } });
+
+    pool.parallel_for(0, keypoints.size(), kPointGrain, [&](const size_t &begin, const size_t &end)
+                      {
+                          float weighted[kDimension];
+
+                          for (size_t s = begin; s < end; s++)
+                          {
+                              std::fill(weighted, weighted + kDimension, 0.0f);
+
+                              const Vector4 point = cloud.point(keypoints[s]);
+
+                              for (uint32_t k = offsets[s]; k < offsets[s + 1]; k++)
+                              {
+                                  const uint32_t neighbour = neighbours[k];
+                                  const float distance = Vector4::distance(point, cloud.point(neighbour));
+
+                                  if (distance <= 0.0f)
+                                  {
+                                      continue;
+                                  }
+
+                                  const float weight = 1.0f / distance;
+                                  const float *histogram = spfh.data() + slots[neighbour] * kDimension;
+
+                                  for (size_t b = 0; b < kDimension; b++)
+                                  {
+                                      weighted[b] += weight * histogram[b];
+                                  }
+                              }
+
+                              const float *own = spfh.data() + s * kDimension;
+                              float *row = descriptors.row(s);
+
+                              for (size_t b = 0; b < kDimension; b++)
+                              {
+                                  row[b] = own[b] + weighted[b];
+                              }
+
+                              // Each angle histogram is rescaled to sum to 100 so descriptors stay comparable across densities.
+                              for (size_t h = 0; h < 3; h++)
+                              {
+                                  float sum = 0.0f;
+
+                                  for (size_t b = 0; b < kBins; b++)
+                                  {
+                                      sum += row[h * kBins + b];
+                                  }
+
+                                  if (sum > 0.0f)
+                                  {
+                                      for (size_t b = 0; b < kBins; b++)
+                                      {
+                                          row[h * kBins + b] *= 100.0f / sum;
+                                      }
+                                  }
+                              }
+                          } });
+}
+
+void FpfhEstimation::compute(const PointCloud &cloud, DescriptorSet &descriptors, ThreadPool &pool) const
+{
+    KdTree tree(cloud);
+    std::vector<uint32_t> keypoints(cloud.size());
+
+    for (uint32_t i = 0; i < keypoints.size(); i++)
+    {
+        keypoints[i] = i;
+    }
+
+    compute(cloud, tree, keypoints, descriptors, pool);
+}
+
+void FpfhEstimation::compute(const PointCloud &cloud, DescriptorSet &descriptors) const
+{
+    compute(cloud, descriptors, ThreadPool::shared());
+}
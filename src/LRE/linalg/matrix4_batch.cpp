@@ -0,0 +1,392 @@
+#include <LRE/linalg/matrix4_batch.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+namespace
+{
+    constexpr float kSingularDeterminant = 1e-6f;
+
+    struct ScalarLanes
+    {
+        using Type = float;
+
+        static constexpr size_t kWidth = 1;
+
+        static Type load(const float *source) { return *source; }
+
+        static Type broadcast(const float &value) { return value; }
+
+        static void store(float *destination, const Type &value) { *destination = value; }
+
+        static Type add(const Type &a, const Type &b) { return a + b; }
+
+        static Type sub(const Type &a, const Type &b) { return a - b; }
+
+        static Type mul(const Type &a, const Type &b) { return a * b; }
+
+        static Type div(const Type &a, const Type &b) { return a / b; }
+
+        static Type negate(const Type &a) { return -a; }
+
+        // Picks fallback where the determinant is too small to invert.
+        static Type select_singular(const Type &det, const Type &value, const Type &fallback)
+        {
+            return std::abs(det) < kSingularDeterminant ? fallback : value;
+        }
+    };
+
+#ifdef __AVX__
+
+    struct AvxLanes
+    {
+        using Type = __m256;
+
+        static constexpr size_t kWidth = 8;
+
+        static Type load(const float *source) { return _mm256_loadu_ps(source); }
+
+        static Type broadcast(const float &value) { return _mm256_set1_ps(value); }
+
+        static void store(float *destination, const Type &value) { _mm256_storeu_ps(destination, value); }
+
+        static Type add(const Type &a, const Type &b) { return _mm256_add_ps(a, b); }
+
+        static Type sub(const Type &a, const Type &b) { return _mm256_sub_ps(a, b); }
+
+        static Type mul(const Type &a, const Type &b) { return _mm256_mul_ps(a, b); }
+
+        static Type div(const Type &a, const Type &b) { return _mm256_div_ps(a, b); }
+
+        static Type negate(const Type &a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+
+        static Type select_singular(const Type &det, const Type &value, const Type &fallback)
+        {
+            const __m256 magnitude = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), det);
+            const __m256 singular = _mm256_cmp_ps(magnitude, _mm256_set1_ps(kSingularDeterminant), _CMP_LT_OQ);
+            return _mm256_blendv_ps(value, fallback, singular);
+        }
+    };
+
+    using Lanes = AvxLanes;
+
+#else
+
+    using Lanes = ScalarLanes;
+
+#endif
+
+    using Lane = Lanes::Type;
+
+    // Element e of matrix i sits at data[e * stride + i]; a zero stride repeats one row-major matrix in every lane.
+    struct Operand
+    {
+        const float *data;
+        size_t stride;
+    };
+
+    void load(const Operand &operand, const size_t &i, Lane lanes[16])
+    {
+        for (int32_t e = 0; e < 16; e++)
+        {
+            lanes[e] = operand.stride == 0 ? Lanes::broadcast(operand.data[e]) : Lanes::load(operand.data + e * operand.stride + i);
+        }
+    }
+
+    void store(float *data, const size_t &stride, const size_t &i, const Lane lanes[16])
+    {
+        for (int32_t e = 0; e < 16; e++)
+        {
+            Lanes::store(data + e * stride + i, lanes[e]);
+        }
+    }
+
+    // Sums in the same order as Matrix4::operator*, so every product matches it exactly.
+    void multiply(const Lane a[16], const Lane b[16], Lane c[16])
+    {
+        for (int32_t y = 0; y < 4; y++)
+        {
+            for (int32_t x = 0; x < 4; x++)
+            {
+                Lane sum = Lanes::mul(a[y * 4], b[x]);
+
+                for (int32_t k = 1; k < 4; k++)
+                {
+                    sum = Lanes::add(sum, Lanes::mul(a[y * 4 + k], b[k * 4 + x]));
+                }
+
+                c[y * 4 + x] = sum;
+            }
+        }
+    }
+
+    // Two-by-two minors of the upper (s) and lower (c) row pairs, as in Matrix4d.
+    void minors(const Lane a[16], Lane s[6], Lane c[6])
+    {
+        s[0] = Lanes::sub(Lanes::mul(a[0], a[5]), Lanes::mul(a[4], a[1]));
+        s[1] = Lanes::sub(Lanes::mul(a[0], a[6]), Lanes::mul(a[4], a[2]));
+        s[2] = Lanes::sub(Lanes::mul(a[0], a[7]), Lanes::mul(a[4], a[3]));
+        s[3] = Lanes::sub(Lanes::mul(a[1], a[6]), Lanes::mul(a[5], a[2]));
+        s[4] = Lanes::sub(Lanes::mul(a[1], a[7]), Lanes::mul(a[5], a[3]));
+        s[5] = Lanes::sub(Lanes::mul(a[2], a[7]), Lanes::mul(a[6], a[3]));
+
+        c[0] = Lanes::sub(Lanes::mul(a[8], a[13]), Lanes::mul(a[12], a[9]));
+        c[1] = Lanes::sub(Lanes::mul(a[8], a[14]), Lanes::mul(a[12], a[10]));
+        c[2] = Lanes::sub(Lanes::mul(a[8], a[15]), Lanes::mul(a[12], a[11]));
+        c[3] = Lanes::sub(Lanes::mul(a[9], a[14]), Lanes::mul(a[13], a[10]));
+        c[4] = Lanes::sub(Lanes::mul(a[9], a[15]), Lanes::mul(a[13], a[11]));
+        c[5] = Lanes::sub(Lanes::mul(a[10], a[15]), Lanes::mul(a[14], a[11]));
+    }
+
+    Lane determinant(const Lane s[6], const Lane c[6])
+    {
+        Lane det = Lanes::mul(s[0], c[5]);
+        det = Lanes::sub(det, Lanes::mul(s[1], c[4]));
+        det = Lanes::add(det, Lanes::mul(s[2], c[3]));
+        det = Lanes::add(det, Lanes::mul(s[3], c[2]));
+        det = Lanes::sub(det, Lanes::mul(s[4], c[1]));
+        return Lanes::add(det, Lanes::mul(s[5], c[0]));
+    }
+
+    // a * x - b * y + c * z
+    Lane combine(const Lane &a, const Lane &x, const Lane &b, const Lane &y, const Lane &c, const Lane &z)
+    {
+        return Lanes::add(Lanes::sub(Lanes::mul(a, x), Lanes::mul(b, y)), Lanes::mul(c, z));
+    }
+
+    void invert(const Lane a[16], Lane b[16])
+    {
+        Lane s[6];
+        Lane c[6];
+        minors(a, s, c);
+
+        const Lane det = determinant(s, c);
+        const Lane inverse_det = Lanes::div(Lanes::broadcast(1.0f), det);
+
+        b[0] = combine(a[5], c[5], a[6], c[4], a[7], c[3]);
+        b[1] = Lanes::negate(combine(a[1], c[5], a[2], c[4], a[3], c[3]));
+        b[2] = combine(a[13], s[5], a[14], s[4], a[15], s[3]);
+        b[3] = Lanes::negate(combine(a[9], s[5], a[10], s[4], a[11], s[3]));
+
+        b[4] = Lanes::negate(combine(a[4], c[5], a[6], c[2], a[7], c[1]));
+        b[5] = combine(a[0], c[5], a[2], c[2], a[3], c[1]);
+        b[6] = Lanes::negate(combine(a[12], s[5], a[14], s[2], a[15], s[1]));
+        b[7] = combine(a[8], s[5], a[10], s[2], a[11], s[1]);
+
+        b[8] = combine(a[4], c[4], a[5], c[2], a[7], c[0]);
+        b[9] = Lanes::negate(combine(a[0], c[4], a[1], c[2], a[3], c[0]));
+        b[10] = combine(a[12], s[4], a[13], s[2], a[15], s[0]);
+        b[11] = Lanes::negate(combine(a[8], s[4], a[9], s[2], a[11], s[0]));
+
+        b[12] = Lanes::negate(combine(a[4], c[3], a[5], c[1], a[6], c[0]));
+        b[13] = combine(a[0], c[3], a[1], c[1], a[2], c[0]);
+        b[14] = Lanes::negate(combine(a[12], s[3], a[13], s[1], a[14], s[0]));
+        b[15] = combine(a[8], s[3], a[9], s[1], a[10], s[0]);
+
+        for (int32_t e = 0; e < 16; e++)
+        {
+            b[e] = Lanes::select_singular(det, Lanes::mul(b[e], inverse_det), a[e]);
+        }
+    }
+
+    // Lanes past the last full vector only ever hold the zero padding.
+    size_t lane_end(const size_t &size)
+    {
+        return (size + Lanes::kWidth - 1) / Lanes::kWidth * Lanes::kWidth;
+    }
+
+    size_t padded(const size_t &size)
+    {
+        return (size + Matrix4Batch::kLanes - 1) / Matrix4Batch::kLanes * Matrix4Batch::kLanes;
+    }
+
+    Operand shared(const Matrix4 &matrix)
+    {
+        return Operand{&matrix[0], 0};
+    }
+}
+
+Matrix4Batch::Matrix4Batch() : size_(0), stride_(0)
+{
+}
+
+Matrix4Batch::Matrix4Batch(const size_t &size) : size_(size), stride_(padded(size)), data_(16 * padded(size), 0.0f)
+{
+}
+
+Matrix4Batch::Matrix4Batch(const std::vector<Matrix4> &matrices) : Matrix4Batch(matrices.size())
+{
+    for (size_t i = 0; i < size_; i++)
+    {
+        set_matrix(i, matrices[i]);
+    }
+}
+
+size_t Matrix4Batch::size() const
+{
+    return size_;
+}
+
+bool Matrix4Batch::empty() const
+{
+    return size_ == 0;
+}
+
+size_t Matrix4Batch::stride() const
+{
+    return stride_;
+}
+
+float *Matrix4Batch::element(const int32_t &index)
+{
+    return data_.data() + std::max(0, std::min(index, 15)) * stride_;
+}
+
+const float *Matrix4Batch::element(const int32_t &index) const
+{
+    return data_.data() + std::max(0, std::min(index, 15)) * stride_;
+}
+
+Matrix4 Matrix4Batch::matrix(const size_t &index) const
+{
+    Matrix4 result;
+
+    for (int32_t e = 0; e < 16; e++)
+    {
+        result[e] = data_[e * stride_ + index];
+    }
+
+    return result;
+}
+
+void Matrix4Batch::set_matrix(const size_t &index, const Matrix4 &matrix)
+{
+    for (int32_t e = 0; e < 16; e++)
+    {
+        data_[e * stride_ + index] = matrix[e];
+    }
+}
+
+std::vector<Matrix4> Matrix4Batch::to_matrices() const
+{
+    std::vector<Matrix4> matrices(size_);
+
+    for (size_t i = 0; i < size_; i++)
+    {
+        matrices[i] = matrix(i);
+    }
+
+    return matrices;
+}
+
+std::vector<float> Matrix4Batch::determinants() const
+{
+    LRE_PROFILE_SCOPE("Matrix4Batch::determinants");
+
+    std::vector<float> result(stride_);
+    const Operand source{data_.data(), stride_};
+
+    for (size_t i = 0; i < lane_end(size_); i += Lanes::kWidth)
+    {
+        Lane a[16];
+        Lane s[6];
+        Lane c[6];
+
+        load(source, i, a);
+        minors(a, s, c);
+        Lanes::store(&result[i], determinant(s, c));
+    }
+
+    result.resize(size_);
+    return result;
+}
+
+Matrix4Batch Matrix4Batch::inverted() const
+{
+    LRE_PROFILE_SCOPE("Matrix4Batch::inverted");
+
+    Matrix4Batch result(size_);
+    const Operand source{data_.data(), stride_};
+
+    for (size_t i = 0; i < lane_end(size_); i += Lanes::kWidth)
+    {
+        Lane a[16];
+        Lane b[16];
+
+        load(source, i, a);
+        invert(a, b);
+        store(result.data_.data(), stride_, i, b);
+    }
+
+    return result;
+}
+
+Matrix4Batch Matrix4Batch::operator*(const Matrix4Batch &other) const
+{
+    LRE_PROFILE_SCOPE("Matrix4Batch::multiply");
+
+    if (other.size_ != size_)
+    {
+        throw std::invalid_argument("Matrix4Batch: batch sizes do not match");
+    }
+
+    Matrix4Batch result(size_);
+    const Operand left{data_.data(), stride_};
+    const Operand right{other.data_.data(), other.stride_};
+
+    for (size_t i = 0; i < lane_end(size_); i += Lanes::kWidth)
+    {
+        Lane a[16];
+        Lane b[16];
+        Lane c[16];
+
+        load(left, i, a);
+        load(right, i, b);
+        multiply(a, b, c);
+        store(result.data_.data(), stride_, i, c);
+    }
+
+    return result;
+}
+
+Matrix4Batch Matrix4Batch::operator*(const Matrix4 &matrix) const
+{
+    LRE_PROFILE_SCOPE("Matrix4Batch::multiply");
+
+    Matrix4Batch result(size_);
+    const Operand left{data_.data(), stride_};
+    Lane b[16];
+    load(shared(matrix), 0, b);
+
+    for (size_t i = 0; i < lane_end(size_); i += Lanes::kWidth)
+    {
+        Lane a[16];
+        Lane c[16];
+
+        load(left, i, a);
+        multiply(a, b, c);
+        store(result.data_.data(), stride_, i, c);
+    }
+
+    return result;
+}
+
+Matrix4Batch Matrix4Batch::premultiplied(const Matrix4 &matrix) const
+{
+    LRE_PROFILE_SCOPE("Matrix4Batch::multiply");
+
+    Matrix4Batch result(size_);
+    const Operand right{data_.data(), stride_};
+    Lane a[16];
+    load(shared(matrix), 0, a);
+
+    for (size_t i = 0; i < lane_end(size_); i += Lanes::kWidth)
+    {
+        Lane b[16];
+        Lane c[16];
+
+        load(right, i, b);
+        multiply(a, b, c);
+        store(result.data_.data(), stride_, i, c);
+    }
+
+    return result;
+}
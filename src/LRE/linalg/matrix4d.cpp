@@ -0,0 +1,302 @@
+#include <LRE/linalg/matrix4d.hpp>
+
+namespace
+{
+    constexpr double kSingularDeterminant = 1e-12;
+
+    // Two-by-two minors of the upper (s) and lower (c) row pairs.
+    void minors(const double *a, double s[6], double c[6])
+    {
+        s[0] = a[0] * a[5] - a[4] * a[1];
+        s[1] = a[0] * a[6] - a[4] * a[2];
+        s[2] = a[0] * a[7] - a[4] * a[3];
+        s[3] = a[1] * a[6] - a[5] * a[2];
+        s[4] = a[1] * a[7] - a[5] * a[3];
+        s[5] = a[2] * a[7] - a[6] * a[3];
+
+        c[0] = a[8] * a[13] - a[12] * a[9];
+        c[1] = a[8] * a[14] - a[12] * a[10];
+        c[2] = a[8] * a[15] - a[12] * a[11];
+        c[3] = a[9] * a[14] - a[13] * a[10];
+        c[4] = a[9] * a[15] - a[13] * a[11];
+        c[5] = a[10] * a[15] - a[14] * a[11];
+    }
+}
+
+Matrix4d::Matrix4d(const Matrix4 &other)
+{
+#ifdef __AVX__
+
+    for (int32_t i = 0; i < 16; i += 4)
+    {
+        _mm256_storeu_pd(&data_[i], _mm256_cvtps_pd(_mm_loadu_ps(&other[i])));
+    }
+
+#else
+
+    for (int32_t i = 0; i < 16; i++)
+    {
+        data_[i] = other[i];
+    }
+
+#endif
+}
+
+Matrix4d::Matrix4d(const Matrix4d &other)
+{
+    std::memcpy(data_, other.data_, sizeof(data_));
+}
+
+Matrix4d::Matrix4d()
+{
+    std::memset(data_, 0, sizeof(data_));
+}
+
+double &Matrix4d::operator[](const int32_t &index)
+{
+    return data_[std::max(0, std::min(index, 15))];
+}
+
+const double &Matrix4d::operator[](const int32_t &index) const
+{
+    return data_[std::max(0, std::min(index, 15))];
+}
+
+void Matrix4d::identity()
+{
+    std::memset(data_, 0, sizeof(data_));
+    data_[0] = 1.0;
+    data_[5] = 1.0;
+    data_[10] = 1.0;
+    data_[15] = 1.0;
+}
+
+double Matrix4d::determinant() const
+{
+    double s[6];
+    double c[6];
+    minors(data_, s, c);
+
+    return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+}
+
+Matrix4d Matrix4d::transposed() const
+{
+    Matrix4d result;
+
+    for (int32_t y = 0; y < 4; y++)
+    {
+        for (int32_t x = 0; x < 4; x++)
+        {
+            result.data_[x * 4 + y] = data_[y * 4 + x];
+        }
+    }
+
+    return result;
+}
+
+Matrix4d Matrix4d::inverted() const
+{
+    const double *a = data_;
+
+    double s[6];
+    double c[6];
+    minors(a, s, c);
+
+    const double det = s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+
+    if (std::abs(det) < kSingularDeterminant)
+    {
+        return *this;
+    }
+
+    Matrix4d result;
+    double *b = result.data_;
+
+    b[0] = a[5] * c[5] - a[6] * c[4] + a[7] * c[3];
+    b[1] = -a[1] * c[5] + a[2] * c[4] - a[3] * c[3];
+    b[2] = a[13] * s[5] - a[14] * s[4] + a[15] * s[3];
+    b[3] = -a[9] * s[5] + a[10] * s[4] - a[11] * s[3];
+
+    b[4] = -a[4] * c[5] + a[6] * c[2] - a[7] * c[1];
+    b[5] = a[0] * c[5] - a[2] * c[2] + a[3] * c[1];
+    b[6] = -a[12] * s[5] + a[14] * s[2] - a[15] * s[1];
+    b[7] = a[8] * s[5] - a[10] * s[2] + a[11] * s[1];
+
+    b[8] = a[4] * c[4] - a[5] * c[2] + a[7] * c[0];
+    b[9] = -a[0] * c[4] + a[1] * c[2] - a[3] * c[0];
+    b[10] = a[12] * s[4] - a[13] * s[2] + a[15] * s[0];
+    b[11] = -a[8] * s[4] + a[9] * s[2] - a[11] * s[0];
+
+    b[12] = -a[4] * c[3] + a[5] * c[1] - a[6] * c[0];
+    b[13] = a[0] * c[3] - a[1] * c[1] + a[2] * c[0];
+    b[14] = -a[12] * s[3] + a[13] * s[1] - a[14] * s[0];
+    b[15] = a[8] * s[3] - a[9] * s[1] + a[10] * s[0];
+
+    return result * (1.0 / det);
+}
+
+Matrix4 Matrix4d::to_float() const
+{
+    Matrix4 result;
+
+#ifdef __AVX__
+
+    for (int32_t i = 0; i < 16; i += 4)
+    {
+        _mm_storeu_ps(&result[i], _mm256_cvtpd_ps(_mm256_loadu_pd(&data_[i])));
+    }
+
+#else
+
+    for (int32_t i = 0; i < 16; i++)
+    {
+        result[i] = static_cast<float>(data_[i]);
+    }
+
+#endif
+
+    return result;
+}
+
+Matrix4d Matrix4d::operator*(const Matrix4d &other) const
+{
+    Matrix4d result;
+
+#ifdef __AVX__
+
+    const __m256d row0 = _mm256_loadu_pd(&other.data_[0]);
+    const __m256d row1 = _mm256_loadu_pd(&other.data_[4]);
+    const __m256d row2 = _mm256_loadu_pd(&other.data_[8]);
+    const __m256d row3 = _mm256_loadu_pd(&other.data_[12]);
+
+    for (int32_t y = 0; y < 4; y++)
+    {
+        const double *row = &data_[y * 4];
+
+        __m256d sum = _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(row[0]), row0),
+                                    _mm256_mul_pd(_mm256_set1_pd(row[1]), row1));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(row[2]), row2));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(row[3]), row3));
+
+        _mm256_storeu_pd(&result.data_[y * 4], sum);
+    }
+
+#else
+
+    for (int32_t y = 0; y < 4; y++)
+    {
+        for (int32_t x = 0; x < 4; x++)
+        {
+            double sum = data_[y * 4] * other.data_[x] + data_[y * 4 + 1] * other.data_[4 + x];
+            sum += data_[y * 4 + 2] * other.data_[8 + x];
+            sum += data_[y * 4 + 3] * other.data_[12 + x];
+
+            result.data_[y * 4 + x] = sum;
+        }
+    }
+
+#endif
+
+    return result;
+}
+
+Vector4d Matrix4d::operator*(const Vector4d &vector) const
+{
+    Vector4d result;
+
+    for (int32_t y = 0; y < 4; y++)
+    {
+        result[y] = (data_[y * 4] * vector[0] + data_[y * 4 + 2] * vector[2]) +
+                    (data_[y * 4 + 1] * vector[1] + data_[y * 4 + 3] * vector[3]);
+    }
+
+    return result;
+}
+
+Matrix4d Matrix4d::operator*(const double &scalar) const
+{
+    Matrix4d result;
+
+#ifdef __AVX__
+
+    const __m256d constant = _mm256_set1_pd(scalar);
+
+    for (int32_t i = 0; i < 16; i += 4)
+    {
+        _mm256_storeu_pd(&result.data_[i], _mm256_mul_pd(_mm256_loadu_pd(&data_[i]), constant));
+    }
+
+#else
+
+    for (int32_t i = 0; i < 16; i++)
+    {
+        result.data_[i] = data_[i] * scalar;
+    }
+
+#endif
+
+    return result;
+}
+
+Matrix4d Matrix4d::operator+(const Matrix4d &other) const
+{
+    Matrix4d result;
+
+#ifdef __AVX__
+
+    for (int32_t i = 0; i < 16; i += 4)
+    {
+        _mm256_storeu_pd(&result.data_[i], _mm256_add_pd(_mm256_loadu_pd(&data_[i]), _mm256_loadu_pd(&other.data_[i])));
+    }
+
+#else
+
+    for (int32_t i = 0; i < 16; i++)
+    {
+        result.data_[i] = data_[i] + other.data_[i];
+    }
+
+#endif
+
+    return result;
+}
+
+Matrix4d Matrix4d::operator-(const Matrix4d &other) const
+{
+    Matrix4d result;
+
+#ifdef __AVX__
+
+    for (int32_t i = 0; i < 16; i += 4)
+    {
+        _mm256_storeu_pd(&result.data_[i], _mm256_sub_pd(_mm256_loadu_pd(&data_[i]), _mm256_loadu_pd(&other.data_[i])));
+    }
+
+#else
+
+    for (int32_t i = 0; i < 16; i++)
+    {
+        result.data_[i] = data_[i] - other.data_[i];
+    }
+
+#endif
+
+    return result;
+}
+
+Matrix4d &Matrix4d::operator=(const Matrix4d &other)
+{
+    std::memcpy(data_, other.data_, sizeof(data_));
+    return *this;
+}
+
+Matrix4d Matrix4d::translation(const Vector4d &offset)
+{
+    Matrix4d result;
+    result.identity();
+    result.data_[3] = offset[0];
+    result.data_[7] = offset[1];
+    result.data_[11] = offset[2];
+    return result;
+}
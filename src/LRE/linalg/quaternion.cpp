@@ -0,0 +1,457 @@
+#include <LRE/linalg/quaternion.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+Quaternion::Quaternion(const float &x, const float &y, const float &z, const float &w)
+{
+    data_[0] = x;
+    data_[1] = y;
+    data_[2] = z;
+    data_[3] = w;
+}
+
+Quaternion::Quaternion(const Quaternion &other)
+{
+    std::memcpy(data_, other.data_, sizeof(data_));
+}
+
+Quaternion::Quaternion()
+{
+    data_[0] = 0.0f;
+    data_[1] = 0.0f;
+    data_[2] = 0.0f;
+    data_[3] = 1.0f;
+}
+
+float &Quaternion::x()
+{
+    return data_[0];
+}
+
+float &Quaternion::y()
+{
+    return data_[1];
+}
+
+float &Quaternion::z()
+{
+    return data_[2];
+}
+
+float &Quaternion::w()
+{
+    return data_[3];
+}
+
+float &Quaternion::operator[](const int32_t &index)
+{
+    int32_t clamped_index = std::max(0, std::min(index, 3));
+    return data_[clamped_index];
+}
+
+const float &Quaternion::operator[](const int32_t &index) const
+{
+    int32_t clamped_index = std::max(0, std::min(index, 3));
+    return data_[clamped_index];
+}
+
+Quaternion &Quaternion::operator=(const Quaternion &other)
+{
+    std::memcpy(data_, other.data_, sizeof(data_));
+    return *this;
+}
+
+float Quaternion::magnitude() const
+{
+    return std::sqrt(dot(*this, *this));
+}
+
+Quaternion Quaternion::normalized() const
+{
+    float length = magnitude();
+
+    if (length <= 1e-6f)
+    {
+        return Quaternion();
+    }
+
+    Quaternion result;
+
+#ifdef __AVX__
+
+    __m128 reg_a = _mm_loadu_ps(data_);
+    __m128 reg_b = _mm_set_ps1(1.0f / length);
+    _mm_storeu_ps(result.data_, _mm_mul_ps(reg_a, reg_b));
+
+#else
+
+    float inverse_length = 1.0f / length;
+
+    result.data_[0] = data_[0] * inverse_length;
+    result.data_[1] = data_[1] * inverse_length;
+    result.data_[2] = data_[2] * inverse_length;
+    result.data_[3] = data_[3] * inverse_length;
+
+#endif
+
+    return result;
+}
+
+Quaternion Quaternion::conjugate() const
+{
+    Quaternion result;
+
+#ifdef __AVX__
+
+    __m128 reg_a = _mm_loadu_ps(data_);
+    __m128 sign = _mm_setr_ps(-0.0f, -0.0f, -0.0f, 0.0f);
+    _mm_storeu_ps(result.data_, _mm_xor_ps(reg_a, sign));
+
+#else
+
+    result.data_[0] = -data_[0];
+    result.data_[1] = -data_[1];
+    result.data_[2] = -data_[2];
+    result.data_[3] = data_[3];
+
+#endif
+
+    return result;
+}
+
+Quaternion Quaternion::inverted() const
+{
+    float sqr_length = dot(*this, *this);
+
+    if (sqr_length < 1e-12f)
+    {
+        return *this;
+    }
+
+    Quaternion result = conjugate();
+
+    if (std::abs(sqr_length - 1.0f) > 1e-6f)
+    {
+        float inverse_sqr_length = 1.0f / sqr_length;
+
+        for (int32_t i = 0; i < 4; i++)
+        {
+            result.data_[i] *= inverse_sqr_length;
+        }
+    }
+
+    return result;
+}
+
+Quaternion Quaternion::operator*(const Quaternion &other) const
+{
+    Quaternion result;
+
+#ifdef __AVX__
+
+    __m128 reg_b = _mm_loadu_ps(other.data_);
+
+    __m128 term_w = _mm_mul_ps(_mm_set_ps1(data_[3]), reg_b);
+
+    __m128 term_x = _mm_mul_ps(_mm_set_ps1(data_[0]), _mm_shuffle_ps(reg_b, reg_b, _MM_SHUFFLE(0, 1, 2, 3)));
+    term_x = _mm_xor_ps(term_x, _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f));
+
+    __m128 term_y = _mm_mul_ps(_mm_set_ps1(data_[1]), _mm_shuffle_ps(reg_b, reg_b, _MM_SHUFFLE(1, 0, 3, 2)));
+    term_y = _mm_xor_ps(term_y, _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f));
+
+    __m128 term_z = _mm_mul_ps(_mm_set_ps1(data_[2]), _mm_shuffle_ps(reg_b, reg_b, _MM_SHUFFLE(2, 3, 0, 1)));
+    term_z = _mm_xor_ps(term_z, _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f));
+
+    // Summed in the scalar order so both paths round identically.
+    __m128 sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(term_w, term_x), term_y), term_z);
+    _mm_storeu_ps(result.data_, sum);
+
+#else
+
+    const float ax = data_[0], ay = data_[1], az = data_[2], aw = data_[3];
+    const float bx = other.data_[0], by = other.data_[1], bz = other.data_[2], bw = other.data_[3];
+
+    result.data_[0] = aw * bx + ax * bw + ay * bz - az * by;
+    result.data_[1] = aw * by - ax * bz + ay * bw + az * bx;
+    result.data_[2] = aw * bz + ax * by - ay * bx + az * bw;
+    result.data_[3] = aw * bw - ax * bx - ay * by - az * bz;
+
+#endif
+
+    return result;
+}
+
+Matrix4 Quaternion::to_matrix() const
+{
+    Matrix4 result;
+
+#ifdef __AVX__
+
+    // Lane i of a row is 2 * (a * b +/- c * d) off the diagonal and 1 - 2 * (a * b + c * d) on it.
+    const __m128 reg_q = _mm_loadu_ps(data_);
+    const __m128 one = _mm_set_ps1(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    auto doubled = [](const __m128 &a, const __m128 &b, const __m128 &c, const __m128 &d, const __m128 &sign)
+    {
+        const __m128 sum = _mm_add_ps(_mm_mul_ps(a, b), _mm_xor_ps(_mm_mul_ps(c, d), sign));
+        return _mm_add_ps(sum, sum);
+    };
+
+    const __m128 row_0 = doubled(_mm_shuffle_ps(reg_q, reg_q, _MM_SHUFFLE(0, 0, 0, 1)), _mm_shuffle_ps(reg_q, reg_q, _MM_SHUFFLE(0, 2, 1, 1)),
+                                 _mm_shuffle_ps(reg_q, reg_q, _MM_SHUFFLE(0, 1, 2, 2)), _mm_shuffle_ps(reg_q, reg_q, _MM_SHUFFLE(0, 3, 3, 2)),
+                                 _mm_setr_ps(0.0f, -0.0f, 0.0f, 0.0f));
+    const __m128 row_1 = doubled(_mm_shuffle_ps(reg_q, reg_q, _MM_SHUFFLE(0, 1, 0, 0)), _mm_shuffle_ps(reg_q, reg_q, _MM_SHUFFLE(0, 2, 0, 1)),
+                                 _mm_shuffle_ps(reg_q, reg_q, _MM_SHUFFLE(0, 0, 2, 2)), _mm_shuffle_ps(reg_q, reg_q, _MM_SHUFFLE(0, 3, 2, 3)),
+                                 _mm_setr_ps(0.0f, 0.0f, -0.0f, 0.0f));
+    const __m128 row_2 = doubled(_mm_shuffle_ps(reg_q, reg_q, _MM_SHUFFLE(0, 0, 1, 0)), _mm_shuffle_ps(reg_q, reg_q, _MM_SHUFFLE(0, 0, 2, 2)),
+                                 _mm_shuffle_ps(reg_q, reg_q, _MM_SHUFFLE(0, 1, 0, 1)), _mm_shuffle_ps(reg_q, reg_q, _MM_SHUFFLE(0, 1, 3, 3)),
+                                 _mm_setr_ps(-0.0f, 0.0f, 0.0f, 0.0f));
+
+    _mm_storeu_ps(&result[0], _mm_blend_ps(_mm_blend_ps(row_0, _mm_sub_ps(one, row_0), 0x1), zero, 0x8));
+    _mm_storeu_ps(&result[4], _mm_blend_ps(_mm_blend_ps(row_1, _mm_sub_ps(one, row_1), 0x2), zero, 0x8));
+    _mm_storeu_ps(&result[8], _mm_blend_ps(_mm_blend_ps(row_2, _mm_sub_ps(one, row_2), 0x4), zero, 0x8));
+
+    result[15] = 1.0f;
+
+#else
+
+    const float x = data_[0];
+    const float y = data_[1];
+    const float z = data_[2];
+    const float w = data_[3];
+
+    result[0] = 1.0f - 2.0f * (y * y + z * z);
+    result[1] = 2.0f * (x * y - z * w);
+    result[2] = 2.0f * (x * z + y * w);
+
+    result[4] = 2.0f * (x * y + z * w);
+    result[5] = 1.0f - 2.0f * (x * x + z * z);
+    result[6] = 2.0f * (y * z - x * w);
+
+    result[8] = 2.0f * (x * z - y * w);
+    result[9] = 2.0f * (y * z + x * w);
+    result[10] = 1.0f - 2.0f * (x * x + y * y);
+
+    result[15] = 1.0f;
+
+#endif
+
+    return result;
+}
+
+Vector4 Quaternion::rotate(const Vector4 &point) const
+{
+    Vector4 result;
+
+#ifdef __AVX__
+
+    // v' = v + w * t + q_xyz x t, where t = 2 * (q_xyz x v)
+    __m128 reg_q = _mm_loadu_ps(data_);
+    __m128 reg_axis = _mm_blend_ps(reg_q, _mm_setzero_ps(), 0x8);
+    __m128 reg_v = _mm_loadu_ps(&point[0]);
+
+    __m128 axis_yzx = _mm_shuffle_ps(reg_axis, reg_axis, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 axis_zxy = _mm_shuffle_ps(reg_axis, reg_axis, _MM_SHUFFLE(3, 1, 0, 2));
+
+    __m128 v_yzx = _mm_shuffle_ps(reg_v, reg_v, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 v_zxy = _mm_shuffle_ps(reg_v, reg_v, _MM_SHUFFLE(3, 1, 0, 2));
+
+    __m128 reg_t = _mm_sub_ps(_mm_mul_ps(axis_yzx, v_zxy), _mm_mul_ps(axis_zxy, v_yzx));
+    reg_t = _mm_add_ps(reg_t, reg_t);
+
+    __m128 t_yzx = _mm_shuffle_ps(reg_t, reg_t, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 t_zxy = _mm_shuffle_ps(reg_t, reg_t, _MM_SHUFFLE(3, 1, 0, 2));
+
+    __m128 cross = _mm_sub_ps(_mm_mul_ps(axis_yzx, t_zxy), _mm_mul_ps(axis_zxy, t_yzx));
+    __m128 scaled = _mm_mul_ps(_mm_shuffle_ps(reg_q, reg_q, _MM_SHUFFLE(3, 3, 3, 3)), reg_t);
+
+    // (v + w * t) + q_xyz x t like the scalar path; w passes through untouched.
+    __m128 rotated = _mm_add_ps(_mm_add_ps(reg_v, scaled), cross);
+    _mm_storeu_ps(&result[0], _mm_blend_ps(rotated, reg_v, 0x8));
+
+#else
+
+    const float x = data_[0];
+    const float y = data_[1];
+    const float z = data_[2];
+    const float w = data_[3];
+
+    // v' = v + w * t + q_xyz x t, where t = 2 * (q_xyz x v)
+    const float tx = 2.0f * (y * point[2] - z * point[1]);
+    const float ty = 2.0f * (z * point[0] - x * point[2]);
+    const float tz = 2.0f * (x * point[1] - y * point[0]);
+
+    result[0] = point[0] + w * tx + (y * tz - z * ty);
+    result[1] = point[1] + w * ty + (z * tx - x * tz);
+    result[2] = point[2] + w * tz + (x * ty - y * tx);
+    result[3] = point[3];
+
+#endif
+
+    return result;
+}
+
+void Quaternion::rotate_points(const float *x, const float *y, const float *z,
+                               float *out_x, float *out_y, float *out_z, const size_t &count) const
+{
+    LRE_PROFILE_SCOPE("Quaternion::rotate_points");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, count);
+
+    const Matrix4 rotation = to_matrix();
+
+    size_t i = 0;
+
+#ifdef __AVX__
+
+    const __m256 r00 = _mm256_set1_ps(rotation[0]), r01 = _mm256_set1_ps(rotation[1]), r02 = _mm256_set1_ps(rotation[2]);
+    const __m256 r10 = _mm256_set1_ps(rotation[4]), r11 = _mm256_set1_ps(rotation[5]), r12 = _mm256_set1_ps(rotation[6]);
+    const __m256 r20 = _mm256_set1_ps(rotation[8]), r21 = _mm256_set1_ps(rotation[9]), r22 = _mm256_set1_ps(rotation[10]);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 px = _mm256_loadu_ps(&x[i]);
+        const __m256 py = _mm256_loadu_ps(&y[i]);
+        const __m256 pz = _mm256_loadu_ps(&z[i]);
+
+        const __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r00, px), _mm256_mul_ps(r01, py)), _mm256_mul_ps(r02, pz));
+        const __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r10, px), _mm256_mul_ps(r11, py)), _mm256_mul_ps(r12, pz));
+        const __m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r20, px), _mm256_mul_ps(r21, py)), _mm256_mul_ps(r22, pz));
+
+        _mm256_storeu_ps(&out_x[i], rx);
+        _mm256_storeu_ps(&out_y[i], ry);
+        _mm256_storeu_ps(&out_z[i], rz);
+    }
+
+#endif
+
+    for (; i < count; i++)
+    {
+        const float px = x[i];
+        const float py = y[i];
+        const float pz = z[i];
+
+        out_x[i] = rotation[0] * px + rotation[1] * py + rotation[2] * pz;
+        out_y[i] = rotation[4] * px + rotation[5] * py + rotation[6] * pz;
+        out_z[i] = rotation[8] * px + rotation[9] * py + rotation[10] * pz;
+    }
+}
+
+float Quaternion::dot(const Quaternion &a, const Quaternion &b)
+{
+
+#ifdef __AVX__
+
+    __m128 reg_a = _mm_loadu_ps(a.data_);
+    __m128 reg_b = _mm_loadu_ps(b.data_);
+
+    __m128 reg_mul = _mm_mul_ps(reg_a, reg_b);
+
+    // Left to right like the scalar path, so both round identically.
+    __m128 sums = _mm_add_ss(reg_mul, _mm_movehdup_ps(reg_mul));
+    sums = _mm_add_ss(sums, _mm_movehl_ps(reg_mul, reg_mul));
+    sums = _mm_add_ss(sums, _mm_shuffle_ps(reg_mul, reg_mul, _MM_SHUFFLE(3, 3, 3, 3)));
+
+    return _mm_cvtss_f32(sums);
+#else
+    return a.data_[0] * b.data_[0] + a.data_[1] * b.data_[1] +
+           a.data_[2] * b.data_[2] + a.data_[3] * b.data_[3];
+#endif
+}
+
+Quaternion Quaternion::from_matrix(const Matrix4 &matrix)
+{
+    Quaternion result;
+
+    const float trace = matrix[0] + matrix[5] + matrix[10];
+
+    if (trace > 0.0f)
+    {
+        float s = 0.5f / std::sqrt(trace + 1.0f);
+        result.data_[3] = 0.25f / s;
+        result.data_[0] = (matrix[9] - matrix[6]) * s;
+        result.data_[1] = (matrix[2] - matrix[8]) * s;
+        result.data_[2] = (matrix[4] - matrix[1]) * s;
+    }
+    else if (matrix[0] > matrix[5] && matrix[0] > matrix[10])
+    {
+        float s = 2.0f * std::sqrt(1.0f + matrix[0] - matrix[5] - matrix[10]);
+        result.data_[3] = (matrix[9] - matrix[6]) / s;
+        result.data_[0] = 0.25f * s;
+        result.data_[1] = (matrix[1] + matrix[4]) / s;
+        result.data_[2] = (matrix[2] + matrix[8]) / s;
+    }
+    else if (matrix[5] > matrix[10])
+    {
+        float s = 2.0f * std::sqrt(1.0f + matrix[5] - matrix[0] - matrix[10]);
+        result.data_[3] = (matrix[2] - matrix[8]) / s;
+        result.data_[0] = (matrix[1] + matrix[4]) / s;
+        result.data_[1] = 0.25f * s;
+        result.data_[2] = (matrix[6] + matrix[9]) / s;
+    }
+    else
+    {
+        float s = 2.0f * std::sqrt(1.0f + matrix[10] - matrix[0] - matrix[5]);
+        result.data_[3] = (matrix[4] - matrix[1]) / s;
+        result.data_[0] = (matrix[2] + matrix[8]) / s;
+        result.data_[1] = (matrix[6] + matrix[9]) / s;
+        result.data_[2] = 0.25f * s;
+    }
+
+    return result.normalized();
+}
+
+Quaternion Quaternion::from_axis_angle(const Vector4 &axis, const float &angle)
+{
+    Vector4 unit_axis(axis[0], axis[1], axis[2], 0.0f);
+    unit_axis = unit_axis.normalized();
+
+    const float half_sin = std::sin(0.5f * angle);
+
+    return Quaternion(unit_axis[0] * half_sin, unit_axis[1] * half_sin, unit_axis[2] * half_sin, std::cos(0.5f * angle));
+}
+
+Quaternion Quaternion::slerp(const Quaternion &a, const Quaternion &b, float t)
+{
+    t = std::fmax(0.0f, std::fmin(t, 1.0f));
+
+    float cos_theta = dot(a, b);
+    float sign = 1.0f;
+
+    if (cos_theta < 0.0f)
+    {
+        cos_theta = -cos_theta;
+        sign = -1.0f;
+    }
+
+    float weight_a = 1.0f - t;
+    float weight_b = t;
+
+    if (cos_theta < 1.0f - 1e-6f)
+    {
+        const float theta = std::acos(cos_theta);
+        const float inverse_sin_theta = 1.0f / std::sin(theta);
+        weight_a = std::sin(weight_a * theta) * inverse_sin_theta;
+        weight_b = std::sin(weight_b * theta) * inverse_sin_theta;
+    }
+
+    weight_b *= sign;
+
+    Quaternion result;
+
+#ifdef __AVX__
+
+    __m128 reg_a = _mm_mul_ps(_mm_loadu_ps(a.data_), _mm_set_ps1(weight_a));
+    __m128 reg_b = _mm_mul_ps(_mm_loadu_ps(b.data_), _mm_set_ps1(weight_b));
+    _mm_storeu_ps(result.data_, _mm_add_ps(reg_a, reg_b));
+
+#else
+
+    for (int32_t i = 0; i < 4; i++)
+    {
+        result.data_[i] = weight_a * a.data_[i] + weight_b * b.data_[i];
+    }
+
+#endif
+
+    return result.normalized();
+}
@@ -0,0 +1,141 @@
+#include <LRE/linalg/rigid_transform.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+RigidTransform::RigidTransform(const Quaternion &rotation, const Vector4 &translation)
+    : rotation_(rotation), translation_(translation[0], translation[1], translation[2], 0.0f)
+{
+}
+
+RigidTransform::RigidTransform(const Matrix4 &matrix)
+    : rotation_(Quaternion::from_matrix(matrix)), translation_(matrix[3], matrix[7], matrix[11], 0.0f)
+{
+}
+
+RigidTransform::RigidTransform(const RigidTransform &other)
+    : rotation_(other.rotation_), translation_(other.translation_)
+{
+}
+
+RigidTransform::RigidTransform()
+{
+}
+
+Quaternion &RigidTransform::rotation()
+{
+    return rotation_;
+}
+
+Vector4 &RigidTransform::translation()
+{
+    return translation_;
+}
+
+const Quaternion &RigidTransform::rotation() const
+{
+    return rotation_;
+}
+
+const Vector4 &RigidTransform::translation() const
+{
+    return translation_;
+}
+
+RigidTransform &RigidTransform::operator=(const RigidTransform &other)
+{
+    rotation_ = other.rotation_;
+    translation_ = other.translation_;
+    return *this;
+}
+
+RigidTransform RigidTransform::operator*(const RigidTransform &other) const
+{
+    return RigidTransform(rotation_ * other.rotation_, rotation_.rotate(other.translation_) + translation_);
+}
+
+RigidTransform RigidTransform::inverted() const
+{
+    Quaternion inverse_rotation = rotation_.conjugate();
+    Vector4 inverse_translation = inverse_rotation.rotate(translation_) * -1.0f;
+
+    return RigidTransform(inverse_rotation, inverse_translation);
+}
+
+RigidTransform &RigidTransform::renormalize()
+{
+    rotation_ = rotation_.normalized();
+    return *this;
+}
+
+Vector4 RigidTransform::transform(const Vector4 &point) const
+{
+    Vector4 result = rotation_.rotate(point);
+
+    result[0] += translation_[0];
+    result[1] += translation_[1];
+    result[2] += translation_[2];
+
+    return result;
+}
+
+void RigidTransform::transform_points(const float *x, const float *y, const float *z,
+                                      float *out_x, float *out_y, float *out_z, const size_t &count) const
+{
+    LRE_PROFILE_SCOPE("RigidTransform::transform_points");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, count);
+
+    const Matrix4 matrix = to_matrix();
+
+    size_t i = 0;
+
+#ifdef __AVX__
+
+    const __m256 r00 = _mm256_set1_ps(matrix[0]), r01 = _mm256_set1_ps(matrix[1]), r02 = _mm256_set1_ps(matrix[2]);
+    const __m256 r10 = _mm256_set1_ps(matrix[4]), r11 = _mm256_set1_ps(matrix[5]), r12 = _mm256_set1_ps(matrix[6]);
+    const __m256 r20 = _mm256_set1_ps(matrix[8]), r21 = _mm256_set1_ps(matrix[9]), r22 = _mm256_set1_ps(matrix[10]);
+    const __m256 tx = _mm256_set1_ps(matrix[3]), ty = _mm256_set1_ps(matrix[7]), tz = _mm256_set1_ps(matrix[11]);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 px = _mm256_loadu_ps(&x[i]);
+        const __m256 py = _mm256_loadu_ps(&y[i]);
+        const __m256 pz = _mm256_loadu_ps(&z[i]);
+
+        const __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r00, px), _mm256_mul_ps(r01, py)), _mm256_mul_ps(r02, pz));
+        const __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r10, px), _mm256_mul_ps(r11, py)), _mm256_mul_ps(r12, pz));
+        const __m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r20, px), _mm256_mul_ps(r21, py)), _mm256_mul_ps(r22, pz));
+
+        _mm256_storeu_ps(&out_x[i], _mm256_add_ps(rx, tx));
+        _mm256_storeu_ps(&out_y[i], _mm256_add_ps(ry, ty));
+        _mm256_storeu_ps(&out_z[i], _mm256_add_ps(rz, tz));
+    }
+
+#endif
+
+    for (; i < count; i++)
+    {
+        const float px = x[i];
+        const float py = y[i];
+        const float pz = z[i];
+
+        out_x[i] = matrix[0] * px + matrix[1] * py + matrix[2] * pz + matrix[3];
+        out_y[i] = matrix[4] * px + matrix[5] * py + matrix[6] * pz + matrix[7];
+        out_z[i] = matrix[8] * px + matrix[9] * py + matrix[10] * pz + matrix[11];
+    }
+}
+
+Matrix4 RigidTransform::to_matrix() const
+{
+    Matrix4 result = rotation_.to_matrix();
+
+    result[3] = translation_[0];
+    result[7] = translation_[1];
+    result[11] = translation_[2];
+
+    return result;
+}
+
+RigidTransform RigidTransform::interpolate(const RigidTransform &a, const RigidTransform &b, const float &t)
+{
+    return RigidTransform(Quaternion::slerp(a.rotation_, b.rotation_, t),
+                          Vector4::lerp(a.translation_, b.translation_, t));
+}
@@ -256,10 +256,10 @@ float Vector4::dot(const Vector4 &a, const Vector4 &b)
 
     __m128 reg_mul = _mm_mul_ps(reg_a, reg_b);
 
-    __m128 shuf = _mm_movehdup_ps(reg_mul);
-    __m128 sums = _mm_add_ps(reg_mul, shuf);
-    shuf = _mm_movehl_ps(shuf, sums);
-    sums = _mm_add_ss(sums, shuf);
+    // Summed left to right like the scalar path, so both return the same bits.
+    __m128 sums = _mm_add_ss(reg_mul, _mm_movehdup_ps(reg_mul));
+    sums = _mm_add_ss(sums, _mm_movehl_ps(reg_mul, reg_mul));
+    sums = _mm_add_ss(sums, _mm_shuffle_ps(reg_mul, reg_mul, _MM_SHUFFLE(3, 3, 3, 3)));
 
     return _mm_cvtss_f32(sums);
 #else
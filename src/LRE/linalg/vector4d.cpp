@@ -0,0 +1,298 @@
+#include <LRE/linalg/vector4d.hpp>
+
+Vector4d::Vector4d(const double &x, const double &y, const double &z, const double &w)
+{
+    data_[0] = x;
+    data_[1] = y;
+    data_[2] = z;
+    data_[3] = w;
+}
+
+Vector4d::Vector4d(const double &x, const double &y, const double &z)
+{
+    data_[0] = x;
+    data_[1] = y;
+    data_[2] = z;
+    data_[3] = 0.0;
+}
+
+Vector4d::Vector4d(const Vector4 &other)
+{
+#ifdef __AVX__
+
+    _mm256_storeu_pd(data_, _mm256_cvtps_pd(_mm_loadu_ps(&other[0])));
+
+#else
+
+    data_[0] = other[0];
+    data_[1] = other[1];
+    data_[2] = other[2];
+    data_[3] = other[3];
+
+#endif
+}
+
+Vector4d::Vector4d(const Vector4d &other)
+{
+    std::memcpy(data_, other.data_, sizeof(data_));
+}
+
+Vector4d::Vector4d()
+{
+    std::memset(data_, 0, sizeof(data_));
+}
+
+double Vector4d::magnitude() const
+{
+    return std::sqrt(sqr_magnitude());
+}
+
+Vector4d Vector4d::normalized() const
+{
+    double length = magnitude();
+
+    if (length <= 1e-12)
+    {
+        length = 1.0;
+    }
+
+    return *this / length;
+}
+
+double Vector4d::sqr_magnitude() const
+{
+    return dot(*this, *this);
+}
+
+bool Vector4d::operator==(const Vector4d &other) const
+{
+    return std::memcmp(data_, other.data_, sizeof(data_)) == 0;
+}
+
+bool Vector4d::operator!=(const Vector4d &other) const
+{
+    return !(*this == other);
+}
+
+Vector4d &Vector4d::operator=(const Vector4d &other)
+{
+    std::memcpy(data_, other.data_, sizeof(data_));
+    return *this;
+}
+
+Vector4d Vector4d::operator+(const Vector4d &other) const
+{
+    Vector4d result;
+
+#ifdef __AVX__
+
+    __m256d reg_a = _mm256_loadu_pd(data_);
+    __m256d reg_b = _mm256_loadu_pd(other.data_);
+    _mm256_storeu_pd(result.data_, _mm256_add_pd(reg_a, reg_b));
+
+#else
+
+    result.data_[0] = data_[0] + other.data_[0];
+    result.data_[1] = data_[1] + other.data_[1];
+    result.data_[2] = data_[2] + other.data_[2];
+    result.data_[3] = data_[3] + other.data_[3];
+
+#endif
+
+    return result;
+}
+
+Vector4d Vector4d::operator*(const Vector4d &other) const
+{
+    Vector4d result;
+
+#ifdef __AVX__
+
+    __m256d reg_a = _mm256_loadu_pd(data_);
+    __m256d reg_b = _mm256_loadu_pd(other.data_);
+    _mm256_storeu_pd(result.data_, _mm256_mul_pd(reg_a, reg_b));
+
+#else
+
+    result.data_[0] = data_[0] * other.data_[0];
+    result.data_[1] = data_[1] * other.data_[1];
+    result.data_[2] = data_[2] * other.data_[2];
+    result.data_[3] = data_[3] * other.data_[3];
+
+#endif
+
+    return result;
+}
+
+Vector4d Vector4d::operator-(const Vector4d &other) const
+{
+    Vector4d result;
+
+#ifdef __AVX__
+
+    __m256d reg_a = _mm256_loadu_pd(data_);
+    __m256d reg_b = _mm256_loadu_pd(other.data_);
+    _mm256_storeu_pd(result.data_, _mm256_sub_pd(reg_a, reg_b));
+
+#else
+
+    result.data_[0] = data_[0] - other.data_[0];
+    result.data_[1] = data_[1] - other.data_[1];
+    result.data_[2] = data_[2] - other.data_[2];
+    result.data_[3] = data_[3] - other.data_[3];
+
+#endif
+
+    return result;
+}
+
+Vector4d Vector4d::operator*(const double &scalar) const
+{
+    Vector4d result;
+
+#ifdef __AVX__
+
+    __m256d reg_a = _mm256_loadu_pd(data_);
+    _mm256_storeu_pd(result.data_, _mm256_mul_pd(reg_a, _mm256_set1_pd(scalar)));
+
+#else
+
+    result.data_[0] = data_[0] * scalar;
+    result.data_[1] = data_[1] * scalar;
+    result.data_[2] = data_[2] * scalar;
+    result.data_[3] = data_[3] * scalar;
+
+#endif
+
+    return result;
+}
+
+Vector4d Vector4d::operator/(const double &scalar) const
+{
+    Vector4d result;
+    double scalar_in_range = scalar;
+
+    if (std::abs(scalar_in_range) < 1e-12)
+    {
+        scalar_in_range = 1.0;
+    }
+
+#ifdef __AVX__
+
+    // A true division keeps both paths bit-identical.
+    __m256d reg_a = _mm256_loadu_pd(data_);
+    _mm256_storeu_pd(result.data_, _mm256_div_pd(reg_a, _mm256_set1_pd(scalar_in_range)));
+
+#else
+
+    result.data_[0] = data_[0] / scalar_in_range;
+    result.data_[1] = data_[1] / scalar_in_range;
+    result.data_[2] = data_[2] / scalar_in_range;
+    result.data_[3] = data_[3] / scalar_in_range;
+
+#endif
+
+    return result;
+}
+
+double &Vector4d::operator[](const int32_t &index)
+{
+    return data_[index < 0 ? 0 : (index > 3 ? 3 : index)];
+}
+
+const double &Vector4d::operator[](const int32_t &index) const
+{
+    return data_[index < 0 ? 0 : (index > 3 ? 3 : index)];
+}
+
+Vector4d &Vector4d::normalize()
+{
+    *this = normalized();
+    return *this;
+}
+
+Vector4 Vector4d::to_float() const
+{
+    Vector4 result;
+
+#ifdef __AVX__
+
+    const __m128 narrowed = _mm256_cvtpd_ps(_mm256_loadu_pd(data_));
+
+    // The 256-bit load folds into the conversion, so the compiler leaves the upper state dirty for the
+    // out-of-line operator[], whose libm calls are legacy SSE and would pay the transition penalty.
+    _mm256_zeroupper();
+    _mm_storeu_ps(&result[0], narrowed);
+
+#else
+
+    result[0] = static_cast<float>(data_[0]);
+    result[1] = static_cast<float>(data_[1]);
+    result[2] = static_cast<float>(data_[2]);
+    result[3] = static_cast<float>(data_[3]);
+
+#endif
+
+    return result;
+}
+
+double &Vector4d::x()
+{
+    return data_[0];
+}
+
+double &Vector4d::y()
+{
+    return data_[1];
+}
+
+double &Vector4d::z()
+{
+    return data_[2];
+}
+
+double &Vector4d::w()
+{
+    return data_[3];
+}
+
+double Vector4d::distance(const Vector4d &a, const Vector4d &b)
+{
+    return (a - b).magnitude();
+}
+
+double Vector4d::dot(const Vector4d &a, const Vector4d &b)
+{
+#ifdef __AVX__
+
+    __m256d product = _mm256_mul_pd(_mm256_loadu_pd(a.data_), _mm256_loadu_pd(b.data_));
+    __m128d sums = _mm_add_pd(_mm256_castpd256_pd128(product), _mm256_extractf128_pd(product, 1));
+    sums = _mm_add_sd(sums, _mm_unpackhi_pd(sums, sums));
+
+    return _mm_cvtsd_f64(sums);
+
+#else
+
+    return (a.data_[0] * b.data_[0] + a.data_[2] * b.data_[2]) +
+           (a.data_[1] * b.data_[1] + a.data_[3] * b.data_[3]);
+
+#endif
+}
+
+Vector4d Vector4d::lerp(const Vector4d &a, const Vector4d &b, double t)
+{
+    t = std::fmax(0.0, std::fmin(t, 1.0));
+    return a + (b - a) * t;
+}
+
+Vector4d Vector4d::max(const Vector4d &a, const Vector4d &b)
+{
+    return Vector4d(std::fmax(a.data_[0], b.data_[0]), std::fmax(a.data_[1], b.data_[1]),
+                    std::fmax(a.data_[2], b.data_[2]), std::fmax(a.data_[3], b.data_[3]));
+}
+
+Vector4d Vector4d::min(const Vector4d &a, const Vector4d &b)
+{
+    return Vector4d(std::fmin(a.data_[0], b.data_[0]), std::fmin(a.data_[1], b.data_[1]),
+                    std::fmin(a.data_[2], b.data_[2]), std::fmin(a.data_[3], b.data_[3]));
+}
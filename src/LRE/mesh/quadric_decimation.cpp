@@ -0,0 +1,894 @@
+#include <LRE/mesh/quadric_decimation.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <LRE/cloud/morton.hpp>
+#include <LRE/parallel/primitives.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    constexpr uint32_t kInvalid = std::numeric_limits<uint32_t>::max();
+
+    // Open mesh borders are held by perpendicular planes weighted well above the surface planes.
+    constexpr double kBorderWeight = 1000.0;
+
+    // A collapse may not tilt a surviving triangle by more than about 78 degrees.
+    constexpr double kMinimumNormalCosine = 0.2;
+
+    constexpr double kSingularRatio = 1e-10;
+
+    constexpr size_t kVertexGrain = 4096;
+
+    constexpr size_t kTriangleGrain = 16384;
+
+    constexpr uint32_t kMortonMaximum = (1u << 21) - 1;
+
+    // Upper triangle of the symmetric 4x4 plane quadric, row by row.
+    struct Quadric
+    {
+        double q[10];
+    };
+
+    void add_plane(Quadric &quadric, const double &a, const double &b, const double &c, const double &d, const double &weight)
+    {
+        double *q = quadric.q;
+
+        q[0] += weight * a * a;
+        q[1] += weight * a * b;
+        q[2] += weight * a * c;
+        q[3] += weight * a * d;
+        q[4] += weight * b * b;
+        q[5] += weight * b * c;
+        q[6] += weight * b * d;
+        q[7] += weight * c * c;
+        q[8] += weight * c * d;
+        q[9] += weight * d * d;
+    }
+
+    double evaluate(const Quadric &quadric, const double &x, const double &y, const double &z)
+    {
+        const double *q = quadric.q;
+
+        return q[0] * x * x + 2.0 * q[1] * x * y + 2.0 * q[2] * x * z + 2.0 * q[3] * x +
+               q[4] * y * y + 2.0 * q[5] * y * z + 2.0 * q[6] * y +
+               q[7] * z * z + 2.0 * q[8] * z + q[9];
+    }
+
+    // Solves for the stationary point of the quadric with Cramer's rule.
+    bool minimize(const Quadric &quadric, double position[3])
+    {
+        const double *q = quadric.q;
+        const double r0 = -q[3];
+        const double r1 = -q[6];
+        const double r2 = -q[8];
+
+        const double det = q[0] * (q[4] * q[7] - q[5] * q[5]) - q[1] * (q[1] * q[7] - q[5] * q[2]) + q[2] * (q[1] * q[5] - q[4] * q[2]);
+        const double scale = q[0] + q[4] + q[7];
+
+        if (!(std::abs(det) > kSingularRatio * scale * scale * scale))
+        {
+            return false;
+        }
+
+        position[0] = (r0 * (q[4] * q[7] - q[5] * q[5]) - q[1] * (r1 * q[7] - q[5] * r2) + q[2] * (r1 * q[5] - q[4] * r2)) / det;
+        position[1] = (q[0] * (r1 * q[7] - r2 * q[5]) - r0 * (q[1] * q[7] - q[5] * q[2]) + q[2] * (q[1] * r2 - r1 * q[2])) / det;
+        position[2] = (q[0] * (q[4] * r2 - q[5] * r1) - q[1] * (q[1] * r2 - r1 * q[2]) + r0 * (q[1] * q[5] - q[4] * q[2])) / det;
+
+        return true;
+    }
+
+    // Indexed mesh shared by all partitions; each partition writes only its own triangles and interior vertices.
+    struct Working
+    {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+        std::vector<uint32_t> indices;
+        std::vector<uint8_t> alive;
+        std::vector<Quadric> quadrics;
+        std::vector<uint8_t> locked;
+        std::vector<uint32_t> local;
+    };
+
+    struct Candidate
+    {
+        double cost;
+        float position[3];
+        uint32_t u;
+        uint32_t v;
+        uint32_t stamp_u;
+        uint32_t stamp_v;
+
+        bool operator>(const Candidate &other) const
+        {
+            return cost > other.cost;
+        }
+    };
+
+    void triangle_normal(const double a[3], const double b[3], const double c[3], double normal[3])
+    {
+        const double u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const double v[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+
+        normal[0] = u[1] * v[2] - u[2] * v[1];
+        normal[1] = u[2] * v[0] - u[0] * v[2];
+        normal[2] = u[0] * v[1] - u[1] * v[0];
+    }
+
+    bool contains(const uint32_t *corners, const uint32_t &vertex)
+    {
+        return corners[0] == vertex || corners[1] == vertex || corners[2] == vertex;
+    }
+
+    void plane_of(const Working &mesh, const uint32_t *corners, double normal[3], double &area)
+    {
+        const double ax = mesh.x[corners[0]];
+        const double ay = mesh.y[corners[0]];
+        const double az = mesh.z[corners[0]];
+        const double ux = mesh.x[corners[1]] - ax;
+        const double uy = mesh.y[corners[1]] - ay;
+        const double uz = mesh.z[corners[1]] - az;
+        const double vx = mesh.x[corners[2]] - ax;
+        const double vy = mesh.y[corners[2]] - ay;
+        const double vz = mesh.z[corners[2]] - az;
+
+        normal[0] = uy * vz - uz * vy;
+        normal[1] = uz * vx - ux * vz;
+        normal[2] = ux * vy - uy * vx;
+
+        const double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        area = 0.5 * length;
+
+        if (length > 0.0)
+        {
+            normal[0] /= length;
+            normal[1] /= length;
+            normal[2] /= length;
+        }
+    }
+
+    void compute_quadrics(Working &mesh, ThreadPool &pool)
+    {
+        const size_t vertex_count = mesh.x.size();
+        std::vector<uint32_t> start(vertex_count + 1, 0);
+
+        for (const uint32_t &vertex : mesh.indices)
+        {
+            start[vertex + 1]++;
+        }
+
+        for (size_t v = 0; v < vertex_count; v++)
+        {
+            start[v + 1] += start[v];
+        }
+
+        std::vector<uint32_t> incident(mesh.indices.size());
+        std::vector<uint32_t> cursor(start.begin(), start.end() - 1);
+
+        for (size_t i = 0; i < mesh.indices.size(); i++)
+        {
+            incident[cursor[mesh.indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        mesh.quadrics.assign(vertex_count, Quadric{});
+
+        pool.parallel_for(0, vertex_count, kVertexGrain, [&mesh, &start, &incident](const size_t &begin, const size_t &end)
+                          {
+                              for (size_t u = begin; u < end; u++)
+                              {
+                                  Quadric &quadric = mesh.quadrics[u];
+
+                                  for (uint32_t r = start[u]; r < start[u + 1]; r++)
+                                  {
+                                      const uint32_t *corners = &mesh.indices[3 * static_cast<size_t>(incident[r])];
+
+                                      double normal[3];
+                                      double area;
+                                      plane_of(mesh, corners, normal, area);
+
+                                      const double d = -(normal[0] * mesh.x[u] + normal[1] * mesh.y[u] + normal[2] * mesh.z[u]);
+                                      add_plane(quadric, normal[0], normal[1], normal[2], d, area);
+
+                                      // An edge used by a single incident triangle lies on the open border.
+                                      for (int32_t c = 0; c < 3; c++)
+                                      {
+                                          const uint32_t w = corners[c];
+
+                                          if (w == u)
+                                          {
+                                              continue;
+                                          }
+
+                                          size_t uses = 0;
+
+                                          for (uint32_t s = start[u]; s < start[u + 1]; s++)
+                                          {
+                                              uses += contains(&mesh.indices[3 * static_cast<size_t>(incident[s])], w) ? 1 : 0;
+                                          }
+
+                                          if (uses != 1)
+                                          {
+                                              continue;
+                                          }
+
+                                          const double ex = static_cast<double>(mesh.x[w]) - mesh.x[u];
+                                          const double ey = static_cast<double>(mesh.y[w]) - mesh.y[u];
+                                          const double ez = static_cast<double>(mesh.z[w]) - mesh.z[u];
+
+                                          double px = ey * normal[2] - ez * normal[1];
+                                          double py = ez * normal[0] - ex * normal[2];
+                                          double pz = ex * normal[1] - ey * normal[0];
+                                          const double length = std::sqrt(px * px + py * py + pz * pz);
+
+                                          if (length <= 0.0)
+                                          {
+                                              continue;
+                                          }
+
+                                          px /= length;
+                                          py /= length;
+                                          pz /= length;
+
+                                          const double pd = -(px * mesh.x[u] + py * mesh.y[u] + pz * mesh.z[u]);
+                                          add_plane(quadric, px, py, pz, pd, kBorderWeight * (ex * ex + ey * ey + ez * ez));
+                                      }
+                                  }
+                              } });
+    }
+
+    // Triangles sorted by the Morton code of their centroid, so contiguous runs are spatially compact.
+    std::vector<uint32_t> morton_order(const Working &mesh, ThreadPool &pool)
+    {
+        const size_t triangle_count = mesh.indices.size() / 3;
+
+        float minimum[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+        float maximum[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+        const std::vector<float> *channels[3] = {&mesh.x, &mesh.y, &mesh.z};
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            const auto bounds = std::minmax_element(channels[c]->begin(), channels[c]->end());
+            minimum[c] = *bounds.first;
+            maximum[c] = *bounds.second;
+        }
+
+        double scale[3];
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            const double extent = static_cast<double>(maximum[c]) - minimum[c];
+            scale[c] = extent > 0.0 ? kMortonMaximum / extent : 0.0;
+        }
+
+        std::vector<uint64_t> keys(triangle_count);
+        std::vector<uint32_t> order(triangle_count);
+
+        pool.parallel_for(0, triangle_count, kTriangleGrain, [&mesh, &keys, &order, &minimum, &scale, &channels](const size_t &begin, const size_t &end)
+                          {
+                              for (size_t t = begin; t < end; t++)
+                              {
+                                  const uint32_t *corners = &mesh.indices[3 * t];
+                                  uint32_t cell[3];
+
+                                  for (int32_t c = 0; c < 3; c++)
+                                  {
+                                      const std::vector<float> &channel = *channels[c];
+                                      const double centroid = (static_cast<double>(channel[corners[0]]) + channel[corners[1]] + channel[corners[2]]) / 3.0;
+                                      const double quantized = (centroid - minimum[c]) * scale[c];
+                                      cell[c] = static_cast<uint32_t>(std::min<double>(std::max(quantized, 0.0), kMortonMaximum));
+                                  }
+
+                                  keys[t] = Morton::encode(cell[0], cell[1], cell[2]);
+                                  order[t] = static_cast<uint32_t>(t);
+                              } });
+
+        ParallelPrimitives::radix_sort(keys, order, pool);
+
+        return order;
+    }
+
+    // Greedy collapse of the edges between interior vertices of one partition, cheapest first.
+    class Partition
+    {
+     private:
+
+        Working &mesh_;
+
+        const uint32_t *triangles_;
+
+        size_t count_;
+
+        std::vector<uint32_t> vertices_;
+
+        std::vector<uint32_t> ref_start_;
+
+        std::vector<uint32_t> ref_count_;
+
+        std::vector<uint32_t> refs_;
+
+        std::vector<uint32_t> stamps_;
+
+        std::vector<uint8_t> vertex_alive_;
+
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> heap_;
+
+        std::vector<uint32_t> neighbours_u_;
+
+        std::vector<uint32_t> neighbours_v_;
+
+        std::vector<uint32_t> scratch_;
+
+        const uint32_t *corners(const uint32_t &local_triangle) const
+        {
+            return &mesh_.indices[3 * static_cast<size_t>(triangles_[local_triangle])];
+        }
+
+        bool alive(const uint32_t &local_triangle) const
+        {
+            return mesh_.alive[triangles_[local_triangle]] != 0;
+        }
+
+        void gather(const uint32_t &vertex, std::vector<uint32_t> &neighbours) const
+        {
+            const uint32_t self = vertices_[vertex];
+            neighbours.clear();
+
+            for (uint32_t r = ref_start_[vertex]; r < ref_start_[vertex] + ref_count_[vertex]; r++)
+            {
+                if (!alive(refs_[r]))
+                {
+                    continue;
+                }
+
+                const uint32_t *triangle = corners(refs_[r]);
+
+                for (int32_t c = 0; c < 3; c++)
+                {
+                    if (triangle[c] != self)
+                    {
+                        neighbours.push_back(triangle[c]);
+                    }
+                }
+            }
+
+            std::sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        }
+
+        void push(const uint32_t &u, const uint32_t &v)
+        {
+            const uint32_t gu = vertices_[u];
+            const uint32_t gv = vertices_[v];
+
+            Quadric quadric = mesh_.quadrics[gu];
+
+            for (int32_t i = 0; i < 10; i++)
+            {
+                quadric.q[i] += mesh_.quadrics[gv].q[i];
+            }
+
+            const double a[3] = {mesh_.x[gu], mesh_.y[gu], mesh_.z[gu]};
+            const double b[3] = {mesh_.x[gv], mesh_.y[gv], mesh_.z[gv]};
+            const double middle[3] = {0.5 * (a[0] + b[0]), 0.5 * (a[1] + b[1]), 0.5 * (a[2] + b[2])};
+            const double edge = (a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) + (a[2] - b[2]) * (a[2] - b[2]);
+
+            double best[3];
+            double cost;
+
+            // Near-singular systems can place the optimum far away; those fall back to the edge itself.
+            if (minimize(quadric, best) &&
+                (best[0] - middle[0]) * (best[0] - middle[0]) + (best[1] - middle[1]) * (best[1] - middle[1]) +
+                        (best[2] - middle[2]) * (best[2] - middle[2]) <= edge)
+            {
+                cost = evaluate(quadric, best[0], best[1], best[2]);
+            }
+            else
+            {
+                const double *options[3] = {a, b, middle};
+                cost = std::numeric_limits<double>::max();
+
+                for (const double *option : options)
+                {
+                    const double error = evaluate(quadric, option[0], option[1], option[2]);
+
+                    if (error < cost)
+                    {
+                        cost = error;
+                        std::copy(option, option + 3, best);
+                    }
+                }
+            }
+
+            heap_.push(Candidate{std::max(cost, 0.0), {static_cast<float>(best[0]), static_cast<float>(best[1]), static_cast<float>(best[2])},
+                                 u, v, stamps_[u], stamps_[v]});
+        }
+
+        bool folds(const uint32_t &vertex, const uint32_t &partner, const float position[3]) const
+        {
+            const uint32_t self = vertices_[vertex];
+
+            for (uint32_t r = ref_start_[vertex]; r < ref_start_[vertex] + ref_count_[vertex]; r++)
+            {
+                if (!alive(refs_[r]))
+                {
+                    continue;
+                }
+
+                const uint32_t *triangle = corners(refs_[r]);
+
+                if (contains(triangle, partner))
+                {
+                    continue;
+                }
+
+                double before[3][3];
+                double after[3][3];
+
+                for (int32_t c = 0; c < 3; c++)
+                {
+                    before[c][0] = mesh_.x[triangle[c]];
+                    before[c][1] = mesh_.y[triangle[c]];
+                    before[c][2] = mesh_.z[triangle[c]];
+
+                    for (int32_t k = 0; k < 3; k++)
+                    {
+                        after[c][k] = triangle[c] == self ? position[k] : before[c][k];
+                    }
+                }
+
+                double normals[2][3];
+                triangle_normal(before[0], before[1], before[2], normals[0]);
+                triangle_normal(after[0], after[1], after[2], normals[1]);
+
+                const double old_length = std::sqrt(normals[0][0] * normals[0][0] + normals[0][1] * normals[0][1] + normals[0][2] * normals[0][2]);
+                const double new_length = std::sqrt(normals[1][0] * normals[1][0] + normals[1][1] * normals[1][1] + normals[1][2] * normals[1][2]);
+
+                if (old_length <= 0.0)
+                {
+                    continue;
+                }
+
+                const double dot = normals[0][0] * normals[1][0] + normals[0][1] * normals[1][1] + normals[0][2] * normals[1][2];
+
+                if (new_length <= 0.0 || dot < kMinimumNormalCosine * old_length * new_length)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        size_t collapse(const Candidate &candidate)
+        {
+            const uint32_t u = candidate.u;
+            const uint32_t v = candidate.v;
+            const uint32_t gu = vertices_[u];
+            const uint32_t gv = vertices_[v];
+
+            // Link condition: the only shared neighbours may be the apexes of the triangles on the edge.
+            size_t shared = 0;
+
+            for (uint32_t r = ref_start_[u]; r < ref_start_[u] + ref_count_[u]; r++)
+            {
+                shared += alive(refs_[r]) && contains(corners(refs_[r]), gv) ? 1 : 0;
+            }
+
+            gather(u, neighbours_u_);
+            gather(v, neighbours_v_);
+
+            size_t common = 0;
+
+            for (size_t i = 0, j = 0; i < neighbours_u_.size() && j < neighbours_v_.size();)
+            {
+                if (neighbours_u_[i] < neighbours_v_[j])
+                {
+                    i++;
+                }
+                else if (neighbours_v_[j] < neighbours_u_[i])
+                {
+                    j++;
+                }
+                else
+                {
+                    common++;
+                    i++;
+                    j++;
+                }
+            }
+
+            if (shared == 0 || common != shared)
+            {
+                return 0;
+            }
+
+            if (folds(u, gv, candidate.position) || folds(v, gu, candidate.position))
+            {
+                return 0;
+            }
+
+            mesh_.x[gu] = candidate.position[0];
+            mesh_.y[gu] = candidate.position[1];
+            mesh_.z[gu] = candidate.position[2];
+
+            for (int32_t i = 0; i < 10; i++)
+            {
+                mesh_.quadrics[gu].q[i] += mesh_.quadrics[gv].q[i];
+            }
+
+            size_t removed = 0;
+            scratch_.clear();
+
+            for (uint32_t r = ref_start_[u]; r < ref_start_[u] + ref_count_[u]; r++)
+            {
+                const uint32_t triangle = refs_[r];
+
+                if (!alive(triangle))
+                {
+                    continue;
+                }
+
+                if (contains(corners(triangle), gv))
+                {
+                    mesh_.alive[triangles_[triangle]] = 0;
+                    removed++;
+                    continue;
+                }
+
+                scratch_.push_back(triangle);
+            }
+
+            for (uint32_t r = ref_start_[v]; r < ref_start_[v] + ref_count_[v]; r++)
+            {
+                const uint32_t triangle = refs_[r];
+
+                if (!alive(triangle))
+                {
+                    continue;
+                }
+
+                uint32_t *triangle_corners = &mesh_.indices[3 * static_cast<size_t>(triangles_[triangle])];
+
+                for (int32_t c = 0; c < 3; c++)
+                {
+                    if (triangle_corners[c] == gv)
+                    {
+                        triangle_corners[c] = gu;
+                    }
+                }
+
+                scratch_.push_back(triangle);
+            }
+
+            ref_start_[u] = static_cast<uint32_t>(refs_.size());
+            ref_count_[u] = static_cast<uint32_t>(scratch_.size());
+            refs_.insert(refs_.end(), scratch_.begin(), scratch_.end());
+
+            vertex_alive_[v] = 0;
+            stamps_[u]++;
+            stamps_[v]++;
+
+            gather(u, neighbours_u_);
+
+            for (const uint32_t &neighbour : neighbours_u_)
+            {
+                if (mesh_.locked[neighbour] == 0)
+                {
+                    push(u, mesh_.local[neighbour]);
+                }
+            }
+
+            return removed;
+        }
+
+     public:
+
+        Partition(Working &mesh, const uint32_t *triangles, const size_t &count)
+            : mesh_(mesh), triangles_(triangles), count_(count)
+        {
+            for (size_t t = 0; t < count_; t++)
+            {
+                const uint32_t *triangle = corners(static_cast<uint32_t>(t));
+
+                for (int32_t c = 0; c < 3; c++)
+                {
+                    const uint32_t vertex = triangle[c];
+
+                    if (mesh_.locked[vertex] != 0)
+                    {
+                        continue;
+                    }
+
+                    if (mesh_.local[vertex] == kInvalid)
+                    {
+                        mesh_.local[vertex] = static_cast<uint32_t>(vertices_.size());
+                        vertices_.push_back(vertex);
+                        ref_count_.push_back(0);
+                    }
+
+                    ref_count_[mesh_.local[vertex]]++;
+                }
+            }
+
+            ref_start_.resize(vertices_.size());
+            uint32_t offset = 0;
+
+            for (size_t v = 0; v < vertices_.size(); v++)
+            {
+                ref_start_[v] = offset;
+                offset += ref_count_[v];
+                ref_count_[v] = 0;
+            }
+
+            refs_.resize(offset);
+
+            for (size_t t = 0; t < count_; t++)
+            {
+                const uint32_t *triangle = corners(static_cast<uint32_t>(t));
+
+                for (int32_t c = 0; c < 3; c++)
+                {
+                    if (mesh_.locked[triangle[c]] == 0)
+                    {
+                        const uint32_t local = mesh_.local[triangle[c]];
+                        refs_[ref_start_[local] + ref_count_[local]++] = static_cast<uint32_t>(t);
+                    }
+                }
+            }
+
+            stamps_.assign(vertices_.size(), 0);
+            vertex_alive_.assign(vertices_.size(), 1);
+        }
+
+        Partition(const Partition &other) = delete;
+
+        Partition &operator=(const Partition &other) = delete;
+
+        ~Partition()
+        {
+            for (const uint32_t &vertex : vertices_)
+            {
+                mesh_.local[vertex] = kInvalid;
+            }
+        }
+
+        size_t simplify(const size_t &goal, const double &max_error)
+        {
+            std::vector<uint64_t> edges;
+            edges.reserve(3 * count_);
+
+            for (size_t t = 0; t < count_; t++)
+            {
+                const uint32_t *triangle = corners(static_cast<uint32_t>(t));
+
+                for (int32_t c = 0; c < 3; c++)
+                {
+                    const uint32_t a = triangle[c];
+                    const uint32_t b = triangle[(c + 1) % 3];
+
+                    if (mesh_.locked[a] == 0 && mesh_.locked[b] == 0)
+                    {
+                        const uint64_t first = std::min(mesh_.local[a], mesh_.local[b]);
+                        const uint64_t second = std::max(mesh_.local[a], mesh_.local[b]);
+                        edges.push_back(first << 32 | second);
+                    }
+                }
+            }
+
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+            for (const uint64_t &edge : edges)
+            {
+                push(static_cast<uint32_t>(edge >> 32), static_cast<uint32_t>(edge));
+            }
+
+            size_t live = count_;
+
+            while (live > goal && !heap_.empty())
+            {
+                const Candidate candidate = heap_.top();
+                heap_.pop();
+
+                if (candidate.cost > max_error)
+                {
+                    break;
+                }
+
+                if (vertex_alive_[candidate.u] == 0 || vertex_alive_[candidate.v] == 0 ||
+                    stamps_[candidate.u] != candidate.stamp_u || stamps_[candidate.v] != candidate.stamp_v)
+                {
+                    continue;
+                }
+
+                live -= collapse(candidate);
+            }
+
+            return count_ - live;
+        }
+    };
+}
+
+QuadricDecimation::QuadricDecimation(const size_t &target_triangles, const float &max_error, const size_t &partition_triangles)
+    : target_triangles_(target_triangles), max_error_(max_error), partition_triangles_(partition_triangles)
+{
+    if (partition_triangles_ == 0)
+    {
+        throw std::invalid_argument("QuadricDecimation: partition size must be positive");
+    }
+}
+
+QuadricDecimation::QuadricDecimation(const size_t &target_triangles)
+    : QuadricDecimation(target_triangles, std::numeric_limits<float>::max(), kPartitionTriangles)
+{
+}
+
+size_t QuadricDecimation::target_triangles() const
+{
+    return target_triangles_;
+}
+
+float QuadricDecimation::max_error() const
+{
+    return max_error_;
+}
+
+size_t QuadricDecimation::partition_triangles() const
+{
+    return partition_triangles_;
+}
+
+TriangleMesh QuadricDecimation::apply(const TriangleMesh &mesh, ThreadPool &pool) const
+{
+    LRE_PROFILE_SCOPE("QuadricDecimation::apply");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, mesh.triangle_count());
+
+    const size_t triangle_count = mesh.triangle_count();
+    const size_t vertex_count = mesh.vertex_count();
+
+    if (triangle_count <= target_triangles_)
+    {
+        return mesh;
+    }
+
+    Working working;
+    working.x.assign(mesh.x(), mesh.x() + vertex_count);
+    working.y.assign(mesh.y(), mesh.y() + vertex_count);
+    working.z.assign(mesh.z(), mesh.z() + vertex_count);
+    working.indices = mesh.indices();
+    working.alive.assign(triangle_count, 1);
+    working.locked.assign(vertex_count, 0);
+    working.local.assign(vertex_count, kInvalid);
+
+    compute_quadrics(working, pool);
+
+    std::vector<uint32_t> order = morton_order(working, pool);
+    std::vector<uint32_t> owner(vertex_count);
+
+    size_t live = triangle_count;
+
+    // Runs one round over consecutive Morton runs; the first run is shortened by shift so borders move between rounds.
+    auto run_round = [&](const size_t &partition_size, const size_t &shift)
+    {
+        order.erase(std::remove_if(order.begin(), order.end(), [&working](const uint32_t &t)
+                                   { return working.alive[t] == 0; }),
+                    order.end());
+
+        std::vector<size_t> starts;
+        size_t start = 0;
+
+        while (start < order.size())
+        {
+            starts.push_back(start);
+            start += std::min(start == 0 && shift > 0 ? shift : partition_size, order.size() - start);
+        }
+
+        starts.push_back(order.size());
+
+        const size_t partition_count = starts.size() - 1;
+
+        std::fill(owner.begin(), owner.end(), kInvalid);
+        std::fill(working.locked.begin(), working.locked.end(), 0);
+
+        for (size_t p = 0; p < partition_count; p++)
+        {
+            for (size_t i = starts[p]; i < starts[p + 1]; i++)
+            {
+                for (int32_t c = 0; c < 3; c++)
+                {
+                    const uint32_t vertex = working.indices[3 * static_cast<size_t>(order[i]) + c];
+
+                    if (owner[vertex] == kInvalid)
+                    {
+                        owner[vertex] = static_cast<uint32_t>(p);
+                    }
+                    else if (owner[vertex] != p)
+                    {
+                        working.locked[vertex] = 1;
+                    }
+                }
+            }
+        }
+
+        const double keep = static_cast<double>(target_triangles_) / static_cast<double>(live);
+        std::vector<size_t> removed(partition_count, 0);
+
+        pool.parallel_for(0, partition_count, 1, [&](const size_t &begin, const size_t &end)
+                          {
+                              for (size_t p = begin; p < end; p++)
+                              {
+                                  const size_t count = starts[p + 1] - starts[p];
+                                  const size_t goal = static_cast<size_t>(std::floor(keep * static_cast<double>(count)));
+
+                                  Partition partition(working, order.data() + starts[p], count);
+                                  removed[p] = partition.simplify(goal, max_error_);
+                              } });
+
+        size_t total = 0;
+
+        for (const size_t &count : removed)
+        {
+            total += count;
+        }
+
+        live -= total;
+        return total;
+    };
+
+    for (size_t round = 0; round < kMaxRounds && live > target_triangles_; round++)
+    {
+        if (run_round(partition_triangles_, round % 2 == 1 ? partition_triangles_ / 2 : 0) == 0)
+        {
+            break;
+        }
+    }
+
+    // Whatever the locked borders held back is finished in a single partition without borders.
+    if (live > target_triangles_)
+    {
+        run_round(std::numeric_limits<size_t>::max(), 0);
+    }
+
+    TriangleMesh result;
+    result.reserve(live, live);
+
+    std::vector<uint32_t> remap(vertex_count, kInvalid);
+
+    for (size_t t = 0; t < triangle_count; t++)
+    {
+        const uint32_t *corners = &working.indices[3 * t];
+
+        if (working.alive[t] == 0 || corners[0] == corners[1] || corners[1] == corners[2] || corners[0] == corners[2])
+        {
+            continue;
+        }
+
+        uint32_t mapped[3];
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            if (remap[corners[c]] == kInvalid)
+            {
+                remap[corners[c]] = result.add_vertex(Vector4(working.x[corners[c]], working.y[corners[c]], working.z[corners[c]]));
+            }
+
+            mapped[c] = remap[corners[c]];
+        }
+
+        result.add_triangle(mapped[0], mapped[1], mapped[2]);
+    }
+
+    return result;
+}
+
+TriangleMesh QuadricDecimation::apply(const TriangleMesh &mesh) const
+{
+    return apply(mesh, ThreadPool::shared());
+}
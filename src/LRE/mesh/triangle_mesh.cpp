@@ -0,0 +1,147 @@
+#include <LRE/mesh/triangle_mesh.hpp>
+
+#include <stdexcept>
+
+TriangleMesh::TriangleMesh(const std::vector<Vector4> &vertices, const std::vector<uint32_t> &indices)
+{
+    if (indices.size() % 3 != 0)
+    {
+        throw std::invalid_argument("TriangleMesh: index count must be a multiple of three");
+    }
+
+    reserve(vertices.size(), indices.size() / 3);
+
+    for (const Vector4 &vertex : vertices)
+    {
+        add_vertex(vertex);
+    }
+
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        add_triangle(indices[i], indices[i + 1], indices[i + 2]);
+    }
+}
+
+TriangleMesh::TriangleMesh()
+{
+}
+
+size_t TriangleMesh::vertex_count() const
+{
+    return x_.size();
+}
+
+size_t TriangleMesh::triangle_count() const
+{
+    return indices_.size() / 3;
+}
+
+bool TriangleMesh::empty() const
+{
+    return indices_.empty();
+}
+
+void TriangleMesh::clear()
+{
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    indices_.clear();
+}
+
+void TriangleMesh::reserve(const size_t &vertices, const size_t &triangles)
+{
+    x_.reserve(vertices);
+    y_.reserve(vertices);
+    z_.reserve(vertices);
+    indices_.reserve(3 * triangles);
+}
+
+uint32_t TriangleMesh::add_vertex(const Vector4 &vertex)
+{
+    x_.push_back(vertex[0]);
+    y_.push_back(vertex[1]);
+    z_.push_back(vertex[2]);
+
+    return static_cast<uint32_t>(x_.size() - 1);
+}
+
+void TriangleMesh::add_triangle(const uint32_t &a, const uint32_t &b, const uint32_t &c)
+{
+    if (a >= x_.size() || b >= x_.size() || c >= x_.size())
+    {
+        throw std::out_of_range("TriangleMesh: triangle references a missing vertex");
+    }
+
+    indices_.push_back(a);
+    indices_.push_back(b);
+    indices_.push_back(c);
+}
+
+Vector4 TriangleMesh::vertex(const size_t &index) const
+{
+    return Vector4(x_[index], y_[index], z_[index], 1.0f);
+}
+
+void TriangleMesh::set_vertex(const size_t &index, const Vector4 &vertex)
+{
+    x_[index] = vertex[0];
+    y_[index] = vertex[1];
+    z_[index] = vertex[2];
+}
+
+Vector4 TriangleMesh::normal(const size_t &triangle) const
+{
+    const uint32_t *corners = &indices_[3 * triangle];
+
+    const Vector4 a = vertex(corners[0]);
+    const Vector4 u = vertex(corners[1]) - a;
+    const Vector4 v = vertex(corners[2]) - a;
+
+    Vector4 cross(u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0], 0.0f);
+
+    if (cross.sqr_magnitude() > 0.0f)
+    {
+        cross.normalize();
+    }
+
+    return cross;
+}
+
+float TriangleMesh::area(const size_t &triangle) const
+{
+    const uint32_t *corners = &indices_[3 * triangle];
+
+    const Vector4 a = vertex(corners[0]);
+    const Vector4 u = vertex(corners[1]) - a;
+    const Vector4 v = vertex(corners[2]) - a;
+
+    const Vector4 cross(u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0], 0.0f);
+
+    return 0.5f * cross.magnitude();
+}
+
+const uint32_t *TriangleMesh::triangle(const size_t &index) const
+{
+    return &indices_[3 * index];
+}
+
+const float *TriangleMesh::x() const
+{
+    return x_.data();
+}
+
+const float *TriangleMesh::y() const
+{
+    return y_.data();
+}
+
+const float *TriangleMesh::z() const
+{
+    return z_.data();
+}
+
+const std::vector<uint32_t> &TriangleMesh::indices() const
+{
+    return indices_;
+}
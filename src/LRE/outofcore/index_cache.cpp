@@ -0,0 +1,381 @@
+#include <LRE/outofcore/index_cache.hpp>
+#include <LRE/profiling/profiler.hpp>
+#include <LRE/outofcore/mapped_file.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+
+namespace
+{
+    constexpr uint32_t kCacheMagic = 0x4349524c;
+    constexpr uint32_t kKdTreeKind = 1;
+    constexpr uint32_t kOctreeKind = 2;
+    constexpr size_t kHeaderSize = 104;
+    constexpr size_t kSectionCount = 5;
+
+    constexpr uint64_t kPrime1 = 0x9e3779b185ebca87ull;
+    constexpr uint64_t kPrime2 = 0xc2b2ae3d27d4eb4full;
+    constexpr uint64_t kPrime3 = 0x165667b19e3779f9ull;
+
+    // Sections in file order; every one starts on a kSectionAlignment boundary.
+    enum Section
+    {
+        Nodes,
+        X,
+        Y,
+        Z,
+        Indices
+    };
+
+    struct CacheHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t kind;
+        uint32_t node_size;
+        uint64_t point_count;
+        uint64_t node_count;
+        uint64_t fingerprint;
+        float parameter;
+        uint32_t reserved;
+        uint64_t offsets[kSectionCount];
+        uint64_t payload_checksum;
+        uint64_t header_checksum;
+    };
+
+    static_assert(sizeof(CacheHeader) == kHeaderSize, "Cache header must stay 104 bytes");
+
+    uint64_t rotate(const uint64_t &value, const int32_t &bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    uint64_t mix(const uint64_t &lane, const uint64_t &word)
+    {
+        return rotate(lane + word * kPrime2, 31) * kPrime1;
+    }
+
+    // Four independent lanes keep the multiplies pipelined; words are read with memcpy so any alignment works.
+    uint64_t checksum(const void *data, const size_t &size, const uint64_t &seed)
+    {
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+        uint64_t lanes[4] = {seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1};
+        size_t offset = 0;
+
+        for (; offset + 32 <= size; offset += 32)
+        {
+            uint64_t words[4];
+            std::memcpy(words, bytes + offset, sizeof(words));
+
+            for (int32_t l = 0; l < 4; l++)
+            {
+                lanes[l] = mix(lanes[l], words[l]);
+            }
+        }
+
+        uint64_t hash = rotate(lanes[0], 1) + rotate(lanes[1], 7) + rotate(lanes[2], 12) + rotate(lanes[3], 18);
+        hash += static_cast<uint64_t>(size);
+
+        for (; offset + 8 <= size; offset += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes + offset, sizeof(word));
+            hash = rotate(hash ^ mix(0, word), 27) * kPrime1 + kPrime3;
+        }
+
+        for (; offset < size; offset++)
+        {
+            hash = rotate(hash ^ (bytes[offset] * kPrime3), 11) * kPrime1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= kPrime2;
+        hash ^= hash >> 29;
+        hash *= kPrime3;
+        hash ^= hash >> 32;
+
+        return hash;
+    }
+
+    uint64_t aligned(const uint64_t &offset)
+    {
+        return (offset + IndexCache::kSectionAlignment - 1) / IndexCache::kSectionAlignment * IndexCache::kSectionAlignment;
+    }
+
+    template <typename Node>
+    void write_cache(const std::string &path, const uint32_t &kind, const float &parameter, const uint64_t &fingerprint,
+                     const ArrayView<Node> &nodes, const float *x, const float *y, const float *z,
+                     const ArrayView<uint32_t> &indices)
+    {
+        const void *sections[kSectionCount] = {nodes.data(), x, y, z, indices.data()};
+        const uint64_t bytes[kSectionCount] = {nodes.size() * sizeof(Node), indices.size() * sizeof(float),
+                                               indices.size() * sizeof(float), indices.size() * sizeof(float),
+                                               indices.size() * sizeof(uint32_t)};
+
+        CacheHeader header = {};
+        header.magic = kCacheMagic;
+        header.version = IndexCache::kFormatVersion;
+        header.kind = kind;
+        header.node_size = sizeof(Node);
+        header.point_count = indices.size();
+        header.node_count = nodes.size();
+        header.fingerprint = fingerprint;
+        header.parameter = parameter;
+
+        uint64_t offset = aligned(sizeof(CacheHeader));
+        uint64_t payload = kCacheMagic;
+
+        for (size_t s = 0; s < kSectionCount; s++)
+        {
+            header.offsets[s] = offset;
+            offset = aligned(offset + bytes[s]);
+            payload = checksum(sections[s], bytes[s], payload);
+        }
+
+        header.payload_checksum = payload;
+        header.header_checksum = checksum(&header, offsetof(CacheHeader, header_checksum), kCacheMagic);
+
+        const std::string staging = path + ".tmp";
+
+        {
+            std::ofstream stream(staging, std::ios::binary | std::ios::trunc);
+
+            if (!stream)
+            {
+                throw std::runtime_error("IndexCache: unable to write " + staging);
+            }
+
+            const char padding[IndexCache::kSectionAlignment] = {};
+            stream.write(reinterpret_cast<const char *>(&header), sizeof(CacheHeader));
+            uint64_t written = sizeof(CacheHeader);
+
+            for (size_t s = 0; s < kSectionCount; s++)
+            {
+                stream.write(padding, static_cast<std::streamsize>(header.offsets[s] - written));
+                stream.write(static_cast<const char *>(sections[s]), static_cast<std::streamsize>(bytes[s]));
+                written = header.offsets[s] + bytes[s];
+            }
+
+            stream.write(padding, static_cast<std::streamsize>(offset - written));
+
+            if (!stream)
+            {
+                throw std::runtime_error("IndexCache: unable to write " + staging);
+            }
+        }
+
+        std::filesystem::rename(staging, path);
+    }
+
+    // Validated view of a mapped cache file; the views stay valid for as long as file is alive.
+    struct MappedCache
+    {
+        std::shared_ptr<MappedFile> file;
+        CacheHeader header;
+        const uint8_t *sections[kSectionCount];
+    };
+
+    MappedCache map_cache(const std::string &path, const uint32_t &kind, const size_t &node_size,
+                          const uint64_t &fingerprint, const CacheVerification &verification)
+    {
+        MappedCache cache;
+        cache.file = std::make_shared<MappedFile>(path);
+
+        const uint8_t *data = cache.file->data();
+        const uint64_t size = cache.file->size();
+
+        if (size < sizeof(CacheHeader))
+        {
+            throw std::runtime_error("IndexCache: truncated header in " + path);
+        }
+
+        CacheHeader &header = cache.header;
+        std::memcpy(&header, data, sizeof(CacheHeader));
+
+        if (header.magic != kCacheMagic)
+        {
+            throw std::runtime_error("IndexCache: not an index cache " + path);
+        }
+
+        if (header.version != IndexCache::kFormatVersion)
+        {
+            throw std::runtime_error("IndexCache: unsupported version in " + path);
+        }
+
+        if (header.header_checksum != checksum(&header, offsetof(CacheHeader, header_checksum), kCacheMagic))
+        {
+            throw std::runtime_error("IndexCache: header checksum mismatch in " + path);
+        }
+
+        if (header.kind != kind || header.node_size != node_size)
+        {
+            throw std::runtime_error("IndexCache: index kind mismatch in " + path);
+        }
+
+        if (header.fingerprint != fingerprint)
+        {
+            throw std::runtime_error("IndexCache: built from a different cloud " + path);
+        }
+
+        const uint64_t element_sizes[kSectionCount] = {node_size, sizeof(float), sizeof(float), sizeof(float), sizeof(uint32_t)};
+        const uint64_t counts[kSectionCount] = {header.node_count, header.point_count, header.point_count,
+                                                header.point_count, header.point_count};
+
+        uint64_t payload = kCacheMagic;
+
+        for (size_t s = 0; s < kSectionCount; s++)
+        {
+            const uint64_t offset = header.offsets[s];
+
+            // Divide instead of multiplying so hostile counts cannot overflow the bounds check.
+            if (offset % IndexCache::kSectionAlignment != 0 || offset < sizeof(CacheHeader) || offset > size ||
+                counts[s] > (size - offset) / element_sizes[s])
+            {
+                throw std::runtime_error("IndexCache: section out of bounds in " + path);
+            }
+
+            cache.sections[s] = data + offset;
+
+            if (verification == CacheVerification::Full)
+            {
+                payload = checksum(cache.sections[s], counts[s] * element_sizes[s], payload);
+            }
+        }
+
+        if (verification == CacheVerification::Full && payload != header.payload_checksum)
+        {
+            throw std::runtime_error("IndexCache: payload checksum mismatch in " + path);
+        }
+
+        return cache;
+    }
+
+    template <typename Value>
+    ArrayView<Value> view(const MappedCache &cache, const Section &section, const uint64_t &count)
+    {
+        return ArrayView<Value>(reinterpret_cast<const Value *>(cache.sections[section]), count);
+    }
+}
+
+uint64_t IndexCache::fingerprint(const PointCloud &cloud)
+{
+    uint64_t hash = checksum(cloud.x(), cloud.size() * sizeof(float), cloud.size());
+    hash = checksum(cloud.y(), cloud.size() * sizeof(float), hash);
+    return checksum(cloud.z(), cloud.size() * sizeof(float), hash);
+}
+
+void IndexCache::write(const std::string &path, const KdTree &tree, const uint64_t &fingerprint)
+{
+    LRE_PROFILE_SCOPE("IndexCache::write");
+
+    write_cache(path, kKdTreeKind, static_cast<float>(tree.leaf_size()), fingerprint, tree.nodes(),
+                tree.x(), tree.y(), tree.z(), tree.indices());
+}
+
+void IndexCache::write(const std::string &path, const Octree &tree, const uint64_t &fingerprint)
+{
+    LRE_PROFILE_SCOPE("IndexCache::write");
+
+    write_cache(path, kOctreeKind, tree.resolution(), fingerprint, tree.nodes(),
+                tree.x(), tree.y(), tree.z(), tree.indices());
+}
+
+KdTree IndexCache::load_kd_tree(const std::string &path, const uint64_t &fingerprint, const CacheVerification &verification)
+{
+    LRE_PROFILE_SCOPE("IndexCache::load");
+
+    const MappedCache cache = map_cache(path, kKdTreeKind, sizeof(KdTree::Node), fingerprint, verification);
+    const uint64_t count = cache.header.point_count;
+
+    try
+    {
+        return KdTree::from_arrays(view<KdTree::Node>(cache, Nodes, cache.header.node_count),
+                                   view<float>(cache, X, count), view<float>(cache, Y, count), view<float>(cache, Z, count),
+                                   view<uint32_t>(cache, Indices, count),
+                                   static_cast<size_t>(cache.header.parameter), cache.file);
+    }
+    catch (const std::invalid_argument &error)
+    {
+        throw std::runtime_error(std::string("IndexCache: ") + error.what() + " in " + path);
+    }
+}
+
+Octree IndexCache::load_octree(const std::string &path, const uint64_t &fingerprint, const CacheVerification &verification)
+{
+    LRE_PROFILE_SCOPE("IndexCache::load");
+
+    const MappedCache cache = map_cache(path, kOctreeKind, sizeof(Octree::Node), fingerprint, verification);
+    const uint64_t count = cache.header.point_count;
+
+    try
+    {
+        return Octree::from_arrays(view<Octree::Node>(cache, Nodes, cache.header.node_count),
+                                   view<float>(cache, X, count), view<float>(cache, Y, count), view<float>(cache, Z, count),
+                                   view<uint32_t>(cache, Indices, count), cache.header.parameter, cache.file);
+    }
+    catch (const std::invalid_argument &error)
+    {
+        throw std::runtime_error(std::string("IndexCache: ") + error.what() + " in " + path);
+    }
+}
+
+KdTree IndexCache::kd_tree(const std::string &path, const PointCloud &cloud, const size_t &leaf_size,
+                           const CacheVerification &verification)
+{
+    const uint64_t key = fingerprint(cloud);
+
+    try
+    {
+        KdTree tree = load_kd_tree(path, key, verification);
+
+        if (tree.leaf_size() == std::max<size_t>(1, leaf_size))
+        {
+            return tree;
+        }
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+
+    KdTree tree(cloud, leaf_size);
+    write(path, tree, key);
+    return tree;
+}
+
+KdTree IndexCache::kd_tree(const std::string &path, const PointCloud &cloud, const size_t &leaf_size)
+{
+    return kd_tree(path, cloud, leaf_size, CacheVerification::Header);
+}
+
+Octree IndexCache::octree(const std::string &path, const PointCloud &cloud, const float &resolution,
+                          const CacheVerification &verification)
+{
+    const uint64_t key = fingerprint(cloud);
+
+    try
+    {
+        Octree tree = load_octree(path, key, verification);
+
+        if (tree.resolution() == std::max(resolution, std::numeric_limits<float>::epsilon()))
+        {
+            return tree;
+        }
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+
+    Octree tree(cloud, resolution);
+    write(path, tree, key);
+    return tree;
+}
+
+Octree IndexCache::octree(const std::string &path, const PointCloud &cloud, const float &resolution)
+{
+    return octree(path, cloud, resolution, CacheVerification::Header);
+}
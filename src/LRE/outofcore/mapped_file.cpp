@@ -0,0 +1,152 @@
+#include <LRE/outofcore/mapped_file.hpp>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string &path)
+    : data_(nullptr), size_(0), file_handle_(INVALID_HANDLE_VALUE), mapping_handle_(nullptr)
+{
+    file_handle_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file_handle_ == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Unable to open " + path);
+    }
+
+    LARGE_INTEGER file_size;
+    GetFileSizeEx(file_handle_, &file_size);
+    size_ = static_cast<size_t>(file_size.QuadPart);
+
+    if (size_ == 0)
+    {
+        return;
+    }
+
+    mapping_handle_ = CreateFileMappingA(file_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mapping_handle_ == nullptr)
+    {
+        CloseHandle(file_handle_);
+        throw std::runtime_error("Unable to map " + path);
+    }
+
+    data_ = MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0);
+
+    if (data_ == nullptr)
+    {
+        CloseHandle(mapping_handle_);
+        CloseHandle(file_handle_);
+        throw std::runtime_error("Unable to map " + path);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr)
+    {
+        UnmapViewOfFile(data_);
+    }
+
+    if (mapping_handle_ != nullptr)
+    {
+        CloseHandle(mapping_handle_);
+    }
+
+    if (file_handle_ != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file_handle_);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &path) : data_(nullptr), size_(0), descriptor_(-1)
+{
+    descriptor_ = open(path.c_str(), O_RDONLY);
+
+    if (descriptor_ < 0)
+    {
+        throw std::runtime_error("Unable to open " + path);
+    }
+
+    struct stat status;
+
+    if (fstat(descriptor_, &status) != 0)
+    {
+        close(descriptor_);
+        throw std::runtime_error("Unable to stat " + path);
+    }
+
+    size_ = static_cast<size_t>(status.st_size);
+
+    if (size_ == 0)
+    {
+        return;
+    }
+
+    data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor_, 0);
+
+    if (data_ == MAP_FAILED)
+    {
+        data_ = nullptr;
+        close(descriptor_);
+        throw std::runtime_error("Unable to map " + path);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr)
+    {
+        munmap(data_, size_);
+    }
+
+    if (descriptor_ >= 0)
+    {
+        close(descriptor_);
+    }
+}
+
+#endif
+
+const uint8_t *MappedFile::data() const
+{
+    return static_cast<const uint8_t *>(data_);
+}
+
+size_t MappedFile::size() const
+{
+    return size_;
+}
+
+void MappedFile::touch() const
+{
+    if (data_ == nullptr)
+    {
+        return;
+    }
+
+#ifndef _WIN32
+    madvise(data_, size_, MADV_WILLNEED);
+#endif
+
+    // Fault every page in so the caller does not stall on first access.
+    volatile uint8_t sink = 0;
+    const uint8_t *bytes = data();
+
+    for (size_t offset = 0; offset < size_; offset += 4096)
+    {
+        sink = sink + bytes[offset];
+    }
+
+    (void)sink;
+}
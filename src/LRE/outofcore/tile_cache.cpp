@@ -0,0 +1,133 @@
+#include <LRE/outofcore/tile_cache.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <iterator>
+
+TileCache::TileCache(const TileStore &store, const size_t &memory_budget)
+    : store_(store), memory_budget_(memory_budget), resident_bytes_(std::make_shared<std::atomic<size_t>>(0)), hits_(0),
+      misses_(0), io_(1)
+{
+}
+
+TileCache::Entry &TileCache::load(const size_t &tile, const bool &requested)
+{
+    LRE_PROFILE_SCOPE("TileCache::load");
+    LRE_PROFILE_COUNT(Counter::Allocations, 1);
+
+    std::shared_ptr<std::promise<std::shared_ptr<const TileView>>> promise =
+        std::make_shared<std::promise<std::shared_ptr<const TileView>>>();
+
+    const std::string path = store_.tile_path(tile);
+    const size_t bytes = store_.tile_bytes(tile);
+    std::shared_ptr<std::atomic<size_t>> resident = resident_bytes_;
+
+    // The bytes are charged up front and released when the last owner of the view drops it.
+    *resident += bytes;
+
+    io_.submit([promise, path, bytes, resident]()
+               {
+                   try
+                   {
+                       std::shared_ptr<const TileView> view(new TileView(path), [bytes, resident](const TileView *released)
+                                                            {
+                                                                delete released;
+                                                                *resident -= bytes;
+                                                            });
+                       view->touch();
+                       promise->set_value(view);
+                   }
+                   catch (...)
+                   {
+                       *resident -= bytes;
+                       promise->set_exception(std::current_exception());
+                   } });
+
+    if (requested)
+    {
+        recency_.push_front(tile);
+    }
+    else
+    {
+        recency_.push_back(tile);
+    }
+
+    Entry entry;
+    entry.view = promise->get_future().share();
+    entry.position = requested ? recency_.begin() : std::prev(recency_.end());
+
+    Entry &inserted = entries_.emplace(tile, entry).first->second;
+
+    evict();
+
+    return inserted;
+}
+
+void TileCache::evict()
+{
+    // The most recently requested tile always stays resident, even if it alone exceeds the budget. Evicting a
+    // view a caller still holds frees nothing yet, so eviction carries on to the next tile.
+    while (*resident_bytes_ > memory_budget_ && recency_.size() > 1)
+    {
+        const size_t victim = recency_.back();
+        recency_.pop_back();
+        entries_.erase(victim);
+    }
+}
+
+std::shared_ptr<const TileView> TileCache::acquire(const size_t &tile)
+{
+    std::shared_future<std::shared_ptr<const TileView>> view;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto found = entries_.find(tile);
+
+        if (found != entries_.end())
+        {
+            recency_.splice(recency_.begin(), recency_, found->second.position);
+            view = found->second.view;
+            hits_++;
+        }
+        else
+        {
+            view = load(tile, true).view;
+            misses_++;
+        }
+    }
+
+    return view.get();
+}
+
+void TileCache::prefetch(const size_t &tile)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // A prefetch that does not fit next to the resident tiles would only evict itself.
+    if (entries_.find(tile) == entries_.end() && *resident_bytes_ + store_.tile_bytes(tile) <= memory_budget_)
+    {
+        load(tile, false);
+    }
+}
+
+size_t TileCache::memory_budget() const
+{
+    return memory_budget_;
+}
+
+size_t TileCache::resident_bytes()
+{
+    return *resident_bytes_;
+}
+
+size_t TileCache::hits()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+size_t TileCache::misses()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
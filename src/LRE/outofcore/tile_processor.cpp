@@ -0,0 +1,138 @@
+#include <LRE/outofcore/tile_processor.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+TileProcessor::TileProcessor(const TileStore &store, TileCache &cache, const float &halo)
+    : store_(store), cache_(cache), halo_(std::max(halo, 0.0f))
+{
+}
+
+const TileStore &TileProcessor::store() const
+{
+    return store_;
+}
+
+float TileProcessor::halo() const
+{
+    return halo_;
+}
+
+void TileProcessor::prefetch_neighbourhood(const size_t &tile, const float &halo)
+{
+    cache_.prefetch(tile);
+
+    for (const size_t &neighbour : store_.neighbours(tile, halo))
+    {
+        cache_.prefetch(neighbour);
+    }
+}
+
+PointCloud TileProcessor::gather(const size_t &tile, const float &halo, size_t &core_count)
+{
+    const TileInfo &info = store_.tile(tile);
+    const std::vector<size_t> neighbours = store_.neighbours(tile, halo);
+
+    const float tile_size = store_.tile_size();
+    const float minimum_x = info.x * tile_size - halo;
+    const float minimum_y = info.y * tile_size - halo;
+    const float maximum_x = (info.x + 1) * tile_size + halo;
+    const float maximum_y = (info.y + 1) * tile_size + halo;
+
+    PointCloud local;
+    local.set_origin(store_.origin());
+
+    if (store_.has_normals())
+    {
+        local.enable_normals();
+    }
+
+    local.reserve(info.count);
+
+    auto append = [&local](const TileView &view, const size_t &index)
+    {
+        local.push_back(Vector4(view.x()[index], view.y()[index], view.z()[index]));
+
+        if (view.has_normals())
+        {
+            local.set_normal(local.size() - 1, Vector4(view.normal_x()[index], view.normal_y()[index], view.normal_z()[index]));
+        }
+    };
+
+    std::shared_ptr<const TileView> core = cache_.acquire(tile);
+
+    for (size_t i = 0; i < core->size(); i++)
+    {
+        append(*core, i);
+    }
+
+    core_count = local.size();
+
+    for (const size_t &neighbour : neighbours)
+    {
+        std::shared_ptr<const TileView> view = cache_.acquire(neighbour);
+
+        for (size_t i = 0; i < view->size(); i++)
+        {
+            const float px = view->x()[i];
+            const float py = view->y()[i];
+
+            if (px >= minimum_x && px < maximum_x && py >= minimum_y && py < maximum_y)
+            {
+                append(*view, i);
+            }
+        }
+    }
+
+    return local;
+}
+
+void TileProcessor::downsample(const VoxelDownsample &filter, TileStoreWriter &output, ThreadPool &pool)
+{
+    LRE_PROFILE_SCOPE("TileProcessor::downsample");
+
+    // A voxel belongs to the tile holding its minimum corner; one voxel of halo makes owned voxels complete.
+    const float halo = std::max(halo_, filter.voxel_size());
+    const float tile_size = store_.tile_size();
+    const float voxel_size = filter.voxel_size();
+
+    for (size_t tile = 0; tile < store_.tile_count(); tile++)
+    {
+        if (tile + 1 < store_.tile_count())
+        {
+            prefetch_neighbourhood(tile + 1, halo);
+        }
+
+        size_t core_count = 0;
+        PointCloud local = gather(tile, halo, core_count);
+        PointCloud reduced = filter.apply(local, pool);
+
+        const TileInfo &info = store_.tile(tile);
+        PointCloud owned;
+        owned.set_origin(reduced.origin());
+
+        for (size_t i = 0; i < reduced.size(); i++)
+        {
+            const float corner_x = std::floor(reduced.x()[i] / voxel_size) * voxel_size;
+            const float corner_y = std::floor(reduced.y()[i] / voxel_size) * voxel_size;
+
+            if (static_cast<int32_t>(std::floor(corner_x / tile_size)) == info.x &&
+                static_cast<int32_t>(std::floor(corner_y / tile_size)) == info.y)
+            {
+                owned.push_back(reduced.point(i));
+            }
+        }
+
+        output.append(owned);
+    }
+}
+
+void TileProcessor::estimate_normals(const NormalEstimation &estimator, TileStoreWriter &output, ThreadPool &pool)
+{
+    LRE_PROFILE_SCOPE("TileProcessor::estimate_normals");
+
+    for_each_tile([&estimator, &output, &pool](const TileInfo &, PointCloud &local, const size_t &core_count)
+                  {
+                      KdTree tree(local);
+                      estimator.apply(local, tree, core_count, pool);
+                      local.resize(core_count);
+                      output.append(local); });
+}
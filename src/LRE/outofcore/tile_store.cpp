@@ -0,0 +1,614 @@
+#include <LRE/outofcore/tile_store.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace
+{
+    constexpr uint32_t kTileMagic = 0x5445524c;
+    constexpr uint32_t kIndexMagic = 0x4945524c;
+    constexpr uint32_t kFormatVersion = 2;
+    constexpr uint32_t kNormalsFlag = 1;
+    constexpr size_t kTileHeaderSize = 32;
+    constexpr size_t kTransposeBatch = 1 << 16;
+    constexpr size_t kIndexRecordSize = 2 * sizeof(int32_t) + sizeof(uint64_t) + 6 * sizeof(float);
+    // Both bounds are exact in float; NaN fails either comparison.
+    constexpr float kTileIndexLimit = 2147483648.0f;
+    constexpr const char *kIndexFilename = "tiles.idx";
+
+    struct TileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t count;
+        uint32_t flags;
+        uint32_t reserved;
+        uint64_t padding;
+    };
+
+    static_assert(sizeof(TileHeader) == kTileHeaderSize, "Tile header must stay 32 bytes");
+
+    template <typename Value>
+    void write_value(std::ofstream &stream, const Value &value)
+    {
+        stream.write(reinterpret_cast<const char *>(&value), sizeof(Value));
+    }
+
+    template <typename Value>
+    void read_value(std::ifstream &stream, Value &value)
+    {
+        stream.read(reinterpret_cast<char *>(&value), sizeof(Value));
+    }
+}
+
+TileStoreWriter::TileStoreWriter(const std::string &directory, const float &tile_size, const size_t &staging_budget)
+    : directory_(directory), tile_size_(tile_size), staging_budget_(staging_budget), staged_bytes_(0), skipped_points_(0),
+      has_normals_(false), schema_fixed_(false), finalized_(false)
+{
+    if (!(tile_size_ > 0.0f))
+    {
+        throw std::invalid_argument("Tile size must be positive");
+    }
+
+    std::filesystem::create_directories(directory_);
+}
+
+TileStoreWriter::TileStoreWriter(const std::string &directory, const float &tile_size)
+    : TileStoreWriter(directory, tile_size, kDefaultStagingBudget)
+{
+}
+
+TileStoreWriter::~TileStoreWriter()
+{
+    try
+    {
+        finalize();
+    }
+    catch (...)
+    {
+    }
+}
+
+void TileStoreWriter::append(const PointCloud &cloud)
+{
+    LRE_PROFILE_SCOPE("TileStoreWriter::append");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, cloud.size());
+
+    if (finalized_)
+    {
+        throw std::logic_error("Cannot append to a finalized tile store");
+    }
+
+    if (!schema_fixed_)
+    {
+        has_normals_ = cloud.has_normals();
+        origin_ = cloud.origin();
+        schema_fixed_ = true;
+    }
+    else if (cloud.has_normals() != has_normals_)
+    {
+        throw std::invalid_argument("All batches of a tile store must share the same channels");
+    }
+
+    const size_t stride = has_normals_ ? 6 : 3;
+    const float inverse_tile_size = 1.0f / tile_size_;
+
+    // Offsets are widened to double before the shift so each point rounds once.
+    const bool rebased = cloud.origin() != origin_;
+    const Vector4d shift = cloud.origin() - origin_;
+
+    for (size_t i = 0; i < cloud.size(); i++)
+    {
+        float px = cloud.x()[i];
+        float py = cloud.y()[i];
+        float pz = cloud.z()[i];
+
+        if (rebased)
+        {
+            px = static_cast<float>(static_cast<double>(px) + shift[0]);
+            py = static_cast<float>(static_cast<double>(py) + shift[1]);
+            pz = static_cast<float>(static_cast<double>(pz) + shift[2]);
+        }
+
+        const float fx = std::floor(px * inverse_tile_size);
+        const float fy = std::floor(py * inverse_tile_size);
+
+        if (!std::isfinite(pz) || !(fx >= -kTileIndexLimit && fx < kTileIndexLimit) ||
+            !(fy >= -kTileIndexLimit && fy < kTileIndexLimit))
+        {
+            skipped_points_++;
+            continue;
+        }
+
+        const int32_t tx = static_cast<int32_t>(fx);
+        const int32_t ty = static_cast<int32_t>(fy);
+
+        auto found = tiles_.find(TileStore::tile_key(tx, ty));
+
+        if (found == tiles_.end())
+        {
+            PendingTile pending;
+            pending.info.x = tx;
+            pending.info.y = ty;
+            pending.info.count = 0;
+
+            for (int32_t c = 0; c < 3; c++)
+            {
+                pending.info.minimum[c] = std::numeric_limits<float>::max();
+                pending.info.maximum[c] = std::numeric_limits<float>::lowest();
+            }
+
+            std::remove((directory_ + "/" + TileStore::tile_filename(tx, ty) + ".stage").c_str());
+            found = tiles_.emplace(TileStore::tile_key(tx, ty), std::move(pending)).first;
+        }
+
+        PendingTile &tile = found->second;
+        const float point[3] = {px, py, pz};
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            tile.info.minimum[c] = std::min(tile.info.minimum[c], point[c]);
+            tile.info.maximum[c] = std::max(tile.info.maximum[c], point[c]);
+            tile.staged.push_back(point[c]);
+        }
+
+        if (has_normals_)
+        {
+            tile.staged.push_back(cloud.normal_x()[i]);
+            tile.staged.push_back(cloud.normal_y()[i]);
+            tile.staged.push_back(cloud.normal_z()[i]);
+        }
+
+        tile.info.count++;
+        staged_bytes_ += stride * sizeof(float);
+
+        if (staged_bytes_ > staging_budget_)
+        {
+            spill();
+        }
+    }
+}
+
+size_t TileStoreWriter::staged_bytes() const
+{
+    return staged_bytes_;
+}
+
+uint64_t TileStoreWriter::skipped_points() const
+{
+    return skipped_points_;
+}
+
+const Vector4d &TileStoreWriter::origin() const
+{
+    return origin_;
+}
+
+void TileStoreWriter::spill()
+{
+    std::vector<PendingTile *> pending;
+
+    for (auto &entry : tiles_)
+    {
+        if (!entry.second.staged.empty())
+        {
+            pending.push_back(&entry.second);
+        }
+    }
+
+    std::sort(pending.begin(), pending.end(), [](const PendingTile *a, const PendingTile *b)
+              { return a->staged.size() > b->staged.size(); });
+
+    // Down to half the budget, so the next spill is a whole half-budget away.
+    for (PendingTile *tile : pending)
+    {
+        if (staged_bytes_ <= staging_budget_ / 2)
+        {
+            break;
+        }
+
+        flush(*tile);
+    }
+}
+
+void TileStoreWriter::flush(PendingTile &tile)
+{
+    if (tile.staged.empty())
+    {
+        return;
+    }
+
+    const std::string path = directory_ + "/" + TileStore::tile_filename(tile.info.x, tile.info.y) + ".stage";
+    std::ofstream stream(path, std::ios::binary | std::ios::app);
+
+    if (!stream)
+    {
+        throw std::runtime_error("Unable to write " + path);
+    }
+
+    stream.write(reinterpret_cast<const char *>(tile.staged.data()), tile.staged.size() * sizeof(float));
+
+    if (!stream)
+    {
+        throw std::runtime_error("Unable to write " + path);
+    }
+
+    staged_bytes_ -= tile.staged.size() * sizeof(float);
+    tile.staged.clear();
+    tile.staged.shrink_to_fit();
+}
+
+void TileStoreWriter::finalize()
+{
+    LRE_PROFILE_SCOPE("TileStoreWriter::finalize");
+
+    if (finalized_)
+    {
+        return;
+    }
+
+    finalized_ = true;
+
+    const size_t stride = has_normals_ ? 6 : 3;
+
+    std::vector<TileInfo> infos;
+    infos.reserve(tiles_.size());
+
+    for (auto &entry : tiles_)
+    {
+        PendingTile &tile = entry.second;
+        flush(tile);
+
+        const std::string name = TileStore::tile_filename(tile.info.x, tile.info.y);
+        const std::string stage_path = directory_ + "/" + name + ".stage";
+
+        const std::string tile_path = directory_ + "/" + name;
+
+        {
+            std::ofstream output(tile_path, std::ios::binary | std::ios::trunc);
+            TileHeader header{kTileMagic, kFormatVersion, tile.info.count, has_normals_ ? kNormalsFlag : 0u, 0, 0};
+            write_value(output, header);
+
+            if (!output)
+            {
+                throw std::runtime_error("Unable to write tile " + name);
+            }
+        }
+
+        std::filesystem::resize_file(tile_path, kTileHeaderSize + stride * tile.info.count * sizeof(float));
+
+        // Transposes the staged points batch by batch, writing each channel slice in place.
+        std::ifstream stage(stage_path, std::ios::binary);
+        std::fstream output(tile_path, std::ios::binary | std::ios::in | std::ios::out);
+        std::vector<float> interleaved(std::min<uint64_t>(tile.info.count, kTransposeBatch) * stride);
+        std::vector<float> channel(std::min<uint64_t>(tile.info.count, kTransposeBatch));
+
+        for (uint64_t begin = 0; begin < tile.info.count; begin += kTransposeBatch)
+        {
+            const size_t batch = static_cast<size_t>(std::min<uint64_t>(kTransposeBatch, tile.info.count - begin));
+            stage.read(reinterpret_cast<char *>(interleaved.data()), batch * stride * sizeof(float));
+
+            if (!stage)
+            {
+                throw std::runtime_error("Unable to read " + stage_path);
+            }
+
+            for (size_t c = 0; c < stride; c++)
+            {
+                for (size_t i = 0; i < batch; i++)
+                {
+                    channel[i] = interleaved[i * stride + c];
+                }
+
+                output.seekp(static_cast<std::streamoff>(kTileHeaderSize + (c * tile.info.count + begin) * sizeof(float)));
+                output.write(reinterpret_cast<const char *>(channel.data()), batch * sizeof(float));
+            }
+        }
+
+        if (!output)
+        {
+            throw std::runtime_error("Unable to write tile " + name);
+        }
+
+        stage.close();
+        std::remove(stage_path.c_str());
+        infos.push_back(tile.info);
+    }
+
+    std::sort(infos.begin(), infos.end(), [](const TileInfo &a, const TileInfo &b)
+              { return a.y != b.y ? a.y < b.y : a.x < b.x; });
+
+    std::ofstream index(directory_ + "/" + kIndexFilename, std::ios::binary | std::ios::trunc);
+
+    write_value(index, kIndexMagic);
+    write_value(index, kFormatVersion);
+    write_value(index, tile_size_);
+    write_value(index, has_normals_ ? kNormalsFlag : 0u);
+
+    for (int32_t c = 0; c < 3; c++)
+    {
+        write_value(index, origin_[c]);
+    }
+
+    write_value(index, static_cast<uint64_t>(infos.size()));
+
+    for (const TileInfo &info : infos)
+    {
+        write_value(index, info.x);
+        write_value(index, info.y);
+        write_value(index, info.count);
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            write_value(index, info.minimum[c]);
+        }
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            write_value(index, info.maximum[c]);
+        }
+    }
+
+    if (!index)
+    {
+        throw std::runtime_error("Unable to write tile index in " + directory_);
+    }
+
+    tiles_.clear();
+}
+
+TileView::TileView(const std::string &path) : file_(path), count_(0), has_normals_(false)
+{
+    if (file_.size() < kTileHeaderSize)
+    {
+        throw std::runtime_error("Truncated tile " + path);
+    }
+
+    TileHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+
+    if (header.magic != kTileMagic || header.version != kFormatVersion)
+    {
+        throw std::runtime_error("Unsupported tile format in " + path);
+    }
+
+    count_ = header.count;
+    has_normals_ = (header.flags & kNormalsFlag) != 0;
+
+    const size_t channels = has_normals_ ? 6 : 3;
+
+    if (file_.size() < kTileHeaderSize + channels * count_ * sizeof(float))
+    {
+        throw std::runtime_error("Truncated tile " + path);
+    }
+}
+
+const float *TileView::channel(const int32_t &index) const
+{
+    return reinterpret_cast<const float *>(file_.data() + kTileHeaderSize) + index * count_;
+}
+
+size_t TileView::size() const
+{
+    return static_cast<size_t>(count_);
+}
+
+bool TileView::has_normals() const
+{
+    return has_normals_;
+}
+
+size_t TileView::memory_usage() const
+{
+    return file_.size();
+}
+
+void TileView::touch() const
+{
+    file_.touch();
+}
+
+const float *TileView::x() const
+{
+    return channel(0);
+}
+
+const float *TileView::y() const
+{
+    return channel(1);
+}
+
+const float *TileView::z() const
+{
+    return channel(2);
+}
+
+const float *TileView::normal_x() const
+{
+    return has_normals_ ? channel(3) : nullptr;
+}
+
+const float *TileView::normal_y() const
+{
+    return has_normals_ ? channel(4) : nullptr;
+}
+
+const float *TileView::normal_z() const
+{
+    return has_normals_ ? channel(5) : nullptr;
+}
+
+TileStore::TileStore(const std::string &directory) : directory_(directory), tile_size_(0.0f), has_normals_(false)
+{
+    const std::string path = directory_ + "/" + kIndexFilename;
+    std::ifstream index(path, std::ios::binary);
+
+    if (!index)
+    {
+        throw std::runtime_error("Unable to open " + path);
+    }
+
+    uint32_t magic = 0, version = 0, flags = 0;
+    uint64_t count = 0;
+
+    read_value(index, magic);
+    read_value(index, version);
+    read_value(index, tile_size_);
+    read_value(index, flags);
+
+    double origin[3] = {0.0, 0.0, 0.0};
+
+    for (int32_t c = 0; c < 3; c++)
+    {
+        read_value(index, origin[c]);
+    }
+
+    origin_ = Vector4d(origin[0], origin[1], origin[2]);
+    read_value(index, count);
+
+    if (!index || magic != kIndexMagic || version != kFormatVersion)
+    {
+        throw std::runtime_error("Unsupported tile index " + path);
+    }
+
+    has_normals_ = (flags & kNormalsFlag) != 0;
+
+    // A corrupt count must not size the table before the records backing it are known to exist.
+    const uint64_t remaining = std::filesystem::file_size(path) - static_cast<uint64_t>(index.tellg());
+
+    if (count > remaining / kIndexRecordSize)
+    {
+        throw std::runtime_error("Truncated tile index " + path);
+    }
+
+    tiles_.resize(count);
+
+    for (TileInfo &info : tiles_)
+    {
+        read_value(index, info.x);
+        read_value(index, info.y);
+        read_value(index, info.count);
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            read_value(index, info.minimum[c]);
+        }
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            read_value(index, info.maximum[c]);
+        }
+    }
+
+    if (!index)
+    {
+        throw std::runtime_error("Truncated tile index " + path);
+    }
+
+    for (size_t i = 0; i < tiles_.size(); i++)
+    {
+        lookup_[tile_key(tiles_[i].x, tiles_[i].y)] = i;
+    }
+}
+
+const std::string &TileStore::directory() const
+{
+    return directory_;
+}
+
+float TileStore::tile_size() const
+{
+    return tile_size_;
+}
+
+const Vector4d &TileStore::origin() const
+{
+    return origin_;
+}
+
+bool TileStore::has_normals() const
+{
+    return has_normals_;
+}
+
+size_t TileStore::tile_count() const
+{
+    return tiles_.size();
+}
+
+uint64_t TileStore::point_count() const
+{
+    uint64_t total = 0;
+
+    for (const TileInfo &info : tiles_)
+    {
+        total += info.count;
+    }
+
+    return total;
+}
+
+const TileInfo &TileStore::tile(const size_t &index) const
+{
+    return tiles_[index];
+}
+
+int64_t TileStore::find(const int32_t &x, const int32_t &y) const
+{
+    auto found = lookup_.find(tile_key(x, y));
+    return found == lookup_.end() ? -1 : static_cast<int64_t>(found->second);
+}
+
+std::string TileStore::tile_path(const size_t &index) const
+{
+    return directory_ + "/" + tile_filename(tiles_[index].x, tiles_[index].y);
+}
+
+size_t TileStore::tile_bytes(const size_t &index) const
+{
+    return kTileHeaderSize + (has_normals_ ? 6 : 3) * tiles_[index].count * sizeof(float);
+}
+
+std::vector<size_t> TileStore::neighbours(const size_t &index, const float &halo) const
+{
+    std::vector<size_t> result;
+
+    const int32_t reach = static_cast<int32_t>(std::ceil(std::max(halo, 0.0f) / tile_size_));
+    const TileInfo &centre = tiles_[index];
+
+    for (int32_t dy = -reach; dy <= reach; dy++)
+    {
+        for (int32_t dx = -reach; dx <= reach; dx++)
+        {
+            if (dx == 0 && dy == 0)
+            {
+                continue;
+            }
+
+            const int64_t found = find(centre.x + dx, centre.y + dy);
+
+            if (found >= 0)
+            {
+                result.push_back(static_cast<size_t>(found));
+            }
+        }
+    }
+
+    return result;
+}
+
+uint64_t TileStore::tile_key(const int32_t &x, const int32_t &y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+std::string TileStore::tile_filename(const int32_t &x, const int32_t &y)
+{
+    return "tile_" + std::to_string(x) + "_" + std::to_string(y) + ".bin";
+}
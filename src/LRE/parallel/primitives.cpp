@@ -0,0 +1,580 @@
+#include <LRE/parallel/primitives.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <limits>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    constexpr size_t kBuckets = size_t(1) << ParallelPrimitives::kRadixBits;
+    constexpr size_t kDigitMask = kBuckets - 1;
+
+    // Oversubscribe blocks so uneven chunks still balance across the workers and the calling thread.
+    size_t block_count_for(const size_t &count, const ThreadPool &pool, const size_t &per_thread)
+    {
+        return std::max<size_t>(1, std::min(per_thread * (pool.size() + 1), count / ParallelPrimitives::kMinBlock));
+    }
+
+    // Offsets, counts and compacted indices are 32-bit.
+    void check_count(const size_t &count)
+    {
+        if (count > std::numeric_limits<uint32_t>::max())
+        {
+            throw std::length_error("ParallelPrimitives: more than 2^32 - 1 entries");
+        }
+    }
+
+    // Bits in which any key differs from the reference; a zero digit means the radix pass would be the identity.
+    uint64_t varying_bits(const uint64_t *keys, const size_t &count, const uint64_t &reference)
+    {
+        uint64_t varying = 0;
+        size_t i = 0;
+
+#ifdef __AVX__
+
+        const __m256d broadcast = _mm256_castsi256_pd(_mm256_set1_epi64x(static_cast<int64_t>(reference)));
+        __m256d accumulator = _mm256_setzero_pd();
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m256d block = _mm256_loadu_pd(reinterpret_cast<const double *>(keys + i));
+            accumulator = _mm256_or_pd(accumulator, _mm256_xor_pd(block, broadcast));
+        }
+
+        uint64_t lanes[4];
+        _mm256_storeu_pd(reinterpret_cast<double *>(lanes), accumulator);
+        varying = lanes[0] | lanes[1] | lanes[2] | lanes[3];
+
+#endif
+
+        for (; i < count; i++)
+        {
+            varying |= keys[i] ^ reference;
+        }
+
+        return varying;
+    }
+
+    uint64_t varying_bits(const uint32_t *keys, const size_t &count, const uint32_t &reference)
+    {
+        uint32_t varying = 0;
+        size_t i = 0;
+
+#ifdef __AVX__
+
+        const __m256 broadcast = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int32_t>(reference)));
+        __m256 accumulator = _mm256_setzero_ps();
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 block = _mm256_loadu_ps(reinterpret_cast<const float *>(keys + i));
+            accumulator = _mm256_or_ps(accumulator, _mm256_xor_ps(block, broadcast));
+        }
+
+        uint32_t lanes[8];
+        _mm256_storeu_ps(reinterpret_cast<float *>(lanes), accumulator);
+
+        for (const uint32_t &lane : lanes)
+        {
+            varying |= lane;
+        }
+
+#endif
+
+        for (; i < count; i++)
+        {
+            varying |= keys[i] ^ reference;
+        }
+
+        return varying;
+    }
+
+    // Four interleaved sub-histograms break the store-to-load chain when neighbouring keys share a digit.
+    template <typename Key>
+    void count_digits(const Key *keys, const size_t &count, const size_t &shift, uint32_t *counts)
+    {
+        uint32_t partial[4][kBuckets] = {};
+        size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            partial[0][(keys[i] >> shift) & kDigitMask]++;
+            partial[1][(keys[i + 1] >> shift) & kDigitMask]++;
+            partial[2][(keys[i + 2] >> shift) & kDigitMask]++;
+            partial[3][(keys[i + 3] >> shift) & kDigitMask]++;
+        }
+
+        for (; i < count; i++)
+        {
+            partial[0][(keys[i] >> shift) & kDigitMask]++;
+        }
+
+        for (size_t d = 0; d < kBuckets; d++)
+        {
+            counts[d] = partial[0][d] + partial[1][d] + partial[2][d] + partial[3][d];
+        }
+    }
+
+    // Entries are staged per bucket and flushed a cache line at a time; writing 256 scattered streams
+    // directly thrashes the TLB and write-combining buffers once the arrays leave the cache.
+    template <typename Key>
+    void scatter_block(const Key *keys, const uint32_t *values, const size_t &count, const size_t &shift,
+                       const uint32_t *offsets, Key *target_keys, uint32_t *target_values)
+    {
+        constexpr uint32_t kStaged = 64 / sizeof(Key);
+
+        uint32_t cursor[kBuckets];
+        uint32_t filled[kBuckets] = {};
+        std::copy(offsets, offsets + kBuckets, cursor);
+
+        std::vector<Key> staged_keys(kBuckets * kStaged);
+        std::vector<uint32_t> staged_values(target_values != nullptr ? kBuckets * kStaged : 0);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const size_t digit = (keys[i] >> shift) & kDigitMask;
+            const size_t slot = digit * kStaged + filled[digit];
+
+            staged_keys[slot] = keys[i];
+
+            if (target_values != nullptr)
+            {
+                staged_values[slot] = values[i];
+            }
+
+            if (++filled[digit] == kStaged)
+            {
+                std::copy(&staged_keys[digit * kStaged], &staged_keys[digit * kStaged] + kStaged, target_keys + cursor[digit]);
+
+                if (target_values != nullptr)
+                {
+                    std::copy(&staged_values[digit * kStaged], &staged_values[digit * kStaged] + kStaged, target_values + cursor[digit]);
+                }
+
+                cursor[digit] += kStaged;
+                filled[digit] = 0;
+            }
+        }
+
+        for (size_t digit = 0; digit < kBuckets; digit++)
+        {
+            std::copy(&staged_keys[digit * kStaged], &staged_keys[digit * kStaged] + filled[digit], target_keys + cursor[digit]);
+
+            if (target_values != nullptr)
+            {
+                std::copy(&staged_values[digit * kStaged], &staged_values[digit * kStaged] + filled[digit], target_values + cursor[digit]);
+            }
+        }
+    }
+
+    template <typename Key>
+    void sort_pairs(std::vector<Key> &keys, std::vector<uint32_t> *values, ThreadPool &pool)
+    {
+        LRE_PROFILE_SCOPE("ParallelPrimitives::radix_sort");
+
+        const size_t count = keys.size();
+
+        if (values != nullptr && values->size() != count)
+        {
+            throw std::invalid_argument("ParallelPrimitives: keys and values differ in size");
+        }
+
+        check_count(count);
+
+        if (count < 2)
+        {
+            return;
+        }
+
+        const size_t block_count = block_count_for(count, pool, 4);
+        const size_t block_size = (count + block_count - 1) / block_count;
+
+        std::vector<uint64_t> block_varying(block_count, 0);
+        const Key reference = keys[0];
+
+        pool.parallel_for(0, block_count, 1, [&keys, &block_varying, reference, block_size, count](const size_t &first, const size_t &last)
+                          {
+                              for (size_t b = first; b < last; b++)
+                              {
+                                  const size_t begin = std::min(count, b * block_size);
+                                  const size_t end = std::min(count, begin + block_size);
+                                  block_varying[b] = varying_bits(keys.data() + begin, end - begin, reference);
+                              } });
+
+        uint64_t varying = 0;
+
+        for (const uint64_t &bits : block_varying)
+        {
+            varying |= bits;
+        }
+
+        std::vector<Key> key_buffer;
+        std::vector<uint32_t> value_buffer;
+        std::vector<uint32_t> offsets(block_count * kBuckets);
+
+        Key *source_keys = keys.data();
+        uint32_t *source_values = values != nullptr ? values->data() : nullptr;
+        bool in_buffer = false;
+
+        for (size_t shift = 0; shift < sizeof(Key) * 8; shift += ParallelPrimitives::kRadixBits)
+        {
+            if (((varying >> shift) & kDigitMask) == 0)
+            {
+                continue;
+            }
+
+            if (key_buffer.empty())
+            {
+                key_buffer.resize(count);
+
+                if (values != nullptr)
+                {
+                    value_buffer.resize(count);
+                }
+            }
+
+            Key *target_keys = in_buffer ? keys.data() : key_buffer.data();
+            uint32_t *target_values = values == nullptr ? nullptr : (in_buffer ? values->data() : value_buffer.data());
+
+            pool.parallel_for(0, block_count, 1, [source_keys, &offsets, shift, block_size, count](const size_t &first, const size_t &last)
+                              {
+                                  for (size_t b = first; b < last; b++)
+                                  {
+                                      const size_t begin = std::min(count, b * block_size);
+                                      const size_t end = std::min(count, begin + block_size);
+                                      count_digits(source_keys + begin, end - begin, shift, &offsets[b * kBuckets]);
+                                  } });
+
+            // Digit-major, block-minor offsets keep equal digits in block order, which is what makes the sort stable.
+            uint32_t running = 0;
+
+            for (size_t d = 0; d < kBuckets; d++)
+            {
+                for (size_t b = 0; b < block_count; b++)
+                {
+                    const uint32_t bucket = offsets[b * kBuckets + d];
+                    offsets[b * kBuckets + d] = running;
+                    running += bucket;
+                }
+            }
+
+            pool.parallel_for(0, block_count, 1, [source_keys, source_values, target_keys, target_values, &offsets, shift, block_size, count](const size_t &first, const size_t &last)
+                              {
+                                  for (size_t b = first; b < last; b++)
+                                  {
+                                      const size_t begin = std::min(count, b * block_size);
+                                      const size_t end = std::min(count, begin + block_size);
+
+                                      scatter_block(source_keys + begin, source_values == nullptr ? nullptr : source_values + begin,
+                                                    end - begin, shift, &offsets[b * kBuckets], target_keys, target_values);
+                                  } });
+
+            source_keys = target_keys;
+            source_values = target_values;
+            in_buffer = !in_buffer;
+        }
+
+        if (in_buffer)
+        {
+            keys.swap(key_buffer);
+
+            if (values != nullptr)
+            {
+                values->swap(value_buffer);
+            }
+        }
+    }
+
+    uint32_t sum(const uint32_t *values, const size_t &count)
+    {
+        uint32_t total = 0;
+        size_t i = 0;
+
+#ifdef __AVX__
+
+        __m128i accumulator = _mm_setzero_si128();
+
+        for (; i + 4 <= count; i += 4)
+        {
+            accumulator = _mm_add_epi32(accumulator, _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i)));
+        }
+
+        uint32_t lanes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), accumulator);
+        total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+#endif
+
+        for (; i < count; i++)
+        {
+            total += values[i];
+        }
+
+        return total;
+    }
+
+    void scan_block(uint32_t *values, const size_t &count, uint32_t carry)
+    {
+        size_t i = 0;
+
+#ifdef __AVX__
+
+        // Two shifted adds give the inclusive prefix of four lanes; subtracting the input makes it exclusive.
+        __m128i running = _mm_set1_epi32(static_cast<int32_t>(carry));
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i));
+            __m128i prefix = _mm_add_epi32(input, _mm_slli_si128(input, 4));
+            prefix = _mm_add_epi32(prefix, _mm_slli_si128(prefix, 8));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(values + i), _mm_add_epi32(running, _mm_sub_epi32(prefix, input)));
+            running = _mm_add_epi32(running, _mm_shuffle_epi32(prefix, 0xff));
+        }
+
+        carry = static_cast<uint32_t>(_mm_cvtsi128_si32(running));
+
+#endif
+
+        for (; i < count; i++)
+        {
+            const uint32_t value = values[i];
+            values[i] = carry;
+            carry += value;
+        }
+    }
+
+    uint32_t count_flags(const uint8_t *flags, const size_t &count)
+    {
+        uint32_t total = 0;
+        size_t i = 0;
+
+#ifdef __AVX__
+
+        const __m128i zero = _mm_setzero_si128();
+
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(flags + i));
+            total += 16 - __builtin_popcount(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero))));
+        }
+
+#endif
+
+        for (; i < count; i++)
+        {
+            total += flags[i] != 0;
+        }
+
+        return total;
+    }
+
+    void write_flags(const uint8_t *flags, const size_t &begin, const size_t &end, uint32_t *output)
+    {
+        size_t i = begin;
+
+#ifdef __AVX__
+
+        const __m128i zero = _mm_setzero_si128();
+
+        for (; i + 16 <= end; i += 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(flags + i));
+            const uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero))) & 0xffff;
+
+            // Groups without kept entries, the common case for selective filters, cost one compare.
+            if (mask == 0)
+            {
+                continue;
+            }
+
+            for (uint32_t bit = 0; bit < 16; bit++)
+            {
+                if (((mask >> bit) & 1) != 0)
+                {
+                    *output++ = static_cast<uint32_t>(i + bit);
+                }
+            }
+        }
+
+#endif
+
+        for (; i < end; i++)
+        {
+            if (flags[i] != 0)
+            {
+                *output++ = static_cast<uint32_t>(i);
+            }
+        }
+    }
+}
+
+void ParallelPrimitives::radix_sort(std::vector<uint32_t> &keys, std::vector<uint32_t> &values, ThreadPool &pool)
+{
+    sort_pairs(keys, &values, pool);
+}
+
+void ParallelPrimitives::radix_sort(std::vector<uint32_t> &keys, std::vector<uint32_t> &values)
+{
+    radix_sort(keys, values, ThreadPool::shared());
+}
+
+void ParallelPrimitives::radix_sort(std::vector<uint64_t> &keys, std::vector<uint32_t> &values, ThreadPool &pool)
+{
+    sort_pairs(keys, &values, pool);
+}
+
+void ParallelPrimitives::radix_sort(std::vector<uint64_t> &keys, std::vector<uint32_t> &values)
+{
+    radix_sort(keys, values, ThreadPool::shared());
+}
+
+void ParallelPrimitives::radix_sort(std::vector<uint64_t> &keys, ThreadPool &pool)
+{
+    sort_pairs(keys, nullptr, pool);
+}
+
+void ParallelPrimitives::radix_sort(std::vector<uint64_t> &keys)
+{
+    radix_sort(keys, ThreadPool::shared());
+}
+
+uint32_t ParallelPrimitives::exclusive_scan(std::vector<uint32_t> &values, ThreadPool &pool)
+{
+    LRE_PROFILE_SCOPE("ParallelPrimitives::exclusive_scan");
+
+    const size_t count = values.size();
+    const size_t block_count = block_count_for(count, pool, 1);
+    const size_t block_size = (count + block_count - 1) / std::max<size_t>(1, block_count);
+
+    std::vector<uint32_t> carries(block_count, 0);
+
+    pool.parallel_for(0, block_count, 1, [&values, &carries, block_size, count](const size_t &first, const size_t &last)
+                      {
+                          for (size_t b = first; b < last; b++)
+                          {
+                              const size_t begin = std::min(count, b * block_size);
+                              carries[b] = sum(values.data() + begin, std::min(count, begin + block_size) - begin);
+                          } });
+
+    uint32_t total = 0;
+
+    for (uint32_t &carry : carries)
+    {
+        const uint32_t block_total = carry;
+        carry = total;
+        total += block_total;
+    }
+
+    pool.parallel_for(0, block_count, 1, [&values, &carries, block_size, count](const size_t &first, const size_t &last)
+                      {
+                          for (size_t b = first; b < last; b++)
+                          {
+                              const size_t begin = std::min(count, b * block_size);
+                              scan_block(values.data() + begin, std::min(count, begin + block_size) - begin, carries[b]);
+                          } });
+
+    return total;
+}
+
+uint32_t ParallelPrimitives::exclusive_scan(std::vector<uint32_t> &values)
+{
+    return exclusive_scan(values, ThreadPool::shared());
+}
+
+std::vector<uint32_t> ParallelPrimitives::compact(const std::vector<uint8_t> &flags, ThreadPool &pool)
+{
+    LRE_PROFILE_SCOPE("ParallelPrimitives::compact");
+
+    const size_t count = flags.size();
+    check_count(count);
+
+    const size_t block_count = block_count_for(count, pool, 1);
+    const size_t block_size = (count + block_count - 1) / block_count;
+
+    std::vector<uint32_t> starts(block_count, 0);
+
+    pool.parallel_for(0, block_count, 1, [&flags, &starts, block_size, count](const size_t &first, const size_t &last)
+                      {
+                          for (size_t b = first; b < last; b++)
+                          {
+                              const size_t begin = std::min(count, b * block_size);
+                              starts[b] = count_flags(flags.data() + begin, std::min(count, begin + block_size) - begin);
+                          } });
+
+    const uint32_t total = exclusive_scan(starts, pool);
+
+    std::vector<uint32_t> indices(total);
+
+    pool.parallel_for(0, block_count, 1, [&flags, &starts, &indices, block_size, count](const size_t &first, const size_t &last)
+                      {
+                          for (size_t b = first; b < last; b++)
+                          {
+                              const size_t begin = std::min(count, b * block_size);
+                              write_flags(flags.data(), begin, std::min(count, begin + block_size), indices.data() + starts[b]);
+                          } });
+
+    return indices;
+}
+
+std::vector<uint32_t> ParallelPrimitives::compact(const std::vector<uint8_t> &flags)
+{
+    return compact(flags, ThreadPool::shared());
+}
+
+std::vector<uint32_t> ParallelPrimitives::histogram(const std::vector<uint32_t> &bins, const size_t &bin_count, ThreadPool &pool)
+{
+    LRE_PROFILE_SCOPE("ParallelPrimitives::histogram");
+
+    const size_t count = bins.size();
+    const size_t block_count = block_count_for(count, pool, 1);
+    const size_t block_size = (count + block_count - 1) / block_count;
+
+    std::vector<uint32_t> partial(block_count * bin_count, 0);
+
+    pool.parallel_for(0, block_count, 1, [&bins, &partial, bin_count, block_size, count](const size_t &first, const size_t &last)
+                      {
+                          for (size_t b = first; b < last; b++)
+                          {
+                              const size_t begin = std::min(count, b * block_size);
+                              const size_t end = std::min(count, begin + block_size);
+                              uint32_t *counts = &partial[b * bin_count];
+
+                              for (size_t i = begin; i < end; i++)
+                              {
+                                  if (bins[i] >= bin_count)
+                                  {
+                                      throw std::out_of_range("ParallelPrimitives: bin out of range");
+                                  }
+
+                                  counts[bins[i]]++;
+                              }
+                          } });
+
+    if (block_count == 1)
+    {
+        return partial;
+    }
+
+    std::vector<uint32_t> counts(bin_count, 0);
+
+    pool.parallel_for(0, bin_count, kMinBlock, [&partial, &counts, block_count, bin_count](const size_t &begin, const size_t &end)
+                      {
+                          for (size_t b = 0; b < block_count; b++)
+                          {
+                              for (size_t i = begin; i < end; i++)
+                              {
+                                  counts[i] += partial[b * bin_count + i];
+                              }
+                          } });
+
+    return counts;
+}
+
+std::vector<uint32_t> ParallelPrimitives::histogram(const std::vector<uint32_t> &bins, const size_t &bin_count)
+{
+    return histogram(bins, bin_count, ThreadPool::shared());
+}
@@ -0,0 +1,74 @@
+#include <LRE/parallel/thread_pool.hpp>
+
+ThreadPool::ThreadPool(const size_t &thread_count) : stopping_(false)
+{
+    workers_.reserve(thread_count);
+
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        workers_.emplace_back(&ThreadPool::worker_loop, this);
+    }
+}
+
+ThreadPool::ThreadPool() : ThreadPool(std::max(1u, std::thread::hardware_concurrency()))
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+
+    condition_.notify_all();
+
+    for (std::thread &worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::size() const
+{
+    return workers_.size();
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+
+    condition_.notify_one();
+}
+
+void ThreadPool::worker_loop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+
+            if (stopping_ && tasks_.empty())
+            {
+                return;
+            }
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        task();
+    }
+}
+
+ThreadPool &ThreadPool::shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
@@ -0,0 +1,389 @@
+#include <LRE/pipeline/pipeline.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    constexpr int32_t kSpinCount = 64;
+
+    void record_max(std::atomic<uint64_t> &maximum, const uint64_t &value)
+    {
+        uint64_t previous = maximum.load();
+
+        while (value > previous && !maximum.compare_exchange_weak(previous, value))
+        {
+        }
+    }
+}
+
+Pipeline::Pipeline(const size_t &ring_capacity, const size_t &batch_capacity)
+    : ring_capacity_(ring_capacity), batch_capacity_(batch_capacity), running_(false), closed_(false), aborting_(false),
+      next_sequence_(0), rejected_inputs_(0)
+{
+    rings_.push_back(std::make_unique<SpscRing<PointBatch>>(ring_capacity_));
+}
+
+Pipeline::~Pipeline()
+{
+    stop();
+}
+
+void Pipeline::add_stage(const std::string &name, std::function<bool(PointBatch &)> function, const OverloadPolicy &policy)
+{
+    if (running_)
+    {
+        throw std::logic_error("Stages must be added before the pipeline starts");
+    }
+
+    std::unique_ptr<Stage> stage = std::make_unique<Stage>();
+    stage->name = name;
+    stage->function = std::move(function);
+    stage->policy = policy;
+
+    stages_.push_back(std::move(stage));
+    rings_.push_back(std::make_unique<SpscRing<PointBatch>>(ring_capacity_));
+}
+
+void Pipeline::start()
+{
+    if (running_)
+    {
+        return;
+    }
+
+    // Preallocate every slot so steady-state batches only swap buffers.
+    for (std::unique_ptr<SpscRing<PointBatch>> &ring : rings_)
+    {
+        for (size_t i = 0; i < ring->capacity(); i++)
+        {
+            ring->slot(i).cloud.reserve(batch_capacity_);
+        }
+    }
+
+    closed_ = false;
+    aborting_ = false;
+    running_ = true;
+
+    for (size_t i = 0; i < stages_.size(); i++)
+    {
+        stages_[i]->finished = false;
+        stages_[i]->thread = std::thread(&Pipeline::run_stage, this, i);
+    }
+}
+
+void Pipeline::close()
+{
+    closed_ = true;
+    wake(0);
+}
+
+bool Pipeline::finished() const
+{
+    for (const std::unique_ptr<Stage> &stage : stages_)
+    {
+        if (!stage->finished)
+        {
+            return false;
+        }
+    }
+
+    return closed_.load();
+}
+
+void Pipeline::stop()
+{
+    if (!running_)
+    {
+        return;
+    }
+
+    // Stages still drain their inputs, but blocked writers give up instead of waiting on a reader that left.
+    closed_ = true;
+    aborting_ = true;
+
+    for (size_t i = 0; i < stages_.size(); i++)
+    {
+        wake(i);
+    }
+
+    for (std::unique_ptr<Stage> &stage : stages_)
+    {
+        stage->thread.join();
+    }
+
+    running_ = false;
+}
+
+bool Pipeline::upstream_finished(const size_t &index) const
+{
+    return index == 0 ? closed_.load() : stages_[index - 1]->finished.load();
+}
+
+void Pipeline::wake(const size_t &index)
+{
+    if (index >= stages_.size())
+    {
+        return;
+    }
+
+    Stage &stage = *stages_[index];
+    stage.wakeups++;
+
+    if (stage.parked)
+    {
+        std::lock_guard<std::mutex> lock(stage.mutex);
+        stage.condition.notify_one();
+    }
+}
+
+// Spins briefly for low latency under load, then sleeps until a wake() after the stage observed its counter.
+void Pipeline::park(Stage &stage, const uint64_t &observed)
+{
+    for (int32_t i = 0; i < kSpinCount; i++)
+    {
+        if (stage.wakeups != observed)
+        {
+            return;
+        }
+
+        std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock(stage.mutex);
+    stage.parked = true;
+    stage.condition.wait(lock, [&stage, &observed]
+                         { return stage.wakeups != observed; });
+    stage.parked = false;
+}
+
+void Pipeline::run_stage(const size_t &index)
+{
+    Stage &stage = *stages_[index];
+    SpscRing<PointBatch> &input = *rings_[index];
+    SpscRing<PointBatch> &output = *rings_[index + 1];
+
+    PointBatch pending;
+    pending.merged = 0;
+    pending.sequence = 0;
+    bool has_pending = false;
+
+    auto publish = [this, &output, &index](PointBatch &batch)
+    {
+        PointBatch *slot = output.begin_push();
+        std::swap(*slot, batch);
+        batch.cloud.clear();
+        output.commit_push();
+        wake(index + 1);
+    };
+
+    // Freeing an input slot may unblock the stage writing into it.
+    auto consume = [this, &input, &index]()
+    {
+        input.pop();
+
+        if (index > 0)
+        {
+            wake(index - 1);
+        }
+    };
+
+    while (true)
+    {
+        const uint64_t observed = stage.wakeups;
+        PointBatch *batch = input.front();
+
+        if (batch == nullptr)
+        {
+            if (has_pending && !output.full())
+            {
+                publish(pending);
+                has_pending = false;
+                continue;
+            }
+
+            if (upstream_finished(index) && input.empty())
+            {
+                if (!has_pending)
+                {
+                    break;
+                }
+
+                if (aborting_)
+                {
+                    stage.dropped += pending.merged + 1;
+                    break;
+                }
+            }
+
+            park(stage, observed);
+            continue;
+        }
+
+        LRE_PROFILE_COUNT(Counter::PointsProcessed, batch->cloud.size());
+
+        const auto begin = std::chrono::steady_clock::now();
+        bool keep = false;
+
+        {
+            LRE_PROFILE_SCOPE("Pipeline::stage");
+            keep = stage.function(*batch);
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        const uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+        const uint64_t age = std::chrono::duration_cast<std::chrono::nanoseconds>(end - batch->created).count();
+
+        stage.processed++;
+        stage.total_latency_ns += elapsed;
+        stage.total_age_ns += age;
+
+        record_max(stage.max_latency_ns, elapsed);
+        record_max(stage.max_age_ns, age);
+
+        if (!keep)
+        {
+            stage.rejected++;
+            batch->cloud.clear();
+            consume();
+            continue;
+        }
+
+        if (output.full() && stage.policy == OverloadPolicy::Block)
+        {
+            while (true)
+            {
+                const uint64_t blocked = stage.wakeups;
+
+                if (!output.full() || aborting_)
+                {
+                    break;
+                }
+
+                park(stage, blocked);
+            }
+        }
+
+        if (output.full() || has_pending)
+        {
+            if (stage.policy == OverloadPolicy::Coalesce)
+            {
+                // Merge into the held-back batch; it keeps the oldest creation time for honest latency.
+                if (!has_pending)
+                {
+                    std::swap(pending, *batch);
+                    has_pending = true;
+                }
+                else
+                {
+                    pending.cloud.append(batch->cloud);
+                    pending.merged += batch->merged + 1;
+                    stage.coalesced++;
+                }
+
+                batch->cloud.clear();
+                consume();
+
+                if (!output.full())
+                {
+                    publish(pending);
+                    has_pending = false;
+                }
+
+                continue;
+            }
+
+            if (output.full())
+            {
+                stage.dropped++;
+                batch->cloud.clear();
+                consume();
+                continue;
+            }
+        }
+
+        publish(*batch);
+        consume();
+    }
+
+    stage.finished = true;
+    wake(index + 1);
+}
+
+bool Pipeline::push(PointCloud &points)
+{
+    SpscRing<PointBatch> &input = *rings_.front();
+    PointBatch *slot = input.begin_push();
+
+    if (slot == nullptr)
+    {
+        rejected_inputs_++;
+        return false;
+    }
+
+    std::swap(slot->cloud, points);
+    points.clear();
+
+    slot->sequence = next_sequence_++;
+    slot->merged = 0;
+    slot->created = std::chrono::steady_clock::now();
+
+    input.commit_push();
+    wake(0);
+    return true;
+}
+
+bool Pipeline::pop(PointBatch &batch)
+{
+    SpscRing<PointBatch> &output = *rings_.back();
+    PointBatch *front = output.front();
+
+    if (front == nullptr)
+    {
+        return false;
+    }
+
+    std::swap(batch, *front);
+    front->cloud.clear();
+    output.pop();
+
+    if (!stages_.empty())
+    {
+        wake(stages_.size() - 1);
+    }
+
+    return true;
+}
+
+size_t Pipeline::stage_count() const
+{
+    return stages_.size();
+}
+
+const std::string &Pipeline::stage_name(const size_t &index) const
+{
+    return stages_[index]->name;
+}
+
+StageStatistics Pipeline::statistics(const size_t &index) const
+{
+    const Stage &stage = *stages_[index];
+
+    StageStatistics result;
+    result.processed = stage.processed.load();
+    result.rejected = stage.rejected.load();
+    result.dropped = stage.dropped.load();
+    result.coalesced = stage.coalesced.load();
+    result.mean_latency_us = result.processed == 0 ? 0.0 : 1e-3 * stage.total_latency_ns.load() / result.processed;
+    result.max_latency_us = 1e-3 * stage.max_latency_ns.load();
+    result.mean_age_us = result.processed == 0 ? 0.0 : 1e-3 * stage.total_age_ns.load() / result.processed;
+    result.max_age_us = 1e-3 * stage.max_age_ns.load();
+
+    return result;
+}
+
+uint64_t Pipeline::rejected_inputs() const
+{
+    return rejected_inputs_.load();
+}
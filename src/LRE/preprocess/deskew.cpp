@@ -0,0 +1,261 @@
+#include <LRE/preprocess/deskew.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+namespace
+{
+    constexpr size_t kDeskewGrain = 16384;
+
+#ifdef __AVX__
+
+    // Taylor series up to x^11, accurate to float precision on [0, pi/2].
+    inline __m256 sin_quarter_turn(const __m256 &x)
+    {
+        const __m256 x2 = _mm256_mul_ps(x, x);
+
+        __m256 poly = _mm256_set1_ps(-1.0f / 39916800.0f);
+        poly = _mm256_add_ps(_mm256_mul_ps(poly, x2), _mm256_set1_ps(1.0f / 362880.0f));
+        poly = _mm256_add_ps(_mm256_mul_ps(poly, x2), _mm256_set1_ps(-1.0f / 5040.0f));
+        poly = _mm256_add_ps(_mm256_mul_ps(poly, x2), _mm256_set1_ps(1.0f / 120.0f));
+        poly = _mm256_add_ps(_mm256_mul_ps(poly, x2), _mm256_set1_ps(-1.0f / 6.0f));
+        poly = _mm256_add_ps(_mm256_mul_ps(poly, x2), _mm256_set1_ps(1.0f));
+
+        return _mm256_mul_ps(poly, x);
+    }
+
+    inline __m256 gather_lanes(const std::vector<float> &table, const int32_t *lanes, const int32_t &offset)
+    {
+        return _mm256_setr_ps(table[lanes[0] + offset], table[lanes[1] + offset],
+                              table[lanes[2] + offset], table[lanes[3] + offset],
+                              table[lanes[4] + offset], table[lanes[5] + offset],
+                              table[lanes[6] + offset], table[lanes[7] + offset]);
+    }
+
+#endif
+}
+
+Deskew::Deskew(const Matrix4 &start_pose, const Matrix4 &end_pose, const float &start_time, const float &end_time)
+    : Deskew(std::vector<Matrix4>{start_pose, end_pose}, std::vector<float>{start_time, end_time})
+{
+}
+
+Deskew::Deskew(const std::vector<Matrix4> &poses, const std::vector<float> &times)
+{
+    if (poses.size() != times.size() || poses.size() < 2)
+    {
+        throw std::invalid_argument("Deskew requires at least two poses with matching timestamps");
+    }
+
+    if (!std::is_sorted(times.begin(), times.end()))
+    {
+        throw std::invalid_argument("Deskew pose timestamps must be sorted");
+    }
+
+    times_ = times;
+    build(poses);
+}
+
+void Deskew::build(const std::vector<Matrix4> &poses)
+{
+    const RigidTransform reference_inverse = RigidTransform(poses.front()).inverted();
+
+    keyframes_.reserve(poses.size());
+
+    for (const Matrix4 &pose : poses)
+    {
+        RigidTransform relative = reference_inverse * RigidTransform(pose);
+        relative.renormalize();
+
+        Quaternion &rotation = relative.rotation();
+
+        // Keep consecutive keyframes on the same hemisphere so slerp takes the short arc.
+        if (!keyframes_.empty() && Quaternion::dot(keyframes_.back().rotation(), rotation) < 0.0f)
+        {
+            rotation = Quaternion(-rotation[0], -rotation[1], -rotation[2], -rotation[3]);
+        }
+
+        keyframes_.push_back(relative);
+
+        for (int32_t c = 0; c < 4; c++)
+        {
+            keyframe_rotations_[c].push_back(rotation[c]);
+        }
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            keyframe_translations_[c].push_back(relative.translation()[c]);
+        }
+    }
+
+    for (size_t k = 0; k + 1 < poses.size(); k++)
+    {
+        const float cos_theta = std::fmin(Quaternion::dot(keyframes_[k].rotation(), keyframes_[k + 1].rotation()), 1.0f);
+        const float duration = times_[k + 1] - times_[k];
+
+        segment_angles_.push_back(std::acos(cos_theta));
+        segment_inverse_sines_.push_back(cos_theta < 1.0f - 1e-6f ? 1.0f / std::sin(segment_angles_.back()) : 0.0f);
+        segment_inverse_durations_.push_back(duration > 1e-9f ? 1.0f / duration : 0.0f);
+    }
+}
+
+size_t Deskew::segment(const float &time) const
+{
+    if (times_.size() == 2)
+    {
+        return 0;
+    }
+
+    const size_t upper = std::upper_bound(times_.begin(), times_.end(), time) - times_.begin();
+
+    return std::min(std::max<size_t>(upper, 1), times_.size() - 1) - 1;
+}
+
+float Deskew::segment_ratio(const size_t &segment, const float &time) const
+{
+    const float duration = times_[segment + 1] - times_[segment];
+
+    if (duration <= 1e-9f)
+    {
+        return 0.0f;
+    }
+
+    return (time - times_[segment]) / duration;
+}
+
+RigidTransform Deskew::transform_at(const float &time) const
+{
+    const size_t index = segment(time);
+    return RigidTransform::interpolate(keyframes_[index], keyframes_[index + 1], segment_ratio(index, time));
+}
+
+Matrix4 Deskew::pose_at(const float &time) const
+{
+    return transform_at(time).to_matrix();
+}
+
+void Deskew::apply(PointCloud &cloud) const
+{
+    apply(cloud, ThreadPool::shared());
+}
+
+void Deskew::apply(PointCloud &cloud, ThreadPool &pool) const
+{
+    LRE_PROFILE_SCOPE("Deskew::apply");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, cloud.size());
+
+    if (!cloud.has_timestamps())
+    {
+        return;
+    }
+
+    pool.parallel_for(0, cloud.size(), kDeskewGrain, [this, &cloud](const size_t &begin, const size_t &end)
+                      { correct_range(cloud, begin, end); });
+}
+
+void Deskew::correct_range(PointCloud &cloud, const size_t &begin, const size_t &end) const
+{
+    float *x = cloud.x();
+    float *y = cloud.y();
+    float *z = cloud.z();
+    const float *timestamps = cloud.timestamps();
+
+    size_t i = begin;
+
+#ifdef __AVX__
+
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+
+    int32_t lanes[8];
+
+    for (; i + 8 <= end; i += 8)
+    {
+        for (int32_t lane = 0; lane < 8; lane++)
+        {
+            lanes[lane] = static_cast<int32_t>(segment(timestamps[i + lane]));
+        }
+
+        __m256 t = _mm256_sub_ps(_mm256_loadu_ps(&timestamps[i]), gather_lanes(times_, lanes, 0));
+        t = _mm256_mul_ps(t, gather_lanes(segment_inverse_durations_, lanes, 0));
+        t = _mm256_max_ps(zero, _mm256_min_ps(t, one));
+
+        const __m256 angle = gather_lanes(segment_angles_, lanes, 0);
+        const __m256 inv_sin = gather_lanes(segment_inverse_sines_, lanes, 0);
+        const __m256 nearly_parallel = _mm256_cmp_ps(inv_sin, zero, _CMP_EQ_OQ);
+
+        const __m256 one_minus_t = _mm256_sub_ps(one, t);
+        __m256 weight_a = _mm256_mul_ps(sin_quarter_turn(_mm256_mul_ps(one_minus_t, angle)), inv_sin);
+        __m256 weight_b = _mm256_mul_ps(sin_quarter_turn(_mm256_mul_ps(t, angle)), inv_sin);
+        weight_a = _mm256_blendv_ps(weight_a, one_minus_t, nearly_parallel);
+        weight_b = _mm256_blendv_ps(weight_b, t, nearly_parallel);
+
+        __m256 q[4];
+        __m256 norm = zero;
+
+        for (int32_t c = 0; c < 4; c++)
+        {
+            q[c] = _mm256_add_ps(_mm256_mul_ps(weight_a, gather_lanes(keyframe_rotations_[c], lanes, 0)),
+                                 _mm256_mul_ps(weight_b, gather_lanes(keyframe_rotations_[c], lanes, 1)));
+            norm = _mm256_add_ps(norm, _mm256_mul_ps(q[c], q[c]));
+        }
+
+        const __m256 inv_norm = _mm256_div_ps(one, _mm256_sqrt_ps(norm));
+
+        for (int32_t c = 0; c < 4; c++)
+        {
+            q[c] = _mm256_mul_ps(q[c], inv_norm);
+        }
+
+        const __m256 xx = _mm256_mul_ps(q[0], q[0]);
+        const __m256 yy = _mm256_mul_ps(q[1], q[1]);
+        const __m256 zz = _mm256_mul_ps(q[2], q[2]);
+        const __m256 xy = _mm256_mul_ps(q[0], q[1]);
+        const __m256 xz = _mm256_mul_ps(q[0], q[2]);
+        const __m256 yz = _mm256_mul_ps(q[1], q[2]);
+        const __m256 xw = _mm256_mul_ps(q[0], q[3]);
+        const __m256 yw = _mm256_mul_ps(q[1], q[3]);
+        const __m256 zw = _mm256_mul_ps(q[2], q[3]);
+
+        const __m256 r00 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz)));
+        const __m256 r01 = _mm256_mul_ps(two, _mm256_sub_ps(xy, zw));
+        const __m256 r02 = _mm256_mul_ps(two, _mm256_add_ps(xz, yw));
+        const __m256 r10 = _mm256_mul_ps(two, _mm256_add_ps(xy, zw));
+        const __m256 r11 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz)));
+        const __m256 r12 = _mm256_mul_ps(two, _mm256_sub_ps(yz, xw));
+        const __m256 r20 = _mm256_mul_ps(two, _mm256_sub_ps(xz, yw));
+        const __m256 r21 = _mm256_mul_ps(two, _mm256_add_ps(yz, xw));
+        const __m256 r22 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy)));
+
+        __m256 translation[3];
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            const __m256 a = gather_lanes(keyframe_translations_[c], lanes, 0);
+            const __m256 b = gather_lanes(keyframe_translations_[c], lanes, 1);
+            translation[c] = _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), t));
+        }
+
+        const __m256 px = _mm256_loadu_ps(&x[i]);
+        const __m256 py = _mm256_loadu_ps(&y[i]);
+        const __m256 pz = _mm256_loadu_ps(&z[i]);
+
+        __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r00, px), _mm256_mul_ps(r01, py)), _mm256_mul_ps(r02, pz));
+        __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r10, px), _mm256_mul_ps(r11, py)), _mm256_mul_ps(r12, pz));
+        __m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r20, px), _mm256_mul_ps(r21, py)), _mm256_mul_ps(r22, pz));
+
+        _mm256_storeu_ps(&x[i], _mm256_add_ps(rx, translation[0]));
+        _mm256_storeu_ps(&y[i], _mm256_add_ps(ry, translation[1]));
+        _mm256_storeu_ps(&z[i], _mm256_add_ps(rz, translation[2]));
+    }
+
+#endif
+
+    for (; i < end; i++)
+    {
+        const Vector4 corrected = transform_at(timestamps[i]).transform(Vector4(x[i], y[i], z[i], 1.0f));
+
+        x[i] = corrected[0];
+        y[i] = corrected[1];
+        z[i] = corrected[2];
+    }
+}
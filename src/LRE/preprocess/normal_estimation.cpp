@@ -0,0 +1,183 @@
+#include <LRE/preprocess/normal_estimation.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+namespace
+{
+    constexpr size_t kNormalGrain = 1024;
+}
+
+NormalEstimation::NormalEstimation(const size_t &neighbours, const Vector4 &viewpoint)
+    : neighbours_(std::max<size_t>(3, neighbours)), viewpoint_(viewpoint)
+{
+}
+
+NormalEstimation::NormalEstimation(const size_t &neighbours) : NormalEstimation(neighbours, Vector4())
+{
+}
+
+void NormalEstimation::apply(PointCloud &cloud, const KdTree &tree, const size_t &count, ThreadPool &pool) const
+{
+    LRE_PROFILE_SCOPE("NormalEstimation::apply");
+
+    if (!cloud.has_normals())
+    {
+        cloud.enable_normals();
+    }
+
+    const size_t limit = std::min(count, cloud.size());
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, limit);
+
+    pool.parallel_for(0, limit, kNormalGrain, [this, &cloud, &tree](const size_t &begin, const size_t &end)
+                      {
+                          std::vector<uint32_t> indices;
+                          std::vector<float> sqr_distances;
+
+                          const float *x = cloud.x();
+                          const float *y = cloud.y();
+                          const float *z = cloud.z();
+
+                          for (size_t i = begin; i < end; i++)
+                          {
+                              const Vector4 point = cloud.point(i);
+                              tree.knn(point, neighbours_, indices, sqr_distances);
+
+                              double mean[3] = {0.0, 0.0, 0.0};
+
+                              for (const uint32_t &index : indices)
+                              {
+                                  mean[0] += x[index];
+                                  mean[1] += y[index];
+                                  mean[2] += z[index];
+                              }
+
+                              const double inverse_count = indices.empty() ? 0.0 : 1.0 / static_cast<double>(indices.size());
+                              mean[0] *= inverse_count;
+                              mean[1] *= inverse_count;
+                              mean[2] *= inverse_count;
+
+                              double sums[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+                              for (const uint32_t &index : indices)
+                              {
+                                  const double dx = x[index] - mean[0];
+                                  const double dy = y[index] - mean[1];
+                                  const double dz = z[index] - mean[2];
+
+                                  sums[0] += dx * dx;
+                                  sums[1] += dx * dy;
+                                  sums[2] += dx * dz;
+                                  sums[3] += dy * dy;
+                                  sums[4] += dy * dz;
+                                  sums[5] += dz * dz;
+                              }
+
+                              float covariance[6];
+
+                              for (int32_t c = 0; c < 6; c++)
+                              {
+                                  covariance[c] = static_cast<float>(sums[c] * inverse_count);
+                              }
+
+                              Vector4 normal = smallest_eigenvector(covariance);
+
+                              if (Vector4::dot(normal, viewpoint_ - Vector4(point[0], point[1], point[2], 0.0f)) < 0.0f)
+                              {
+                                  normal = normal * -1.0f;
+                              }
+
+                              cloud.set_normal(i, normal);
+                          } });
+}
+
+void NormalEstimation::apply(PointCloud &cloud, ThreadPool &pool) const
+{
+    KdTree tree(cloud);
+    apply(cloud, tree, cloud.size(), pool);
+}
+
+void NormalEstimation::apply(PointCloud &cloud) const
+{
+    apply(cloud, ThreadPool::shared());
+}
+
+Vector4 NormalEstimation::smallest_eigenvector(const float covariance[6])
+{
+    const double a00 = covariance[0], a01 = covariance[1], a02 = covariance[2];
+    const double a11 = covariance[3], a12 = covariance[4], a22 = covariance[5];
+
+    // Closed-form eigenvalues of a symmetric 3x3 matrix.
+    const double off_diagonal = a01 * a01 + a02 * a02 + a12 * a12;
+    const double trace = a00 + a11 + a22;
+
+    double smallest;
+
+    if (off_diagonal < 1e-30)
+    {
+        smallest = std::min(a00, std::min(a11, a22));
+    }
+    else
+    {
+        const double q = trace / 3.0;
+        const double b00 = a00 - q, b11 = a11 - q, b22 = a22 - q;
+        const double p = std::sqrt((b00 * b00 + b11 * b11 + b22 * b22 + 2.0 * off_diagonal) / 6.0);
+
+        if (p < 1e-30)
+        {
+            return Vector4(0.0f, 0.0f, 1.0f, 0.0f);
+        }
+
+        const double inverse_p = 1.0 / p;
+        const double c00 = b00 * inverse_p, c11 = b11 * inverse_p, c22 = b22 * inverse_p;
+        const double c01 = a01 * inverse_p, c02 = a02 * inverse_p, c12 = a12 * inverse_p;
+
+        const double half_determinant = 0.5 * (c00 * (c11 * c22 - c12 * c12) -
+                                               c01 * (c01 * c22 - c12 * c02) +
+                                               c02 * (c01 * c12 - c11 * c02));
+
+        const double phi = std::acos(std::max(-1.0, std::min(1.0, half_determinant))) / 3.0;
+
+        smallest = q + 2.0 * p * std::cos(phi + 2.0 * 3.14159265358979323846 / 3.0);
+    }
+
+    // The eigenvector is orthogonal to the rows of (A - lambda * I); take the best conditioned cross product.
+    const double r0[3] = {a00 - smallest, a01, a02};
+    const double r1[3] = {a01, a11 - smallest, a12};
+    const double r2[3] = {a02, a12, a22 - smallest};
+
+    const double *rows[3][2] = {{r0, r1}, {r0, r2}, {r1, r2}};
+
+    double best[3] = {0.0, 0.0, 1.0};
+    double best_length = 0.0;
+
+    for (int32_t pair = 0; pair < 3; pair++)
+    {
+        const double *u = rows[pair][0];
+        const double *v = rows[pair][1];
+
+        const double cross[3] = {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+        const double length = cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2];
+
+        if (length > best_length)
+        {
+            best_length = length;
+            best[0] = cross[0];
+            best[1] = cross[1];
+            best[2] = cross[2];
+        }
+    }
+
+    if (best_length < 1e-30)
+    {
+        // Degenerate (repeated smallest eigenvalue): fall back to the axis with least variance.
+        const int32_t axis = a00 <= a11 && a00 <= a22 ? 0 : (a11 <= a22 ? 1 : 2);
+        Vector4 axis_vector;
+        axis_vector[axis] = 1.0f;
+        return axis_vector;
+    }
+
+    const double inverse_length = 1.0 / std::sqrt(best_length);
+
+    return Vector4(static_cast<float>(best[0] * inverse_length),
+                   static_cast<float>(best[1] * inverse_length),
+                   static_cast<float>(best[2] * inverse_length), 0.0f);
+}
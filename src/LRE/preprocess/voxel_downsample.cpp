@@ -0,0 +1,157 @@
+#include <LRE/preprocess/voxel_downsample.hpp>
+#include <LRE/profiling/profiler.hpp>
+#include <LRE/parallel/primitives.hpp>
+
+#include <tuple>
+
+namespace
+{
+    constexpr size_t kKeyGrain = 65536;
+    constexpr float kIndexLimit = 4611686018427387904.0f;
+
+    int32_t bit_width(const uint64_t &span)
+    {
+        int32_t width = 0;
+
+        while (width < 64 && (span >> width) != 0)
+        {
+            width++;
+        }
+
+        return width;
+    }
+}
+
+VoxelDownsample::VoxelDownsample(const float &voxel_size) : voxel_size_(std::max(voxel_size, 1e-6f))
+{
+}
+
+float VoxelDownsample::voxel_size() const
+{
+    return voxel_size_;
+}
+
+std::array<int64_t, 3> VoxelDownsample::voxel_index(const float &x, const float &y, const float &z) const
+{
+    const float inverse_size = 1.0f / voxel_size_;
+    const float cells[3] = {std::floor(x * inverse_size), std::floor(y * inverse_size), std::floor(z * inverse_size)};
+
+    std::array<int64_t, 3> index;
+
+    for (int32_t c = 0; c < 3; c++)
+    {
+        index[c] = static_cast<int64_t>(std::max(-kIndexLimit, std::min(kIndexLimit, cells[c])));
+    }
+
+    return index;
+}
+
+PointCloud VoxelDownsample::apply(const PointCloud &cloud, ThreadPool &pool) const
+{
+    LRE_PROFILE_SCOPE("VoxelDownsample::apply");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, cloud.size());
+
+    std::vector<std::array<int64_t, 3>> cells(cloud.size());
+    std::vector<uint32_t> order(cloud.size());
+
+    const float *x = cloud.x();
+    const float *y = cloud.y();
+    const float *z = cloud.z();
+
+    pool.parallel_for(0, cloud.size(), kKeyGrain, [this, &cells, &order, x, y, z](const size_t &begin, const size_t &end)
+                      {
+                          for (size_t i = begin; i < end; i++)
+                          {
+                              cells[i] = voxel_index(x[i], y[i], z[i]);
+                              order[i] = static_cast<uint32_t>(i);
+                          } });
+
+    std::array<int64_t, 3> minimum = {0, 0, 0};
+    std::array<int64_t, 3> maximum = {0, 0, 0};
+
+    if (!cells.empty())
+    {
+        minimum = maximum = cells[0];
+    }
+
+    for (const std::array<int64_t, 3> &cell : cells)
+    {
+        for (int32_t c = 0; c < 3; c++)
+        {
+            minimum[c] = std::min(minimum[c], cell[c]);
+            maximum[c] = std::max(maximum[c], cell[c]);
+        }
+    }
+
+    int32_t widths[3];
+
+    for (int32_t c = 0; c < 3; c++)
+    {
+        widths[c] = bit_width(static_cast<uint64_t>(maximum[c]) - static_cast<uint64_t>(minimum[c]));
+    }
+
+    // Both orders are x fastest, so the output does not depend on which one the extent allows.
+    if (widths[0] + widths[1] + widths[2] <= 64)
+    {
+        std::vector<uint64_t> keys(cloud.size());
+
+        pool.parallel_for(0, cloud.size(), kKeyGrain, [&cells, &keys, &minimum, &widths](const size_t &begin, const size_t &end)
+                          {
+                              for (size_t i = begin; i < end; i++)
+                              {
+                                  const std::array<int64_t, 3> &cell = cells[i];
+
+                                  keys[i] = (static_cast<uint64_t>(cell[0]) - static_cast<uint64_t>(minimum[0])) |
+                                            ((static_cast<uint64_t>(cell[1]) - static_cast<uint64_t>(minimum[1])) << widths[0]) |
+                                            ((static_cast<uint64_t>(cell[2]) - static_cast<uint64_t>(minimum[2])) << (widths[0] + widths[1]));
+                              } });
+
+        // The sort is stable, so points inside a voxel keep their input order and the centroid sums stay deterministic.
+        ParallelPrimitives::radix_sort(keys, order, pool);
+    }
+    else
+    {
+        std::stable_sort(order.begin(), order.end(), [&cells](const uint32_t &a, const uint32_t &b)
+                         {
+                             const std::array<int64_t, 3> &left = cells[a];
+                             const std::array<int64_t, 3> &right = cells[b];
+                             return std::make_tuple(left[2], left[1], left[0]) < std::make_tuple(right[2], right[1], right[0]);
+                         });
+    }
+
+    PointCloud result;
+    result.reserve(cloud.size() / 4 + 1);
+    result.set_origin(cloud.origin());
+
+    size_t run_begin = 0;
+
+    while (run_begin < order.size())
+    {
+        size_t run_end = run_begin;
+        double sum[3] = {0.0, 0.0, 0.0};
+
+        while (run_end < order.size() && cells[order[run_end]] == cells[order[run_begin]])
+        {
+            const uint32_t index = order[run_end];
+            sum[0] += x[index];
+            sum[1] += y[index];
+            sum[2] += z[index];
+            run_end++;
+        }
+
+        const double inverse_count = 1.0 / static_cast<double>(run_end - run_begin);
+
+        result.push_back(Vector4(static_cast<float>(sum[0] * inverse_count),
+                                 static_cast<float>(sum[1] * inverse_count),
+                                 static_cast<float>(sum[2] * inverse_count)));
+
+        run_begin = run_end;
+    }
+
+    return result;
+}
+
+PointCloud VoxelDownsample::apply(const PointCloud &cloud) const
+{
+    return apply(cloud, ThreadPool::shared());
+}
@@ -0,0 +1,473 @@
+#include <LRE/profiling/profiler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <string>
+
+namespace
+{
+    constexpr double kNanosecondsPerMicrosecond = 1e3;
+
+    constexpr double kNanosecondsPerMillisecond = 1e6;
+
+    uint64_t steady_nanoseconds()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    void write_escaped(std::ostream &stream, const char *text)
+    {
+        for (; *text != '\0'; text++)
+        {
+            if (*text == '"' || *text == '\\')
+            {
+                stream << '\\';
+            }
+
+            stream << *text;
+        }
+    }
+}
+
+// Written only by its owning thread; exporters read the relaxed atomics concurrently.
+struct Profiler::ThreadState
+{
+    struct Slot
+    {
+        std::atomic<const char *> name;
+        std::atomic<uint64_t> begin;
+        std::atomic<uint64_t> duration;
+    };
+
+    struct Scope
+    {
+        std::atomic<const char *> name;
+        std::atomic<uint64_t> calls;
+        std::atomic<uint64_t> total;
+        std::atomic<uint64_t> maximum;
+    };
+
+    uint32_t id;
+
+    std::atomic<uint64_t> head;
+
+    std::atomic<uint64_t> counters[kCounterCount];
+
+    Slot ring[kRingCapacity];
+
+    Scope scopes[kMaxScopes];
+
+    ThreadState(const uint32_t &thread_id)
+        : id(thread_id)
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        head.store(0, std::memory_order_relaxed);
+
+        for (Slot &slot : ring)
+        {
+            slot.name.store(nullptr, std::memory_order_relaxed);
+            slot.begin.store(0, std::memory_order_relaxed);
+            slot.duration.store(0, std::memory_order_relaxed);
+        }
+
+        clear_totals();
+    }
+
+    void clear_totals()
+    {
+        for (std::atomic<uint64_t> &counter : counters)
+        {
+            counter.store(0, std::memory_order_relaxed);
+        }
+
+        for (Scope &scope : scopes)
+        {
+            scope.name.store(nullptr, std::memory_order_relaxed);
+            scope.calls.store(0, std::memory_order_relaxed);
+            scope.total.store(0, std::memory_order_relaxed);
+            scope.maximum.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Open addressing on the name pointer; a full table silently drops new scopes.
+    Scope *find_scope(const char *name)
+    {
+        const size_t hash = (reinterpret_cast<uintptr_t>(name) >> 3) * 0x9E3779B97F4A7C15ull;
+
+        for (size_t probe = 0; probe < kMaxScopes; probe++)
+        {
+            Scope &scope = scopes[(hash + probe) % kMaxScopes];
+            const char *key = scope.name.load(std::memory_order_relaxed);
+
+            if (key == name)
+            {
+                return &scope;
+            }
+
+            if (key == nullptr)
+            {
+                scope.calls.store(0, std::memory_order_relaxed);
+                scope.total.store(0, std::memory_order_relaxed);
+                scope.maximum.store(0, std::memory_order_relaxed);
+                scope.name.store(name, std::memory_order_release);
+                return &scope;
+            }
+        }
+
+        return nullptr;
+    }
+};
+
+// Hands the state back when its thread exits.
+struct Profiler::ThreadOwner
+{
+    ThreadState *state = nullptr;
+
+    ~ThreadOwner()
+    {
+        if (state != nullptr)
+        {
+            Profiler::instance().retire(*state);
+        }
+    }
+};
+
+Profiler::Profiler()
+    : retired_counters_(),
+      epoch_(steady_nanoseconds())
+{
+}
+
+Profiler &Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+const char *Profiler::counter_name(const Counter &counter)
+{
+    switch (counter)
+    {
+    case Counter::PointsProcessed:
+        return "points_processed";
+    case Counter::QueriesIssued:
+        return "queries_issued";
+    case Counter::Allocations:
+        return "allocations";
+    default:
+        return "unknown";
+    }
+}
+
+Profiler::ThreadState &Profiler::local()
+{
+    static thread_local ThreadOwner owner;
+
+    if (owner.state == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (free_.empty())
+        {
+            threads_.push_back(std::make_shared<ThreadState>(static_cast<uint32_t>(threads_.size())));
+            owner.state = threads_.back().get();
+        }
+        else
+        {
+            owner.state = free_.back();
+            free_.pop_back();
+        }
+    }
+
+    return *owner.state;
+}
+
+// Folds the totals into the retired ones; the ring keeps its events until the next owner overwrites them.
+void Profiler::retire(ThreadState &state)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (size_t c = 0; c < kCounterCount; c++)
+    {
+        retired_counters_[c] += state.counters[c].load(std::memory_order_relaxed);
+    }
+
+    for (const ThreadState::Scope &scope : state.scopes)
+    {
+        const char *name = scope.name.load(std::memory_order_relaxed);
+
+        if (name == nullptr)
+        {
+            continue;
+        }
+
+        auto found = std::find_if(retired_scopes_.begin(), retired_scopes_.end(), [name](const ScopeStatistics &entry)
+                                  { return entry.name == name; });
+
+        if (found == retired_scopes_.end())
+        {
+            found = retired_scopes_.insert(retired_scopes_.end(), ScopeStatistics{name, 0, 0, 0});
+        }
+
+        found->calls += scope.calls.load(std::memory_order_relaxed);
+        found->total += scope.total.load(std::memory_order_relaxed);
+        found->maximum = std::max(found->maximum, scope.maximum.load(std::memory_order_relaxed));
+    }
+
+    state.clear_totals();
+    free_.push_back(&state);
+}
+
+uint64_t Profiler::now() const
+{
+    return steady_nanoseconds() - epoch_;
+}
+
+void Profiler::record(const char *name, const uint64_t &begin, const uint64_t &end)
+{
+    ThreadState &state = local();
+    const uint64_t duration = end > begin ? end - begin : 0;
+
+    const uint64_t head = state.head.load(std::memory_order_relaxed);
+    ThreadState::Slot &slot = state.ring[head % kRingCapacity];
+
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin.store(begin, std::memory_order_relaxed);
+    slot.duration.store(duration, std::memory_order_relaxed);
+    state.head.store(head + 1, std::memory_order_release);
+
+    ThreadState::Scope *scope = state.find_scope(name);
+
+    if (scope != nullptr)
+    {
+        scope->calls.store(scope->calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        scope->total.store(scope->total.load(std::memory_order_relaxed) + duration, std::memory_order_relaxed);
+        scope->maximum.store(std::max(scope->maximum.load(std::memory_order_relaxed), duration), std::memory_order_relaxed);
+    }
+}
+
+void Profiler::add(const Counter &counter, const uint64_t &value)
+{
+    std::atomic<uint64_t> &target = local().counters[static_cast<size_t>(counter)];
+    target.store(target.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+uint64_t Profiler::counter(const Counter &counter) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    uint64_t total = retired_counters_[static_cast<size_t>(counter)];
+
+    for (const std::shared_ptr<ThreadState> &state : threads_)
+    {
+        total += state->counters[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+size_t Profiler::thread_count() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return threads_.size();
+}
+
+void Profiler::events(std::vector<Event> &events) const
+{
+    events.clear();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const std::shared_ptr<ThreadState> &state : threads_)
+    {
+        const uint64_t head = state->head.load(std::memory_order_acquire);
+        const uint64_t first = head > kRingCapacity ? head - kRingCapacity : 0;
+        const size_t start = events.size();
+
+        for (uint64_t i = first; i < head; i++)
+        {
+            const ThreadState::Slot &slot = state->ring[i % kRingCapacity];
+            events.push_back(Event{slot.name.load(std::memory_order_relaxed), slot.begin.load(std::memory_order_relaxed),
+                                   slot.duration.load(std::memory_order_relaxed), state->id});
+        }
+
+        // Slots the owner overwrote while they were being copied are discarded.
+        const uint64_t after = state->head.load(std::memory_order_acquire);
+        const uint64_t valid = after > kRingCapacity ? after - kRingCapacity : 0;
+
+        if (valid > first)
+        {
+            const size_t stale = static_cast<size_t>(std::min(valid, head) - first);
+            events.erase(events.begin() + start, events.begin() + start + stale);
+        }
+    }
+}
+
+void Profiler::statistics(std::vector<ScopeStatistics> &statistics) const
+{
+    std::map<std::string, ScopeStatistics> merged;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (const ScopeStatistics &scope : retired_scopes_)
+        {
+            auto found = merged.find(scope.name);
+
+            if (found == merged.end())
+            {
+                found = merged.emplace(scope.name, ScopeStatistics{scope.name, 0, 0, 0}).first;
+            }
+
+            found->second.calls += scope.calls;
+            found->second.total += scope.total;
+            found->second.maximum = std::max(found->second.maximum, scope.maximum);
+        }
+
+        for (const std::shared_ptr<ThreadState> &state : threads_)
+        {
+            for (const ThreadState::Scope &scope : state->scopes)
+            {
+                const char *name = scope.name.load(std::memory_order_acquire);
+
+                if (name == nullptr)
+                {
+                    continue;
+                }
+
+                auto found = merged.find(name);
+
+                if (found == merged.end())
+                {
+                    found = merged.emplace(name, ScopeStatistics{name, 0, 0, 0}).first;
+                }
+
+                ScopeStatistics &entry = found->second;
+                entry.calls += scope.calls.load(std::memory_order_relaxed);
+                entry.total += scope.total.load(std::memory_order_relaxed);
+                entry.maximum = std::max(entry.maximum, scope.maximum.load(std::memory_order_relaxed));
+            }
+        }
+    }
+
+    statistics.clear();
+
+    for (const auto &entry : merged)
+    {
+        statistics.push_back(entry.second);
+    }
+
+    std::sort(statistics.begin(), statistics.end(), [](const ScopeStatistics &a, const ScopeStatistics &b)
+              { return a.total > b.total; });
+}
+
+void Profiler::write_chrome_trace(std::ostream &stream) const
+{
+    std::vector<Event> snapshot;
+    events(snapshot);
+
+    const std::ios_base::fmtflags flags = stream.flags();
+    const std::streamsize precision = stream.precision();
+
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\"traceEvents\":[";
+
+    uint64_t last = 0;
+    bool first = true;
+
+    for (const Event &event : snapshot)
+    {
+        stream << (first ? "\n" : ",\n") << "{\"name\":\"";
+        write_escaped(stream, event.name);
+        stream << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+               << ",\"ts\":" << static_cast<double>(event.begin) / kNanosecondsPerMicrosecond
+               << ",\"dur\":" << static_cast<double>(event.duration) / kNanosecondsPerMicrosecond << "}";
+
+        last = std::max(last, event.begin + event.duration);
+        first = false;
+    }
+
+    stream << (first ? "\n" : ",\n") << "{\"name\":\"counters\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":"
+           << static_cast<double>(last) / kNanosecondsPerMicrosecond << ",\"args\":{";
+
+    for (size_t c = 0; c < kCounterCount; c++)
+    {
+        const Counter id = static_cast<Counter>(c);
+        stream << (c == 0 ? "" : ",") << "\"" << counter_name(id) << "\":" << counter(id);
+    }
+
+    stream << "}}\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+void Profiler::write_summary(std::ostream &stream) const
+{
+    std::vector<ScopeStatistics> scopes;
+    statistics(scopes);
+
+    const std::ios_base::fmtflags flags = stream.flags();
+    const std::streamsize precision = stream.precision();
+
+    stream << std::left << std::setw(40) << "scope" << std::right << std::setw(12) << "calls" << std::setw(14) << "total ms"
+           << std::setw(14) << "mean us" << std::setw(14) << "max us" << "\n";
+
+    stream << std::fixed << std::setprecision(3);
+
+    for (const ScopeStatistics &scope : scopes)
+    {
+        const double mean = scope.calls > 0 ? static_cast<double>(scope.total) / static_cast<double>(scope.calls) : 0.0;
+
+        stream << std::left << std::setw(40) << scope.name << std::right << std::setw(12) << scope.calls
+               << std::setw(14) << static_cast<double>(scope.total) / kNanosecondsPerMillisecond
+               << std::setw(14) << mean / kNanosecondsPerMicrosecond
+               << std::setw(14) << static_cast<double>(scope.maximum) / kNanosecondsPerMicrosecond << "\n";
+    }
+
+    stream << "\n";
+
+    for (size_t c = 0; c < kCounterCount; c++)
+    {
+        const Counter id = static_cast<Counter>(c);
+        stream << std::left << std::setw(40) << counter_name(id) << std::right << std::setw(12) << counter(id) << "\n";
+    }
+
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+void Profiler::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const std::shared_ptr<ThreadState> &state : threads_)
+    {
+        state->clear();
+    }
+
+    std::fill(std::begin(retired_counters_), std::end(retired_counters_), 0);
+    retired_scopes_.clear();
+}
+
+ScopedTimer::ScopedTimer(const char *name)
+    : name_(name),
+      begin_(Profiler::instance().now())
+{
+}
+
+ScopedTimer::~ScopedTimer()
+{
+    Profiler &profiler = Profiler::instance();
+    profiler.record(name_, begin_, profiler.now());
+}
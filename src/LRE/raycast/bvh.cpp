@@ -0,0 +1,410 @@
+#include <LRE/raycast/bvh.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    constexpr int32_t kBinCount = 12;
+
+    constexpr int32_t kMaxSahDepth = 40;
+
+    constexpr int32_t kStackSize = 128;
+
+    struct Bin
+    {
+        float minimum[3];
+        float maximum[3];
+        uint32_t count;
+    };
+
+    void reset(float minimum[3], float maximum[3])
+    {
+        for (int32_t c = 0; c < 3; c++)
+        {
+            minimum[c] = std::numeric_limits<float>::max();
+            maximum[c] = std::numeric_limits<float>::lowest();
+        }
+    }
+
+    void grow(float minimum[3], float maximum[3], const float *other_minimum, const float *other_maximum)
+    {
+        for (int32_t c = 0; c < 3; c++)
+        {
+            minimum[c] = std::min(minimum[c], other_minimum[c]);
+            maximum[c] = std::max(maximum[c], other_maximum[c]);
+        }
+    }
+
+    float half_area(const float minimum[3], const float maximum[3])
+    {
+        const float dx = std::max(0.0f, maximum[0] - minimum[0]);
+        const float dy = std::max(0.0f, maximum[1] - minimum[1]);
+        const float dz = std::max(0.0f, maximum[2] - minimum[2]);
+
+        return dx * dy + dy * dz + dz * dx;
+    }
+
+    float safe_inverse(const float &value)
+    {
+        const float clamped = std::abs(value) < 1e-12f ? std::copysign(1e-12f, value) : value;
+        return 1.0f / clamped;
+    }
+}
+
+Bvh::Bvh(const TriangleMesh &mesh, const size_t &leaf_size)
+    : triangle_ids_(mesh.triangle_count()),
+      leaf_size_(std::max<size_t>(1, leaf_size))
+{
+    LRE_PROFILE_SCOPE("Bvh::build");
+
+    const size_t count = mesh.triangle_count();
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    std::vector<float> bounds(6 * count);
+    std::vector<float> centroids(3 * count);
+
+    const float *channels[3] = {mesh.x(), mesh.y(), mesh.z()};
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint32_t *corners = mesh.triangle(i);
+
+        float *minimum = &bounds[6 * i];
+        float *maximum = minimum + 3;
+        reset(minimum, maximum);
+
+        for (int32_t k = 0; k < 3; k++)
+        {
+            const float vertex[3] = {channels[0][corners[k]], channels[1][corners[k]], channels[2][corners[k]]};
+            grow(minimum, maximum, vertex, vertex);
+        }
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            centroids[3 * i + c] = 0.5f * (minimum[c] + maximum[c]);
+        }
+
+        triangle_ids_[i] = static_cast<uint32_t>(i);
+    }
+
+    nodes_.reserve(2 * count / leaf_size_ + 1);
+    nodes_.emplace_back();
+    build(0, 0, static_cast<uint32_t>(count), 0, bounds, centroids);
+
+    // Precompute Moller-Trumbore edges in leaf order so leaves read contiguous memory.
+    for (int32_t c = 0; c < 3; c++)
+    {
+        origins_[c].resize(count);
+        first_edges_[c].resize(count);
+        second_edges_[c].resize(count);
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint32_t *corners = mesh.triangle(triangle_ids_[i]);
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            const float a = channels[c][corners[0]];
+            origins_[c][i] = a;
+            first_edges_[c][i] = channels[c][corners[1]] - a;
+            second_edges_[c][i] = channels[c][corners[2]] - a;
+        }
+    }
+}
+
+Bvh::Bvh(const TriangleMesh &mesh) : Bvh(mesh, 4)
+{
+}
+
+Bvh::Bvh() : leaf_size_(4)
+{
+}
+
+void Bvh::build(const uint32_t &node, const uint32_t &begin, const uint32_t &end, const int32_t &depth,
+                const std::vector<float> &bounds, const std::vector<float> &centroids)
+{
+    float minimum[3];
+    float maximum[3];
+    float centroid_minimum[3];
+    float centroid_maximum[3];
+
+    reset(minimum, maximum);
+    reset(centroid_minimum, centroid_maximum);
+
+    for (uint32_t i = begin; i < end; i++)
+    {
+        const uint32_t id = triangle_ids_[i];
+        grow(minimum, maximum, &bounds[6 * id], &bounds[6 * id + 3]);
+        grow(centroid_minimum, centroid_maximum, &centroids[3 * id], &centroids[3 * id]);
+    }
+
+    std::copy(minimum, minimum + 3, nodes_[node].minimum);
+    std::copy(maximum, maximum + 3, nodes_[node].maximum);
+    nodes_[node].first = begin;
+    nodes_[node].count = end - begin;
+
+    const uint32_t count = end - begin;
+
+    if (count <= leaf_size_)
+    {
+        return;
+    }
+
+    int32_t best_axis = -1;
+    int32_t best_split = 0;
+    float best_cost = std::numeric_limits<float>::max();
+
+    for (int32_t axis = 0; axis < 3; axis++)
+    {
+        const float extent = centroid_maximum[axis] - centroid_minimum[axis];
+
+        if (extent <= 0.0f)
+        {
+            continue;
+        }
+
+        const float scale = kBinCount / extent;
+
+        Bin bins[kBinCount];
+
+        for (Bin &bin : bins)
+        {
+            reset(bin.minimum, bin.maximum);
+            bin.count = 0;
+        }
+
+        for (uint32_t i = begin; i < end; i++)
+        {
+            const uint32_t id = triangle_ids_[i];
+            const int32_t b = std::min(kBinCount - 1, static_cast<int32_t>((centroids[3 * id + axis] - centroid_minimum[axis]) * scale));
+
+            grow(bins[b].minimum, bins[b].maximum, &bounds[6 * id], &bounds[6 * id + 3]);
+            bins[b].count++;
+        }
+
+        float left_areas[kBinCount];
+        uint32_t left_counts[kBinCount];
+
+        float running_minimum[3];
+        float running_maximum[3];
+        uint32_t running_count = 0;
+
+        reset(running_minimum, running_maximum);
+
+        for (int32_t b = 0; b < kBinCount - 1; b++)
+        {
+            grow(running_minimum, running_maximum, bins[b].minimum, bins[b].maximum);
+            running_count += bins[b].count;
+            left_areas[b] = half_area(running_minimum, running_maximum);
+            left_counts[b] = running_count;
+        }
+
+        reset(running_minimum, running_maximum);
+        running_count = 0;
+
+        for (int32_t b = kBinCount - 1; b > 0; b--)
+        {
+            grow(running_minimum, running_maximum, bins[b].minimum, bins[b].maximum);
+            running_count += bins[b].count;
+
+            const uint32_t left_count = left_counts[b - 1];
+
+            if (left_count == 0 || running_count == 0)
+            {
+                continue;
+            }
+
+            const float cost = left_areas[b - 1] * left_count + half_area(running_minimum, running_maximum) * running_count;
+
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                best_axis = axis;
+                best_split = b;
+            }
+        }
+    }
+
+    uint32_t middle = begin;
+
+    if (best_axis >= 0 && depth < kMaxSahDepth)
+    {
+        if (best_cost >= half_area(minimum, maximum) * count && count <= 4 * leaf_size_)
+        {
+            return;
+        }
+
+        const float scale = kBinCount / (centroid_maximum[best_axis] - centroid_minimum[best_axis]);
+
+        middle = static_cast<uint32_t>(
+            std::partition(triangle_ids_.begin() + begin, triangle_ids_.begin() + end,
+                           [&](const uint32_t &id)
+                           {
+                               const int32_t b = std::min(kBinCount - 1, static_cast<int32_t>((centroids[3 * id + best_axis] - centroid_minimum[best_axis]) * scale));
+                               return b < best_split;
+                           }) -
+            triangle_ids_.begin());
+    }
+
+    // Coincident centroids or a runaway SAH recursion fall back to an object median split.
+    if (middle == begin || middle == end)
+    {
+        int32_t axis = 0;
+
+        for (int32_t c = 1; c < 3; c++)
+        {
+            if (centroid_maximum[c] - centroid_minimum[c] > centroid_maximum[axis] - centroid_minimum[axis])
+            {
+                axis = c;
+            }
+        }
+
+        middle = begin + count / 2;
+
+        std::nth_element(triangle_ids_.begin() + begin, triangle_ids_.begin() + middle, triangle_ids_.begin() + end,
+                         [&centroids, axis](const uint32_t &a, const uint32_t &b)
+                         { return centroids[3 * a + axis] < centroids[3 * b + axis]; });
+    }
+
+    const uint32_t left = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+    nodes_.emplace_back();
+
+    nodes_[node].first = left;
+    nodes_[node].count = 0;
+
+    build(left, begin, middle, depth + 1, bounds, centroids);
+    build(left + 1, middle, end, depth + 1, bounds, centroids);
+}
+
+size_t Bvh::size() const
+{
+    return triangle_ids_.size();
+}
+
+bool Bvh::empty() const
+{
+    return triangle_ids_.empty();
+}
+
+bool Bvh::intersect(const Vector4 &origin, const Vector4 &direction, const float &minimum_distance,
+                    float &distance, uint32_t &triangle) const
+{
+    if (nodes_.empty())
+    {
+        return false;
+    }
+
+    const float o[3] = {origin[0], origin[1], origin[2]};
+    const float d[3] = {direction[0], direction[1], direction[2]};
+    const float inverse[3] = {safe_inverse(d[0]), safe_inverse(d[1]), safe_inverse(d[2])};
+
+    bool found = false;
+
+    uint32_t stack[kStackSize];
+    int32_t top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const Node &node = nodes_[stack[--top]];
+
+        float near = minimum_distance;
+        float far = distance;
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            const float t0 = (node.minimum[c] - o[c]) * inverse[c];
+            const float t1 = (node.maximum[c] - o[c]) * inverse[c];
+            near = std::max(near, std::min(t0, t1));
+            far = std::min(far, std::max(t0, t1));
+        }
+
+        if (near > far)
+        {
+            continue;
+        }
+
+        if (node.count == 0)
+        {
+            stack[top++] = node.first + 1;
+            stack[top++] = node.first;
+            continue;
+        }
+
+        for (uint32_t i = node.first; i < node.first + node.count; i++)
+        {
+            const float e1[3] = {first_edges_[0][i], first_edges_[1][i], first_edges_[2][i]};
+            const float e2[3] = {second_edges_[0][i], second_edges_[1][i], second_edges_[2][i]};
+
+            const float p[3] = {d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0]};
+            const float determinant = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+
+            if (std::abs(determinant) < 1e-12f)
+            {
+                continue;
+            }
+
+            const float inverse_determinant = 1.0f / determinant;
+            const float s[3] = {o[0] - origins_[0][i], o[1] - origins_[1][i], o[2] - origins_[2][i]};
+            const float u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inverse_determinant;
+
+            if (u < 0.0f || u > 1.0f)
+            {
+                continue;
+            }
+
+            const float q[3] = {s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0]};
+            const float v = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) * inverse_determinant;
+
+            if (v < 0.0f || u + v > 1.0f)
+            {
+                continue;
+            }
+
+            const float t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inverse_determinant;
+
+            if (t >= minimum_distance && t < distance)
+            {
+                distance = t;
+                triangle = triangle_ids_[i];
+                found = true;
+            }
+        }
+    }
+
+    return found;
+}
+
+const std::vector<Bvh::Node> &Bvh::nodes() const
+{
+    return nodes_;
+}
+
+const std::vector<uint32_t> &Bvh::triangle_ids() const
+{
+    return triangle_ids_;
+}
+
+const float *Bvh::origin(const int32_t &axis) const
+{
+    return origins_[axis].data();
+}
+
+const float *Bvh::first_edge(const int32_t &axis) const
+{
+    return first_edges_[axis].data();
+}
+
+const float *Bvh::second_edge(const int32_t &axis) const
+{
+    return second_edges_[axis].data();
+}
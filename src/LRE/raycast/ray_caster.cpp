@@ -0,0 +1,490 @@
+#include <LRE/raycast/ray_caster.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    constexpr size_t kRayGrain = 512;
+
+    constexpr int32_t kStackSize = 256;
+
+    float safe_inverse(const float &value)
+    {
+        const float clamped = std::abs(value) < 1e-12f ? std::copysign(1e-12f, value) : value;
+        return 1.0f / clamped;
+    }
+
+    int32_t sign_mask(const float direction[3])
+    {
+        return (direction[0] < 0.0f ? 1 : 0) | (direction[1] < 0.0f ? 2 : 0) | (direction[2] < 0.0f ? 4 : 0);
+    }
+
+    void slab(const float minimum[3], const float maximum[3], const float origin[3], const float inverse[3],
+              float &entry, float &exit)
+    {
+        entry = std::numeric_limits<float>::lowest();
+        exit = std::numeric_limits<float>::max();
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            const float t0 = (minimum[c] - origin[c]) * inverse[c];
+            const float t1 = (maximum[c] - origin[c]) * inverse[c];
+            entry = std::max(entry, std::min(t0, t1));
+            exit = std::min(exit, std::max(t0, t1));
+        }
+    }
+
+    void push_children(const Octree &octree, const uint32_t &node, const int32_t &signs, uint32_t *stack, int32_t &top)
+    {
+        // Pushed back to front so the child nearest the origin is popped first.
+        for (int32_t k = 7; k >= 0; k--)
+        {
+            const int32_t child = octree.child(node, k ^ signs);
+
+            if (child >= 0)
+            {
+                stack[top++] = static_cast<uint32_t>(child);
+            }
+        }
+    }
+
+    // Voxels are hit where the ray enters them; rays starting inside an occupied voxel pass through it.
+    void cast_octree(const Octree &octree, const float origin[3], const float direction[3],
+                     const float &minimum_range, float &range, int32_t &hit)
+    {
+        const float inverse[3] = {safe_inverse(direction[0]), safe_inverse(direction[1]), safe_inverse(direction[2])};
+        const int32_t signs = sign_mask(direction);
+        const ArrayView<Octree::Node> nodes = octree.nodes();
+
+        uint32_t stack[kStackSize];
+        int32_t top = 0;
+        stack[top++] = 0;
+
+        while (top > 0)
+        {
+            const uint32_t index = stack[--top];
+            const Octree::Node &node = nodes[index];
+
+            float entry;
+            float exit;
+            slab(node.minimum, node.maximum, origin, inverse, entry, exit);
+
+            if (std::max(entry, minimum_range) > std::min(exit, range))
+            {
+                continue;
+            }
+
+            if (node.child_mask != 0)
+            {
+                push_children(octree, index, signs, stack, top);
+                continue;
+            }
+
+            if (entry >= minimum_range && entry < range)
+            {
+                range = entry;
+                hit = static_cast<int32_t>(octree.indices()[node.begin]);
+            }
+        }
+    }
+
+#ifdef __AVX__
+    struct RayPacket
+    {
+        __m256 origin[3];
+        __m256 direction[3];
+        __m256 inverse[3];
+        __m256 minimum;
+        __m256 range;
+    };
+
+    __m256 slab8(const float minimum[3], const float maximum[3], const RayPacket &packet, __m256 &entry)
+    {
+        __m256 near = _mm256_set1_ps(std::numeric_limits<float>::lowest());
+        __m256 far = _mm256_set1_ps(std::numeric_limits<float>::max());
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            const __m256 t0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(minimum[c]), packet.origin[c]), packet.inverse[c]);
+            const __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(maximum[c]), packet.origin[c]), packet.inverse[c]);
+            near = _mm256_max_ps(near, _mm256_min_ps(t0, t1));
+            far = _mm256_min_ps(far, _mm256_max_ps(t0, t1));
+        }
+
+        entry = near;
+
+        const __m256 clamped_near = _mm256_max_ps(near, packet.minimum);
+        const __m256 clamped_far = _mm256_min_ps(far, packet.range);
+
+        return _mm256_cmp_ps(clamped_near, clamped_far, _CMP_LE_OQ);
+    }
+
+    void store_hits(const int32_t &mask, const int32_t &id, int32_t hits[8])
+    {
+        for (int32_t lane = 0; lane < 8; lane++)
+        {
+            if ((mask >> lane) & 1)
+            {
+                hits[lane] = id;
+            }
+        }
+    }
+
+    void cast_octree8(const Octree &octree, RayPacket &packet, const int32_t &signs, int32_t hits[8])
+    {
+        const ArrayView<Octree::Node> nodes = octree.nodes();
+
+        uint32_t stack[kStackSize];
+        int32_t top = 0;
+        stack[top++] = 0;
+
+        while (top > 0)
+        {
+            const uint32_t index = stack[--top];
+            const Octree::Node &node = nodes[index];
+
+            __m256 entry;
+            const __m256 active = slab8(node.minimum, node.maximum, packet, entry);
+
+            if (_mm256_movemask_ps(active) == 0)
+            {
+                continue;
+            }
+
+            if (node.child_mask != 0)
+            {
+                push_children(octree, index, signs, stack, top);
+                continue;
+            }
+
+            const __m256 hit = _mm256_and_ps(active, _mm256_and_ps(_mm256_cmp_ps(entry, packet.minimum, _CMP_GE_OQ),
+                                                                   _mm256_cmp_ps(entry, packet.range, _CMP_LT_OQ)));
+            const int32_t mask = _mm256_movemask_ps(hit);
+
+            if (mask != 0)
+            {
+                packet.range = _mm256_blendv_ps(packet.range, entry, hit);
+                store_hits(mask, static_cast<int32_t>(octree.indices()[node.begin]), hits);
+            }
+        }
+    }
+
+    void cast_bvh8(const Bvh &bvh, RayPacket &packet, const float lead_origin[3], const float lead_direction[3], int32_t hits[8])
+    {
+        const std::vector<Bvh::Node> &nodes = bvh.nodes();
+
+        if (nodes.empty())
+        {
+            return;
+        }
+
+        const float *origins[3] = {bvh.origin(0), bvh.origin(1), bvh.origin(2)};
+        const float *first_edges[3] = {bvh.first_edge(0), bvh.first_edge(1), bvh.first_edge(2)};
+        const float *second_edges[3] = {bvh.second_edge(0), bvh.second_edge(1), bvh.second_edge(2)};
+
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 epsilon = _mm256_set1_ps(1e-12f);
+        const __m256 sign_bit = _mm256_set1_ps(-0.0f);
+
+        uint32_t stack[kStackSize];
+        int32_t top = 0;
+        stack[top++] = 0;
+
+        while (top > 0)
+        {
+            const Bvh::Node &node = nodes[stack[--top]];
+
+            __m256 entry;
+            const __m256 active = slab8(node.minimum, node.maximum, packet, entry);
+
+            if (_mm256_movemask_ps(active) == 0)
+            {
+                continue;
+            }
+
+            if (node.count == 0)
+            {
+                const Bvh::Node &left = nodes[node.first];
+                const Bvh::Node &right = nodes[node.first + 1];
+
+                // Order children along the lead ray so the nearer one is traversed first.
+                float left_distance = 0.0f;
+                float right_distance = 0.0f;
+
+                for (int32_t c = 0; c < 3; c++)
+                {
+                    left_distance += (0.5f * (left.minimum[c] + left.maximum[c]) - lead_origin[c]) * lead_direction[c];
+                    right_distance += (0.5f * (right.minimum[c] + right.maximum[c]) - lead_origin[c]) * lead_direction[c];
+                }
+
+                const bool left_first = left_distance <= right_distance;
+                stack[top++] = left_first ? node.first + 1 : node.first;
+                stack[top++] = left_first ? node.first : node.first + 1;
+                continue;
+            }
+
+            for (uint32_t i = node.first; i < node.first + node.count; i++)
+            {
+                const __m256 e1[3] = {_mm256_set1_ps(first_edges[0][i]), _mm256_set1_ps(first_edges[1][i]), _mm256_set1_ps(first_edges[2][i])};
+                const __m256 e2[3] = {_mm256_set1_ps(second_edges[0][i]), _mm256_set1_ps(second_edges[1][i]), _mm256_set1_ps(second_edges[2][i])};
+                const __m256 *d = packet.direction;
+
+                const __m256 p[3] = {
+                    _mm256_sub_ps(_mm256_mul_ps(d[1], e2[2]), _mm256_mul_ps(d[2], e2[1])),
+                    _mm256_sub_ps(_mm256_mul_ps(d[2], e2[0]), _mm256_mul_ps(d[0], e2[2])),
+                    _mm256_sub_ps(_mm256_mul_ps(d[0], e2[1]), _mm256_mul_ps(d[1], e2[0]))};
+
+                const __m256 determinant = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1[0], p[0]), _mm256_mul_ps(e1[1], p[1])), _mm256_mul_ps(e1[2], p[2]));
+                const __m256 valid = _mm256_cmp_ps(_mm256_andnot_ps(sign_bit, determinant), epsilon, _CMP_GE_OQ);
+                const __m256 inverse_determinant = _mm256_div_ps(one, determinant);
+
+                const __m256 s[3] = {
+                    _mm256_sub_ps(packet.origin[0], _mm256_set1_ps(origins[0][i])),
+                    _mm256_sub_ps(packet.origin[1], _mm256_set1_ps(origins[1][i])),
+                    _mm256_sub_ps(packet.origin[2], _mm256_set1_ps(origins[2][i]))};
+
+                const __m256 u = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(s[0], p[0]), _mm256_mul_ps(s[1], p[1])), _mm256_mul_ps(s[2], p[2])), inverse_determinant);
+
+                const __m256 q[3] = {
+                    _mm256_sub_ps(_mm256_mul_ps(s[1], e1[2]), _mm256_mul_ps(s[2], e1[1])),
+                    _mm256_sub_ps(_mm256_mul_ps(s[2], e1[0]), _mm256_mul_ps(s[0], e1[2])),
+                    _mm256_sub_ps(_mm256_mul_ps(s[0], e1[1]), _mm256_mul_ps(s[1], e1[0]))};
+
+                const __m256 v = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(d[0], q[0]), _mm256_mul_ps(d[1], q[1])), _mm256_mul_ps(d[2], q[2])), inverse_determinant);
+                const __m256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2[0], q[0]), _mm256_mul_ps(e2[1], q[1])), _mm256_mul_ps(e2[2], q[2])), inverse_determinant);
+
+                __m256 hit = _mm256_and_ps(active, valid);
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, packet.minimum, _CMP_GE_OQ));
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, packet.range, _CMP_LT_OQ));
+
+                const int32_t mask = _mm256_movemask_ps(hit);
+
+                if (mask != 0)
+                {
+                    packet.range = _mm256_blendv_ps(packet.range, t, hit);
+                    store_hits(mask, static_cast<int32_t>(bvh.triangle_ids()[i]), hits);
+                }
+            }
+        }
+    }
+#endif
+}
+
+RayCaster::RayCaster(const Octree &octree, const float &minimum_range, const float &maximum_range)
+    : octree_(&octree),
+      bvh_(nullptr),
+      minimum_range_(std::max(0.0f, minimum_range)),
+      maximum_range_(std::max(minimum_range_, maximum_range))
+{
+}
+
+RayCaster::RayCaster(const Bvh &bvh, const float &minimum_range, const float &maximum_range)
+    : octree_(nullptr),
+      bvh_(&bvh),
+      minimum_range_(std::max(0.0f, minimum_range)),
+      maximum_range_(std::max(minimum_range_, maximum_range))
+{
+}
+
+float RayCaster::minimum_range() const
+{
+    return minimum_range_;
+}
+
+float RayCaster::maximum_range() const
+{
+    return maximum_range_;
+}
+
+void RayCaster::cast_range(const float origin[3], const float rotation[9], const PointCloud &directions,
+                           const size_t &begin, const size_t &end, RayScan &scan) const
+{
+    const float *dx = directions.x();
+    const float *dy = directions.y();
+    const float *dz = directions.z();
+
+    float *px = scan.points.x();
+    float *py = scan.points.y();
+    float *pz = scan.points.z();
+
+    size_t i = begin;
+
+#ifdef __AVX__
+    const bool has_map = octree_ != nullptr ? !octree_->empty() : !bvh_->empty();
+
+    for (; has_map && i + 8 <= end; i += 8)
+    {
+        const __m256 sx = _mm256_loadu_ps(dx + i);
+        const __m256 sy = _mm256_loadu_ps(dy + i);
+        const __m256 sz = _mm256_loadu_ps(dz + i);
+
+        const __m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, sx), _mm256_mul_ps(sy, sy)), _mm256_mul_ps(sz, sz)));
+        const __m256 scale = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_max_ps(length, _mm256_set1_ps(1e-20f)));
+
+        const __m256 ux = _mm256_mul_ps(sx, scale);
+        const __m256 uy = _mm256_mul_ps(sy, scale);
+        const __m256 uz = _mm256_mul_ps(sz, scale);
+
+        RayPacket packet;
+
+        for (int32_t r = 0; r < 3; r++)
+        {
+            packet.origin[r] = _mm256_set1_ps(origin[r]);
+            packet.direction[r] = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(rotation[3 * r]), ux),
+                                                              _mm256_mul_ps(_mm256_set1_ps(rotation[3 * r + 1]), uy)),
+                                                _mm256_mul_ps(_mm256_set1_ps(rotation[3 * r + 2]), uz));
+
+            // Keep zero components away from 0 so slab tests never produce 0 * inf.
+            const __m256 magnitude = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), packet.direction[r]);
+            const __m256 sign = _mm256_and_ps(_mm256_set1_ps(-0.0f), packet.direction[r]);
+            const __m256 clamped = _mm256_or_ps(_mm256_max_ps(magnitude, _mm256_set1_ps(1e-12f)), sign);
+            packet.inverse[r] = _mm256_div_ps(_mm256_set1_ps(1.0f), clamped);
+        }
+
+        packet.minimum = _mm256_set1_ps(minimum_range_);
+        packet.range = _mm256_set1_ps(maximum_range_);
+
+        float lead_direction[3];
+
+        for (int32_t r = 0; r < 3; r++)
+        {
+            float lanes[8];
+            _mm256_storeu_ps(lanes, packet.direction[r]);
+            lead_direction[r] = lanes[0];
+        }
+
+        int32_t hits[8] = {-1, -1, -1, -1, -1, -1, -1, -1};
+
+        if (octree_ != nullptr)
+        {
+            cast_octree8(*octree_, packet, sign_mask(lead_direction), hits);
+        }
+        else
+        {
+            cast_bvh8(*bvh_, packet, origin, lead_direction, hits);
+        }
+
+        const __m256 missed = _mm256_castsi256_ps(_mm256_setr_epi32(hits[0] >> 31, hits[1] >> 31, hits[2] >> 31, hits[3] >> 31,
+                                                                   hits[4] >> 31, hits[5] >> 31, hits[6] >> 31, hits[7] >> 31));
+        const __m256 range = _mm256_andnot_ps(missed, packet.range);
+
+        _mm256_storeu_ps(scan.ranges.data() + i, range);
+        _mm256_storeu_ps(px + i, _mm256_mul_ps(ux, range));
+        _mm256_storeu_ps(py + i, _mm256_mul_ps(uy, range));
+        _mm256_storeu_ps(pz + i, _mm256_mul_ps(uz, range));
+        std::copy(hits, hits + 8, scan.hits.begin() + i);
+    }
+#endif
+
+    for (; i < end; i++)
+    {
+        float local[3] = {dx[i], dy[i], dz[i]};
+        const float length = std::sqrt(local[0] * local[0] + local[1] * local[1] + local[2] * local[2]);
+        const float scale = 1.0f / std::max(length, 1e-20f);
+
+        for (float &value : local)
+        {
+            value *= scale;
+        }
+
+        float direction[3];
+
+        for (int32_t r = 0; r < 3; r++)
+        {
+            direction[r] = rotation[3 * r] * local[0] + rotation[3 * r + 1] * local[1] + rotation[3 * r + 2] * local[2];
+        }
+
+        float range = maximum_range_;
+        int32_t hit = -1;
+
+        if (octree_ != nullptr)
+        {
+            if (!octree_->empty())
+            {
+                cast_octree(*octree_, origin, direction, minimum_range_, range, hit);
+            }
+        }
+        else
+        {
+            uint32_t triangle = 0;
+
+            if (bvh_->intersect(Vector4(origin[0], origin[1], origin[2], 1.0f), Vector4(direction[0], direction[1], direction[2], 0.0f),
+                                minimum_range_, range, triangle))
+            {
+                hit = static_cast<int32_t>(triangle);
+            }
+        }
+
+        if (hit < 0)
+        {
+            range = 0.0f;
+        }
+
+        scan.ranges[i] = range;
+        scan.hits[i] = hit;
+        px[i] = local[0] * range;
+        py[i] = local[1] * range;
+        pz[i] = local[2] * range;
+    }
+}
+
+void RayCaster::cast(const Matrix4 &pose, const PointCloud &directions, RayScan &scan, ThreadPool &pool) const
+{
+    LRE_PROFILE_SCOPE("RayCaster::cast");
+    LRE_PROFILE_COUNT(Counter::QueriesIssued, directions.size());
+
+    const size_t count = directions.size();
+
+    scan.points.resize(count);
+    scan.ranges.resize(count);
+    scan.hits.resize(count);
+
+    const float origin[3] = {pose[3], pose[7], pose[11]};
+    const float rotation[9] = {pose[0], pose[1], pose[2], pose[4], pose[5], pose[6], pose[8], pose[9], pose[10]};
+
+    pool.parallel_for(0, count, kRayGrain, [this, &origin, &rotation, &directions, &scan](const size_t &begin, const size_t &end)
+                      { cast_range(origin, rotation, directions, begin, end, scan); });
+}
+
+void RayCaster::cast(const Matrix4 &pose, const PointCloud &directions, RayScan &scan) const
+{
+    cast(pose, directions, scan, ThreadPool::shared());
+}
+
+PointCloud RayCaster::spinning_pattern(const size_t &rings, const size_t &columns,
+                                       const float &lower_elevation, const float &upper_elevation)
+{
+    PointCloud pattern;
+    pattern.reserve(rings * columns);
+
+    const float pi = 3.14159265358979323846f;
+
+    // Column-major order keeps the beams of one firing adjacent, which keeps packets coherent.
+    for (size_t column = 0; column < columns; column++)
+    {
+        const float azimuth = 2.0f * pi * static_cast<float>(column) / static_cast<float>(columns);
+
+        for (size_t ring = 0; ring < rings; ring++)
+        {
+            const float t = rings > 1 ? static_cast<float>(ring) / static_cast<float>(rings - 1) : 0.0f;
+            const float elevation = lower_elevation + (upper_elevation - lower_elevation) * t;
+
+            pattern.push_back(Vector4(std::cos(elevation) * std::cos(azimuth),
+                                      std::cos(elevation) * std::sin(azimuth),
+                                      std::sin(elevation)));
+        }
+    }
+
+    return pattern;
+}
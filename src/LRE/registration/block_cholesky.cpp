@@ -0,0 +1,386 @@
+#include <LRE/registration/block_cholesky.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <stdexcept>
+
+namespace
+{
+    constexpr size_t kBlock = BlockCholesky::kBlock;
+
+    constexpr size_t kBlockSize = BlockCholesky::kBlockSize;
+
+    constexpr double kMinimumDamping = 1e-6;
+
+    // In-place lower Cholesky factor of a dense 6x6 block.
+    bool factor_block(double *block)
+    {
+        for (size_t c = 0; c < kBlock; c++)
+        {
+            double pivot = block[c * kBlock + c];
+
+            for (size_t k = 0; k < c; k++)
+            {
+                pivot -= block[c * kBlock + k] * block[c * kBlock + k];
+            }
+
+            if (!(pivot > 0.0))
+            {
+                return false;
+            }
+
+            const double root = std::sqrt(pivot);
+            block[c * kBlock + c] = root;
+
+            for (size_t r = c + 1; r < kBlock; r++)
+            {
+                double value = block[r * kBlock + c];
+
+                for (size_t k = 0; k < c; k++)
+                {
+                    value -= block[r * kBlock + k] * block[c * kBlock + k];
+                }
+
+                block[r * kBlock + c] = value / root;
+            }
+        }
+
+        return true;
+    }
+
+    // Replaces X with X * L^-T for the lower factor L.
+    void solve_right(const double *lower, double *block)
+    {
+        for (size_t r = 0; r < kBlock; r++)
+        {
+            double *row = block + r * kBlock;
+
+            for (size_t c = 0; c < kBlock; c++)
+            {
+                double value = row[c];
+
+                for (size_t k = 0; k < c; k++)
+                {
+                    value -= row[k] * lower[c * kBlock + k];
+                }
+
+                row[c] = value / lower[c * kBlock + c];
+            }
+        }
+    }
+
+    // target -= a * b^T
+    void subtract_outer(const double *a, const double *b, double *target)
+    {
+        for (size_t r = 0; r < kBlock; r++)
+        {
+            for (size_t c = 0; c < kBlock; c++)
+            {
+                double sum = 0.0;
+
+                for (size_t k = 0; k < kBlock; k++)
+                {
+                    sum += a[r * kBlock + k] * b[c * kBlock + k];
+                }
+
+                target[r * kBlock + c] -= sum;
+            }
+        }
+    }
+}
+
+BlockCholesky::BlockCholesky()
+{
+}
+
+double *BlockCholesky::find(std::vector<double> &blocks, const uint32_t &row, const uint32_t &column)
+{
+    const auto first = rows_.begin() + column_start_[column];
+    const auto last = rows_.begin() + column_start_[column + 1];
+    const auto found = std::lower_bound(first, last, row);
+
+    if (found == last || *found != row)
+    {
+        return nullptr;
+    }
+
+    return blocks.data() + (found - rows_.begin()) * kBlockSize;
+}
+
+void BlockCholesky::analyze(const size_t &size, const std::vector<std::pair<uint32_t, uint32_t>> &couplings)
+{
+    std::vector<std::vector<uint32_t>> adjacency(size);
+
+    for (const std::pair<uint32_t, uint32_t> &coupling : couplings)
+    {
+        if (coupling.first >= size || coupling.second >= size)
+        {
+            throw std::out_of_range("BlockCholesky: coupling references a missing variable");
+        }
+
+        if (coupling.first != coupling.second)
+        {
+            adjacency[coupling.first].push_back(coupling.second);
+            adjacency[coupling.second].push_back(coupling.first);
+        }
+    }
+
+    using Entry = std::pair<size_t, uint32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+    for (uint32_t v = 0; v < size; v++)
+    {
+        std::sort(adjacency[v].begin(), adjacency[v].end());
+        adjacency[v].erase(std::unique(adjacency[v].begin(), adjacency[v].end()), adjacency[v].end());
+        queue.push(Entry(adjacency[v].size(), v));
+    }
+
+    // Eliminating a variable turns its neighbourhood into a clique, which is exactly its factor column.
+    std::vector<std::vector<uint32_t>> patterns(size);
+    std::vector<uint8_t> eliminated(size, 0);
+    std::vector<uint32_t> merged;
+
+    order_.clear();
+    order_.reserve(size);
+
+    while (!queue.empty())
+    {
+        const Entry entry = queue.top();
+        queue.pop();
+
+        const uint32_t v = entry.second;
+
+        if (eliminated[v] || entry.first != adjacency[v].size())
+        {
+            continue;
+        }
+
+        eliminated[v] = 1;
+        order_.push_back(v);
+        patterns[v].swap(adjacency[v]);
+
+        for (const uint32_t u : patterns[v])
+        {
+            merged.clear();
+            std::set_union(adjacency[u].begin(), adjacency[u].end(), patterns[v].begin(), patterns[v].end(), std::back_inserter(merged));
+            merged.erase(std::remove_if(merged.begin(), merged.end(), [u, v](const uint32_t &w)
+                                        { return w == u || w == v; }),
+                         merged.end());
+
+            adjacency[u].swap(merged);
+            queue.push(Entry(adjacency[u].size(), u));
+        }
+    }
+
+    position_.assign(size, 0);
+
+    for (uint32_t p = 0; p < size; p++)
+    {
+        position_[order_[p]] = p;
+    }
+
+    column_start_.assign(size + 1, 0);
+    rows_.clear();
+
+    for (uint32_t p = 0; p < size; p++)
+    {
+        const size_t first = rows_.size();
+
+        for (const uint32_t u : patterns[order_[p]])
+        {
+            rows_.push_back(position_[u]);
+        }
+
+        std::sort(rows_.begin() + first, rows_.end());
+        column_start_[p + 1] = static_cast<uint32_t>(rows_.size());
+    }
+
+    diagonal_.assign(size * kBlockSize, 0.0);
+    blocks_.assign(rows_.size() * kBlockSize, 0.0);
+}
+
+size_t BlockCholesky::size() const
+{
+    return order_.size();
+}
+
+size_t BlockCholesky::block_count() const
+{
+    return order_.size() + rows_.size();
+}
+
+void BlockCholesky::clear()
+{
+    std::fill(diagonal_.begin(), diagonal_.end(), 0.0);
+    std::fill(blocks_.begin(), blocks_.end(), 0.0);
+}
+
+void BlockCholesky::add_diagonal(const uint32_t &variable, const double *block)
+{
+    double *target = diagonal_.data() + position_[variable] * kBlockSize;
+
+    for (size_t i = 0; i < kBlockSize; i++)
+    {
+        target[i] += block[i];
+    }
+}
+
+void BlockCholesky::add(const uint32_t &a, const uint32_t &b, const double *block)
+{
+    const uint32_t row = position_[a];
+    const uint32_t column = position_[b];
+
+    // Only the lower triangle is stored, so couplings above the diagonal are added transposed.
+    double *target = row > column ? find(blocks_, row, column) : find(blocks_, column, row);
+
+    if (target == nullptr)
+    {
+        throw std::invalid_argument("BlockCholesky: coupling was not part of the analyzed pattern");
+    }
+
+    for (size_t r = 0; r < kBlock; r++)
+    {
+        for (size_t c = 0; c < kBlock; c++)
+        {
+            target[r * kBlock + c] += row > column ? block[r * kBlock + c] : block[c * kBlock + r];
+        }
+    }
+}
+
+bool BlockCholesky::factorize(const double &damping)
+{
+    LRE_PROFILE_SCOPE("BlockCholesky::factorize");
+
+    factor_diagonal_ = diagonal_;
+    factor_blocks_ = blocks_;
+
+    const size_t size = order_.size();
+
+    if (damping > 0.0)
+    {
+        for (size_t p = 0; p < size; p++)
+        {
+            for (size_t k = 0; k < kBlock; k++)
+            {
+                double &value = factor_diagonal_[p * kBlockSize + k * kBlock + k];
+                value += damping * std::max(value, kMinimumDamping);
+            }
+        }
+    }
+
+    for (uint32_t p = 0; p < size; p++)
+    {
+        double *lower = factor_diagonal_.data() + p * kBlockSize;
+
+        if (!factor_block(lower))
+        {
+            return false;
+        }
+
+        const uint32_t first = column_start_[p];
+        const uint32_t last = column_start_[p + 1];
+
+        for (uint32_t k = first; k < last; k++)
+        {
+            solve_right(lower, factor_blocks_.data() + k * kBlockSize);
+        }
+
+        // Right-looking Schur complement update of the trailing submatrix.
+        for (uint32_t k1 = first; k1 < last; k1++)
+        {
+            const double *a = factor_blocks_.data() + k1 * kBlockSize;
+
+            for (uint32_t k2 = first; k2 <= k1; k2++)
+            {
+                const double *b = factor_blocks_.data() + k2 * kBlockSize;
+                double *target = k1 == k2 ? factor_diagonal_.data() + rows_[k1] * kBlockSize : find(factor_blocks_, rows_[k1], rows_[k2]);
+
+                subtract_outer(a, b, target);
+            }
+        }
+    }
+
+    return true;
+}
+
+void BlockCholesky::solve(const std::vector<double> &rhs, std::vector<double> &solution) const
+{
+    const size_t size = order_.size();
+    std::vector<double> y(size * kBlock);
+
+    for (size_t p = 0; p < size; p++)
+    {
+        std::copy_n(rhs.begin() + order_[p] * kBlock, kBlock, y.begin() + p * kBlock);
+    }
+
+    for (size_t p = 0; p < size; p++)
+    {
+        const double *lower = factor_diagonal_.data() + p * kBlockSize;
+        double *value = y.data() + p * kBlock;
+
+        for (size_t r = 0; r < kBlock; r++)
+        {
+            for (size_t k = 0; k < r; k++)
+            {
+                value[r] -= lower[r * kBlock + k] * value[k];
+            }
+
+            value[r] /= lower[r * kBlock + r];
+        }
+
+        for (uint32_t k = column_start_[p]; k < column_start_[p + 1]; k++)
+        {
+            const double *block = factor_blocks_.data() + k * kBlockSize;
+            double *target = y.data() + rows_[k] * kBlock;
+
+            for (size_t r = 0; r < kBlock; r++)
+            {
+                for (size_t c = 0; c < kBlock; c++)
+                {
+                    target[r] -= block[r * kBlock + c] * value[c];
+                }
+            }
+        }
+    }
+
+    for (size_t p = size; p-- > 0;)
+    {
+        const double *lower = factor_diagonal_.data() + p * kBlockSize;
+        double *value = y.data() + p * kBlock;
+
+        for (uint32_t k = column_start_[p]; k < column_start_[p + 1]; k++)
+        {
+            const double *block = factor_blocks_.data() + k * kBlockSize;
+            const double *source = y.data() + rows_[k] * kBlock;
+
+            for (size_t r = 0; r < kBlock; r++)
+            {
+                for (size_t c = 0; c < kBlock; c++)
+                {
+                    value[c] -= block[r * kBlock + c] * source[r];
+                }
+            }
+        }
+
+        for (size_t r = kBlock; r-- > 0;)
+        {
+            for (size_t k = r + 1; k < kBlock; k++)
+            {
+                value[r] -= lower[k * kBlock + r] * value[k];
+            }
+
+            value[r] /= lower[r * kBlock + r];
+        }
+    }
+
+    solution.assign(size * kBlock, 0.0);
+
+    for (size_t p = 0; p < size; p++)
+    {
+        std::copy_n(y.begin() + p * kBlock, kBlock, solution.begin() + order_[p] * kBlock);
+    }
+}
@@ -0,0 +1,728 @@
+#include <LRE/registration/global_registration.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <LRE/linalg/quaternion.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <random>
+
+namespace
+{
+    constexpr size_t kIterationGrain = 64;
+
+    constexpr size_t kMatchGrain = 256;
+
+    constexpr size_t kCliqueSeeds = 32;
+
+    constexpr int32_t kGncIterations = 100;
+
+    constexpr double kGncFactor = 1.4;
+
+    // Largest-eigenvalue eigenvector of a symmetric 4x4 matrix by cyclic Jacobi rotations.
+    void dominant_eigenvector(double matrix[4][4], double vector[4])
+    {
+        double eigenvectors[4][4] = {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+
+        for (int32_t sweep = 0; sweep < 50; sweep++)
+        {
+            double off = 0.0;
+
+            for (int32_t p = 0; p < 4; p++)
+            {
+                for (int32_t q = p + 1; q < 4; q++)
+                {
+                    off += matrix[p][q] * matrix[p][q];
+                }
+            }
+
+            if (off < 1e-24)
+            {
+                break;
+            }
+
+            for (int32_t p = 0; p < 4; p++)
+            {
+                for (int32_t q = p + 1; q < 4; q++)
+                {
+                    if (std::abs(matrix[p][q]) < 1e-30)
+                    {
+                        continue;
+                    }
+
+                    const double theta = 0.5 * (matrix[q][q] - matrix[p][p]) / matrix[p][q];
+                    const double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                    const double c = 1.0 / std::sqrt(t * t + 1.0);
+                    const double s = t * c;
+
+                    for (int32_t k = 0; k < 4; k++)
+                    {
+                        const double kp = matrix[k][p];
+                        const double kq = matrix[k][q];
+                        matrix[k][p] = c * kp - s * kq;
+                        matrix[k][q] = s * kp + c * kq;
+                    }
+
+                    for (int32_t k = 0; k < 4; k++)
+                    {
+                        const double pk = matrix[p][k];
+                        const double qk = matrix[q][k];
+                        matrix[p][k] = c * pk - s * qk;
+                        matrix[q][k] = s * pk + c * qk;
+                    }
+
+                    for (int32_t k = 0; k < 4; k++)
+                    {
+                        const double kp = eigenvectors[k][p];
+                        const double kq = eigenvectors[k][q];
+                        eigenvectors[k][p] = c * kp - s * kq;
+                        eigenvectors[k][q] = s * kp + c * kq;
+                    }
+                }
+            }
+        }
+
+        int32_t best = 0;
+
+        for (int32_t i = 1; i < 4; i++)
+        {
+            if (matrix[i][i] > matrix[best][best])
+            {
+                best = i;
+            }
+        }
+
+        for (int32_t k = 0; k < 4; k++)
+        {
+            vector[k] = eigenvectors[k][best];
+        }
+    }
+
+    // Horn's closed-form absolute orientation from the cross-covariance S[a][b] = sum(source_a * target_b).
+    Quaternion horn_rotation(const double s[3][3])
+    {
+        double matrix[4][4] = {
+            {s[0][0] + s[1][1] + s[2][2], s[1][2] - s[2][1], s[2][0] - s[0][2], s[0][1] - s[1][0]},
+            {s[1][2] - s[2][1], s[0][0] - s[1][1] - s[2][2], s[0][1] + s[1][0], s[2][0] + s[0][2]},
+            {s[2][0] - s[0][2], s[0][1] + s[1][0], -s[0][0] + s[1][1] - s[2][2], s[1][2] + s[2][1]},
+            {s[0][1] - s[1][0], s[2][0] + s[0][2], s[1][2] + s[2][1], -s[0][0] - s[1][1] + s[2][2]}};
+
+        double q[4];
+        dominant_eigenvector(matrix, q);
+
+        return Quaternion(static_cast<float>(q[1]), static_cast<float>(q[2]), static_cast<float>(q[3]), static_cast<float>(q[0])).normalized();
+    }
+
+    Quaternion fit_rotation(const std::vector<Vector4> &source, const std::vector<Vector4> &target, const std::vector<float> &weights)
+    {
+        double s[3][3] = {};
+
+        for (size_t i = 0; i < source.size(); i++)
+        {
+            for (int32_t a = 0; a < 3; a++)
+            {
+                for (int32_t b = 0; b < 3; b++)
+                {
+                    s[a][b] += static_cast<double>(weights[i]) * source[i][a] * target[i][b];
+                }
+            }
+        }
+
+        return horn_rotation(s);
+    }
+
+    Vector4 apply(const Matrix4 &transform, const Vector4 &point)
+    {
+        return Vector4(transform[0] * point[0] + transform[1] * point[1] + transform[2] * point[2] + transform[3],
+                       transform[4] * point[0] + transform[5] * point[1] + transform[6] * point[2] + transform[7],
+                       transform[8] * point[0] + transform[9] * point[1] + transform[10] * point[2] + transform[11],
+                       1.0f);
+    }
+
+    size_t count_inliers(const Matrix4 &transform, const std::vector<Vector4> &source, const std::vector<Vector4> &target,
+                         const float &sqr_threshold, std::vector<uint32_t> *inliers)
+    {
+        size_t count = 0;
+
+        for (size_t i = 0; i < source.size(); i++)
+        {
+            const Vector4 moved = apply(transform, source[i]);
+
+            const float dx = moved[0] - target[i][0];
+            const float dy = moved[1] - target[i][1];
+            const float dz = moved[2] - target[i][2];
+
+            if (dx * dx + dy * dy + dz * dz <= sqr_threshold)
+            {
+                count++;
+
+                if (inliers != nullptr)
+                {
+                    inliers->push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+
+        return count;
+    }
+
+    // Correspondence pairs must preserve distances up to the similarity ratio under any rigid motion.
+    bool compatible(const Vector4 &source_a, const Vector4 &source_b, const Vector4 &target_a, const Vector4 &target_b,
+                    const float &similarity, const float &tolerance)
+    {
+        const float source_length = Vector4::distance(source_a, source_b);
+        const float target_length = Vector4::distance(target_a, target_b);
+
+        return std::abs(source_length - target_length) <= tolerance ||
+               std::min(source_length, target_length) >= similarity * std::max(source_length, target_length);
+    }
+
+    // Component-wise interval voting: the value supported by the most measurements within the bound.
+    float vote(std::vector<float> &values, const float &bound)
+    {
+        std::sort(values.begin(), values.end());
+
+        size_t best_count = 0;
+        float best_value = values.empty() ? 0.0f : values[0];
+        size_t low = 0;
+
+        for (size_t high = 0; high < values.size(); high++)
+        {
+            while (values[high] - values[low] > 2.0f * bound)
+            {
+                low++;
+            }
+
+            if (high - low + 1 > best_count)
+            {
+                best_count = high - low + 1;
+
+                float sum = 0.0f;
+
+                for (size_t k = low; k <= high; k++)
+                {
+                    sum += values[k];
+                }
+
+                best_value = sum / static_cast<float>(best_count);
+            }
+        }
+
+        return best_value;
+    }
+}
+
+GlobalRegistration::GlobalRegistration(const float &inlier_threshold, const size_t &max_iterations, const float &edge_similarity,
+                                       const RegistrationSolver &solver, const uint32_t &seed)
+    : inlier_threshold_(std::max(1e-6f, inlier_threshold)),
+      max_iterations_(std::max<size_t>(1, max_iterations)),
+      edge_similarity_(std::max(0.0f, std::min(1.0f, edge_similarity))),
+      confidence_(0.999f),
+      solver_(solver),
+      seed_(seed)
+{
+}
+
+GlobalRegistration::GlobalRegistration(const float &inlier_threshold, const RegistrationSolver &solver)
+    : GlobalRegistration(inlier_threshold, 100000, 0.9f, solver, 42)
+{
+}
+
+GlobalRegistration::GlobalRegistration(const float &inlier_threshold)
+    : GlobalRegistration(inlier_threshold, RegistrationSolver::Ransac)
+{
+}
+
+float GlobalRegistration::inlier_threshold() const
+{
+    return inlier_threshold_;
+}
+
+RegistrationSolver GlobalRegistration::solver() const
+{
+    return solver_;
+}
+
+Matrix4 GlobalRegistration::estimate_rigid(const std::vector<Vector4> &source, const std::vector<Vector4> &target)
+{
+    std::vector<uint32_t> indices(source.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    return estimate_rigid(source, target, indices.data(), indices.size(), nullptr);
+}
+
+Matrix4 GlobalRegistration::estimate_rigid(const std::vector<Vector4> &source, const std::vector<Vector4> &target,
+                                           const uint32_t *indices, const size_t &count, const float *weights)
+{
+    Matrix4 transform;
+    transform.identity();
+
+    if (count == 0)
+    {
+        return transform;
+    }
+
+    double total = 0.0;
+    double source_centroid[3] = {};
+    double target_centroid[3] = {};
+
+    for (size_t k = 0; k < count; k++)
+    {
+        const double weight = weights != nullptr ? weights[k] : 1.0;
+        const uint32_t i = indices[k];
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            source_centroid[c] += weight * source[i][c];
+            target_centroid[c] += weight * target[i][c];
+        }
+
+        total += weight;
+    }
+
+    if (total <= 0.0)
+    {
+        return transform;
+    }
+
+    for (int32_t c = 0; c < 3; c++)
+    {
+        source_centroid[c] /= total;
+        target_centroid[c] /= total;
+    }
+
+    double s[3][3] = {};
+
+    for (size_t k = 0; k < count; k++)
+    {
+        const double weight = weights != nullptr ? weights[k] : 1.0;
+        const uint32_t i = indices[k];
+
+        for (int32_t a = 0; a < 3; a++)
+        {
+            for (int32_t b = 0; b < 3; b++)
+            {
+                s[a][b] += weight * (source[i][a] - source_centroid[a]) * (target[i][b] - target_centroid[b]);
+            }
+        }
+    }
+
+    transform = horn_rotation(s).to_matrix();
+
+    for (int32_t r = 0; r < 3; r++)
+    {
+        transform[4 * r + 3] = static_cast<float>(target_centroid[r] - (transform[4 * r] * source_centroid[0] +
+                                                                         transform[4 * r + 1] * source_centroid[1] +
+                                                                         transform[4 * r + 2] * source_centroid[2]));
+    }
+
+    return transform;
+}
+
+void GlobalRegistration::match(const DescriptorSet &source, const DescriptorSet &target, const bool &mutual,
+                               std::vector<Correspondence> &correspondences, ThreadPool &pool)
+{
+    LRE_PROFILE_SCOPE("GlobalRegistration::match");
+
+    correspondences.clear();
+
+    if (source.empty() || target.empty())
+    {
+        return;
+    }
+
+    const DescriptorTree target_tree(target);
+    DescriptorTree source_tree;
+
+    if (mutual)
+    {
+        source_tree = DescriptorTree(source);
+    }
+
+    std::vector<int64_t> matches(source.size(), -1);
+    std::vector<float> distances(source.size(), 0.0f);
+
+    pool.parallel_for(0, source.size(), kMatchGrain, [&](const size_t &begin, const size_t &end)
+                      {
+                          std::vector<uint32_t> indices;
+                          std::vector<float> sqr_distances;
+
+                          for (size_t i = begin; i < end; i++)
+                          {
+                              target_tree.knn(source.row(i), 1, indices, sqr_distances);
+
+                              if (indices.empty())
+                              {
+                                  continue;
+                              }
+
+                              const uint32_t candidate = indices[0];
+                              const float distance = std::sqrt(sqr_distances[0]);
+
+                              if (mutual)
+                              {
+                                  source_tree.knn(target.row(candidate), 1, indices, sqr_distances);
+
+                                  if (indices.empty() || indices[0] != i)
+                                  {
+                                      continue;
+                                  }
+                              }
+
+                              matches[i] = candidate;
+                              distances[i] = distance;
+                          } });
+
+    for (size_t i = 0; i < matches.size(); i++)
+    {
+        if (matches[i] >= 0)
+        {
+            correspondences.push_back(Correspondence{static_cast<uint32_t>(i), static_cast<uint32_t>(matches[i]), distances[i]});
+        }
+    }
+}
+
+RegistrationResult GlobalRegistration::align(const PointCloud &source, const PointCloud &target,
+                                             const std::vector<Correspondence> &correspondences, ThreadPool &pool) const
+{
+    LRE_PROFILE_SCOPE("GlobalRegistration::align");
+
+    std::vector<Vector4> source_points(correspondences.size());
+    std::vector<Vector4> target_points(correspondences.size());
+
+    for (size_t i = 0; i < correspondences.size(); i++)
+    {
+        source_points[i] = source.point(correspondences[i].source);
+        target_points[i] = target.point(correspondences[i].target);
+    }
+
+    RegistrationResult result;
+    result.transform.identity();
+    result.fitness = 0.0f;
+    result.iterations = 0;
+
+    if (correspondences.size() < 3)
+    {
+        return result;
+    }
+
+    result = solver_ == RegistrationSolver::MaxClique ? align_max_clique(source_points, target_points, pool)
+                                                      : align_ransac(source_points, target_points, pool);
+
+    refine(source_points, target_points, result);
+
+    return result;
+}
+
+RegistrationResult GlobalRegistration::align(const PointCloud &source, const PointCloud &target,
+                                             const DescriptorSet &source_descriptors, const DescriptorSet &target_descriptors, ThreadPool &pool) const
+{
+    std::vector<Correspondence> correspondences;
+    match(source_descriptors, target_descriptors, true, correspondences, pool);
+
+    return align(source, target, correspondences, pool);
+}
+
+RegistrationResult GlobalRegistration::align(const PointCloud &source, const PointCloud &target,
+                                             const DescriptorSet &source_descriptors, const DescriptorSet &target_descriptors) const
+{
+    return align(source, target, source_descriptors, target_descriptors, ThreadPool::shared());
+}
+
+RegistrationResult GlobalRegistration::align_ransac(const std::vector<Vector4> &source, const std::vector<Vector4> &target, ThreadPool &pool) const
+{
+    const size_t count = source.size();
+    const float sqr_threshold = inlier_threshold_ * inlier_threshold_;
+
+    std::mutex mutex;
+    size_t best_count = 0;
+    Matrix4 best_transform;
+    best_transform.identity();
+
+    std::atomic<size_t> iterations{0};
+    std::atomic<size_t> required{max_iterations_};
+
+    pool.parallel_for(0, max_iterations_, kIterationGrain, [&](const size_t &begin, const size_t &end)
+                      {
+                          std::mt19937 generator(seed_ + static_cast<uint32_t>(begin));
+                          std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(count - 1));
+
+                          for (size_t iteration = begin; iteration < end; iteration++)
+                          {
+                              if (iterations.fetch_add(1) >= required.load())
+                              {
+                                  return;
+                              }
+
+                              uint32_t sample[3] = {pick(generator), pick(generator), pick(generator)};
+
+                              if (sample[0] == sample[1] || sample[0] == sample[2] || sample[1] == sample[2])
+                              {
+                                  continue;
+                              }
+
+                              // Edge-length pruning rejects most contaminated samples before any model is fitted.
+                              bool consistent = true;
+
+                              for (int32_t a = 0; a < 3 && consistent; a++)
+                              {
+                                  const int32_t b = (a + 1) % 3;
+                                  consistent = compatible(source[sample[a]], source[sample[b]], target[sample[a]], target[sample[b]],
+                                                          edge_similarity_, 2.0f * inlier_threshold_);
+                              }
+
+                              if (!consistent)
+                              {
+                                  continue;
+                              }
+
+                              const Matrix4 transform = estimate_rigid(source, target, sample, 3, nullptr);
+                              const size_t inliers = count_inliers(transform, source, target, sqr_threshold, nullptr);
+
+                              std::lock_guard<std::mutex> lock(mutex);
+
+                              if (inliers > best_count)
+                              {
+                                  best_count = inliers;
+                                  best_transform = transform;
+
+                                  const double ratio = static_cast<double>(inliers) / static_cast<double>(count);
+                                  const double miss = 1.0 - ratio * ratio * ratio;
+
+                                  if (miss <= 0.0)
+                                  {
+                                      required.store(0);
+                                  }
+                                  else if (miss < 1.0)
+                                  {
+                                      const double needed = std::log(1.0 - confidence_) / std::log(miss);
+                                      required.store(std::min<size_t>(max_iterations_, static_cast<size_t>(std::ceil(needed))));
+                                  }
+                              }
+                          } });
+
+    RegistrationResult result;
+    result.transform = best_transform;
+    result.iterations = std::min(iterations.load(), max_iterations_);
+    count_inliers(best_transform, source, target, sqr_threshold, &result.inliers);
+    result.fitness = static_cast<float>(result.inliers.size()) / static_cast<float>(count);
+
+    return result;
+}
+
+RegistrationResult GlobalRegistration::align_max_clique(const std::vector<Vector4> &source, const std::vector<Vector4> &target, ThreadPool &pool) const
+{
+    const size_t count = source.size();
+    const float tolerance = 2.0f * inlier_threshold_;
+
+    // Pairwise consistency graph over correspondences, stored as adjacency bitsets.
+    const size_t words = (count + 63) / 64;
+    std::vector<uint64_t> adjacency(count * words, 0);
+    std::vector<uint32_t> degree(count, 0);
+
+    pool.parallel_for(0, count, 64, [&](const size_t &begin, const size_t &end)
+                      {
+                          for (size_t i = begin; i < end; i++)
+                          {
+                              uint64_t *row = adjacency.data() + i * words;
+
+                              for (size_t j = 0; j < count; j++)
+                              {
+                                  const float source_length = Vector4::distance(source[i], source[j]);
+                                  const float target_length = Vector4::distance(target[i], target[j]);
+
+                                  if (j != i && std::abs(source_length - target_length) <= tolerance)
+                                  {
+                                      row[j / 64] |= uint64_t(1) << (j % 64);
+                                      degree[i]++;
+                                  }
+                              }
+                          } });
+
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&degree](const uint32_t &a, const uint32_t &b)
+              { return degree[a] > degree[b]; });
+
+    // Greedy clique growth from the highest-degree seeds approximates the maximum clique.
+    const size_t seed_count = std::min(kCliqueSeeds, count);
+    std::vector<std::vector<uint32_t>> cliques(seed_count);
+
+    pool.parallel_for(0, seed_count, 1, [&](const size_t &begin, const size_t &end)
+                      {
+                          std::vector<uint64_t> candidates(words);
+
+                          for (size_t s = begin; s < end; s++)
+                          {
+                              const uint32_t seed = order[s];
+                              std::vector<uint32_t> &clique = cliques[s];
+                              clique.push_back(seed);
+
+                              std::copy(adjacency.begin() + seed * words, adjacency.begin() + (seed + 1) * words, candidates.begin());
+
+                              while (true)
+                              {
+                                  int64_t best = -1;
+
+                                  for (const uint32_t vertex : order)
+                                  {
+                                      if ((candidates[vertex / 64] >> (vertex % 64)) & 1)
+                                      {
+                                          best = vertex;
+                                          break;
+                                      }
+                                  }
+
+                                  if (best < 0)
+                                  {
+                                      break;
+                                  }
+
+                                  clique.push_back(static_cast<uint32_t>(best));
+
+                                  const uint64_t *row = adjacency.data() + best * words;
+
+                                  for (size_t w = 0; w < words; w++)
+                                  {
+                                      candidates[w] &= row[w];
+                                  }
+                              }
+                          } });
+
+    const std::vector<uint32_t> &clique = *std::max_element(cliques.begin(), cliques.end(),
+                                                            [](const std::vector<uint32_t> &a, const std::vector<uint32_t> &b)
+                                                            { return a.size() < b.size(); });
+
+    RegistrationResult result;
+    result.transform.identity();
+    result.iterations = seed_count;
+    result.fitness = 0.0f;
+
+    if (clique.size() < 3)
+    {
+        return result;
+    }
+
+    // Translation-invariant measurements between consecutive clique members isolate the rotation.
+    std::vector<Vector4> source_differences;
+    std::vector<Vector4> target_differences;
+
+    for (size_t k = 0; k < clique.size(); k++)
+    {
+        const uint32_t a = clique[k];
+        const uint32_t b = clique[(k + 1) % clique.size()];
+
+        source_differences.push_back(source[b] - source[a]);
+        target_differences.push_back(target[b] - target[a]);
+    }
+
+    // Graduated non-convexity over a truncated least-squares cost.
+    const double noise = static_cast<double>(tolerance) * tolerance;
+    std::vector<float> weights(source_differences.size(), 1.0f);
+    Quaternion rotation = fit_rotation(source_differences, target_differences, weights);
+
+    std::vector<double> residuals(source_differences.size());
+
+    auto update_residuals = [&]()
+    {
+        double largest = 0.0;
+
+        for (size_t k = 0; k < residuals.size(); k++)
+        {
+            const Vector4 difference = target_differences[k] - rotation.rotate(source_differences[k]);
+            residuals[k] = difference[0] * difference[0] + difference[1] * difference[1] + difference[2] * difference[2];
+            largest = std::max(largest, residuals[k]);
+        }
+
+        return largest;
+    };
+
+    double mu = 1.0 / std::max(1e-12, 2.0 * update_residuals() / noise - 1.0);
+
+    for (int32_t iteration = 0; iteration < kGncIterations && mu > 0.0; iteration++)
+    {
+        const double upper = (mu + 1.0) / mu * noise;
+        const double lower = mu / (mu + 1.0) * noise;
+
+        bool binary = true;
+
+        for (size_t k = 0; k < residuals.size(); k++)
+        {
+            if (residuals[k] >= upper)
+            {
+                weights[k] = 0.0f;
+            }
+            else if (residuals[k] <= lower)
+            {
+                weights[k] = 1.0f;
+            }
+            else
+            {
+                weights[k] = static_cast<float>(std::sqrt(noise * mu * (mu + 1.0) / residuals[k]) - mu);
+                binary = false;
+            }
+        }
+
+        rotation = fit_rotation(source_differences, target_differences, weights);
+        update_residuals();
+
+        if (binary && iteration > 0)
+        {
+            break;
+        }
+
+        mu *= kGncFactor;
+    }
+
+    const Matrix4 rotation_matrix = rotation.to_matrix();
+    std::vector<float> components[3];
+
+    for (const uint32_t i : clique)
+    {
+        const Vector4 rotated = rotation.rotate(source[i]);
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            components[c].push_back(target[i][c] - rotated[c]);
+        }
+    }
+
+    result.transform = rotation_matrix;
+
+    for (int32_t c = 0; c < 3; c++)
+    {
+        result.transform[4 * c + 3] = vote(components[c], inlier_threshold_);
+    }
+
+    count_inliers(result.transform, source, target, inlier_threshold_ * inlier_threshold_, &result.inliers);
+    result.fitness = static_cast<float>(result.inliers.size()) / static_cast<float>(count);
+
+    return result;
+}
+
+void GlobalRegistration::refine(const std::vector<Vector4> &source, const std::vector<Vector4> &target, RegistrationResult &result) const
+{
+    const float sqr_threshold = inlier_threshold_ * inlier_threshold_;
+
+    for (int32_t pass = 0; pass < 3 && result.inliers.size() >= 3; pass++)
+    {
+        const Matrix4 transform = estimate_rigid(source, target, result.inliers.data(), result.inliers.size(), nullptr);
+
+        std::vector<uint32_t> inliers;
+        count_inliers(transform, source, target, sqr_threshold, &inliers);
+
+        if (inliers.size() < result.inliers.size())
+        {
+            break;
+        }
+
+        result.transform = transform;
+        result.inliers.swap(inliers);
+    }
+
+    result.fitness = source.empty() ? 0.0f : static_cast<float>(result.inliers.size()) / static_cast<float>(source.size());
+}
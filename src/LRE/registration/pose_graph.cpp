@@ -0,0 +1,799 @@
+#include <LRE/registration/pose_graph.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    constexpr size_t kEdgeGrain = 64;
+
+    constexpr double kInitialDamping = 1e-4;
+
+    constexpr double kMaximumDamping = 1e12;
+
+    constexpr double kSmallAngle = 1e-6;
+
+    constexpr double kConvergence = 1e-10;
+
+    const double kPi = std::acos(-1.0);
+
+    struct Pose
+    {
+        double r[9];
+        double t[3];
+    };
+
+    struct Linearization
+    {
+        double from_from[36];
+        double from_to[36];
+        double to_to[36];
+        double from_gradient[6];
+        double to_gradient[6];
+    };
+
+    Pose to_pose(const Matrix4 &matrix)
+    {
+        Pose pose;
+
+        for (int32_t r = 0; r < 3; r++)
+        {
+            for (int32_t c = 0; c < 3; c++)
+            {
+                pose.r[3 * r + c] = matrix[4 * r + c];
+            }
+
+            pose.t[r] = matrix[4 * r + 3];
+        }
+
+        return pose;
+    }
+
+    Matrix4 to_matrix(const Pose &pose)
+    {
+        Matrix4 matrix;
+        matrix.identity();
+
+        for (int32_t r = 0; r < 3; r++)
+        {
+            for (int32_t c = 0; c < 3; c++)
+            {
+                matrix[4 * r + c] = static_cast<float>(pose.r[3 * r + c]);
+            }
+
+            matrix[4 * r + 3] = static_cast<float>(pose.t[r]);
+        }
+
+        return matrix;
+    }
+
+    Pose compose(const Pose &a, const Pose &b)
+    {
+        Pose result;
+
+        for (int32_t r = 0; r < 3; r++)
+        {
+            for (int32_t c = 0; c < 3; c++)
+            {
+                result.r[3 * r + c] = a.r[3 * r] * b.r[c] + a.r[3 * r + 1] * b.r[3 + c] + a.r[3 * r + 2] * b.r[6 + c];
+            }
+
+            result.t[r] = a.r[3 * r] * b.t[0] + a.r[3 * r + 1] * b.t[1] + a.r[3 * r + 2] * b.t[2] + a.t[r];
+        }
+
+        return result;
+    }
+
+    Pose inverse(const Pose &pose)
+    {
+        Pose result;
+
+        for (int32_t r = 0; r < 3; r++)
+        {
+            for (int32_t c = 0; c < 3; c++)
+            {
+                result.r[3 * r + c] = pose.r[3 * c + r];
+            }
+        }
+
+        for (int32_t r = 0; r < 3; r++)
+        {
+            result.t[r] = -(result.r[3 * r] * pose.t[0] + result.r[3 * r + 1] * pose.t[1] + result.r[3 * r + 2] * pose.t[2]);
+        }
+
+        return result;
+    }
+
+    void hat(const double *v, double *out)
+    {
+        out[0] = 0.0;
+        out[1] = -v[2];
+        out[2] = v[1];
+        out[3] = v[2];
+        out[4] = 0.0;
+        out[5] = -v[0];
+        out[6] = -v[1];
+        out[7] = v[0];
+        out[8] = 0.0;
+    }
+
+    void multiply3(const double *a, const double *b, double *out)
+    {
+        for (int32_t r = 0; r < 3; r++)
+        {
+            for (int32_t c = 0; c < 3; c++)
+            {
+                out[3 * r + c] = a[3 * r] * b[c] + a[3 * r + 1] * b[3 + c] + a[3 * r + 2] * b[6 + c];
+            }
+        }
+    }
+
+    // Tangent vectors are ordered (translation, rotation).
+    Pose exp_map(const double *xi)
+    {
+        const double *rho = xi;
+        const double *phi = xi + 3;
+        const double theta = std::sqrt(phi[0] * phi[0] + phi[1] * phi[1] + phi[2] * phi[2]);
+
+        double skew[9];
+        double skew2[9];
+        hat(phi, skew);
+        multiply3(skew, skew, skew2);
+
+        double a = 1.0;
+        double b = 0.5;
+        double c = 1.0 / 6.0;
+
+        if (theta > kSmallAngle)
+        {
+            a = std::sin(theta) / theta;
+            b = (1.0 - std::cos(theta)) / (theta * theta);
+            c = (theta - std::sin(theta)) / (theta * theta * theta);
+        }
+
+        Pose pose;
+        double v[9];
+
+        for (int32_t i = 0; i < 9; i++)
+        {
+            const double identity = i % 4 == 0 ? 1.0 : 0.0;
+            pose.r[i] = identity + a * skew[i] + b * skew2[i];
+            v[i] = identity + b * skew[i] + c * skew2[i];
+        }
+
+        for (int32_t r = 0; r < 3; r++)
+        {
+            pose.t[r] = v[3 * r] * rho[0] + v[3 * r + 1] * rho[1] + v[3 * r + 2] * rho[2];
+        }
+
+        return pose;
+    }
+
+    void log_map(const Pose &pose, double *xi)
+    {
+        const double *r = pose.r;
+        const double cosine = std::max(-1.0, std::min(1.0, 0.5 * (r[0] + r[4] + r[8] - 1.0)));
+        const double theta = std::acos(cosine);
+        const double vee[3] = {0.5 * (r[7] - r[5]), 0.5 * (r[2] - r[6]), 0.5 * (r[3] - r[1])};
+
+        double *phi = xi + 3;
+
+        if (theta < kSmallAngle)
+        {
+            std::copy_n(vee, 3, phi);
+        }
+        else if (theta > kPi - 1e-4)
+        {
+            // Near a half turn the antisymmetric part vanishes, so the axis comes from the diagonal.
+            int32_t k = 0;
+
+            for (int32_t i = 1; i < 3; i++)
+            {
+                if (r[4 * i] > r[4 * k])
+                {
+                    k = i;
+                }
+            }
+
+            double axis[3];
+            axis[k] = std::sqrt(std::max(0.0, (r[4 * k] - cosine) / (1.0 - cosine)));
+
+            for (int32_t j = 0; j < 3; j++)
+            {
+                if (j != k)
+                {
+                    axis[j] = (r[3 * k + j] + r[3 * j + k]) / (2.0 * (1.0 - cosine) * axis[k]);
+                }
+            }
+
+            const double sign = axis[0] * vee[0] + axis[1] * vee[1] + axis[2] * vee[2] < 0.0 ? -1.0 : 1.0;
+
+            for (int32_t i = 0; i < 3; i++)
+            {
+                phi[i] = sign * theta * axis[i];
+            }
+        }
+        else
+        {
+            const double scale = theta / std::sin(theta);
+
+            for (int32_t i = 0; i < 3; i++)
+            {
+                phi[i] = scale * vee[i];
+            }
+        }
+
+        double skew[9];
+        double skew2[9];
+        hat(phi, skew);
+        multiply3(skew, skew, skew2);
+
+        double c = 1.0 / 12.0;
+
+        if (theta > kSmallAngle)
+        {
+            c = (1.0 - theta * std::sin(theta) / (2.0 * (1.0 - std::cos(theta)))) / (theta * theta);
+        }
+
+        for (int32_t row = 0; row < 3; row++)
+        {
+            double value = 0.0;
+
+            for (int32_t col = 0; col < 3; col++)
+            {
+                const double identity = row == col ? 1.0 : 0.0;
+                value += (identity - 0.5 * skew[3 * row + col] + c * skew2[3 * row + col]) * pose.t[col];
+            }
+
+            xi[row] = value;
+        }
+    }
+
+    void adjoint(const Pose &pose, double *out)
+    {
+        double skew[9];
+        double coupling[9];
+        hat(pose.t, skew);
+        multiply3(skew, pose.r, coupling);
+
+        std::fill_n(out, 36, 0.0);
+
+        for (int32_t r = 0; r < 3; r++)
+        {
+            for (int32_t c = 0; c < 3; c++)
+            {
+                out[6 * r + c] = pose.r[3 * r + c];
+                out[6 * r + c + 3] = coupling[3 * r + c];
+                out[6 * (r + 3) + c + 3] = pose.r[3 * r + c];
+            }
+        }
+    }
+
+    void multiply6(const double *a, const double *b, double *out)
+    {
+        for (int32_t r = 0; r < 6; r++)
+        {
+            for (int32_t c = 0; c < 6; c++)
+            {
+                double sum = 0.0;
+
+                for (int32_t k = 0; k < 6; k++)
+                {
+                    sum += a[6 * r + k] * b[6 * k + c];
+                }
+
+                out[6 * r + c] = sum;
+            }
+        }
+    }
+
+    // out = scale * a^T * b
+    void transpose_multiply6(const double *a, const double *b, const double &scale, double *out)
+    {
+        for (int32_t r = 0; r < 6; r++)
+        {
+            for (int32_t c = 0; c < 6; c++)
+            {
+                double sum = 0.0;
+
+                for (int32_t k = 0; k < 6; k++)
+                {
+                    sum += a[6 * k + r] * b[6 * k + c];
+                }
+
+                out[6 * r + c] = scale * sum;
+            }
+        }
+    }
+
+    // Robust cost of a squared Mahalanobis error and the matching IRLS weight.
+    double robust(const RobustKernel &kernel, const double &width, const double &sqr_error, double &weight)
+    {
+        const double sqr_width = width * width;
+
+        switch (kernel)
+        {
+        case RobustKernel::Huber:
+            if (sqr_error <= sqr_width)
+            {
+                weight = 1.0;
+                return sqr_error;
+            }
+
+            weight = width / std::sqrt(sqr_error);
+            return 2.0 * width * std::sqrt(sqr_error) - sqr_width;
+
+        case RobustKernel::Cauchy:
+            weight = 1.0 / (1.0 + sqr_error / sqr_width);
+            return sqr_width * std::log1p(sqr_error / sqr_width);
+
+        default:
+            weight = 1.0;
+            return sqr_error;
+        }
+    }
+
+    double edge_cost(const PoseGraph::Edge &edge, const Pose &measurement_inverse, const Pose &from, const Pose &to,
+                     const RobustKernel &kernel, const double &width, double *residual)
+    {
+        log_map(compose(measurement_inverse, compose(inverse(from), to)), residual);
+
+        double sqr_error = 0.0;
+
+        for (int32_t r = 0; r < 6; r++)
+        {
+            for (int32_t c = 0; c < 6; c++)
+            {
+                sqr_error += residual[r] * edge.information[6 * r + c] * residual[c];
+            }
+        }
+
+        double weight = 1.0;
+        return robust(kernel, width, sqr_error, weight);
+    }
+}
+
+PoseGraph::PoseGraph(const RobustKernel &kernel, const double &kernel_width, const PoseGraphMethod &method)
+    : kernel_(kernel),
+      kernel_width_(kernel_width),
+      method_(method)
+{
+    if (!(kernel_width > 0.0))
+    {
+        throw std::invalid_argument("PoseGraph: kernel width must be positive");
+    }
+}
+
+PoseGraph::PoseGraph(const RobustKernel &kernel, const double &kernel_width)
+    : PoseGraph(kernel, kernel_width, PoseGraphMethod::LevenbergMarquardt)
+{
+}
+
+PoseGraph::PoseGraph()
+    : PoseGraph(RobustKernel::None, 1.0)
+{
+}
+
+size_t PoseGraph::add_node(const Matrix4 &pose)
+{
+    poses_.push_back(pose);
+    fixed_.push_back(0);
+    return poses_.size() - 1;
+}
+
+void PoseGraph::set_fixed(const size_t &node, const bool &fixed)
+{
+    if (node >= poses_.size())
+    {
+        throw std::out_of_range("PoseGraph: node index out of range");
+    }
+
+    fixed_[node] = fixed ? 1 : 0;
+}
+
+size_t PoseGraph::add_edge(const size_t &from, const size_t &to, const Matrix4 &measurement, const double *information)
+{
+    if (from >= poses_.size() || to >= poses_.size())
+    {
+        throw std::out_of_range("PoseGraph: edge references a missing node");
+    }
+
+    if (from == to)
+    {
+        throw std::invalid_argument("PoseGraph: edge must connect two different nodes");
+    }
+
+    Edge edge;
+    edge.from = static_cast<uint32_t>(from);
+    edge.to = static_cast<uint32_t>(to);
+    edge.measurement = measurement;
+    std::copy_n(information, 36, edge.information);
+
+    edges_.push_back(edge);
+    return edges_.size() - 1;
+}
+
+size_t PoseGraph::add_edge(const size_t &from, const size_t &to, const Matrix4 &measurement)
+{
+    double information[36] = {};
+
+    for (int32_t i = 0; i < 6; i++)
+    {
+        information[7 * i] = 1.0;
+    }
+
+    return add_edge(from, to, measurement, information);
+}
+
+size_t PoseGraph::node_count() const
+{
+    return poses_.size();
+}
+
+size_t PoseGraph::edge_count() const
+{
+    return edges_.size();
+}
+
+const Matrix4 &PoseGraph::pose(const size_t &node) const
+{
+    if (node >= poses_.size())
+    {
+        throw std::out_of_range("PoseGraph: node index out of range");
+    }
+
+    return poses_[node];
+}
+
+const std::vector<Matrix4> &PoseGraph::poses() const
+{
+    return poses_;
+}
+
+const std::vector<PoseGraph::Edge> &PoseGraph::edges() const
+{
+    return edges_;
+}
+
+double PoseGraph::error(ThreadPool &pool) const
+{
+    std::vector<double> costs(edges_.size(), 0.0);
+
+    pool.parallel_for(0, edges_.size(), kEdgeGrain, [&](const size_t &begin, const size_t &end)
+                      {
+                          double residual[6];
+
+                          for (size_t e = begin; e < end; e++)
+                          {
+                              const Edge &edge = edges_[e];
+                              costs[e] = edge_cost(edge, inverse(to_pose(edge.measurement)), to_pose(poses_[edge.from]),
+                                                   to_pose(poses_[edge.to]), kernel_, kernel_width_, residual);
+                          } });
+
+    double total = 0.0;
+
+    for (const double cost : costs)
+    {
+        total += cost;
+    }
+
+    return total;
+}
+
+double PoseGraph::error() const
+{
+    return error(ThreadPool::shared());
+}
+
+size_t PoseGraph::optimize(const size_t &max_iterations, ThreadPool &pool)
+{
+    LRE_PROFILE_SCOPE("PoseGraph::optimize");
+
+    const size_t node_count = poses_.size();
+
+    std::vector<int64_t> variables(node_count, -1);
+    size_t variable_count = 0;
+    const bool anchored = std::find(fixed_.begin(), fixed_.end(), 1) != fixed_.end();
+
+    for (size_t n = 0; n < node_count; n++)
+    {
+        if (!fixed_[n] && (anchored || n != 0))
+        {
+            variables[n] = static_cast<int64_t>(variable_count++);
+        }
+    }
+
+    if (variable_count == 0 || edges_.empty())
+    {
+        return 0;
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> couplings;
+
+    for (const Edge &edge : edges_)
+    {
+        if (variables[edge.from] >= 0 && variables[edge.to] >= 0)
+        {
+            couplings.push_back(std::make_pair(static_cast<uint32_t>(variables[edge.from]), static_cast<uint32_t>(variables[edge.to])));
+        }
+    }
+
+    BlockCholesky solver;
+    solver.analyze(variable_count, couplings);
+
+    std::vector<Pose> poses(node_count);
+    std::vector<Pose> measurement_inverses(edges_.size());
+
+    for (size_t n = 0; n < node_count; n++)
+    {
+        poses[n] = to_pose(poses_[n]);
+    }
+
+    for (size_t e = 0; e < edges_.size(); e++)
+    {
+        measurement_inverses[e] = inverse(to_pose(edges_[e].measurement));
+    }
+
+    std::vector<Linearization> linearizations(edges_.size());
+    std::vector<double> costs(edges_.size());
+
+    auto evaluate = [&](const std::vector<Pose> &state)
+    {
+        pool.parallel_for(0, edges_.size(), kEdgeGrain, [&](const size_t &begin, const size_t &end)
+                          {
+                              double residual[6];
+
+                              for (size_t e = begin; e < end; e++)
+                              {
+                                  const Edge &edge = edges_[e];
+                                  costs[e] = edge_cost(edge, measurement_inverses[e], state[edge.from], state[edge.to],
+                                                       kernel_, kernel_width_, residual);
+                              } });
+
+        double total = 0.0;
+
+        for (const double cost : costs)
+        {
+            total += cost;
+        }
+
+        return total;
+    };
+
+    // Edge contributions are computed independently in parallel and scattered into the sparse system serially.
+    auto linearize = [&]()
+    {
+        pool.parallel_for(0, edges_.size(), kEdgeGrain, [&](const size_t &begin, const size_t &end)
+                          {
+                              double residual[6];
+                              double coupling[36];
+                              double jacobian_from[36];
+                              double jacobian_to[36];
+                              double weighted_from[36];
+                              double weighted_to[36];
+
+                              for (size_t e = begin; e < end; e++)
+                              {
+                                  const Edge &edge = edges_[e];
+                                  Linearization &result = linearizations[e];
+
+                                  const Pose relative = compose(inverse(poses[edge.from]), poses[edge.to]);
+                                  log_map(compose(measurement_inverses[e], relative), residual);
+
+                                  // First-order inverse right Jacobian I + ad(e) / 2.
+                                  double inverse_jacobian[36] = {};
+                                  double rho_hat[9];
+                                  double phi_hat[9];
+                                  hat(residual, rho_hat);
+                                  hat(residual + 3, phi_hat);
+
+                                  for (int32_t r = 0; r < 3; r++)
+                                  {
+                                      for (int32_t c = 0; c < 3; c++)
+                                      {
+                                          inverse_jacobian[6 * r + c] = 0.5 * phi_hat[3 * r + c];
+                                          inverse_jacobian[6 * r + c + 3] = 0.5 * rho_hat[3 * r + c];
+                                          inverse_jacobian[6 * (r + 3) + c + 3] = 0.5 * phi_hat[3 * r + c];
+                                      }
+                                  }
+
+                                  for (int32_t i = 0; i < 6; i++)
+                                  {
+                                      inverse_jacobian[7 * i] += 1.0;
+                                  }
+
+                                  adjoint(inverse(relative), coupling);
+                                  multiply6(inverse_jacobian, coupling, jacobian_from);
+                                  std::copy_n(inverse_jacobian, 36, jacobian_to);
+
+                                  for (int32_t i = 0; i < 36; i++)
+                                  {
+                                      jacobian_from[i] = -jacobian_from[i];
+                                  }
+
+                                  double sqr_error = 0.0;
+                                  double information_residual[6];
+
+                                  for (int32_t r = 0; r < 6; r++)
+                                  {
+                                      information_residual[r] = 0.0;
+
+                                      for (int32_t c = 0; c < 6; c++)
+                                      {
+                                          information_residual[r] += edge.information[6 * r + c] * residual[c];
+                                      }
+
+                                      sqr_error += residual[r] * information_residual[r];
+                                  }
+
+                                  double weight = 1.0;
+                                  robust(kernel_, kernel_width_, sqr_error, weight);
+
+                                  multiply6(edge.information, jacobian_from, weighted_from);
+                                  multiply6(edge.information, jacobian_to, weighted_to);
+
+                                  transpose_multiply6(jacobian_from, weighted_from, weight, result.from_from);
+                                  transpose_multiply6(jacobian_from, weighted_to, weight, result.from_to);
+                                  transpose_multiply6(jacobian_to, weighted_to, weight, result.to_to);
+
+                                  for (int32_t r = 0; r < 6; r++)
+                                  {
+                                      result.from_gradient[r] = 0.0;
+                                      result.to_gradient[r] = 0.0;
+
+                                      for (int32_t k = 0; k < 6; k++)
+                                      {
+                                          result.from_gradient[r] += weight * jacobian_from[6 * k + r] * information_residual[k];
+                                          result.to_gradient[r] += weight * jacobian_to[6 * k + r] * information_residual[k];
+                                      }
+                                  }
+                              } });
+    };
+
+    std::vector<double> gradient(variable_count * 6);
+    std::vector<double> step;
+    std::vector<Pose> candidate(node_count);
+
+    double cost = evaluate(poses);
+    double damping = method_ == PoseGraphMethod::LevenbergMarquardt ? kInitialDamping : 0.0;
+    size_t iterations = 0;
+
+    for (size_t iteration = 0; iteration < max_iterations; iteration++)
+    {
+        linearize();
+
+        solver.clear();
+        std::fill(gradient.begin(), gradient.end(), 0.0);
+
+        for (size_t e = 0; e < edges_.size(); e++)
+        {
+            const Linearization &result = linearizations[e];
+            const int64_t from = variables[edges_[e].from];
+            const int64_t to = variables[edges_[e].to];
+
+            if (from >= 0)
+            {
+                solver.add_diagonal(static_cast<uint32_t>(from), result.from_from);
+
+                for (int32_t k = 0; k < 6; k++)
+                {
+                    gradient[6 * from + k] -= result.from_gradient[k];
+                }
+            }
+
+            if (to >= 0)
+            {
+                solver.add_diagonal(static_cast<uint32_t>(to), result.to_to);
+
+                for (int32_t k = 0; k < 6; k++)
+                {
+                    gradient[6 * to + k] -= result.to_gradient[k];
+                }
+            }
+
+            if (from >= 0 && to >= 0)
+            {
+                solver.add(static_cast<uint32_t>(from), static_cast<uint32_t>(to), result.from_to);
+            }
+        }
+
+        bool accepted = false;
+        bool converged = false;
+        double step_size = 0.0;
+
+        while (!accepted)
+        {
+            if (!solver.factorize(damping))
+            {
+                if (method_ == PoseGraphMethod::GaussNewton && damping == 0.0)
+                {
+                    damping = kInitialDamping;
+                    continue;
+                }
+
+                damping *= 4.0;
+
+                if (damping > kMaximumDamping)
+                {
+                    break;
+                }
+
+                continue;
+            }
+
+            solver.solve(gradient, step);
+
+            candidate = poses;
+            step_size = 0.0;
+
+            for (size_t n = 0; n < node_count; n++)
+            {
+                if (variables[n] >= 0)
+                {
+                    const double *delta = step.data() + 6 * variables[n];
+                    candidate[n] = compose(poses[n], exp_map(delta));
+
+                    for (int32_t k = 0; k < 6; k++)
+                    {
+                        step_size = std::max(step_size, std::abs(delta[k]));
+                    }
+                }
+            }
+
+            const double candidate_cost = evaluate(candidate);
+
+            if (method_ == PoseGraphMethod::GaussNewton)
+            {
+                accepted = std::isfinite(candidate_cost);
+            }
+            else
+            {
+                accepted = candidate_cost < cost;
+            }
+
+            if (accepted)
+            {
+                const double decrease = cost - candidate_cost;
+
+                poses.swap(candidate);
+                cost = candidate_cost;
+                damping = method_ == PoseGraphMethod::LevenbergMarquardt ? std::max(damping / 3.0, 1e-12) : 0.0;
+                iterations++;
+
+                converged = step_size < kConvergence || std::abs(decrease) <= kConvergence * std::max(cost, 1.0);
+                break;
+            }
+
+            if (method_ == PoseGraphMethod::GaussNewton)
+            {
+                break;
+            }
+
+            damping *= 4.0;
+
+            if (damping > kMaximumDamping)
+            {
+                break;
+            }
+        }
+
+        if (!accepted || converged)
+        {
+            break;
+        }
+    }
+
+    for (size_t n = 0; n < node_count; n++)
+    {
+        poses_[n] = to_matrix(poses[n]);
+    }
+
+    return iterations;
+}
+
+size_t PoseGraph::optimize(const size_t &max_iterations)
+{
+    return optimize(max_iterations, ThreadPool::shared());
+}
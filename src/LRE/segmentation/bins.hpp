@@ -0,0 +1,40 @@
+#ifndef SEGMENTATION_BINS_HPP
+#define SEGMENTATION_BINS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Counting sort of point indices by bin; points with a negative bin are skipped.
+inline void sort_into_bins(const std::vector<int32_t> &bins, const size_t &bin_count,
+                           std::vector<uint32_t> &offsets, std::vector<uint32_t> &order)
+{
+    offsets.assign(bin_count + 1, 0);
+
+    for (const int32_t bin : bins)
+    {
+        if (bin >= 0)
+        {
+            offsets[bin + 1]++;
+        }
+    }
+
+    for (size_t b = 0; b < bin_count; b++)
+    {
+        offsets[b + 1] += offsets[b];
+    }
+
+    order.resize(offsets[bin_count]);
+
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+
+    for (size_t i = 0; i < bins.size(); i++)
+    {
+        if (bins[i] >= 0)
+        {
+            order[cursor[bins[i]]++] = static_cast<uint32_t>(i);
+        }
+    }
+}
+
+#endif
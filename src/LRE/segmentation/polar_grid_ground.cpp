@@ -0,0 +1,259 @@
+#include <LRE/segmentation/polar_grid_ground.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <LRE/preprocess/normal_estimation.hpp>
+
+#include <LRE/segmentation/bins.hpp>
+
+namespace
+{
+    constexpr size_t kBinGrain = 8;
+
+    constexpr size_t kLowestPoints = 20;
+
+    constexpr int32_t kFitIterations = 3;
+
+    constexpr float kSeedMargin = 0.3f;
+
+    constexpr float kMinimumSpread = 0.1f;
+
+    // Allowed rise of the fitted ground above the sensor base per metre of range.
+    constexpr float kElevationGradient = 0.05f;
+}
+
+PolarGridGround::PolarGridGround(const size_t &rings, const size_t &sectors, const float &minimum_range, const float &maximum_range,
+                                 const float &sensor_height, const float &distance_threshold, const float &maximum_slope)
+    : rings_(std::max<size_t>(1, rings)),
+      sectors_(std::max<size_t>(1, sectors)),
+      minimum_range_(std::max(0.0f, minimum_range)),
+      maximum_range_(std::max(minimum_range_ + 1e-3f, maximum_range)),
+      sensor_height_(sensor_height),
+      distance_threshold_(std::max(1e-3f, distance_threshold)),
+      maximum_slope_(std::max(0.0f, std::min(1.5f, maximum_slope)))
+{
+}
+
+PolarGridGround::PolarGridGround(const float &sensor_height)
+    : PolarGridGround(20, 64, 1.0f, 80.0f, sensor_height, 0.15f, 0.35f)
+{
+}
+
+size_t PolarGridGround::bin_count() const
+{
+    return rings_ * sectors_;
+}
+
+int32_t PolarGridGround::bin_of(const float &x, const float &y) const
+{
+    const float range = std::sqrt(x * x + y * y);
+
+    if (range < minimum_range_ || range >= maximum_range_)
+    {
+        return -1;
+    }
+
+    const float pi = 3.14159265358979323846f;
+
+    const size_t ring = std::min(rings_ - 1, static_cast<size_t>((range - minimum_range_) / (maximum_range_ - minimum_range_) * rings_));
+    const size_t sector = std::min(sectors_ - 1, static_cast<size_t>((std::atan2(y, x) + pi) / (2.0f * pi) * sectors_));
+
+    return static_cast<int32_t>(ring * sectors_ + sector);
+}
+
+bool PolarGridGround::fit_plane(const PointCloud &cloud, const uint32_t *indices, const size_t &count, Vector4 &normal, float &offset)
+{
+    if (count < 3)
+    {
+        return false;
+    }
+
+    Vector4 centroid(0.0f, 0.0f, 0.0f, 0.0f);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        centroid = centroid + Vector4(cloud.x()[indices[i]], cloud.y()[indices[i]], cloud.z()[indices[i]], 0.0f);
+    }
+
+    centroid = centroid * (1.0f / static_cast<float>(count));
+
+    float covariance[6] = {};
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const Vector4 d = Vector4(cloud.x()[indices[i]], cloud.y()[indices[i]], cloud.z()[indices[i]], 0.0f) - centroid;
+
+        covariance[0] += d[0] * d[0];
+        covariance[1] += d[0] * d[1];
+        covariance[2] += d[0] * d[2];
+        covariance[3] += d[1] * d[1];
+        covariance[4] += d[1] * d[2];
+        covariance[5] += d[2] * d[2];
+    }
+
+    // Bins crossed by a single ring hold a thin arc that cannot orient a plane; assume it is level instead.
+    const float horizontal_trace = covariance[0] + covariance[3];
+    const float horizontal_spread = std::sqrt((covariance[0] - covariance[3]) * (covariance[0] - covariance[3]) + 4.0f * covariance[1] * covariance[1]);
+    const float narrow_variance = 0.5f * (horizontal_trace - horizontal_spread) / static_cast<float>(count);
+
+    if (narrow_variance < kMinimumSpread * kMinimumSpread)
+    {
+        normal = Vector4(0.0f, 0.0f, 1.0f, 0.0f);
+        offset = -centroid[2];
+        return true;
+    }
+
+    normal = NormalEstimation::smallest_eigenvector(covariance);
+
+    if (normal[2] < 0.0f)
+    {
+        normal = normal * -1.0f;
+    }
+
+    offset = -Vector4::dot(normal, centroid);
+
+    return true;
+}
+
+void PolarGridGround::fit_bin(const PointCloud &cloud, const uint32_t *members, const size_t &count, const float &radius,
+                              std::vector<float> &heights, std::vector<uint32_t> &inliers, uint8_t *ground) const
+{
+    const float *z = cloud.z();
+    const float base = -sensor_height_;
+    const float elevation_limit = base + distance_threshold_ + kElevationGradient * radius;
+
+    if (count < 3)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            ground[members[i]] = std::abs(z[members[i]] - base) < distance_threshold_ ? 1 : 0;
+        }
+
+        return;
+    }
+
+    // Seeds are the points near the mean of the lowest few heights in the bin.
+    heights.resize(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        heights[i] = z[members[i]];
+    }
+
+    const size_t lowest = std::min(kLowestPoints, count);
+    std::partial_sort(heights.begin(), heights.begin() + lowest, heights.end());
+
+    float lowest_mean = 0.0f;
+
+    for (size_t i = 0; i < lowest; i++)
+    {
+        lowest_mean += heights[i];
+    }
+
+    lowest_mean /= static_cast<float>(lowest);
+
+    inliers.clear();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (z[members[i]] < lowest_mean + kSeedMargin)
+        {
+            inliers.push_back(members[i]);
+        }
+    }
+
+    Vector4 normal(0.0f, 0.0f, 1.0f, 0.0f);
+    float offset = sensor_height_;
+    bool fitted = false;
+
+    for (int32_t iteration = 0; iteration < kFitIterations; iteration++)
+    {
+        if (!fit_plane(cloud, inliers.data(), inliers.size(), normal, offset))
+        {
+            break;
+        }
+
+        fitted = true;
+        inliers.clear();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const uint32_t index = members[i];
+            const float distance = normal[0] * cloud.x()[index] + normal[1] * cloud.y()[index] + normal[2] * z[index] + offset;
+
+            if (std::abs(distance) < distance_threshold_)
+            {
+                inliers.push_back(index);
+            }
+        }
+    }
+
+    if (!fitted || inliers.empty())
+    {
+        return;
+    }
+
+    float inlier_height = 0.0f;
+
+    for (const uint32_t index : inliers)
+    {
+        inlier_height += z[index];
+    }
+
+    inlier_height /= static_cast<float>(inliers.size());
+
+    // Reject bins whose plane is too steep (walls) or floats well above the expected ground (roofs, canopies).
+    if (normal[2] < std::cos(maximum_slope_) || inlier_height > elevation_limit)
+    {
+        return;
+    }
+
+    for (const uint32_t index : inliers)
+    {
+        ground[index] = 1;
+    }
+}
+
+void PolarGridGround::segment(const PointCloud &cloud, std::vector<uint8_t> &ground, ThreadPool &pool) const
+{
+    LRE_PROFILE_SCOPE("PolarGridGround::segment");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, cloud.size());
+
+    const size_t count = cloud.size();
+
+    ground.assign(count, 0);
+
+    std::vector<int32_t> bins(count);
+
+    pool.parallel_for(0, count, 16384, [this, &cloud, &bins](const size_t &begin, const size_t &end)
+                      {
+                          for (size_t i = begin; i < end; i++)
+                          {
+                              bins[i] = bin_of(cloud.x()[i], cloud.y()[i]);
+                          } });
+
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> order;
+    sort_into_bins(bins, bin_count(), offsets, order);
+
+    // Bins own disjoint points, so every task writes its own mask entries.
+    pool.parallel_for(0, bin_count(), kBinGrain, [this, &cloud, &offsets, &order, &ground](const size_t &begin, const size_t &end)
+                      {
+                          std::vector<float> heights;
+                          std::vector<uint32_t> inliers;
+
+                          for (size_t b = begin; b < end; b++)
+                          {
+                              const size_t ring = b / sectors_;
+                              const float radius = minimum_range_ + (ring + 0.5f) * (maximum_range_ - minimum_range_) / rings_;
+
+                              fit_bin(cloud, order.data() + offsets[b], offsets[b + 1] - offsets[b], radius, heights, inliers, ground.data());
+                          } });
+}
+
+void PolarGridGround::segment(const PointCloud &cloud, std::vector<uint8_t> &ground) const
+{
+    segment(cloud, ground, ThreadPool::shared());
+}
@@ -0,0 +1,105 @@
+#include <LRE/segmentation/scan_line_ground.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <LRE/segmentation/bins.hpp>
+
+namespace
+{
+    constexpr size_t kColumnGrain = 32;
+}
+
+ScanLineGround::ScanLineGround(const size_t &columns, const float &sensor_height, const float &local_slope,
+                               const float &global_slope, const float &height_threshold)
+    : columns_(std::max<size_t>(1, columns)),
+      sensor_height_(sensor_height),
+      local_slope_(std::max(0.0f, std::min(1.5f, local_slope))),
+      global_slope_(std::max(0.0f, std::min(1.5f, global_slope))),
+      height_threshold_(std::max(0.0f, height_threshold))
+{
+}
+
+ScanLineGround::ScanLineGround(const float &sensor_height)
+    : ScanLineGround(1800, sensor_height, 0.14f, 0.09f, 0.15f)
+{
+}
+
+void ScanLineGround::segment(const PointCloud &cloud, std::vector<uint8_t> &ground, ThreadPool &pool) const
+{
+    LRE_PROFILE_SCOPE("ScanLineGround::segment");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, cloud.size());
+
+    const size_t count = cloud.size();
+    const float *x = cloud.x();
+    const float *y = cloud.y();
+    const float *z = cloud.z();
+
+    ground.assign(count, 0);
+
+    std::vector<int32_t> columns(count);
+    std::vector<float> ranges(count);
+
+    pool.parallel_for(0, count, 16384, [this, x, y, &columns, &ranges](const size_t &begin, const size_t &end)
+                      {
+                          const float pi = 3.14159265358979323846f;
+
+                          for (size_t i = begin; i < end; i++)
+                          {
+                              ranges[i] = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+                              columns[i] = static_cast<int32_t>(std::min(columns_ - 1, static_cast<size_t>((std::atan2(y[i], x[i]) + pi) / (2.0f * pi) * columns_)));
+                          } });
+
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> order;
+    sort_into_bins(columns, columns_, offsets, order);
+
+    const float local_tangent = std::tan(local_slope_);
+    const float global_tangent = std::tan(global_slope_);
+
+    pool.parallel_for(0, columns_, kColumnGrain, [&](const size_t &begin, const size_t &end)
+                      {
+                          for (size_t c = begin; c < end; c++)
+                          {
+                              uint32_t *members = order.data() + offsets[c];
+                              const size_t member_count = offsets[c + 1] - offsets[c];
+
+                              // Within one column successive rings appear in order of horizontal range.
+                              std::sort(members, members + member_count, [&ranges](const uint32_t &a, const uint32_t &b)
+                                        { return ranges[a] < ranges[b]; });
+
+                              float previous_range = 0.0f;
+                              float previous_height = -sensor_height_;
+                              bool previous_ground = true;
+
+                              for (size_t k = 0; k < member_count; k++)
+                              {
+                                  const uint32_t index = members[k];
+                                  const float range = ranges[index];
+                                  const float height = z[index] + sensor_height_;
+
+                                  const bool within_global = std::abs(height) <= global_tangent * range + height_threshold_;
+                                  const bool within_local = std::abs(z[index] - previous_height) <= local_tangent * (range - previous_range) + height_threshold_;
+
+                                  bool is_ground = previous_ground && within_local && within_global;
+
+                                  // Re-acquire the ground after an obstacle once the beam returns to the base plane.
+                                  if (!is_ground && std::abs(height) <= height_threshold_)
+                                  {
+                                      is_ground = true;
+                                  }
+
+                                  ground[index] = is_ground ? 1 : 0;
+
+                                  previous_range = range;
+                                  previous_height = z[index];
+                                  previous_ground = is_ground;
+                              }
+                          } });
+}
+
+void ScanLineGround::segment(const PointCloud &cloud, std::vector<uint8_t> &ground) const
+{
+    segment(cloud, ground, ThreadPool::shared());
+}
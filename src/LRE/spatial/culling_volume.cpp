@@ -0,0 +1,558 @@
+#include <LRE/spatial/culling_volume.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    constexpr size_t kSelectChunk = 1 << 16;
+
+    constexpr size_t kMaskGrain = 1024;
+
+    struct CompressTable
+    {
+        uint8_t shuffle[16][16];
+        uint8_t count[16];
+    };
+
+    // Byte shuffles that pack the selected 32-bit lanes of a 4-lane vector to the front.
+    constexpr CompressTable make_compress_table()
+    {
+        CompressTable table{};
+
+        for (int32_t mask = 0; mask < 16; mask++)
+        {
+            int32_t count = 0;
+
+            for (int32_t lane = 0; lane < 4; lane++)
+            {
+                if ((mask >> lane) & 1)
+                {
+                    for (int32_t byte = 0; byte < 4; byte++)
+                    {
+                        table.shuffle[mask][4 * count + byte] = static_cast<uint8_t>(4 * lane + byte);
+                    }
+
+                    count++;
+                }
+            }
+
+            for (int32_t byte = 4 * count; byte < 16; byte++)
+            {
+                table.shuffle[mask][byte] = 0x80;
+            }
+
+            table.count[mask] = static_cast<uint8_t>(count);
+        }
+
+        return table;
+    }
+
+    constexpr CompressTable kCompress = make_compress_table();
+
+    // Appends base + k for every set bit k of an 8-bit mask; may write up to eight entries.
+    size_t compress_store(const int32_t &mask, const uint32_t &base, uint32_t *out)
+    {
+#ifdef __AVX__
+
+        const __m128i low = _mm_add_epi32(_mm_set1_epi32(static_cast<int32_t>(base)), _mm_setr_epi32(0, 1, 2, 3));
+        const __m128i high = _mm_add_epi32(low, _mm_set1_epi32(4));
+
+        const int32_t low_mask = mask & 15;
+        const int32_t high_mask = (mask >> 4) & 15;
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                         _mm_shuffle_epi8(low, _mm_loadu_si128(reinterpret_cast<const __m128i *>(kCompress.shuffle[low_mask]))));
+
+        const size_t first = kCompress.count[low_mask];
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + first),
+                         _mm_shuffle_epi8(high, _mm_loadu_si128(reinterpret_cast<const __m128i *>(kCompress.shuffle[high_mask]))));
+
+        return first + kCompress.count[high_mask];
+
+#else
+
+        size_t count = 0;
+
+        for (uint32_t lane = 0; lane < 8; lane++)
+        {
+            if ((mask >> lane) & 1)
+            {
+                out[count++] = base + lane;
+            }
+        }
+
+        return count;
+
+#endif
+    }
+
+    void set_plane(float plane[4], const float &nx, const float &ny, const float &nz, const float &d)
+    {
+        plane[0] = nx;
+        plane[1] = ny;
+        plane[2] = nz;
+        plane[3] = d;
+    }
+}
+
+CullingVolume::CullingVolume()
+    : shape_(Shape::Box),
+      plane_count_(0)
+{
+    for (int32_t c = 0; c < 3; c++)
+    {
+        minimum_[c] = -std::numeric_limits<float>::infinity();
+        maximum_[c] = std::numeric_limits<float>::infinity();
+    }
+
+    world_to_box_.identity();
+    std::memset(planes_, 0, sizeof(planes_));
+}
+
+CullingVolume CullingVolume::box(const Vector4 &minimum, const Vector4 &maximum)
+{
+    CullingVolume volume;
+
+    for (int32_t c = 0; c < 3; c++)
+    {
+        volume.minimum_[c] = minimum[c];
+        volume.maximum_[c] = maximum[c];
+    }
+
+    return volume;
+}
+
+CullingVolume CullingVolume::oriented_box(const Matrix4 &pose, const Vector4 &half_extents)
+{
+    CullingVolume volume;
+    volume.shape_ = Shape::OrientedBox;
+    volume.world_to_box_ = pose.inverted();
+
+    for (int32_t c = 0; c < 3; c++)
+    {
+        volume.minimum_[c] = -half_extents[c];
+        volume.maximum_[c] = half_extents[c];
+    }
+
+    // Face planes are only used for classifying node bounds.
+    const float center[3] = {pose[3], pose[7], pose[11]};
+
+    for (int32_t axis = 0; axis < 3; axis++)
+    {
+        const float a[3] = {pose[axis], pose[4 + axis], pose[8 + axis]};
+        const float length_sqr = a[0] * a[0] + a[1] * a[1] + a[2] * a[2];
+        const float offset = a[0] * center[0] + a[1] * center[1] + a[2] * center[2];
+        const float extent = half_extents[axis] * length_sqr;
+
+        set_plane(volume.planes_[2 * axis], a[0], a[1], a[2], extent - offset);
+        set_plane(volume.planes_[2 * axis + 1], -a[0], -a[1], -a[2], extent + offset);
+    }
+
+    volume.plane_count_ = 6;
+
+    return volume;
+}
+
+CullingVolume CullingVolume::frustum(const Matrix4 &view_projection)
+{
+    const Matrix4 &m = view_projection;
+    Vector4 planes[kMaxPlanes];
+
+    for (int32_t row = 0; row < 3; row++)
+    {
+        planes[2 * row] = Vector4(m[12] + m[4 * row], m[13] + m[4 * row + 1], m[14] + m[4 * row + 2], m[15] + m[4 * row + 3]);
+        planes[2 * row + 1] = Vector4(m[12] - m[4 * row], m[13] - m[4 * row + 1], m[14] - m[4 * row + 2], m[15] - m[4 * row + 3]);
+    }
+
+    return convex(planes, kMaxPlanes);
+}
+
+CullingVolume CullingVolume::convex(const Vector4 *planes, const size_t &count)
+{
+    if (count > kMaxPlanes)
+    {
+        throw std::invalid_argument("CullingVolume: at most six planes are supported");
+    }
+
+    CullingVolume volume;
+    volume.shape_ = Shape::Planes;
+    volume.plane_count_ = count;
+
+    for (size_t p = 0; p < count; p++)
+    {
+        const float length = std::sqrt(planes[p][0] * planes[p][0] + planes[p][1] * planes[p][1] + planes[p][2] * planes[p][2]);
+        const float scale = length > 0.0f ? 1.0f / length : 1.0f;
+
+        set_plane(volume.planes_[p], planes[p][0] * scale, planes[p][1] * scale, planes[p][2] * scale, planes[p][3] * scale);
+    }
+
+    return volume;
+}
+
+size_t CullingVolume::plane_count() const
+{
+    return plane_count_;
+}
+
+bool CullingVolume::test(const float &x, const float &y, const float &z) const
+{
+    switch (shape_)
+    {
+    case Shape::Box:
+        return x >= minimum_[0] && x <= maximum_[0] && y >= minimum_[1] && y <= maximum_[1] && z >= minimum_[2] && z <= maximum_[2];
+
+    case Shape::OrientedBox:
+    {
+        const Matrix4 &m = world_to_box_;
+        const float lx = m[0] * x + m[1] * y + m[2] * z + m[3];
+        const float ly = m[4] * x + m[5] * y + m[6] * z + m[7];
+        const float lz = m[8] * x + m[9] * y + m[10] * z + m[11];
+
+        return lx >= minimum_[0] && lx <= maximum_[0] && ly >= minimum_[1] && ly <= maximum_[1] && lz >= minimum_[2] && lz <= maximum_[2];
+    }
+
+    default:
+        for (size_t p = 0; p < plane_count_; p++)
+        {
+            if (planes_[p][0] * x + planes_[p][1] * y + planes_[p][2] * z + planes_[p][3] < 0.0f)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int32_t CullingVolume::test8(const float *x, const float *y, const float *z) const
+{
+#ifdef __AVX__
+
+    __m256 px = _mm256_loadu_ps(x);
+    __m256 py = _mm256_loadu_ps(y);
+    __m256 pz = _mm256_loadu_ps(z);
+
+    if (shape_ == Shape::Planes)
+    {
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        for (size_t p = 0; p < plane_count_; p++)
+        {
+            const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes_[p][0]), px),
+                                                                _mm256_mul_ps(_mm256_set1_ps(planes_[p][1]), py)),
+                                                  _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes_[p][2]), pz),
+                                                                _mm256_set1_ps(planes_[p][3])));
+
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+
+        return _mm256_movemask_ps(inside);
+    }
+
+    if (shape_ == Shape::OrientedBox)
+    {
+        const Matrix4 &m = world_to_box_;
+
+        const __m256 lx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(m[0]), px), _mm256_mul_ps(_mm256_set1_ps(m[1]), py)),
+                                        _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(m[2]), pz), _mm256_set1_ps(m[3])));
+        const __m256 ly = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(m[4]), px), _mm256_mul_ps(_mm256_set1_ps(m[5]), py)),
+                                        _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(m[6]), pz), _mm256_set1_ps(m[7])));
+        const __m256 lz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(m[8]), px), _mm256_mul_ps(_mm256_set1_ps(m[9]), py)),
+                                        _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(m[10]), pz), _mm256_set1_ps(m[11])));
+
+        px = lx;
+        py = ly;
+        pz = lz;
+    }
+
+    const __m256 inside_x = _mm256_and_ps(_mm256_cmp_ps(px, _mm256_set1_ps(minimum_[0]), _CMP_GE_OQ),
+                                          _mm256_cmp_ps(px, _mm256_set1_ps(maximum_[0]), _CMP_LE_OQ));
+    const __m256 inside_y = _mm256_and_ps(_mm256_cmp_ps(py, _mm256_set1_ps(minimum_[1]), _CMP_GE_OQ),
+                                          _mm256_cmp_ps(py, _mm256_set1_ps(maximum_[1]), _CMP_LE_OQ));
+    const __m256 inside_z = _mm256_and_ps(_mm256_cmp_ps(pz, _mm256_set1_ps(minimum_[2]), _CMP_GE_OQ),
+                                          _mm256_cmp_ps(pz, _mm256_set1_ps(maximum_[2]), _CMP_LE_OQ));
+
+    return _mm256_movemask_ps(_mm256_and_ps(inside_x, _mm256_and_ps(inside_y, inside_z)));
+
+#else
+
+    int32_t mask = 0;
+
+    for (int32_t k = 0; k < 8; k++)
+    {
+        mask |= test(x[k], y[k], z[k]) ? 1 << k : 0;
+    }
+
+    return mask;
+
+#endif
+}
+
+size_t CullingVolume::select_range(const float *x, const float *y, const float *z, const size_t &first, const size_t &count, uint32_t *indices) const
+{
+    size_t selected = 0;
+    size_t i = first;
+    const size_t end = first + count;
+
+    // The compress store of a block never writes past its own last position, so count entries suffice.
+    for (; i + 8 <= end; i += 8)
+    {
+        selected += compress_store(test8(x + i, y + i, z + i), static_cast<uint32_t>(i), indices + selected);
+    }
+
+    for (; i < end; i++)
+    {
+        if (test(x[i], y[i], z[i]))
+        {
+            indices[selected++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    return selected;
+}
+
+bool CullingVolume::contains(const Vector4 &point) const
+{
+    return test(point[0], point[1], point[2]);
+}
+
+CullResult CullingVolume::classify(const float minimum[3], const float maximum[3]) const
+{
+    if (shape_ == Shape::Box)
+    {
+        bool inside = true;
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            if (maximum[c] < minimum_[c] || minimum[c] > maximum_[c])
+            {
+                return CullResult::Outside;
+            }
+
+            inside = inside && minimum[c] >= minimum_[c] && maximum[c] <= maximum_[c];
+        }
+
+        return inside ? CullResult::Inside : CullResult::Intersecting;
+    }
+
+    bool inside = true;
+
+    for (size_t p = 0; p < plane_count_; p++)
+    {
+        const float *plane = planes_[p];
+        float nearest = plane[3];
+        float farthest = plane[3];
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            nearest += plane[c] * (plane[c] >= 0.0f ? minimum[c] : maximum[c]);
+            farthest += plane[c] * (plane[c] >= 0.0f ? maximum[c] : minimum[c]);
+        }
+
+        if (farthest < 0.0f)
+        {
+            return CullResult::Outside;
+        }
+
+        inside = inside && nearest >= 0.0f;
+    }
+
+    return inside ? CullResult::Inside : CullResult::Intersecting;
+}
+
+size_t CullingVolume::select(const float *x, const float *y, const float *z, const size_t &count, uint32_t *indices) const
+{
+    return select_range(x, y, z, 0, count, indices);
+}
+
+void CullingVolume::select(const PointCloud &cloud, std::vector<uint32_t> &indices, ThreadPool &pool) const
+{
+    LRE_PROFILE_SCOPE("CullingVolume::select");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, cloud.size());
+
+    const size_t count = cloud.size();
+    const size_t chunk_count = (count + kSelectChunk - 1) / kSelectChunk;
+
+    // Each chunk compresses into its own slice of the output, then the slices are packed together.
+    std::vector<size_t> selected(chunk_count, 0);
+    indices.resize(count);
+
+    pool.parallel_for(0, chunk_count, 1, [&](const size_t &begin, const size_t &end)
+                      {
+                          for (size_t chunk = begin; chunk < end; chunk++)
+                          {
+                              const size_t first = chunk * kSelectChunk;
+                              const size_t length = std::min(kSelectChunk, count - first);
+
+                              selected[chunk] = select_range(cloud.x(), cloud.y(), cloud.z(), first, length, indices.data() + first);
+                          } });
+
+    size_t total = 0;
+
+    for (size_t chunk = 0; chunk < chunk_count; chunk++)
+    {
+        std::memmove(indices.data() + total, indices.data() + chunk * kSelectChunk, selected[chunk] * sizeof(uint32_t));
+        total += selected[chunk];
+    }
+
+    indices.resize(total);
+}
+
+void CullingVolume::select(const PointCloud &cloud, std::vector<uint32_t> &indices) const
+{
+    select(cloud, indices, ThreadPool::shared());
+}
+
+void CullingVolume::mask(const PointCloud &cloud, std::vector<uint64_t> &bits, ThreadPool &pool) const
+{
+    LRE_PROFILE_SCOPE("CullingVolume::mask");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, cloud.size());
+
+    const size_t count = cloud.size();
+    const float *x = cloud.x();
+    const float *y = cloud.y();
+    const float *z = cloud.z();
+
+    bits.assign((count + 63) / 64, 0);
+
+    pool.parallel_for(0, bits.size(), kMaskGrain, [&](const size_t &begin, const size_t &end)
+                      {
+                          for (size_t word = begin; word < end; word++)
+                          {
+                              const size_t first = word * 64;
+                              uint64_t value = 0;
+
+                              if (first + 64 <= count)
+                              {
+                                  for (size_t block = 0; block < 8; block++)
+                                  {
+                                      const size_t i = first + 8 * block;
+                                      value |= static_cast<uint64_t>(test8(x + i, y + i, z + i)) << (8 * block);
+                                  }
+                              }
+                              else
+                              {
+                                  for (size_t i = first; i < count; i++)
+                                  {
+                                      value |= static_cast<uint64_t>(test(x[i], y[i], z[i])) << (i - first);
+                                  }
+                              }
+
+                              bits[word] = value;
+                          } });
+}
+
+void CullingVolume::mask(const PointCloud &cloud, std::vector<uint64_t> &bits) const
+{
+    mask(cloud, bits, ThreadPool::shared());
+}
+
+void CullingVolume::classify(const Octree &octree, std::vector<CullResult> &results) const
+{
+    const ArrayView<Octree::Node> nodes = octree.nodes();
+    results.assign(nodes.size(), CullResult::Outside);
+
+    if (nodes.empty())
+    {
+        return;
+    }
+
+    // Descendants of fully inside or outside nodes inherit the result without further tests.
+    std::vector<std::pair<uint32_t, CullResult>> stack;
+    stack.push_back(std::make_pair(0u, CullResult::Intersecting));
+
+    while (!stack.empty())
+    {
+        const uint32_t node = stack.back().first;
+        const CullResult inherited = stack.back().second;
+        stack.pop_back();
+
+        const Octree::Node &current = nodes[node];
+        const CullResult result = inherited == CullResult::Intersecting ? classify(current.minimum, current.maximum) : inherited;
+        results[node] = result;
+
+        for (int32_t octant = 0; octant < 8; octant++)
+        {
+            const int32_t child = octree.child(node, octant);
+
+            if (child >= 0)
+            {
+                stack.push_back(std::make_pair(static_cast<uint32_t>(child), result));
+            }
+        }
+    }
+}
+
+void CullingVolume::select(const Octree &octree, std::vector<uint32_t> &indices) const
+{
+    LRE_PROFILE_SCOPE("CullingVolume::select_octree");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, octree.size());
+
+    indices.clear();
+
+    const ArrayView<Octree::Node> nodes = octree.nodes();
+
+    if (nodes.empty())
+    {
+        return;
+    }
+
+    const ArrayView<uint32_t> order = octree.indices();
+    std::vector<uint32_t> stack(1, 0);
+    std::vector<uint32_t> scratch;
+
+    while (!stack.empty())
+    {
+        const uint32_t node = stack.back();
+        stack.pop_back();
+
+        const Octree::Node &current = nodes[node];
+        const CullResult result = classify(current.minimum, current.maximum);
+
+        if (result == CullResult::Outside)
+        {
+            continue;
+        }
+
+        if (result == CullResult::Inside)
+        {
+            indices.insert(indices.end(), order.begin() + current.begin, order.begin() + current.end);
+            continue;
+        }
+
+        if (current.child_mask == 0)
+        {
+            const size_t length = current.end - current.begin;
+            scratch.resize(length);
+
+            const size_t selected = select(octree.x() + current.begin, octree.y() + current.begin, octree.z() + current.begin, length, scratch.data());
+
+            for (size_t k = 0; k < selected; k++)
+            {
+                indices.push_back(order[current.begin + scratch[k]]);
+            }
+
+            continue;
+        }
+
+        for (int32_t octant = 7; octant >= 0; octant--)
+        {
+            const int32_t child = octree.child(node, octant);
+
+            if (child >= 0)
+            {
+                stack.push_back(static_cast<uint32_t>(child));
+            }
+        }
+    }
+}
@@ -0,0 +1,1029 @@
+#include <LRE/spatial/incremental_kd_tree.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+
+namespace
+{
+    constexpr uint32_t kMinimumRebuildSize = 16;
+
+    struct Candidate
+    {
+        float sqr_distance;
+        int32_t index;
+
+        bool operator<(const Candidate &other) const
+        {
+            return sqr_distance < other.sqr_distance;
+        }
+    };
+
+    IncrementalKdTree::Node make_leaf(const float point[3], const int32_t &parent, const int32_t &axis)
+    {
+        IncrementalKdTree::Node node;
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            node.point[c] = point[c];
+            node.minimum[c] = point[c];
+            node.maximum[c] = point[c];
+        }
+
+        node.left = -1;
+        node.right = -1;
+        node.parent = parent;
+        node.size = 1;
+        node.invalid = 0;
+        node.axis = axis;
+        node.deleted = false;
+        node.tree_deleted = false;
+
+        return node;
+    }
+
+    float box_sqr_distance(const IncrementalKdTree::Node &node, const float query[3])
+    {
+        float sqr_distance = 0.0f;
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            const float below = node.minimum[c] - query[c];
+            const float above = query[c] - node.maximum[c];
+            const float gap = std::max(0.0f, std::max(below, above));
+            sqr_distance += gap * gap;
+        }
+
+        return sqr_distance;
+    }
+
+    bool disjoint(const IncrementalKdTree::Node &node, const float minimum[3], const float maximum[3])
+    {
+        for (int32_t c = 0; c < 3; c++)
+        {
+            if (node.maximum[c] < minimum[c] || node.minimum[c] > maximum[c])
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool contained(const IncrementalKdTree::Node &node, const float minimum[3], const float maximum[3])
+    {
+        for (int32_t c = 0; c < 3; c++)
+        {
+            if (node.minimum[c] < minimum[c] || node.maximum[c] > maximum[c])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool inside(const float point[3], const float minimum[3], const float maximum[3])
+    {
+        for (int32_t c = 0; c < 3; c++)
+        {
+            if (point[c] < minimum[c] || point[c] > maximum[c])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    using VoxelCell = std::array<int64_t, 3>;
+
+    struct VoxelCellHash
+    {
+        size_t operator()(const VoxelCell &cell) const
+        {
+            uint64_t hash = 0;
+
+            for (const int64_t value : cell)
+            {
+                hash = (hash ^ static_cast<uint64_t>(value)) * 0x9e3779b97f4a7c15ull;
+                hash ^= hash >> 32;
+            }
+
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    // Saturated to +-2^62 so far-away and non-finite coordinates still map to a defined cell.
+    VoxelCell voxel_cell(const float point[3], const float &resolution)
+    {
+        constexpr float kLimit = 4611686018427387904.0f;
+
+        VoxelCell cell;
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            cell[c] = static_cast<int64_t>(std::max(-kLimit, std::min(kLimit, std::floor(point[c] / resolution))));
+        }
+
+        return cell;
+    }
+
+    float center_sqr_distance(const float point[3], const float &resolution)
+    {
+        float sqr_distance = 0.0f;
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            const float center = (std::floor(point[c] / resolution) + 0.5f) * resolution;
+            const float delta = point[c] - center;
+            sqr_distance += delta * delta;
+        }
+
+        return sqr_distance;
+    }
+}
+
+IncrementalKdTree::IncrementalKdTree(const float &downsample_resolution, const size_t &background_threshold)
+    : root_(-1),
+      downsample_resolution_(std::max(0.0f, downsample_resolution)),
+      balance_threshold_(0.7f),
+      delete_threshold_(0.5f),
+      background_threshold_(std::max<size_t>(kMinimumRebuildSize, background_threshold)),
+      stopping_(false),
+      job_pending_(false),
+      rebuilding_root_(-1)
+{
+    worker_ = std::thread(&IncrementalKdTree::worker_loop, this);
+}
+
+IncrementalKdTree::IncrementalKdTree(const float &downsample_resolution) : IncrementalKdTree(downsample_resolution, 4096)
+{
+}
+
+IncrementalKdTree::IncrementalKdTree() : IncrementalKdTree(0.0f, 4096)
+{
+}
+
+IncrementalKdTree::~IncrementalKdTree()
+{
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        stopping_ = true;
+    }
+
+    job_condition_.notify_all();
+    worker_.join();
+}
+
+void IncrementalKdTree::refresh(std::vector<Node> &nodes, const int32_t &index)
+{
+    Node &node = nodes[index];
+
+    node.size = 1;
+    node.invalid = node.deleted ? 1 : 0;
+
+    for (int32_t c = 0; c < 3; c++)
+    {
+        node.minimum[c] = node.point[c];
+        node.maximum[c] = node.point[c];
+    }
+
+    for (const int32_t child : {node.left, node.right})
+    {
+        if (child < 0)
+        {
+            continue;
+        }
+
+        const Node &other = nodes[child];
+        node.size += other.size;
+        node.invalid += other.invalid;
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            node.minimum[c] = std::min(node.minimum[c], other.minimum[c]);
+            node.maximum[c] = std::max(node.maximum[c], other.maximum[c]);
+        }
+    }
+
+    if (node.tree_deleted)
+    {
+        node.invalid = node.size;
+    }
+}
+
+int32_t IncrementalKdTree::build_nodes(std::vector<Node> &nodes, std::vector<std::array<float, 3>> &points,
+                                       const size_t &begin, const size_t &end, const int32_t &parent)
+{
+    if (begin >= end)
+    {
+        return -1;
+    }
+
+    float minimum[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    float maximum[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+
+    for (size_t i = begin; i < end; i++)
+    {
+        for (int32_t c = 0; c < 3; c++)
+        {
+            minimum[c] = std::min(minimum[c], points[i][c]);
+            maximum[c] = std::max(maximum[c], points[i][c]);
+        }
+    }
+
+    int32_t axis = 0;
+
+    for (int32_t c = 1; c < 3; c++)
+    {
+        if (maximum[c] - minimum[c] > maximum[axis] - minimum[axis])
+        {
+            axis = c;
+        }
+    }
+
+    const size_t middle = begin + (end - begin) / 2;
+
+    std::nth_element(points.begin() + begin, points.begin() + middle, points.begin() + end,
+                     [axis](const std::array<float, 3> &a, const std::array<float, 3> &b)
+                     { return a[axis] < b[axis]; });
+
+    const int32_t index = static_cast<int32_t>(nodes.size());
+    nodes.push_back(make_leaf(points[middle].data(), parent, axis));
+
+    const int32_t left = build_nodes(nodes, points, begin, middle, index);
+    const int32_t right = build_nodes(nodes, points, middle + 1, end, index);
+
+    nodes[index].left = left;
+    nodes[index].right = right;
+    refresh(nodes, index);
+
+    return index;
+}
+
+int32_t IncrementalKdTree::allocate()
+{
+    if (!free_nodes_.empty())
+    {
+        const int32_t index = free_nodes_.back();
+        free_nodes_.pop_back();
+        return index;
+    }
+
+    nodes_.emplace_back();
+    return static_cast<int32_t>(nodes_.size() - 1);
+}
+
+void IncrementalKdTree::release(const int32_t &index)
+{
+    if (index < 0)
+    {
+        return;
+    }
+
+    std::vector<int32_t> stack = {index};
+
+    while (!stack.empty())
+    {
+        const int32_t current = stack.back();
+        stack.pop_back();
+
+        free_nodes_.push_back(current);
+
+        for (const int32_t child : {nodes_[current].left, nodes_[current].right})
+        {
+            if (child >= 0)
+            {
+                stack.push_back(child);
+            }
+        }
+    }
+}
+
+void IncrementalKdTree::push_down(const int32_t &index)
+{
+    Node &node = nodes_[index];
+
+    if (!node.tree_deleted)
+    {
+        return;
+    }
+
+    for (const int32_t child : {node.left, node.right})
+    {
+        if (child >= 0)
+        {
+            nodes_[child].tree_deleted = true;
+            nodes_[child].deleted = true;
+            nodes_[child].invalid = nodes_[child].size;
+
+            // A delete covering an ancestor reaches the rebuilding slot only now; replay it as one covering everything.
+            if (child == rebuilding_root_)
+            {
+                constexpr float kInfinity = std::numeric_limits<float>::infinity();
+                operation_log_.push_back(Operation{false, {-kInfinity, -kInfinity, -kInfinity, kInfinity, kInfinity, kInfinity}});
+            }
+        }
+    }
+
+    node.tree_deleted = false;
+}
+
+void IncrementalKdTree::refresh_ancestors(int32_t index)
+{
+    while (index >= 0)
+    {
+        refresh(nodes_, index);
+        index = nodes_[index].parent;
+    }
+}
+
+void IncrementalKdTree::collect(const int32_t &index, std::vector<std::array<float, 3>> &points) const
+{
+    if (index < 0)
+    {
+        return;
+    }
+
+    std::vector<int32_t> stack = {index};
+
+    while (!stack.empty())
+    {
+        const Node &node = nodes_[stack.back()];
+        stack.pop_back();
+
+        if (node.tree_deleted)
+        {
+            continue;
+        }
+
+        if (!node.deleted)
+        {
+            points.push_back({node.point[0], node.point[1], node.point[2]});
+        }
+
+        for (const int32_t child : {node.left, node.right})
+        {
+            if (child >= 0)
+            {
+                stack.push_back(child);
+            }
+        }
+    }
+}
+
+int32_t IncrementalKdTree::splice(std::vector<Node> &local, const int32_t &local_root, const int32_t &old_root)
+{
+    const int32_t parent = nodes_[old_root].parent;
+    const bool left = parent >= 0 && nodes_[parent].left == old_root;
+
+    release(old_root);
+
+    std::vector<int32_t> mapping(local.size());
+
+    for (size_t i = 0; i < local.size(); i++)
+    {
+        mapping[i] = allocate();
+    }
+
+    for (size_t i = 0; i < local.size(); i++)
+    {
+        Node node = local[i];
+        node.left = node.left < 0 ? -1 : mapping[node.left];
+        node.right = node.right < 0 ? -1 : mapping[node.right];
+        node.parent = node.parent < 0 ? parent : mapping[node.parent];
+        nodes_[mapping[i]] = node;
+    }
+
+    const int32_t new_root = local_root < 0 ? -1 : mapping[local_root];
+
+    if (parent < 0)
+    {
+        root_ = new_root;
+    }
+    else if (left)
+    {
+        nodes_[parent].left = new_root;
+    }
+    else
+    {
+        nodes_[parent].right = new_root;
+    }
+
+    refresh_ancestors(parent);
+
+    return new_root;
+}
+
+bool IncrementalKdTree::degraded(const int32_t &index) const
+{
+    const Node &node = nodes_[index];
+
+    if (node.size < kMinimumRebuildSize)
+    {
+        return false;
+    }
+
+    const uint32_t left = node.left < 0 ? 0 : nodes_[node.left].size;
+    const uint32_t right = node.right < 0 ? 0 : nodes_[node.right].size;
+
+    return std::max(left, right) > balance_threshold_ * node.size ||
+           node.invalid > delete_threshold_ * node.size;
+}
+
+bool IncrementalKdTree::is_ancestor(const int32_t &ancestor, int32_t index) const
+{
+    while (index >= 0)
+    {
+        if (index == ancestor)
+        {
+            return true;
+        }
+
+        index = nodes_[index].parent;
+    }
+
+    return false;
+}
+
+bool IncrementalKdTree::rebalance(const int32_t &index)
+{
+    // Subtrees enclosing the one being rebuilt in the background keep their shape until it is swapped in.
+    if (rebuilding_root_ >= 0 && is_ancestor(index, rebuilding_root_))
+    {
+        return false;
+    }
+
+    if (rebuilding_root_ < 0 && nodes_[index].size >= background_threshold_)
+    {
+        rebuilding_root_ = index;
+        job_points_.clear();
+        collect(index, job_points_);
+        operation_log_.clear();
+        job_pending_ = true;
+        job_condition_.notify_all();
+        return true;
+    }
+
+    std::vector<std::array<float, 3>> points;
+    collect(index, points);
+
+    std::vector<Node> local;
+    local.reserve(points.size());
+    const int32_t local_root = build_nodes(local, points, 0, points.size(), -1);
+
+    splice(local, local_root, index);
+    return true;
+}
+
+std::vector<std::array<float, 3>> IncrementalKdTree::reduce(const PointCloud &cloud) const
+{
+    std::vector<std::array<float, 3>> points;
+    points.reserve(cloud.size());
+
+    if (downsample_resolution_ <= 0.0f)
+    {
+        for (size_t i = 0; i < cloud.size(); i++)
+        {
+            points.push_back({cloud.x()[i], cloud.y()[i], cloud.z()[i]});
+        }
+
+        return points;
+    }
+
+    std::unordered_map<VoxelCell, size_t, VoxelCellHash> best;
+    best.reserve(cloud.size());
+
+    for (size_t i = 0; i < cloud.size(); i++)
+    {
+        const std::array<float, 3> point = {cloud.x()[i], cloud.y()[i], cloud.z()[i]};
+        const VoxelCell cell = voxel_cell(point.data(), downsample_resolution_);
+
+        auto found = best.find(cell);
+
+        if (found == best.end())
+        {
+            best.emplace(cell, points.size());
+            points.push_back(point);
+        }
+        else if (center_sqr_distance(point.data(), downsample_resolution_) <
+                 center_sqr_distance(points[found->second].data(), downsample_resolution_))
+        {
+            points[found->second] = point;
+        }
+    }
+
+    return points;
+}
+
+void IncrementalKdTree::insert_from(const float point[3], std::vector<int32_t> &path)
+{
+    path.clear();
+
+    if (root_ < 0)
+    {
+        root_ = allocate();
+        nodes_[root_] = make_leaf(point, -1, 0);
+        path.push_back(root_);
+        return;
+    }
+
+    int32_t index = root_;
+
+    while (true)
+    {
+        push_down(index);
+        path.push_back(index);
+
+        const int32_t axis = nodes_[index].axis;
+        const bool left = point[axis] < nodes_[index].point[axis];
+        const int32_t child = left ? nodes_[index].left : nodes_[index].right;
+
+        if (child >= 0)
+        {
+            index = child;
+            continue;
+        }
+
+        const int32_t leaf = allocate();
+        nodes_[leaf] = make_leaf(point, index, (axis + 1) % 3);
+
+        if (left)
+        {
+            nodes_[index].left = leaf;
+        }
+        else
+        {
+            nodes_[index].right = leaf;
+        }
+
+        path.push_back(leaf);
+        break;
+    }
+
+    for (size_t i = path.size(); i-- > 0;)
+    {
+        refresh(nodes_, path[i]);
+    }
+}
+
+uint32_t IncrementalKdTree::delete_from(const int32_t &index, const float minimum[3], const float maximum[3], std::vector<int32_t> &visited)
+{
+    if (index < 0 || nodes_[index].tree_deleted || disjoint(nodes_[index], minimum, maximum))
+    {
+        return 0;
+    }
+
+    visited.push_back(index);
+
+    Node &node = nodes_[index];
+
+    if (contained(node, minimum, maximum))
+    {
+        const uint32_t removed = node.size - node.invalid;
+        node.tree_deleted = true;
+        node.deleted = true;
+        node.invalid = node.size;
+        return removed;
+    }
+
+    uint32_t removed = 0;
+
+    if (!node.deleted && inside(node.point, minimum, maximum))
+    {
+        node.deleted = true;
+        removed++;
+    }
+
+    const int32_t left = node.left;
+    const int32_t right = node.right;
+
+    removed += delete_from(left, minimum, maximum, visited);
+    removed += delete_from(right, minimum, maximum, visited);
+
+    refresh(nodes_, index);
+
+    return removed;
+}
+
+void IncrementalKdTree::insert_point(const float point[3])
+{
+    std::vector<int32_t> path;
+    insert_from(point, path);
+
+    if (rebuilding_root_ >= 0 && std::find(path.begin(), path.end(), rebuilding_root_) != path.end())
+    {
+        operation_log_.push_back(Operation{true, {point[0], point[1], point[2], 0.0f, 0.0f, 0.0f}});
+    }
+
+    for (const int32_t index : path)
+    {
+        if (degraded(index) && rebalance(index))
+        {
+            break;
+        }
+    }
+}
+
+uint32_t IncrementalKdTree::delete_box(const float minimum[3], const float maximum[3])
+{
+    std::vector<int32_t> visited;
+    const uint32_t removed = delete_from(root_, minimum, maximum, visited);
+
+    if (rebuilding_root_ >= 0 && std::find(visited.begin(), visited.end(), rebuilding_root_) != visited.end())
+    {
+        operation_log_.push_back(Operation{false, {minimum[0], minimum[1], minimum[2], maximum[0], maximum[1], maximum[2]}});
+    }
+
+    for (const int32_t index : visited)
+    {
+        if (degraded(index) && rebalance(index))
+        {
+            break;
+        }
+    }
+
+    return removed;
+}
+
+void IncrementalKdTree::search_box(const int32_t &index, const float minimum[3], const float maximum[3], std::vector<Vector4> &points) const
+{
+    if (index < 0)
+    {
+        return;
+    }
+
+    const Node &node = nodes_[index];
+
+    if (node.tree_deleted || disjoint(node, minimum, maximum))
+    {
+        return;
+    }
+
+    if (!node.deleted && inside(node.point, minimum, maximum))
+    {
+        points.emplace_back(node.point[0], node.point[1], node.point[2], 1.0f);
+    }
+
+    search_box(node.left, minimum, maximum, points);
+    search_box(node.right, minimum, maximum, points);
+}
+
+void IncrementalKdTree::worker_loop()
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    while (true)
+    {
+        job_condition_.wait(lock, [this]
+                            { return stopping_ || job_pending_; });
+
+        if (stopping_)
+        {
+            return;
+        }
+
+        job_pending_ = false;
+
+        const int32_t root = rebuilding_root_;
+        std::vector<std::array<float, 3>> points;
+        points.swap(job_points_);
+
+        lock.unlock();
+
+        std::vector<Node> local;
+        local.reserve(points.size());
+        const int32_t local_root = build_nodes(local, points, 0, points.size(), -1);
+
+        lock.lock();
+
+        if (stopping_)
+        {
+            return;
+        }
+
+        const int32_t parent = nodes_[root].parent;
+        const bool left = parent >= 0 && nodes_[parent].left == root;
+
+        splice(local, local_root, root);
+        rebuilding_root_ = -1;
+
+        // Ancestors of the rebuilt subtree were frozen, so inserts replayed from the root land in the same slot.
+        // Deletes already hit everything outside it live and replay against the slot alone, in log order; nothing is
+        // rebalanced until the whole log is applied, so the slot stays put.
+        const auto slot = [this, parent, left]()
+        { return parent < 0 ? root_ : left ? nodes_[parent].left : nodes_[parent].right; };
+
+        std::vector<Operation> operations;
+        operations.swap(operation_log_);
+        std::vector<int32_t> scratch;
+
+        for (const Operation &operation : operations)
+        {
+            if (operation.insert)
+            {
+                insert_from(operation.values, scratch);
+            }
+            else
+            {
+                scratch.clear();
+                delete_from(slot(), operation.values, operation.values + 3, scratch);
+                refresh_ancestors(parent);
+            }
+        }
+
+        std::vector<int32_t> chain;
+
+        for (int32_t index = slot(); index >= 0; index = nodes_[index].parent)
+        {
+            chain.push_back(index);
+        }
+
+        for (size_t i = chain.size(); i-- > 0;)
+        {
+            if (degraded(chain[i]) && rebalance(chain[i]))
+            {
+                break;
+            }
+        }
+
+        job_condition_.notify_all();
+    }
+}
+
+void IncrementalKdTree::build(const PointCloud &cloud)
+{
+    LRE_PROFILE_SCOPE("IncrementalKdTree::build");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, cloud.size());
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    job_condition_.wait(lock, [this]
+                        { return rebuilding_root_ < 0; });
+
+    std::vector<std::array<float, 3>> points = reduce(cloud);
+
+    nodes_.clear();
+    free_nodes_.clear();
+    nodes_.reserve(points.size());
+
+    root_ = build_nodes(nodes_, points, 0, points.size(), -1);
+}
+
+size_t IncrementalKdTree::insert(const PointCloud &cloud)
+{
+    LRE_PROFILE_SCOPE("IncrementalKdTree::insert");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, cloud.size());
+
+    std::vector<std::array<float, 3>> points = reduce(cloud);
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    if (downsample_resolution_ <= 0.0f)
+    {
+        for (const std::array<float, 3> &point : points)
+        {
+            insert_point(point.data());
+        }
+
+        return points.size();
+    }
+
+    size_t inserted = 0;
+    std::vector<Vector4> existing;
+
+    for (const std::array<float, 3> &point : points)
+    {
+        float minimum[3];
+        float maximum[3];
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            minimum[c] = std::floor(point[c] / downsample_resolution_) * downsample_resolution_;
+            maximum[c] = std::nextafter(minimum[c] + downsample_resolution_, minimum[c]);
+        }
+
+        existing.clear();
+        search_box(root_, minimum, maximum, existing);
+
+        if (!existing.empty())
+        {
+            float nearest = std::numeric_limits<float>::max();
+
+            for (const Vector4 &other : existing)
+            {
+                const float coordinates[3] = {other[0], other[1], other[2]};
+                nearest = std::min(nearest, center_sqr_distance(coordinates, downsample_resolution_));
+            }
+
+            // Keep whichever point sits closest to the voxel centre so the map does not drift.
+            if (center_sqr_distance(point.data(), downsample_resolution_) >= nearest)
+            {
+                continue;
+            }
+
+            delete_box(minimum, maximum);
+        }
+
+        insert_point(point.data());
+        inserted++;
+    }
+
+    return inserted;
+}
+
+size_t IncrementalKdTree::remove_box(const Vector4 &minimum, const Vector4 &maximum)
+{
+    LRE_PROFILE_SCOPE("IncrementalKdTree::remove_box");
+
+    const float lower[3] = {std::min(minimum[0], maximum[0]), std::min(minimum[1], maximum[1]), std::min(minimum[2], maximum[2])};
+    const float upper[3] = {std::max(minimum[0], maximum[0]), std::max(minimum[1], maximum[1]), std::max(minimum[2], maximum[2])};
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return delete_box(lower, upper);
+}
+
+void IncrementalKdTree::knn(const Vector4 &query, const size_t &k, std::vector<Vector4> &points, std::vector<float> &sqr_distances) const
+{
+    LRE_PROFILE_COUNT(Counter::QueriesIssued, 1);
+
+    points.clear();
+    sqr_distances.clear();
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    if (k == 0 || root_ < 0)
+    {
+        return;
+    }
+
+    const float target[3] = {query[0], query[1], query[2]};
+
+    std::priority_queue<Candidate> best;
+    std::vector<std::pair<float, int32_t>> stack = {{box_sqr_distance(nodes_[root_], target), root_}};
+
+    while (!stack.empty())
+    {
+        const std::pair<float, int32_t> entry = stack.back();
+        stack.pop_back();
+
+        if (best.size() == k && entry.first > best.top().sqr_distance)
+        {
+            continue;
+        }
+
+        const Node &node = nodes_[entry.second];
+
+        if (node.tree_deleted)
+        {
+            continue;
+        }
+
+        if (!node.deleted)
+        {
+            float sqr_distance = 0.0f;
+
+            for (int32_t c = 0; c < 3; c++)
+            {
+                const float delta = node.point[c] - target[c];
+                sqr_distance += delta * delta;
+            }
+
+            if (best.size() < k)
+            {
+                best.push(Candidate{sqr_distance, entry.second});
+            }
+            else if (sqr_distance < best.top().sqr_distance)
+            {
+                best.pop();
+                best.push(Candidate{sqr_distance, entry.second});
+            }
+        }
+
+        const float left = node.left < 0 ? std::numeric_limits<float>::max() : box_sqr_distance(nodes_[node.left], target);
+        const float right = node.right < 0 ? std::numeric_limits<float>::max() : box_sqr_distance(nodes_[node.right], target);
+
+        // Push the farther child first so the nearer one is explored next.
+        if (left <= right)
+        {
+            if (node.right >= 0)
+            {
+                stack.emplace_back(right, node.right);
+            }
+
+            if (node.left >= 0)
+            {
+                stack.emplace_back(left, node.left);
+            }
+        }
+        else
+        {
+            if (node.left >= 0)
+            {
+                stack.emplace_back(left, node.left);
+            }
+
+            if (node.right >= 0)
+            {
+                stack.emplace_back(right, node.right);
+            }
+        }
+    }
+
+    points.resize(best.size());
+    sqr_distances.resize(best.size());
+
+    for (size_t i = best.size(); i-- > 0;)
+    {
+        const Node &node = nodes_[best.top().index];
+        points[i] = Vector4(node.point[0], node.point[1], node.point[2], 1.0f);
+        sqr_distances[i] = best.top().sqr_distance;
+        best.pop();
+    }
+}
+
+void IncrementalKdTree::box_search(const Vector4 &minimum, const Vector4 &maximum, std::vector<Vector4> &points) const
+{
+    LRE_PROFILE_COUNT(Counter::QueriesIssued, 1);
+
+    points.clear();
+
+    const float lower[3] = {minimum[0], minimum[1], minimum[2]};
+    const float upper[3] = {maximum[0], maximum[1], maximum[2]};
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    search_box(root_, lower, upper, points);
+}
+
+size_t IncrementalKdTree::size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return root_ < 0 ? 0 : nodes_[root_].size - nodes_[root_].invalid;
+}
+
+size_t IncrementalKdTree::node_count() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return nodes_.size() - free_nodes_.size();
+}
+
+size_t IncrementalKdTree::depth() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    if (root_ < 0)
+    {
+        return 0;
+    }
+
+    size_t deepest = 0;
+    std::vector<std::pair<int32_t, size_t>> stack = {{root_, 1}};
+
+    while (!stack.empty())
+    {
+        const std::pair<int32_t, size_t> entry = stack.back();
+        stack.pop_back();
+
+        deepest = std::max(deepest, entry.second);
+
+        for (const int32_t child : {nodes_[entry.first].left, nodes_[entry.first].right})
+        {
+            if (child >= 0)
+            {
+                stack.emplace_back(child, entry.second + 1);
+            }
+        }
+    }
+
+    return deepest;
+}
+
+PointCloud IncrementalKdTree::points() const
+{
+    std::vector<std::array<float, 3>> points;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        collect(root_, points);
+    }
+
+    PointCloud cloud;
+    cloud.reserve(points.size());
+
+    for (const std::array<float, 3> &point : points)
+    {
+        cloud.push_back(Vector4(point[0], point[1], point[2], 1.0f));
+    }
+
+    return cloud;
+}
+
+void IncrementalKdTree::wait_for_rebuild()
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    job_condition_.wait(lock, [this]
+                        { return rebuilding_root_ < 0 || stopping_; });
+}
@@ -0,0 +1,384 @@
+#include <LRE/spatial/kd_tree.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <stdexcept>
+
+namespace
+{
+    constexpr uint32_t kNoChild = 0;
+
+    // Query stacks hold 64 entries and grow by at most one per level.
+    constexpr uint8_t kMaxDepth = 62;
+
+    struct Candidate
+    {
+        float sqr_distance;
+        uint32_t index;
+
+        bool operator<(const Candidate &other) const
+        {
+            return sqr_distance < other.sqr_distance;
+        }
+    };
+}
+
+KdTree::KdTree(const PointCloud &cloud, const size_t &leaf_size)
+    : leaf_size_(std::max<size_t>(1, leaf_size))
+{
+    LRE_PROFILE_SCOPE("KdTree::build");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, cloud.size());
+
+    std::shared_ptr<Storage> storage = std::make_shared<Storage>();
+    storage->x.assign(cloud.x(), cloud.x() + cloud.size());
+    storage->y.assign(cloud.y(), cloud.y() + cloud.size());
+    storage->z.assign(cloud.z(), cloud.z() + cloud.size());
+    storage->indices.resize(cloud.size());
+
+    std::vector<uint32_t> &indices = storage->indices;
+
+    for (uint32_t i = 0; i < indices.size(); i++)
+    {
+        indices[i] = i;
+    }
+
+    if (!indices.empty())
+    {
+        storage->nodes.reserve(2 * indices.size() / leaf_size_ + 1);
+        build(*storage, 0, static_cast<uint32_t>(indices.size()));
+    }
+
+    // Store coordinates in tree order so leaves are contiguous in memory.
+    std::vector<float> ordered(indices.size());
+    std::vector<float> *channels[3] = {&storage->x, &storage->y, &storage->z};
+
+    for (std::vector<float> *channel : channels)
+    {
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            ordered[i] = (*channel)[indices[i]];
+        }
+
+        channel->swap(ordered);
+    }
+
+    nodes_ = ArrayView<Node>(storage->nodes.data(), storage->nodes.size());
+    x_ = ArrayView<float>(storage->x.data(), storage->x.size());
+    y_ = ArrayView<float>(storage->y.data(), storage->y.size());
+    z_ = ArrayView<float>(storage->z.data(), storage->z.size());
+    indices_ = ArrayView<uint32_t>(indices.data(), indices.size());
+    storage_ = storage;
+}
+
+KdTree::KdTree(const PointCloud &cloud) : KdTree(cloud, 16)
+{
+}
+
+KdTree::KdTree() : leaf_size_(16)
+{
+}
+
+KdTree KdTree::from_arrays(const ArrayView<Node> &nodes, const ArrayView<float> &x, const ArrayView<float> &y,
+                           const ArrayView<float> &z, const ArrayView<uint32_t> &indices, const size_t &leaf_size,
+                           const std::shared_ptr<const void> &storage)
+{
+    const size_t count = indices.size();
+
+    if (x.size() != count || y.size() != count || z.size() != count || (count == 0) != nodes.empty())
+    {
+        throw std::invalid_argument("KdTree: array sizes do not match");
+    }
+
+    // Children always follow their parent and have exactly one, so one forward pass bounds the depth the query
+    // stacks must hold; a child shared by two parents could otherwise be re-entered at a shallower depth.
+    std::vector<uint8_t> depth(nodes.size(), 0);
+    std::vector<uint8_t> reached(nodes.size(), 0);
+
+    for (size_t n = 0; n < nodes.size(); n++)
+    {
+        const Node &node = nodes[n];
+
+        if (node.begin > node.end || node.end > count)
+        {
+            throw std::invalid_argument("KdTree: node range out of bounds");
+        }
+
+        if (node.left == kNoChild && node.right == kNoChild)
+        {
+            continue;
+        }
+
+        if (node.left <= n || node.right <= n || node.left >= nodes.size() || node.right >= nodes.size() ||
+            node.axis < 0 || node.axis > 2 || depth[n] >= kMaxDepth || node.left == node.right ||
+            reached[node.left] != 0 || reached[node.right] != 0)
+        {
+            throw std::invalid_argument("KdTree: malformed node");
+        }
+
+        reached[node.left] = 1;
+        reached[node.right] = 1;
+        depth[node.left] = static_cast<uint8_t>(depth[n] + 1);
+        depth[node.right] = static_cast<uint8_t>(depth[n] + 1);
+    }
+
+    for (const uint32_t &index : indices)
+    {
+        if (index >= count)
+        {
+            throw std::invalid_argument("KdTree: point index out of bounds");
+        }
+    }
+
+    KdTree tree;
+    tree.storage_ = storage;
+    tree.nodes_ = nodes;
+    tree.x_ = x;
+    tree.y_ = y;
+    tree.z_ = z;
+    tree.indices_ = indices;
+    tree.leaf_size_ = std::max<size_t>(1, leaf_size);
+
+    return tree;
+}
+
+uint32_t KdTree::build(Storage &storage, const uint32_t &begin, const uint32_t &end) const
+{
+    std::vector<Node> &nodes = storage.nodes;
+    std::vector<uint32_t> &indices = storage.indices;
+
+    const uint32_t node_index = static_cast<uint32_t>(nodes.size());
+    nodes.push_back(Node{begin, end, kNoChild, kNoChild, 0.0f, -1});
+
+    if (end - begin <= leaf_size_)
+    {
+        return node_index;
+    }
+
+    const std::vector<float> *channels[3] = {&storage.x, &storage.y, &storage.z};
+
+    float minimum[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    float maximum[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+
+    for (uint32_t i = begin; i < end; i++)
+    {
+        for (int32_t c = 0; c < 3; c++)
+        {
+            const float value = (*channels[c])[indices[i]];
+            minimum[c] = std::min(minimum[c], value);
+            maximum[c] = std::max(maximum[c], value);
+        }
+    }
+
+    int32_t axis = 0;
+
+    for (int32_t c = 1; c < 3; c++)
+    {
+        if (maximum[c] - minimum[c] > maximum[axis] - minimum[axis])
+        {
+            axis = c;
+        }
+    }
+
+    const std::vector<float> &channel = *channels[axis];
+    const uint32_t middle = begin + (end - begin) / 2;
+
+    std::nth_element(indices.begin() + begin, indices.begin() + middle, indices.begin() + end,
+                     [&channel](const uint32_t &a, const uint32_t &b)
+                     { return channel[a] < channel[b]; });
+
+    const float split = channel[indices[middle]];
+
+    const uint32_t left = build(storage, begin, middle);
+    const uint32_t right = build(storage, middle, end);
+
+    nodes[node_index].left = left;
+    nodes[node_index].right = right;
+    nodes[node_index].split = split;
+    nodes[node_index].axis = axis;
+
+    return node_index;
+}
+
+size_t KdTree::size() const
+{
+    return indices_.size();
+}
+
+bool KdTree::empty() const
+{
+    return indices_.empty();
+}
+
+size_t KdTree::leaf_size() const
+{
+    return leaf_size_;
+}
+
+void KdTree::knn(const Vector4 &query, const size_t &k,
+                 std::vector<uint32_t> &indices, std::vector<float> &sqr_distances) const
+{
+    LRE_PROFILE_COUNT(Counter::QueriesIssued, 1);
+
+    indices.clear();
+    sqr_distances.clear();
+
+    if (nodes_.empty() || k == 0)
+    {
+        return;
+    }
+
+    std::vector<Candidate> heap;
+    heap.reserve(k + 1);
+
+    float worst = std::numeric_limits<float>::max();
+
+    struct Pending
+    {
+        uint32_t node;
+        float sqr_distance;
+    };
+
+    Pending stack[64];
+    int32_t top = 0;
+    stack[top++] = Pending{0, 0.0f};
+
+    while (top > 0)
+    {
+        const Pending pending = stack[--top];
+
+        if (pending.sqr_distance > worst)
+        {
+            continue;
+        }
+
+        const Node &node = nodes_[pending.node];
+
+        if (node.left == kNoChild)
+        {
+            for (uint32_t i = node.begin; i < node.end; i++)
+            {
+                const float dx = x_[i] - query[0];
+                const float dy = y_[i] - query[1];
+                const float dz = z_[i] - query[2];
+                const float distance = dx * dx + dy * dy + dz * dz;
+
+                if (heap.size() < k)
+                {
+                    heap.push_back(Candidate{distance, indices_[i]});
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                else if (distance < heap.front().sqr_distance)
+                {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = Candidate{distance, indices_[i]};
+                    std::push_heap(heap.begin(), heap.end());
+                }
+
+                if (heap.size() == k)
+                {
+                    worst = heap.front().sqr_distance;
+                }
+            }
+
+            continue;
+        }
+
+        const float difference = query[node.axis] - node.split;
+        const uint32_t near_child = difference < 0.0f ? node.left : node.right;
+        const uint32_t far_child = difference < 0.0f ? node.right : node.left;
+
+        stack[top++] = Pending{far_child, difference * difference};
+        stack[top++] = Pending{near_child, 0.0f};
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+
+    indices.reserve(heap.size());
+    sqr_distances.reserve(heap.size());
+
+    for (const Candidate &candidate : heap)
+    {
+        indices.push_back(candidate.index);
+        sqr_distances.push_back(candidate.sqr_distance);
+    }
+}
+
+void KdTree::radius(const Vector4 &query, const float &radius,
+                    std::vector<uint32_t> &indices, std::vector<float> &sqr_distances) const
+{
+    LRE_PROFILE_COUNT(Counter::QueriesIssued, 1);
+
+    indices.clear();
+    sqr_distances.clear();
+
+    if (nodes_.empty())
+    {
+        return;
+    }
+
+    const float sqr_radius = radius * radius;
+
+    uint32_t stack[64];
+    int32_t top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const Node &node = nodes_[stack[--top]];
+
+        if (node.left == kNoChild)
+        {
+            for (uint32_t i = node.begin; i < node.end; i++)
+            {
+                const float dx = x_[i] - query[0];
+                const float dy = y_[i] - query[1];
+                const float dz = z_[i] - query[2];
+                const float distance = dx * dx + dy * dy + dz * dz;
+
+                if (distance <= sqr_radius)
+                {
+                    indices.push_back(indices_[i]);
+                    sqr_distances.push_back(distance);
+                }
+            }
+
+            continue;
+        }
+
+        const float difference = query[node.axis] - node.split;
+
+        if (difference - radius <= 0.0f)
+        {
+            stack[top++] = node.left;
+        }
+
+        if (difference + radius >= 0.0f)
+        {
+            stack[top++] = node.right;
+        }
+    }
+}
+
+ArrayView<KdTree::Node> KdTree::nodes() const
+{
+    return nodes_;
+}
+
+ArrayView<uint32_t> KdTree::indices() const
+{
+    return indices_;
+}
+
+const float *KdTree::x() const
+{
+    return x_.data();
+}
+
+const float *KdTree::y() const
+{
+    return y_.data();
+}
+
+const float *KdTree::z() const
+{
+    return z_.data();
+}
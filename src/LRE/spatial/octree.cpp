@@ -0,0 +1,372 @@
+#include <LRE/spatial/octree.hpp>
+#include <LRE/profiling/profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    constexpr int32_t kMaxLevels = 21;
+
+    int32_t octant_of(const float point[3], const Octree::Node &node)
+    {
+        int32_t octant = 0;
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            if (point[c] >= 0.5f * (node.minimum[c] + node.maximum[c]))
+            {
+                octant |= 1 << c;
+            }
+        }
+
+        return octant;
+    }
+
+    int32_t popcount(uint32_t mask)
+    {
+        int32_t count = 0;
+
+        while (mask != 0)
+        {
+            mask &= mask - 1;
+            count++;
+        }
+
+        return count;
+    }
+}
+
+Octree::Octree(const PointCloud &cloud, const float &resolution)
+    : resolution_(std::max(resolution, std::numeric_limits<float>::epsilon()))
+{
+    LRE_PROFILE_SCOPE("Octree::build");
+    LRE_PROFILE_COUNT(Counter::PointsProcessed, cloud.size());
+
+    if (cloud.empty())
+    {
+        return;
+    }
+
+    std::shared_ptr<Storage> storage = std::make_shared<Storage>();
+    storage->x.assign(cloud.x(), cloud.x() + cloud.size());
+    storage->y.assign(cloud.y(), cloud.y() + cloud.size());
+    storage->z.assign(cloud.z(), cloud.z() + cloud.size());
+    storage->indices.resize(cloud.size());
+
+    std::vector<uint32_t> &indices = storage->indices;
+
+    for (uint32_t i = 0; i < indices.size(); i++)
+    {
+        indices[i] = i;
+    }
+
+    float minimum[3] = {storage->x[0], storage->y[0], storage->z[0]};
+    float maximum[3] = {storage->x[0], storage->y[0], storage->z[0]};
+
+    for (size_t i = 1; i < indices.size(); i++)
+    {
+        const float point[3] = {storage->x[i], storage->y[i], storage->z[i]};
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            minimum[c] = std::min(minimum[c], point[c]);
+            maximum[c] = std::max(maximum[c], point[c]);
+        }
+    }
+
+    const float extent = std::max(maximum[0] - minimum[0], std::max(maximum[1] - minimum[1], maximum[2] - minimum[2]));
+
+    // Grow the root cube in powers of two so every leaf is exactly one voxel wide.
+    float size = resolution_;
+    int32_t levels = 0;
+
+    while (size <= extent && levels < kMaxLevels)
+    {
+        size *= 2.0f;
+        levels++;
+    }
+
+    Node root;
+
+    for (int32_t c = 0; c < 3; c++)
+    {
+        const float center = 0.5f * (minimum[c] + maximum[c]);
+        root.minimum[c] = center - 0.5f * size;
+        root.maximum[c] = center + 0.5f * size;
+    }
+
+    root.begin = 0;
+    root.end = static_cast<uint32_t>(indices.size());
+    root.first_child = 0;
+    root.child_mask = 0;
+    root.depth = static_cast<uint8_t>(levels);
+
+    storage->nodes.reserve(2 * indices.size() + 1);
+    storage->nodes.push_back(root);
+
+    std::vector<uint32_t> scratch(indices.size());
+    build(*storage, 0, scratch);
+
+    // Store coordinates in tree order so every node covers a contiguous range.
+    std::vector<float> ordered(indices.size());
+    std::vector<float> *channels[3] = {&storage->x, &storage->y, &storage->z};
+
+    for (std::vector<float> *channel : channels)
+    {
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            ordered[i] = (*channel)[indices[i]];
+        }
+
+        channel->swap(ordered);
+    }
+
+    nodes_ = ArrayView<Node>(storage->nodes.data(), storage->nodes.size());
+    x_ = ArrayView<float>(storage->x.data(), storage->x.size());
+    y_ = ArrayView<float>(storage->y.data(), storage->y.size());
+    z_ = ArrayView<float>(storage->z.data(), storage->z.size());
+    indices_ = ArrayView<uint32_t>(indices.data(), indices.size());
+    storage_ = storage;
+}
+
+Octree::Octree() : resolution_(1.0f)
+{
+}
+
+Octree Octree::from_arrays(const ArrayView<Node> &nodes, const ArrayView<float> &x, const ArrayView<float> &y,
+                           const ArrayView<float> &z, const ArrayView<uint32_t> &indices, const float &resolution,
+                           const std::shared_ptr<const void> &storage)
+{
+    const size_t count = indices.size();
+
+    if (x.size() != count || y.size() != count || z.size() != count || (count == 0) != nodes.empty())
+    {
+        throw std::invalid_argument("Octree: array sizes do not match");
+    }
+
+    if (!nodes.empty() && nodes[0].depth > kMaxLevels)
+    {
+        throw std::invalid_argument("Octree: malformed node");
+    }
+
+    for (size_t n = 0; n < nodes.size(); n++)
+    {
+        const Node &node = nodes[n];
+
+        if (node.begin > node.end || node.end > count)
+        {
+            throw std::invalid_argument("Octree: node range out of bounds");
+        }
+
+        if (node.child_mask == 0)
+        {
+            continue;
+        }
+
+        const size_t last = static_cast<size_t>(node.first_child) + popcount(node.child_mask);
+
+        // Depth strictly decreases along child links, which rules out cycles and bounds recursion.
+        if (node.first_child <= n || last > nodes.size() || node.depth == 0)
+        {
+            throw std::invalid_argument("Octree: malformed node");
+        }
+
+        for (size_t c = node.first_child; c < last; c++)
+        {
+            if (nodes[c].depth != node.depth - 1)
+            {
+                throw std::invalid_argument("Octree: malformed node");
+            }
+        }
+    }
+
+    for (const uint32_t &index : indices)
+    {
+        if (index >= count)
+        {
+            throw std::invalid_argument("Octree: point index out of bounds");
+        }
+    }
+
+    Octree tree;
+    tree.storage_ = storage;
+    tree.nodes_ = nodes;
+    tree.x_ = x;
+    tree.y_ = y;
+    tree.z_ = z;
+    tree.indices_ = indices;
+    tree.resolution_ = std::max(resolution, std::numeric_limits<float>::epsilon());
+
+    return tree;
+}
+
+void Octree::build(Storage &storage, const uint32_t &node, std::vector<uint32_t> &scratch)
+{
+    std::vector<Node> &nodes = storage.nodes;
+    std::vector<uint32_t> &indices = storage.indices;
+
+    const Node parent = nodes[node];
+
+    if (parent.depth == 0)
+    {
+        return;
+    }
+
+    uint32_t counts[8] = {};
+
+    for (uint32_t i = parent.begin; i < parent.end; i++)
+    {
+        const uint32_t index = indices[i];
+        const float point[3] = {storage.x[index], storage.y[index], storage.z[index]};
+        counts[octant_of(point, parent)]++;
+    }
+
+    uint32_t offsets[9] = {parent.begin};
+
+    for (int32_t o = 0; o < 8; o++)
+    {
+        offsets[o + 1] = offsets[o] + counts[o];
+    }
+
+    uint32_t cursor[8];
+    std::copy(offsets, offsets + 8, cursor);
+
+    for (uint32_t i = parent.begin; i < parent.end; i++)
+    {
+        const uint32_t index = indices[i];
+        const float point[3] = {storage.x[index], storage.y[index], storage.z[index]};
+        scratch[cursor[octant_of(point, parent)]++] = index;
+    }
+
+    std::copy(scratch.begin() + parent.begin, scratch.begin() + parent.end, indices.begin() + parent.begin);
+
+    uint8_t mask = 0;
+    const uint32_t first_child = static_cast<uint32_t>(nodes.size());
+
+    for (int32_t o = 0; o < 8; o++)
+    {
+        if (counts[o] == 0)
+        {
+            continue;
+        }
+
+        mask |= static_cast<uint8_t>(1 << o);
+
+        Node child;
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            const float center = 0.5f * (parent.minimum[c] + parent.maximum[c]);
+            const bool upper = (o >> c) & 1;
+            child.minimum[c] = upper ? center : parent.minimum[c];
+            child.maximum[c] = upper ? parent.maximum[c] : center;
+        }
+
+        child.begin = offsets[o];
+        child.end = offsets[o + 1];
+        child.first_child = 0;
+        child.child_mask = 0;
+        child.depth = static_cast<uint8_t>(parent.depth - 1);
+
+        nodes.push_back(child);
+    }
+
+    nodes[node].first_child = first_child;
+    nodes[node].child_mask = mask;
+
+    const int32_t children = popcount(mask);
+
+    for (int32_t i = 0; i < children; i++)
+    {
+        build(storage, first_child + i, scratch);
+    }
+}
+
+size_t Octree::size() const
+{
+    return indices_.size();
+}
+
+bool Octree::empty() const
+{
+    return indices_.empty();
+}
+
+float Octree::resolution() const
+{
+    return resolution_;
+}
+
+size_t Octree::leaf_count() const
+{
+    return std::count_if(nodes_.begin(), nodes_.end(), [](const Node &node)
+                         { return node.child_mask == 0; });
+}
+
+int32_t Octree::child(const uint32_t &node, const int32_t &octant) const
+{
+    const Node &parent = nodes_[node];
+    const uint32_t bit = 1u << octant;
+
+    if ((parent.child_mask & bit) == 0)
+    {
+        return -1;
+    }
+
+    return static_cast<int32_t>(parent.first_child + popcount(parent.child_mask & (bit - 1)));
+}
+
+int32_t Octree::find_leaf(const Vector4 &point) const
+{
+    if (nodes_.empty())
+    {
+        return -1;
+    }
+
+    const float target[3] = {point[0], point[1], point[2]};
+
+    for (int32_t c = 0; c < 3; c++)
+    {
+        if (target[c] < nodes_[0].minimum[c] || target[c] > nodes_[0].maximum[c])
+        {
+            return -1;
+        }
+    }
+
+    int32_t node = 0;
+
+    while (node >= 0 && nodes_[node].child_mask != 0)
+    {
+        node = child(node, octant_of(target, nodes_[node]));
+    }
+
+    return node;
+}
+
+ArrayView<Octree::Node> Octree::nodes() const
+{
+    return nodes_;
+}
+
+ArrayView<uint32_t> Octree::indices() const
+{
+    return indices_;
+}
+
+const float *Octree::x() const
+{
+    return x_.data();
+}
+
+const float *Octree::y() const
+{
+    return y_.data();
+}
+
+const float *Octree::z() const
+{
+    return z_.data();
+}
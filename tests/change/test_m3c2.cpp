@@ -0,0 +1,201 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/change/m3c2.hpp>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <random>
+#include <utility>
+
+namespace
+{
+    std::string scratch_directory(const std::string &name)
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / ("lre_" + name);
+        std::filesystem::remove_all(path);
+        return path.string();
+    }
+
+    // Noisy plane sampled on a jittered grid; points with x above step_x are raised by step.
+    PointCloud terrain(const float &extent, const float &spacing, const float &step_x, const float &step, const uint32_t &seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> jitter(-0.25f * spacing, 0.25f * spacing);
+        std::normal_distribution<float> noise(0.0f, 0.005f);
+
+        PointCloud cloud;
+        cloud.enable_normals();
+
+        for (float y = 0.5f * spacing; y < extent; y += spacing)
+        {
+            for (float x = 0.5f * spacing; x < extent; x += spacing)
+            {
+                const float px = x + jitter(generator);
+                const float py = y + jitter(generator);
+                const float pz = (px > step_x ? step : 0.0f) + noise(generator);
+
+                cloud.push_back(Vector4(px, py, pz));
+                cloud.set_normal(cloud.size() - 1, Vector4(0.0f, 0.0f, 1.0f));
+            }
+        }
+
+        return cloud;
+    }
+}
+
+TEST_CASE("M3C2: Signed distances")
+{
+    ThreadPool pool(2);
+
+    const PointCloud reference = terrain(6.0f, 0.1f, 100.0f, 0.0f, 1);
+    const PointCloud compared = terrain(6.0f, 0.1f, 3.0f, 0.3f, 2);
+    const KdTree reference_tree(reference);
+
+    const M3C2 m3c2(0.3f, 0.5f, 5, 0.01f);
+    const std::vector<ChangeMeasurement> measurements = m3c2.apply(compared, reference, reference_tree, pool);
+
+    REQUIRE(measurements.size() == compared.size());
+
+    for (size_t i = 0; i < compared.size(); i++)
+    {
+        const float x = compared.x()[i];
+        const ChangeMeasurement &measurement = measurements[i];
+
+        if (x < 2.6f)
+        {
+            REQUIRE(std::abs(measurement.distance) < 0.01f);
+            REQUIRE_FALSE(measurement.significant);
+        }
+        else if (x > 3.4f)
+        {
+            REQUIRE(std::abs(measurement.distance - 0.3f) < 0.01f);
+            REQUIRE(measurement.significant);
+            REQUIRE(measurement.uncertainty >= 0.01f);
+        }
+
+        REQUIRE(measurement.reference_count > 0);
+        REQUIRE(measurement.compared_count > 0);
+    }
+
+    SECTION("Flipped normals flip the sign")
+    {
+        PointCloud flipped = compared;
+
+        for (size_t i = 0; i < flipped.size(); i++)
+        {
+            flipped.set_normal(i, Vector4(0.0f, 0.0f, -1.0f));
+        }
+
+        const std::vector<ChangeMeasurement> opposite = m3c2.apply(flipped, reference, reference_tree, pool);
+
+        for (size_t i = 0; i < flipped.size(); i++)
+        {
+            REQUIRE(std::abs(opposite[i].distance + measurements[i].distance) < 1e-5f);
+        }
+    }
+
+    SECTION("Core points without reference coverage are undetermined")
+    {
+        PointCloud far = compared;
+        far.set_point(0, Vector4(50.0f, 50.0f, 0.0f));
+
+        const std::vector<ChangeMeasurement> result = m3c2.apply(far, reference, reference_tree, pool);
+
+        REQUIRE(std::isnan(result[0].distance));
+        REQUIRE(result[0].reference_count == 0);
+        REQUIRE_FALSE(result[0].significant);
+    }
+
+    SECTION("Invalid inputs")
+    {
+        PointCloud bare;
+        bare.push_back(Vector4(1.0f, 1.0f, 0.0f));
+
+        REQUIRE_THROWS_AS(m3c2.apply(bare, reference, reference_tree, pool), std::invalid_argument);
+        REQUIRE_THROWS_AS(M3C2(0.0f, 1.0f), std::invalid_argument);
+    }
+}
+
+TEST_CASE("M3C2: Cloud to cloud")
+{
+    ThreadPool pool(2);
+
+    const PointCloud reference = terrain(4.0f, 0.05f, 100.0f, 0.0f, 3);
+    PointCloud compared;
+    compared.push_back(Vector4(2.0f, 2.0f, 0.5f));
+    compared.push_back(Vector4(2.0f, 2.0f, -0.5f));
+
+    const std::vector<float> distances = M3C2::cloud_to_cloud(compared, reference, KdTree(reference), pool);
+
+    REQUIRE(std::abs(distances[0] - 0.5f) < 0.02f);
+    REQUIRE(std::abs(distances[1] + 0.5f) < 0.02f);
+}
+
+TEST_CASE("M3C2: Out-of-core tiles")
+{
+    ThreadPool pool(2);
+
+    const PointCloud reference = terrain(8.0f, 0.1f, 100.0f, 0.0f, 4);
+    const PointCloud compared = terrain(8.0f, 0.1f, 4.0f, 0.2f, 5);
+
+    const std::string reference_directory = scratch_directory("m3c2_reference");
+    const std::string compared_directory = scratch_directory("m3c2_compared");
+    const std::string index_directory = scratch_directory("m3c2_indices");
+
+    {
+        TileStoreWriter writer(reference_directory, 3.0f);
+        writer.append(reference);
+    }
+
+    {
+        TileStoreWriter writer(compared_directory, 2.5f);
+        writer.append(compared);
+    }
+
+    const M3C2 m3c2(0.3f, 0.5f);
+    const std::vector<ChangeMeasurement> expected = m3c2.apply(compared, reference, KdTree(reference), pool);
+
+    std::map<std::pair<float, float>, size_t> lookup;
+
+    for (size_t i = 0; i < compared.size(); i++)
+    {
+        lookup[std::make_pair(compared.x()[i], compared.y()[i])] = i;
+    }
+
+    const TileStore reference_store(reference_directory);
+    const TileStore compared_store(compared_directory);
+    TileCache reference_cache(reference_store, 1 << 20);
+    TileCache compared_cache(compared_store, 1 << 20);
+
+    // Runs twice so the second pass maps the reference indices written by the first.
+    for (int32_t run = 0; run < 2; run++)
+    {
+        TileProcessor processor(compared_store, compared_cache, m3c2.reach());
+        size_t measured = 0;
+
+        m3c2.apply(processor, reference_store, reference_cache, index_directory, pool,
+                   [&lookup, &expected, &measured](const TileInfo &, const PointCloud &core, const std::vector<ChangeMeasurement> &measurements)
+                   {
+                       REQUIRE(measurements.size() == core.size());
+
+                       for (size_t i = 0; i < core.size(); i++)
+                       {
+                           const ChangeMeasurement &reference_measurement = expected[lookup.at(std::make_pair(core.x()[i], core.y()[i]))];
+
+                           REQUIRE(std::abs(measurements[i].distance - reference_measurement.distance) < 1e-5f);
+                           REQUIRE(measurements[i].reference_count == reference_measurement.reference_count);
+                           REQUIRE(measurements[i].compared_count == reference_measurement.compared_count);
+                       }
+
+                       measured += core.size();
+                   });
+
+        REQUIRE(measured == compared.size());
+        REQUIRE_FALSE(std::filesystem::is_empty(index_directory));
+    }
+
+    TileProcessor narrow(compared_store, compared_cache, 0.1f);
+    REQUIRE_THROWS_AS(m3c2.apply(narrow, reference_store, reference_cache, std::string(), pool,
+                                 [](const TileInfo &, const PointCloud &, const std::vector<ChangeMeasurement> &) {}),
+                      std::invalid_argument);
+}
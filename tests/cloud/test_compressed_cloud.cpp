@@ -0,0 +1,103 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/cloud/compressed_cloud.hpp>
+#include <cstdint>
+#include <random>
+#include <tuple>
+
+namespace
+{
+    PointCloud grid_cloud(const size_t &count, const float &resolution)
+    {
+        std::mt19937 generator(7);
+        std::uniform_int_distribution<int32_t> wide(-60000, 90000);
+        std::uniform_int_distribution<int32_t> narrow(-500, 2000);
+
+        PointCloud cloud;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            cloud.push_back(Vector4(wide(generator) * resolution,
+                                    wide(generator) * resolution,
+                                    narrow(generator) * resolution));
+        }
+
+        return cloud;
+    }
+
+    std::vector<std::tuple<int64_t, int64_t, int64_t>> snapped(const PointCloud &cloud, const float &resolution)
+    {
+        std::vector<std::tuple<int64_t, int64_t, int64_t>> result;
+
+        for (size_t i = 0; i < cloud.size(); i++)
+        {
+            result.emplace_back(std::llround(cloud.x()[i] / resolution),
+                                std::llround(cloud.y()[i] / resolution),
+                                std::llround(cloud.z()[i] / resolution));
+        }
+
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
+
+TEST_CASE("Morton: Round Trip")
+{
+    uint32_t x, y, z;
+    Morton::decode(Morton::encode(123456, 7, 2097151), x, y, z);
+
+    REQUIRE(x == 123456);
+    REQUIRE(y == 7);
+    REQUIRE(z == 2097151);
+    REQUIRE(Morton::encode(1, 0, 0) == 1);
+    REQUIRE(Morton::encode(0, 1, 0) == 2);
+    REQUIRE(Morton::encode(0, 0, 1) == 4);
+}
+
+TEST_CASE("CompressedCloud: Round Trip")
+{
+    const float resolution = 0.001f;
+    PointCloud cloud = grid_cloud(5000, resolution);
+    const auto expected = snapped(cloud, resolution);
+
+    auto encoding = GENERATE(CloudEncoding::Quantized16, CloudEncoding::Quantized32, CloudEncoding::MortonDelta);
+
+    CompressedCloud compressed(cloud, resolution, encoding);
+    ThreadPool pool(2);
+    PointCloud decoded = compressed.decode(pool);
+
+    REQUIRE(compressed.size() == cloud.size());
+    REQUIRE(decoded.size() == cloud.size());
+    REQUIRE(snapped(decoded, resolution) == expected);
+
+    size_t visited = 0;
+    compressed.for_each_tile([&visited](const size_t &, const PointCloud &tile)
+                             { visited += tile.size(); },
+                             ThreadPool::shared());
+
+    REQUIRE(visited == cloud.size());
+}
+
+TEST_CASE("CompressedCloud: Memory Footprint")
+{
+    const float resolution = 0.01f;
+    PointCloud cloud;
+
+    for (int32_t i = 0; i < 64; i++)
+    {
+        for (int32_t j = 0; j < 64; j++)
+        {
+            for (int32_t k = 0; k < 16; k++)
+            {
+                cloud.push_back(Vector4(i * 0.05f, j * 0.05f, k * 0.05f));
+            }
+        }
+    }
+
+    const size_t raw_bytes = cloud.size() * 3 * sizeof(float);
+
+    CompressedCloud quantized(cloud, resolution, CloudEncoding::Quantized16);
+    CompressedCloud packed(cloud, resolution, CloudEncoding::MortonDelta);
+
+    REQUIRE(quantized.memory_usage() * 2 <= raw_bytes + 1024);
+    REQUIRE(packed.memory_usage() * 3 < raw_bytes);
+}
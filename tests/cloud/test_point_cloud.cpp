@@ -0,0 +1,130 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/cloud/point_cloud.hpp>
+#include <cstdint>
+
+TEST_CASE("PointCloud: Construction")
+{
+    SECTION("Default cloud is empty")
+    {
+        PointCloud cloud;
+        REQUIRE(cloud.empty());
+        REQUIRE_FALSE(cloud.has_timestamps());
+    }
+
+    SECTION("Construction from vectors keeps coordinates")
+    {
+        PointCloud cloud({Vector4(1.0f, 2.0f, 3.0f), Vector4(4.0f, 5.0f, 6.0f)});
+        REQUIRE(cloud.size() == 2);
+        REQUIRE(cloud.x()[1] == 4.0f);
+        REQUIRE(cloud.y()[1] == 5.0f);
+        REQUIRE(cloud.z()[1] == 6.0f);
+        REQUIRE(cloud.point(0) == Vector4(1.0f, 2.0f, 3.0f, 1.0f));
+    }
+}
+
+TEST_CASE("PointCloud: Timestamps")
+{
+    PointCloud cloud;
+    cloud.push_back(Vector4(1.0f, 0.0f, 0.0f));
+    cloud.push_back(Vector4(2.0f, 0.0f, 0.0f), 0.5f);
+
+    SECTION("Timestamps are enabled on demand")
+    {
+        REQUIRE(cloud.has_timestamps());
+        REQUIRE(cloud.timestamps()[0] == 0.0f);
+        REQUIRE(cloud.timestamps()[1] == 0.5f);
+    }
+
+    SECTION("Resize keeps channels aligned")
+    {
+        cloud.resize(5);
+        cloud.timestamps()[4] = 1.0f;
+        REQUIRE(cloud.size() == 5);
+        REQUIRE(cloud.timestamps()[4] == 1.0f);
+    }
+}
+
+TEST_CASE("PointCloud: Floating origin")
+{
+    const Vector4d origin(4123000.0, 512000.0, 300.0);
+
+    PointCloud cloud;
+    cloud.set_origin(origin);
+
+    for (int32_t i = 0; i < 11; i++)
+    {
+        cloud.push_back_world(Vector4d(4123000.0 + i * 0.125, 512000.0 - i * 0.25, 300.0 + i));
+    }
+
+    SECTION("Offsets stay small and world points round-trip")
+    {
+        REQUIRE(cloud.x()[4] == 0.5f);
+        REQUIRE(cloud.y()[4] == -1.0f);
+        REQUIRE(cloud.world_point(10) == Vector4d(4123001.25, 511997.5, 310.0, 1.0));
+    }
+
+    SECTION("Rebasing keeps world positions")
+    {
+        const Vector4d shifted(4123500.0, 511500.0, 250.0);
+        cloud.rebase(shifted);
+
+        REQUIRE(cloud.origin() == shifted);
+        REQUIRE(cloud.x()[0] == -500.0f);
+
+        for (size_t i = 0; i < cloud.size(); i++)
+        {
+            REQUIRE(cloud.world_point(i) == Vector4d(4123000.0 + i * 0.125, 512000.0 - i * 0.25, 300.0 + i, 1.0));
+        }
+    }
+
+    SECTION("Rebasing with a pose matches the double-precision transform")
+    {
+        Matrix4d pose;
+        pose[1] = -1.0;
+        pose[4] = 1.0;
+        pose[10] = 1.0;
+        pose[15] = 1.0;
+        pose[3] = 10.0;
+        pose[7] = -5.0;
+
+        std::vector<Vector4d> expected;
+
+        for (size_t i = 0; i < cloud.size(); i++)
+        {
+            expected.push_back(pose * cloud.world_point(i));
+        }
+
+        const Vector4d target = pose * Vector4d(origin[0], origin[1], origin[2], 1.0);
+        cloud.rebase(pose, target);
+
+        for (size_t i = 0; i < cloud.size(); i++)
+        {
+            REQUIRE(Vector4d::distance(cloud.world_point(i), expected[i]) < 1e-6);
+        }
+    }
+
+    SECTION("Appending clouds with another origin re-expresses their offsets")
+    {
+        PointCloud other;
+        other.set_origin(Vector4d(4123010.0, 512000.0, 300.0));
+        other.push_back(Vector4(0.5f, 0.0f, 0.0f));
+
+        cloud.append(other);
+
+        REQUIRE(cloud.world_point(cloud.size() - 1) == Vector4d(4123010.5, 512000.0, 300.0, 1.0));
+    }
+
+    SECTION("Appending a cloud to itself doubles it")
+    {
+        cloud.enable_normals();
+        cloud.append(cloud);
+
+        REQUIRE(cloud.size() == 22);
+        REQUIRE(cloud.has_normals());
+
+        for (size_t i = 0; i < 11; i++)
+        {
+            REQUIRE(cloud.world_point(i + 11) == cloud.world_point(i));
+        }
+    }
+}
@@ -0,0 +1,167 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/features/fpfh_estimation.hpp>
+#include <LRE/features/descriptor_tree.hpp>
+#include <LRE/linalg/quaternion.hpp>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+namespace
+{
+    // Points on a unit sphere above a plane, with analytic normals.
+    PointCloud sphere_on_plane(const uint32_t &seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+        PointCloud cloud;
+        cloud.enable_normals();
+
+        for (int32_t i = 0; i < 1500; i++)
+        {
+            Vector4 direction(unit(generator), unit(generator), unit(generator), 0.0f);
+
+            if (direction.sqr_magnitude() < 1e-3f)
+            {
+                continue;
+            }
+
+            direction.normalize();
+            cloud.push_back(Vector4(direction[0], direction[1], direction[2] + 1.0f));
+            cloud.set_normal(cloud.size() - 1, direction);
+        }
+
+        for (int32_t i = 0; i < 1500; i++)
+        {
+            cloud.push_back(Vector4(2.0f * unit(generator), 2.0f * unit(generator), 0.0f));
+            cloud.set_normal(cloud.size() - 1, Vector4(0.0f, 0.0f, 1.0f, 0.0f));
+        }
+
+        return cloud;
+    }
+}
+
+TEST_CASE("FpfhEstimation: Pair Features")
+{
+    float features[3];
+
+    SECTION("Parallel normals along the line")
+    {
+        REQUIRE(FpfhEstimation::pair_features(Vector4(0.0f, 0.0f, 0.0f), Vector4(0.0f, 0.0f, 1.0f, 0.0f),
+                                              Vector4(1.0f, 0.0f, 0.0f), Vector4(0.0f, 0.0f, 1.0f, 0.0f), features));
+
+        REQUIRE(std::abs(features[0]) < 1e-6f);
+        REQUIRE(std::abs(features[1]) < 1e-6f);
+        REQUIRE(std::abs(features[2]) < 1e-6f);
+    }
+
+    SECTION("Coincident points are rejected")
+    {
+        REQUIRE_FALSE(FpfhEstimation::pair_features(Vector4(1.0f, 2.0f, 3.0f), Vector4(0.0f, 0.0f, 1.0f, 0.0f),
+                                                    Vector4(1.0f, 2.0f, 3.0f), Vector4(0.0f, 1.0f, 0.0f, 0.0f), features));
+    }
+}
+
+TEST_CASE("FpfhEstimation: Descriptors")
+{
+    PointCloud cloud = sphere_on_plane(4);
+    FpfhEstimation estimation(0.3f, 64);
+    ThreadPool pool(3);
+
+    DescriptorSet descriptors;
+    estimation.compute(cloud, descriptors, pool);
+
+    REQUIRE(descriptors.size() == cloud.size());
+    REQUIRE(descriptors.dimension() == FpfhEstimation::kDimension);
+
+    SECTION("Each angle histogram sums to 100")
+    {
+        for (size_t i = 0; i < descriptors.size(); i += 37)
+        {
+            for (size_t h = 0; h < 3; h++)
+            {
+                float sum = 0.0f;
+
+                for (size_t b = 0; b < FpfhEstimation::kBins; b++)
+                {
+                    sum += descriptors.row(i)[h * FpfhEstimation::kBins + b];
+                }
+
+                REQUIRE(std::abs(sum - 100.0f) < 1e-2f);
+            }
+        }
+    }
+
+    SECTION("Keypoint subsets match the full computation")
+    {
+        KdTree tree(cloud);
+        std::vector<uint32_t> keypoints = {5, 700, 1499, 1500, 2999};
+
+        DescriptorSet subset;
+        estimation.compute(cloud, tree, keypoints, subset, pool);
+
+        for (size_t i = 0; i < keypoints.size(); i++)
+        {
+            const float distance = DescriptorSet::sqr_distance(subset.row(i), descriptors.row(keypoints[i]), FpfhEstimation::kDimension);
+            REQUIRE(distance < 1e-6f);
+        }
+    }
+
+    SECTION("Descriptors are invariant to rigid motion")
+    {
+        const Quaternion rotation = Quaternion::from_axis_angle(Vector4(0.3f, 1.0f, -0.2f, 0.0f).normalized(), 0.8f);
+
+        PointCloud moved = cloud;
+
+        for (size_t i = 0; i < moved.size(); i++)
+        {
+            moved.set_point(i, rotation.rotate(cloud.point(i)) + Vector4(5.0f, -2.0f, 1.0f, 0.0f));
+            moved.set_normal(i, rotation.rotate(cloud.normal(i)));
+        }
+
+        DescriptorSet moved_descriptors;
+        estimation.compute(moved, moved_descriptors, pool);
+
+        size_t close = 0;
+
+        for (size_t i = 0; i < cloud.size(); i++)
+        {
+            if (DescriptorSet::sqr_distance(descriptors.row(i), moved_descriptors.row(i), FpfhEstimation::kDimension) < 25.0f)
+            {
+                close++;
+            }
+        }
+
+        REQUIRE(close > 0.95 * cloud.size());
+    }
+
+    SECTION("Descriptor tree matches brute force")
+    {
+        DescriptorTree tree(descriptors, 8);
+        REQUIRE(tree.size() == descriptors.size());
+
+        std::vector<uint32_t> indices;
+        std::vector<float> sqr_distances;
+
+        for (size_t q = 0; q < descriptors.size(); q += 151)
+        {
+            tree.knn(descriptors.row(q), 5, indices, sqr_distances);
+
+            std::vector<float> expected;
+
+            for (size_t i = 0; i < descriptors.size(); i++)
+            {
+                expected.push_back(DescriptorSet::sqr_distance(descriptors.row(q), descriptors.row(i), FpfhEstimation::kDimension));
+            }
+
+            std::sort(expected.begin(), expected.end());
+
+            REQUIRE(indices.size() == 5);
+
+            for (size_t k = 0; k < 5; k++)
+            {
+                REQUIRE(std::abs(sqr_distances[k] - expected[k]) < 1e-2f);
+            }
+        }
+    }
+}
@@ -0,0 +1,150 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/linalg/matrix4_batch.hpp>
+#include <LRE/linalg/quaternion.hpp>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+    std::vector<Matrix4> poses(const size_t &count, const uint32_t &seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+        std::vector<Matrix4> result(count);
+
+        for (Matrix4 &matrix : result)
+        {
+            const Vector4 axis = Vector4(unit(generator), unit(generator), unit(generator) + 2.0f).normalized();
+            matrix = Quaternion::from_axis_angle(axis, 3.0f * unit(generator)).to_matrix();
+            matrix[3] = 50.0f * unit(generator);
+            matrix[7] = 50.0f * unit(generator);
+            matrix[11] = 5.0f * unit(generator);
+        }
+
+        return result;
+    }
+}
+
+TEST_CASE("Matrix4Batch: Layout")
+{
+    const std::vector<Matrix4> matrices = poses(13, 1);
+    const Matrix4Batch batch(matrices);
+
+    REQUIRE(batch.size() == 13);
+    REQUIRE(batch.stride() == 16);
+    REQUIRE(batch.element(1)[4] == matrices[4][1]);
+    REQUIRE(batch.element(15) - batch.element(0) == 15 * 16);
+
+    const std::vector<Matrix4> round_trip = batch.to_matrices();
+    REQUIRE(round_trip.size() == matrices.size());
+
+    for (size_t i = 0; i < matrices.size(); i++)
+    {
+        for (int32_t e = 0; e < 16; e++)
+        {
+            REQUIRE(round_trip[i][e] == matrices[i][e]);
+        }
+    }
+
+    REQUIRE(Matrix4Batch().empty());
+    REQUIRE(Matrix4Batch().inverted().empty());
+}
+
+TEST_CASE("Matrix4Batch: Products")
+{
+    const std::vector<Matrix4> left = poses(21, 2);
+    const std::vector<Matrix4> right = poses(21, 3);
+    const Matrix4Batch a(left);
+    const Matrix4Batch b(right);
+
+    SECTION("Pairwise products match Matrix4 exactly")
+    {
+        const Matrix4Batch product = a * b;
+
+        for (size_t i = 0; i < left.size(); i++)
+        {
+            const Matrix4 expected = left[i] * right[i];
+            const Matrix4 actual = product.matrix(i);
+
+            for (int32_t e = 0; e < 16; e++)
+            {
+                REQUIRE(actual[e] == expected[e]);
+            }
+        }
+    }
+
+    SECTION("Shared operands")
+    {
+        const Matrix4Batch after = a * right[0];
+        const Matrix4Batch before = a.premultiplied(right[0]);
+
+        for (size_t i = 0; i < left.size(); i++)
+        {
+            const Matrix4 expected_after = left[i] * right[0];
+            const Matrix4 expected_before = right[0] * left[i];
+
+            for (int32_t e = 0; e < 16; e++)
+            {
+                REQUIRE(after.matrix(i)[e] == expected_after[e]);
+                REQUIRE(before.matrix(i)[e] == expected_before[e]);
+            }
+        }
+    }
+
+    SECTION("Mismatched sizes")
+    {
+        REQUIRE_THROWS_AS(a * Matrix4Batch(left.size() - 1), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Matrix4Batch: Inverse and determinant")
+{
+    std::vector<Matrix4> matrices = poses(19, 4);
+
+    // Non-rigid matrices too, so the determinant is not always one.
+    for (size_t i = 0; i < matrices.size(); i += 3)
+    {
+        matrices[i] = matrices[i] * 2.0f;
+    }
+
+    Matrix4 singular;
+    singular[0] = 1.0f;
+    singular[5] = 2.0f;
+    matrices[10] = singular;
+
+    const Matrix4Batch batch(matrices);
+    const std::vector<float> determinants = batch.determinants();
+    const Matrix4Batch inverse = batch.inverted();
+
+    REQUIRE(determinants.size() == matrices.size());
+
+    for (size_t i = 0; i < matrices.size(); i++)
+    {
+        const float expected = matrices[i].determinant();
+        REQUIRE(std::abs(determinants[i] - expected) <= 1e-4f * std::max(1.0f, std::abs(expected)));
+
+        if (i == 10)
+        {
+            REQUIRE(determinants[i] == 0.0f);
+
+            for (int32_t e = 0; e < 16; e++)
+            {
+                REQUIRE(inverse.matrix(i)[e] == singular[e]);
+            }
+
+            continue;
+        }
+
+        const Matrix4 reference = matrices[i].inverted();
+        const Matrix4 identity = matrices[i] * inverse.matrix(i);
+
+        for (int32_t e = 0; e < 16; e++)
+        {
+            REQUIRE(std::abs(inverse.matrix(i)[e] - reference[e]) < 1e-3f);
+            REQUIRE(std::abs(identity[e] - (e % 5 == 0 ? 1.0f : 0.0f)) < 1e-4f);
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/linalg/matrix4d.hpp>
+#include <LRE/linalg/quaternion.hpp>
+#include <cstdint>
+
+namespace
+{
+    Matrix4d pose(const float &angle, const Vector4d &translation)
+    {
+        const Quaternion rotation = Quaternion::from_axis_angle(Vector4(0.3f, -0.5f, 0.8f).normalized(), angle);
+        Matrix4d result(rotation.to_matrix());
+        result[3] = translation[0];
+        result[7] = translation[1];
+        result[11] = translation[2];
+        return result;
+    }
+}
+
+TEST_CASE("Matrix4d: Products")
+{
+    SECTION("Identity is neutral")
+    {
+        Matrix4d identity;
+        identity.identity();
+
+        Matrix4d value;
+
+        for (int32_t i = 0; i < 16; i++)
+        {
+            value[i] = static_cast<double>(i) - 7.5;
+        }
+
+        const Matrix4d left = identity * value;
+        const Matrix4d right = value * identity;
+
+        for (int32_t i = 0; i < 16; i++)
+        {
+            REQUIRE(left[i] == value[i]);
+            REQUIRE(right[i] == value[i]);
+        }
+    }
+
+    SECTION("Matches the float product")
+    {
+        Matrix4 a;
+        Matrix4 b;
+
+        for (int32_t i = 0; i < 16; i++)
+        {
+            a[i] = static_cast<float>(i % 5) - 2.0f;
+            b[i] = static_cast<float>((i * 7) % 11) * 0.5f;
+        }
+
+        const Matrix4 single = a * b;
+        const Matrix4d wide = Matrix4d(a) * Matrix4d(b);
+
+        for (int32_t i = 0; i < 16; i++)
+        {
+            REQUIRE(wide[i] == static_cast<double>(single[i]));
+        }
+
+        const Matrix4 narrowed = wide.to_float();
+        REQUIRE(narrowed[5] == single[5]);
+    }
+
+    SECTION("Transforms georeferenced points")
+    {
+        const Matrix4d transform = Matrix4d::translation(Vector4d(4123000.0, 512000.0, 300.0));
+        const Vector4d point = transform * Vector4d(0.125, -0.5, 1.0, 1.0);
+
+        REQUIRE(point == Vector4d(4123000.125, 511999.5, 301.0, 1.0));
+    }
+}
+
+TEST_CASE("Matrix4d: Inverse")
+{
+    SECTION("Inverse of a georeferenced pose")
+    {
+        const Matrix4d value = pose(0.8f, Vector4d(4123456.5, 512345.25, 301.0));
+        const Matrix4d product = value * value.inverted();
+
+        REQUIRE(std::abs(value.determinant() - 1.0) < 1e-6);
+
+        for (int32_t i = 0; i < 16; i++)
+        {
+            REQUIRE(std::abs(product[i] - (i % 5 == 0 ? 1.0 : 0.0)) < 1e-8);
+        }
+    }
+
+    SECTION("Singular matrices are returned unchanged")
+    {
+        Matrix4d value;
+        value[0] = 1.0;
+        value[5] = 2.0;
+
+        const Matrix4d inverse = value.inverted();
+        REQUIRE(inverse[0] == 1.0);
+        REQUIRE(inverse[5] == 2.0);
+    }
+
+    SECTION("Transpose")
+    {
+        Matrix4d value;
+        value[1] = 3.0;
+        value[14] = -2.0;
+
+        const Matrix4d transposed = value.transposed();
+        REQUIRE(transposed[4] == 3.0);
+        REQUIRE(transposed[11] == -2.0);
+    }
+}
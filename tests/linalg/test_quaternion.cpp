@@ -0,0 +1,161 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/linalg/quaternion.hpp>
+#include <cstdint>
+#include <limits>
+
+TEST_CASE("Quaternion: Constructors")
+{
+    SECTION("Default Constructor is identity")
+    {
+        Quaternion q;
+        REQUIRE(q.x() == 0.0f);
+        REQUIRE(q.y() == 0.0f);
+        REQUIRE(q.z() == 0.0f);
+        REQUIRE(q.w() == 1.0f);
+    }
+
+    SECTION("Copy Constructor")
+    {
+        Quaternion original(0.1f, 0.2f, 0.3f, 0.4f);
+        Quaternion copy(original);
+        for (int32_t i = 0; i < 4; i++)
+        {
+            REQUIRE(copy[i] == original[i]);
+        }
+    }
+}
+
+TEST_CASE("Quaternion: Matrix Conversion")
+{
+    const float half_angle = 0.25f * 3.14159265f;
+    Quaternion q(0.0f, 0.0f, std::sin(half_angle), std::cos(half_angle));
+
+    Matrix4 rotation = q.to_matrix();
+
+    SECTION("Rotation about z by 90 degrees")
+    {
+        REQUIRE(std::abs(rotation[0]) < 1e-6f);
+        REQUIRE(std::abs(rotation[1] + 1.0f) < 1e-6f);
+        REQUIRE(std::abs(rotation[4] - 1.0f) < 1e-6f);
+        REQUIRE(std::abs(rotation[10] - 1.0f) < 1e-6f);
+        REQUIRE(rotation[15] == 1.0f);
+    }
+
+    SECTION("Round trip through matrix")
+    {
+        Quaternion back = Quaternion::from_matrix(rotation);
+        REQUIRE(std::abs(std::abs(Quaternion::dot(back, q)) - 1.0f) < 1e-6f);
+    }
+
+    SECTION("Rotate matches matrix")
+    {
+        Vector4 rotated = q.rotate(Vector4(1.0f, 0.0f, 0.0f, 1.0f));
+        REQUIRE(std::abs(rotated.x()) < 1e-6f);
+        REQUIRE(std::abs(rotated.y() - 1.0f) < 1e-6f);
+        REQUIRE(rotated.w() == 1.0f);
+    }
+
+    SECTION("Rotate passes w through")
+    {
+        const Quaternion general = Quaternion(0.2f, -0.4f, 0.5f, 0.7f).normalized();
+
+        Vector4 rotated = general.rotate(Vector4(1.0f, 2.0f, 3.0f, std::numeric_limits<float>::infinity()));
+        REQUIRE(std::isinf(rotated.w()));
+        REQUIRE(std::isfinite(rotated.x()));
+
+        rotated = general.rotate(Vector4(1.0f, 2.0f, 3.0f, std::numeric_limits<float>::quiet_NaN()));
+        REQUIRE(std::isnan(rotated.w()));
+        REQUIRE(std::isfinite(rotated.z()));
+    }
+
+    SECTION("General rotation matches the expanded formula exactly")
+    {
+        const float x = 0.2f, y = -0.4f, z = 0.5f, w = 0.7f;
+        const Matrix4 matrix = Quaternion(x, y, z, w).to_matrix();
+
+        const float expected[16] = {1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y - z * w), 2.0f * (x * z + y * w), 0.0f,
+                                    2.0f * (x * y + z * w), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z - x * w), 0.0f,
+                                    2.0f * (x * z - y * w), 2.0f * (y * z + x * w), 1.0f - 2.0f * (x * x + y * y), 0.0f,
+                                    0.0f, 0.0f, 0.0f, 1.0f};
+
+        for (int32_t i = 0; i < 16; i++)
+        {
+            REQUIRE(matrix[i] == expected[i]);
+        }
+    }
+}
+
+TEST_CASE("Quaternion: Slerp")
+{
+    Quaternion a;
+    Quaternion b(0.0f, 0.0f, 1.0f, 0.0f);
+
+    SECTION("Endpoints")
+    {
+        Quaternion start = Quaternion::slerp(a, b, 0.0f);
+        Quaternion end = Quaternion::slerp(a, b, 1.0f);
+        REQUIRE(std::abs(Quaternion::dot(start, a) - 1.0f) < 1e-6f);
+        REQUIRE(std::abs(Quaternion::dot(end, b) - 1.0f) < 1e-6f);
+    }
+
+    SECTION("Halfway rotates by half the angle")
+    {
+        Quaternion half = Quaternion::slerp(a, b, 0.5f);
+        REQUIRE(std::abs(half.z() - std::sqrt(0.5f)) < 1e-6f);
+        REQUIRE(std::abs(half.w() - std::sqrt(0.5f)) < 1e-6f);
+    }
+
+    SECTION("Parameter is clamped")
+    {
+        Quaternion over = Quaternion::slerp(a, b, 2.0f);
+        REQUIRE(std::abs(Quaternion::dot(over, b) - 1.0f) < 1e-6f);
+    }
+}
+
+TEST_CASE("Quaternion: Composition and Inverse")
+{
+    Quaternion a = Quaternion::from_axis_angle(Vector4(0.0f, 0.0f, 1.0f), 0.7f);
+    Quaternion b = Quaternion::from_axis_angle(Vector4(1.0f, 1.0f, 0.0f), -0.4f);
+
+    SECTION("Product matches matrix product")
+    {
+        Matrix4 composed = (a * b).to_matrix();
+        Matrix4 expected = a.to_matrix() * b.to_matrix();
+
+        for (int32_t i = 0; i < 16; i++)
+        {
+            REQUIRE(std::abs(composed[i] - expected[i]) < 1e-5f);
+        }
+    }
+
+    SECTION("Inverse cancels rotation")
+    {
+        Quaternion identity = a * a.inverted();
+        REQUIRE(std::abs(identity.w() - 1.0f) < 1e-6f);
+        REQUIRE(std::abs(identity.x()) < 1e-6f);
+        REQUIRE(std::abs(identity.y()) < 1e-6f);
+        REQUIRE(std::abs(identity.z()) < 1e-6f);
+    }
+
+    SECTION("Batched rotation matches single rotation")
+    {
+        float x[11], y[11], z[11], out_x[11], out_y[11], out_z[11];
+
+        for (int32_t i = 0; i < 11; i++)
+        {
+            x[i] = static_cast<float>(i);
+            y[i] = 1.0f - static_cast<float>(i);
+            z[i] = 0.5f * static_cast<float>(i);
+        }
+
+        b.rotate_points(x, y, z, out_x, out_y, out_z, 11);
+
+        for (int32_t i = 0; i < 11; i++)
+        {
+            Vector4 expected = b.rotate(Vector4(x[i], y[i], z[i]));
+            REQUIRE(std::abs(out_x[i] - expected.x()) < 1e-5f);
+            REQUIRE(std::abs(out_y[i] - expected.y()) < 1e-5f);
+            REQUIRE(std::abs(out_z[i] - expected.z()) < 1e-5f);
+        }
+    }
+}
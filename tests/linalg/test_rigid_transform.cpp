@@ -0,0 +1,87 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/linalg/rigid_transform.hpp>
+#include <cstdint>
+
+TEST_CASE("RigidTransform: Matrix Conversion")
+{
+    RigidTransform transform(Quaternion::from_axis_angle(Vector4(0.0f, 1.0f, 0.0f), 0.3f), Vector4(1.0f, 2.0f, 3.0f));
+
+    SECTION("Round trip through matrix")
+    {
+        RigidTransform back(transform.to_matrix());
+        Matrix4 a = transform.to_matrix();
+        Matrix4 b = back.to_matrix();
+
+        for (int32_t i = 0; i < 16; i++)
+        {
+            REQUIRE(std::abs(a[i] - b[i]) < 1e-6f);
+        }
+    }
+
+    SECTION("Translation occupies the last column")
+    {
+        Matrix4 matrix = transform.to_matrix();
+        REQUIRE(matrix[3] == 1.0f);
+        REQUIRE(matrix[7] == 2.0f);
+        REQUIRE(matrix[11] == 3.0f);
+        REQUIRE(matrix[15] == 1.0f);
+    }
+}
+
+TEST_CASE("RigidTransform: Composition")
+{
+    RigidTransform a(Quaternion::from_axis_angle(Vector4(0.0f, 0.0f, 1.0f), 0.5f), Vector4(1.0f, 0.0f, 0.0f));
+    RigidTransform b(Quaternion::from_axis_angle(Vector4(1.0f, 0.0f, 0.0f), -1.2f), Vector4(0.0f, 2.0f, -1.0f));
+    Vector4 point(0.3f, -0.7f, 2.0f, 1.0f);
+
+    SECTION("Compose matches matrix product")
+    {
+        Matrix4 composed = (a * b).to_matrix();
+        Matrix4 expected = a.to_matrix() * b.to_matrix();
+
+        for (int32_t i = 0; i < 16; i++)
+        {
+            REQUIRE(std::abs(composed[i] - expected[i]) < 1e-5f);
+        }
+    }
+
+    SECTION("Inverse undoes the transform")
+    {
+        Vector4 restored = a.inverted().transform(a.transform(point));
+
+        for (int32_t i = 0; i < 3; i++)
+        {
+            REQUIRE(std::abs(restored[i] - point[i]) < 1e-5f);
+        }
+    }
+
+    SECTION("Batched transform matches single transform")
+    {
+        float x[13], y[13], z[13];
+
+        for (int32_t i = 0; i < 13; i++)
+        {
+            x[i] = 0.1f * static_cast<float>(i);
+            y[i] = -0.2f * static_cast<float>(i);
+            z[i] = 1.0f;
+        }
+
+        b.transform_points(x, y, z, x, y, z, 13);
+
+        for (int32_t i = 0; i < 13; i++)
+        {
+            Vector4 expected = b.transform(Vector4(0.1f * static_cast<float>(i), -0.2f * static_cast<float>(i), 1.0f));
+            REQUIRE(std::abs(x[i] - expected.x()) < 1e-5f);
+            REQUIRE(std::abs(y[i] - expected.y()) < 1e-5f);
+            REQUIRE(std::abs(z[i] - expected.z()) < 1e-5f);
+        }
+    }
+
+    SECTION("Interpolation endpoints")
+    {
+        RigidTransform middle = RigidTransform::interpolate(a, b, 0.5f);
+        REQUIRE(std::abs(middle.translation().x() - 0.5f) < 1e-6f);
+        REQUIRE(std::abs(middle.translation().y() - 1.0f) < 1e-6f);
+        REQUIRE(std::abs(middle.rotation().magnitude() - 1.0f) < 1e-6f);
+    }
+}
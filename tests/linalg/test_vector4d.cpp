@@ -0,0 +1,77 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/linalg/vector4d.hpp>
+#include <cstdint>
+
+TEST_CASE("Vector4d: Arithmetic")
+{
+    const Vector4d a(1.5, -2.0, 4.0, 1.0);
+    const Vector4d b(0.5, 3.0, -1.0, 2.0);
+
+    SECTION("Element-wise operators")
+    {
+        REQUIRE(a + b == Vector4d(2.0, 1.0, 3.0, 3.0));
+        REQUIRE(a - b == Vector4d(1.0, -5.0, 5.0, -1.0));
+        REQUIRE(a * b == Vector4d(0.75, -6.0, -4.0, 2.0));
+        REQUIRE(a * 2.0 == Vector4d(3.0, -4.0, 8.0, 2.0));
+        REQUIRE(a / 4.0 == Vector4d(0.375, -0.5, 1.0, 0.25));
+    }
+
+    SECTION("Division is exact")
+    {
+        const Vector4d value(1.0, 2.0, 7.0, 10.0);
+        const Vector4d divided = value / 3.0;
+
+        for (int32_t i = 0; i < 4; i++)
+        {
+            REQUIRE(divided[i] == value[i] / 3.0);
+        }
+    }
+
+    SECTION("Dot product and magnitude")
+    {
+        REQUIRE(Vector4d::dot(a, b) == -7.25);
+        REQUIRE(Vector4d(3.0, 4.0, 0.0).magnitude() == 5.0);
+        REQUIRE(std::abs(Vector4d(2.0, -3.0, 6.0).normalized().magnitude() - 1.0) < 1e-15);
+        REQUIRE(Vector4d::distance(Vector4d(1.0, 1.0, 1.0), Vector4d(1.0, 4.0, 5.0)) == 5.0);
+    }
+
+    SECTION("Min, max and lerp")
+    {
+        REQUIRE(Vector4d::min(a, b) == Vector4d(0.5, -2.0, -1.0, 1.0));
+        REQUIRE(Vector4d::max(a, b) == Vector4d(1.5, 3.0, 4.0, 2.0));
+        REQUIRE(Vector4d::lerp(a, b, 0.5) == Vector4d(1.0, 0.5, 1.5, 1.5));
+        REQUIRE(Vector4d::lerp(a, b, 2.0) == b);
+    }
+}
+
+TEST_CASE("Vector4d: Float conversion")
+{
+    SECTION("Widening is exact")
+    {
+        const Vector4 single(0.1f, -3.25f, 1e7f, 1.0f);
+        const Vector4d wide(single);
+
+        for (int32_t i = 0; i < 4; i++)
+        {
+            REQUIRE(wide[i] == static_cast<double>(single[i]));
+        }
+    }
+
+    SECTION("Narrowing rounds to nearest")
+    {
+        const Vector4d wide(500000.123456789, -0.1, 3.0, 0.0);
+        const Vector4 single = wide.to_float();
+
+        REQUIRE(single[0] == static_cast<float>(500000.123456789));
+        REQUIRE(single[1] == -0.1f);
+        REQUIRE(single[2] == 3.0f);
+    }
+
+    SECTION("Georeferenced coordinates keep sub-millimetre precision")
+    {
+        const Vector4d a(4123456.789, 512345.678, 301.25);
+        const Vector4d b(4123456.790, 512345.679, 301.25);
+
+        REQUIRE(std::abs(Vector4d::distance(a, b) - std::sqrt(2.0) * 1e-3) < 1e-7);
+    }
+}
@@ -0,0 +1,156 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/mesh/quadric_decimation.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace
+{
+    float height(const float &x, const float &y)
+    {
+        return 0.5f * std::sin(0.3f * x) * std::cos(0.2f * y);
+    }
+
+    TriangleMesh grid_mesh(const uint32_t &size, const bool &flat)
+    {
+        TriangleMesh mesh;
+
+        for (uint32_t j = 0; j <= size; j++)
+        {
+            for (uint32_t i = 0; i <= size; i++)
+            {
+                const float x = static_cast<float>(i) * 0.25f;
+                const float y = static_cast<float>(j) * 0.25f;
+                mesh.add_vertex(Vector4(x, y, flat ? 0.0f : height(x, y)));
+            }
+        }
+
+        for (uint32_t j = 0; j < size; j++)
+        {
+            for (uint32_t i = 0; i < size; i++)
+            {
+                const uint32_t a = j * (size + 1) + i;
+                mesh.add_triangle(a, a + 1, a + size + 2);
+                mesh.add_triangle(a, a + size + 2, a + size + 1);
+            }
+        }
+
+        return mesh;
+    }
+
+    void check_manifold(const TriangleMesh &mesh)
+    {
+        std::map<std::pair<uint32_t, uint32_t>, size_t> edges;
+
+        for (size_t t = 0; t < mesh.triangle_count(); t++)
+        {
+            const uint32_t *corners = mesh.triangle(t);
+
+            REQUIRE(corners[0] != corners[1]);
+            REQUIRE(corners[1] != corners[2]);
+            REQUIRE(corners[0] != corners[2]);
+            REQUIRE(mesh.normal(t)[2] > 0.0f);
+
+            for (int32_t c = 0; c < 3; c++)
+            {
+                const uint32_t a = corners[c];
+                const uint32_t b = corners[(c + 1) % 3];
+                edges[std::make_pair(std::min(a, b), std::max(a, b))]++;
+            }
+        }
+
+        for (const auto &edge : edges)
+        {
+            REQUIRE(edge.second <= 2);
+        }
+    }
+
+    float total_area(const TriangleMesh &mesh)
+    {
+        float area = 0.0f;
+
+        for (size_t t = 0; t < mesh.triangle_count(); t++)
+        {
+            area += mesh.area(t);
+        }
+
+        return area;
+    }
+}
+
+TEST_CASE("QuadricDecimation: Simplification")
+{
+    SECTION("Flat grids collapse to the target without leaving the plane")
+    {
+        const TriangleMesh mesh = grid_mesh(40, true);
+        const TriangleMesh simplified = QuadricDecimation(200).apply(mesh);
+
+        REQUIRE(simplified.triangle_count() <= 200);
+        REQUIRE(simplified.triangle_count() >= 180);
+        REQUIRE(std::abs(total_area(simplified) - total_area(mesh)) < 1e-2f);
+
+        for (size_t v = 0; v < simplified.vertex_count(); v++)
+        {
+            REQUIRE(std::abs(simplified.z()[v]) < 1e-5f);
+        }
+
+        check_manifold(simplified);
+    }
+
+    SECTION("Curved surfaces stay close to the original")
+    {
+        const TriangleMesh mesh = grid_mesh(60, false);
+        const TriangleMesh simplified = QuadricDecimation(1200).apply(mesh);
+
+        REQUIRE(simplified.triangle_count() <= 1200);
+        REQUIRE(simplified.triangle_count() >= 1100);
+
+        for (size_t v = 0; v < simplified.vertex_count(); v++)
+        {
+            REQUIRE(std::abs(simplified.z()[v] - height(simplified.x()[v], simplified.y()[v])) < 0.02f);
+        }
+
+        check_manifold(simplified);
+    }
+
+    SECTION("Small partitions lock their borders and still reach the target")
+    {
+        ThreadPool pool(4);
+        const TriangleMesh mesh = grid_mesh(60, false);
+        const QuadricDecimation decimation(800, std::numeric_limits<float>::max(), 256);
+
+        const TriangleMesh simplified = decimation.apply(mesh, pool);
+
+        REQUIRE(simplified.triangle_count() <= 800);
+        REQUIRE(simplified.triangle_count() >= 700);
+        REQUIRE(std::abs(total_area(simplified) - total_area(mesh)) < 0.05f * total_area(mesh));
+
+        check_manifold(simplified);
+    }
+
+    SECTION("The error bound stops collapses early")
+    {
+        const TriangleMesh mesh = grid_mesh(30, false);
+        const TriangleMesh simplified = QuadricDecimation(0, 1e-9f, QuadricDecimation::kPartitionTriangles).apply(mesh);
+
+        REQUIRE(simplified.triangle_count() > 100);
+        REQUIRE(simplified.triangle_count() < mesh.triangle_count());
+        check_manifold(simplified);
+    }
+
+    SECTION("Meshes already below the target are returned unchanged")
+    {
+        const TriangleMesh mesh = grid_mesh(4, false);
+        const TriangleMesh simplified = QuadricDecimation(100).apply(mesh);
+
+        REQUIRE(simplified.triangle_count() == mesh.triangle_count());
+        REQUIRE(simplified.indices() == mesh.indices());
+    }
+
+    SECTION("Partitions must not be empty")
+    {
+        REQUIRE_THROWS_AS(QuadricDecimation(10, 1.0f, 0), std::invalid_argument);
+    }
+}
@@ -0,0 +1,200 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/outofcore/index_cache.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace
+{
+    std::string scratch_file(const std::string &name)
+    {
+        std::filesystem::path directory = std::filesystem::temp_directory_path() / ("lre_" + name);
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        return (directory / "index.lre").string();
+    }
+
+    PointCloud scattered(const size_t &count, const uint32_t &seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> distribution(-20.0f, 20.0f);
+
+        PointCloud cloud;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            cloud.push_back(Vector4(distribution(generator), distribution(generator), distribution(generator)));
+        }
+
+        return cloud;
+    }
+
+    void corrupt(const std::string &path, const std::streamoff &offset)
+    {
+        std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+        stream.seekg(offset);
+        char value = 0;
+        stream.read(&value, 1);
+        value = static_cast<char>(value ^ 0x5a);
+        stream.seekp(offset);
+        stream.write(&value, 1);
+    }
+}
+
+TEST_CASE("IndexCache: KdTree Round Trip")
+{
+    const std::string path = scratch_file("index_cache_kd");
+    const PointCloud cloud = scattered(5000, 3);
+    const KdTree built(cloud, 8);
+
+    IndexCache::write(path, built, IndexCache::fingerprint(cloud));
+
+    const KdTree mapped = IndexCache::load_kd_tree(path, IndexCache::fingerprint(cloud), CacheVerification::Full);
+
+    REQUIRE(mapped.size() == built.size());
+    REQUIRE(mapped.leaf_size() == 8);
+    REQUIRE(mapped.nodes().size() == built.nodes().size());
+
+    std::vector<uint32_t> expected_indices, mapped_indices;
+    std::vector<float> expected_distances, mapped_distances;
+
+    for (size_t i = 0; i < cloud.size(); i += 97)
+    {
+        const Vector4 query = cloud.point(i) + Vector4(0.3f, -0.2f, 0.1f);
+
+        built.knn(query, 6, expected_indices, expected_distances);
+        mapped.knn(query, 6, mapped_indices, mapped_distances);
+        REQUIRE(mapped_indices == expected_indices);
+        REQUIRE(mapped_distances == expected_distances);
+
+        built.radius(query, 2.0f, expected_indices, expected_distances);
+        mapped.radius(query, 2.0f, mapped_indices, mapped_distances);
+        REQUIRE(mapped_indices == expected_indices);
+    }
+}
+
+TEST_CASE("IndexCache: Octree Round Trip")
+{
+    const std::string path = scratch_file("index_cache_octree");
+    const PointCloud cloud = scattered(4000, 5);
+    const Octree built(cloud, 0.5f);
+
+    IndexCache::write(path, built, IndexCache::fingerprint(cloud));
+
+    const Octree mapped = IndexCache::load_octree(path, IndexCache::fingerprint(cloud), CacheVerification::Full);
+
+    REQUIRE(mapped.size() == built.size());
+    REQUIRE(mapped.resolution() == built.resolution());
+    REQUIRE(mapped.leaf_count() == built.leaf_count());
+
+    for (size_t i = 0; i < cloud.size(); i += 53)
+    {
+        REQUIRE(mapped.find_leaf(cloud.point(i)) == built.find_leaf(cloud.point(i)));
+    }
+
+    for (size_t i = 0; i < built.size(); i++)
+    {
+        REQUIRE(mapped.indices()[i] == built.indices()[i]);
+        REQUIRE(mapped.x()[i] == built.x()[i]);
+    }
+}
+
+TEST_CASE("IndexCache: Validation")
+{
+    const std::string path = scratch_file("index_cache_validation");
+    const PointCloud cloud = scattered(3000, 7);
+    const uint64_t fingerprint = IndexCache::fingerprint(cloud);
+
+    IndexCache::write(path, KdTree(cloud, 16), fingerprint);
+
+    SECTION("Other cloud")
+    {
+        REQUIRE_THROWS_AS(IndexCache::load_kd_tree(path, IndexCache::fingerprint(scattered(3000, 8)), CacheVerification::Header),
+                          std::runtime_error);
+    }
+
+    SECTION("Other index kind")
+    {
+        REQUIRE_THROWS_AS(IndexCache::load_octree(path, fingerprint, CacheVerification::Header), std::runtime_error);
+    }
+
+    SECTION("Missing file")
+    {
+        REQUIRE_THROWS_AS(IndexCache::load_kd_tree(path + ".missing", fingerprint, CacheVerification::Header), std::runtime_error);
+    }
+
+    SECTION("Bad magic")
+    {
+        corrupt(path, 0);
+        REQUIRE_THROWS_AS(IndexCache::load_kd_tree(path, fingerprint, CacheVerification::Header), std::runtime_error);
+    }
+
+    SECTION("Bad version")
+    {
+        corrupt(path, 4);
+        REQUIRE_THROWS_AS(IndexCache::load_kd_tree(path, fingerprint, CacheVerification::Header), std::runtime_error);
+    }
+
+    SECTION("Corrupt header")
+    {
+        corrupt(path, 16);
+        REQUIRE_THROWS_AS(IndexCache::load_kd_tree(path, fingerprint, CacheVerification::Header), std::runtime_error);
+    }
+
+    SECTION("Corrupt payload")
+    {
+        // Flips a bit in the root split plane, which only the payload checksum can detect.
+        corrupt(path, static_cast<std::streamoff>(IndexCache::kSectionAlignment * 2 + 17));
+        REQUIRE_NOTHROW(IndexCache::load_kd_tree(path, fingerprint, CacheVerification::Header));
+        REQUIRE_THROWS_AS(IndexCache::load_kd_tree(path, fingerprint, CacheVerification::Full), std::runtime_error);
+    }
+}
+
+TEST_CASE("IndexCache: Fallback Rebuild")
+{
+    const std::string path = scratch_file("index_cache_fallback");
+    const PointCloud cloud = scattered(2000, 9);
+
+    SECTION("Missing cache is built and written")
+    {
+        const KdTree tree = IndexCache::kd_tree(path, cloud, 16);
+
+        REQUIRE(tree.size() == cloud.size());
+        REQUIRE(std::filesystem::exists(path));
+        REQUIRE_FALSE(std::filesystem::exists(path + ".tmp"));
+        REQUIRE_NOTHROW(IndexCache::load_kd_tree(path, IndexCache::fingerprint(cloud), CacheVerification::Full));
+    }
+
+    SECTION("Corrupt cache is replaced")
+    {
+        IndexCache::write(path, Octree(cloud, 1.0f), IndexCache::fingerprint(cloud));
+        corrupt(path, 40);
+
+        const Octree tree = IndexCache::octree(path, cloud, 1.0f, CacheVerification::Full);
+
+        REQUIRE(tree.size() == cloud.size());
+        REQUIRE_NOTHROW(IndexCache::load_octree(path, IndexCache::fingerprint(cloud), CacheVerification::Full));
+    }
+
+    SECTION("Changed cloud or parameters rebuild")
+    {
+        IndexCache::kd_tree(path, cloud, 16);
+
+        const PointCloud other = scattered(2500, 10);
+        const KdTree tree = IndexCache::kd_tree(path, other, 16);
+        REQUIRE(tree.size() == other.size());
+
+        const KdTree resized = IndexCache::kd_tree(path, other, 4);
+        REQUIRE(resized.leaf_size() == 4);
+        REQUIRE(IndexCache::load_kd_tree(path, IndexCache::fingerprint(other), CacheVerification::Full).leaf_size() == 4);
+    }
+
+    SECTION("Empty cloud")
+    {
+        const KdTree tree = IndexCache::kd_tree(path, PointCloud(), 16);
+
+        REQUIRE(tree.empty());
+        REQUIRE(IndexCache::load_kd_tree(path, IndexCache::fingerprint(PointCloud()), CacheVerification::Full).empty());
+    }
+}
@@ -0,0 +1,267 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/outofcore/tile_processor.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+
+namespace
+{
+    std::string scratch_directory(const std::string &name)
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / ("lre_" + name);
+        std::filesystem::remove_all(path);
+        return path.string();
+    }
+
+    PointCloud terrain(const size_t &count)
+    {
+        std::mt19937 generator(11);
+        std::uniform_real_distribution<float> distribution(0.0f, 40.0f);
+
+        PointCloud cloud;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const float x = distribution(generator);
+            const float y = distribution(generator);
+            cloud.push_back(Vector4(x, y, 0.1f * x));
+        }
+
+        return cloud;
+    }
+}
+
+TEST_CASE("TileStore: Round Trip")
+{
+    const std::string directory = scratch_directory("round_trip");
+    PointCloud cloud = terrain(20000);
+
+    {
+        // A 500-point staging budget across all 16 tiles forces repeated spills.
+        const size_t budget = 500 * 3 * sizeof(float);
+        TileStoreWriter writer(directory, 10.0f, budget);
+
+        for (size_t begin = 0; begin < cloud.size(); begin += 1000)
+        {
+            PointCloud chunk;
+
+            for (size_t i = begin; i < std::min(cloud.size(), begin + 1000); i++)
+            {
+                chunk.push_back(cloud.point(i));
+            }
+
+            writer.append(chunk);
+            REQUIRE(writer.staged_bytes() <= budget);
+        }
+    }
+
+    TileStore store(directory);
+
+    REQUIRE(store.tile_count() == 16);
+    REQUIRE(store.point_count() == cloud.size());
+    REQUIRE(store.tile_size() == 10.0f);
+
+    SECTION("Tiles contain only their own points")
+    {
+        TileCache cache(store, 1 << 30);
+
+        for (size_t t = 0; t < store.tile_count(); t++)
+        {
+            std::shared_ptr<const TileView> view = cache.acquire(t);
+            const TileInfo &info = store.tile(t);
+
+            REQUIRE(view->size() == info.count);
+
+            for (size_t i = 0; i < view->size(); i++)
+            {
+                REQUIRE(static_cast<int32_t>(std::floor(view->x()[i] / 10.0f)) == info.x);
+                REQUIRE(static_cast<int32_t>(std::floor(view->y()[i] / 10.0f)) == info.y);
+            }
+        }
+    }
+
+    SECTION("Cache respects the memory budget")
+    {
+        TileCache cache(store, 2 * store.tile_bytes(0));
+
+        for (size_t t = 0; t < store.tile_count(); t++)
+        {
+            cache.acquire(t);
+            REQUIRE(cache.resident_bytes() <= 3 * store.tile_bytes(0));
+        }
+
+        cache.acquire(store.tile_count() - 1);
+        REQUIRE(cache.hits() == 1);
+        REQUIRE(cache.misses() == store.tile_count());
+    }
+
+    SECTION("Held views count against the budget")
+    {
+        TileCache cache(store, 2 * store.tile_bytes(0));
+        std::vector<std::shared_ptr<const TileView>> held;
+        size_t total = 0;
+
+        for (size_t t = 0; t < store.tile_count(); t++)
+        {
+            held.push_back(cache.acquire(t));
+            total += store.tile_bytes(t);
+            REQUIRE(cache.resident_bytes() == total);
+        }
+
+        held.clear();
+        REQUIRE(cache.resident_bytes() == store.tile_bytes(store.tile_count() - 1));
+    }
+
+    SECTION("Prefetches never evict requested tiles")
+    {
+        TileCache cache(store, store.tile_bytes(0) + store.tile_bytes(1) + store.tile_bytes(2));
+
+        cache.acquire(0);
+        cache.acquire(1);
+
+        for (size_t t = 2; t < store.tile_count(); t++)
+        {
+            cache.prefetch(t);
+        }
+
+        cache.acquire(0);
+        cache.acquire(1);
+        cache.acquire(2);
+        REQUIRE(cache.hits() == 3);
+        REQUIRE(cache.misses() == 2);
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("TileStore: Floating Origin")
+{
+    const std::string directory = scratch_directory("floating_origin");
+    const Vector4d origin(4123000.0, 512000.0, 300.0);
+
+    {
+        TileStoreWriter writer(directory, 5.0f);
+
+        PointCloud first;
+        first.set_origin(origin);
+        first.push_back(Vector4(1.0f, 1.0f, 0.0f));
+        writer.append(first);
+
+        PointCloud second;
+        second.set_origin(Vector4d(origin[0] + 10.0, origin[1], origin[2]));
+        second.push_back(Vector4(1.0f, 1.0f, 0.0f));
+        writer.append(second);
+    }
+
+    TileStore store(directory);
+    TileCache cache(store, 1 << 20);
+    TileProcessor processor(store, cache, 0.0f);
+
+    REQUIRE(store.origin() == origin);
+    REQUIRE(store.tile_count() == 2);
+
+    const int64_t shifted = store.find(2, 0);
+    REQUIRE(shifted >= 0);
+
+    size_t core_count = 0;
+    const PointCloud local = processor.gather(static_cast<size_t>(shifted), 0.0f, core_count);
+
+    REQUIRE(core_count == 1);
+    REQUIRE(local.origin() == origin);
+    REQUIRE(local.world_point(0) == Vector4d(origin[0] + 11.0, origin[1] + 1.0, origin[2], 1.0));
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("TileStore: Invalid Input")
+{
+    const std::string directory = scratch_directory("invalid_input");
+
+    {
+        TileStoreWriter writer(directory, 5.0f);
+
+        PointCloud cloud;
+        cloud.push_back(Vector4(1.0f, 1.0f, 0.0f));
+        cloud.push_back(Vector4(std::numeric_limits<float>::quiet_NaN(), 1.0f, 0.0f));
+        cloud.push_back(Vector4(1.0f, std::numeric_limits<float>::infinity(), 0.0f));
+        cloud.push_back(Vector4(1.0f, 1.0f, std::numeric_limits<float>::quiet_NaN()));
+        cloud.push_back(Vector4(1e30f, 1.0f, 0.0f));
+        cloud.push_back(Vector4(6.0f, 1.0f, 0.0f));
+        writer.append(cloud);
+
+        REQUIRE(writer.skipped_points() == 4);
+    }
+
+    REQUIRE(TileStore(directory).point_count() == 2);
+
+    SECTION("A tile count beyond the index file is rejected")
+    {
+        // The count follows magic, version, tile size, flags and the origin.
+        std::fstream index(directory + "/tiles.idx", std::ios::binary | std::ios::in | std::ios::out);
+        const uint64_t count = uint64_t(1) << 40;
+        index.seekp(40);
+        index.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        index.close();
+
+        REQUIRE_THROWS_AS(TileStore(directory), std::runtime_error);
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("TileProcessor: Halo Processing")
+{
+    const std::string input = scratch_directory("halo_input");
+    const std::string output = scratch_directory("halo_output");
+    PointCloud cloud = terrain(20000);
+
+    {
+        TileStoreWriter writer(input, 10.0f);
+        writer.append(cloud);
+    }
+
+    TileStore store(input);
+    TileCache cache(store, 4 * store.tile_bytes(0));
+    TileProcessor processor(store, cache, 1.0f);
+
+    SECTION("Tiled downsampling matches in-core downsampling")
+    {
+        VoxelDownsample filter(0.75f);
+
+        {
+            TileStoreWriter writer(output, 10.0f);
+            processor.downsample(filter, writer, ThreadPool::shared());
+        }
+
+        REQUIRE(TileStore(output).point_count() == filter.apply(cloud).size());
+    }
+
+    SECTION("Normals are estimated for every core point")
+    {
+        {
+            TileStoreWriter writer(output, 10.0f);
+            processor.estimate_normals(NormalEstimation(8, Vector4(20.0f, 20.0f, 100.0f)), writer, ThreadPool::shared());
+        }
+
+        TileStore normals(output);
+        TileCache normal_cache(normals, 1 << 30);
+
+        REQUIRE(normals.has_normals());
+        REQUIRE(normals.point_count() == cloud.size());
+
+        std::shared_ptr<const TileView> view = normal_cache.acquire(0);
+        const Vector4 expected = Vector4(-0.1f, 0.0f, 1.0f, 0.0f).normalized();
+
+        for (size_t i = 0; i < view->size(); i++)
+        {
+            Vector4 normal(view->normal_x()[i], view->normal_y()[i], view->normal_z()[i]);
+            REQUIRE(std::abs(Vector4::dot(normal, expected) - 1.0f) < 1e-3f);
+        }
+    }
+
+    std::filesystem::remove_all(input);
+    std::filesystem::remove_all(output);
+}
@@ -0,0 +1,181 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/parallel/primitives.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+    template <typename Key>
+    void check_sorted_pairs(const std::vector<Key> &original, const std::vector<Key> &keys, const std::vector<uint32_t> &values)
+    {
+        std::vector<uint32_t> expected(original.size());
+        std::iota(expected.begin(), expected.end(), 0u);
+        std::stable_sort(expected.begin(), expected.end(), [&original](const uint32_t &a, const uint32_t &b)
+                         { return original[a] < original[b]; });
+
+        REQUIRE(values == expected);
+
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            REQUIRE(keys[i] == original[values[i]]);
+        }
+    }
+}
+
+TEST_CASE("ParallelPrimitives: Radix Sort")
+{
+    ThreadPool pool(4);
+    std::mt19937_64 generator(17);
+
+    SECTION("64-bit keys are sorted stably with their values")
+    {
+        std::vector<uint64_t> keys(100000);
+
+        for (uint64_t &key : keys)
+        {
+            // Few distinct keys force long runs of equal keys across blocks.
+            key = generator() % 1000 * 0x0001000100010001ull;
+        }
+
+        const std::vector<uint64_t> original = keys;
+        std::vector<uint32_t> values(keys.size());
+        std::iota(values.begin(), values.end(), 0u);
+
+        ParallelPrimitives::radix_sort(keys, values, pool);
+        check_sorted_pairs(original, keys, values);
+    }
+
+    SECTION("32-bit keys")
+    {
+        std::vector<uint32_t> keys(70001);
+
+        for (uint32_t &key : keys)
+        {
+            key = static_cast<uint32_t>(generator());
+        }
+
+        const std::vector<uint32_t> original = keys;
+        std::vector<uint32_t> values(keys.size());
+        std::iota(values.begin(), values.end(), 0u);
+
+        ParallelPrimitives::radix_sort(keys, values, pool);
+        check_sorted_pairs(original, keys, values);
+    }
+
+    SECTION("Keys only, including constant and extreme digits")
+    {
+        std::vector<uint64_t> keys(50000);
+
+        for (uint64_t &key : keys)
+        {
+            key = (generator() & 0xff000000000000ffull) | 0x0000ffff00000000ull;
+        }
+
+        keys[7] = 0;
+        keys[9] = UINT64_MAX;
+
+        std::vector<uint64_t> expected = keys;
+        std::sort(expected.begin(), expected.end());
+
+        ParallelPrimitives::radix_sort(keys, pool);
+        REQUIRE(keys == expected);
+    }
+
+    SECTION("Small and degenerate inputs")
+    {
+        std::vector<uint64_t> empty;
+        ParallelPrimitives::radix_sort(empty);
+        REQUIRE(empty.empty());
+
+        std::vector<uint64_t> keys = {5, 3, 5, 1};
+        std::vector<uint32_t> values = {0, 1, 2, 3};
+        ParallelPrimitives::radix_sort(keys, values);
+        REQUIRE(keys == std::vector<uint64_t>{1, 3, 5, 5});
+        REQUIRE(values == std::vector<uint32_t>{3, 1, 0, 2});
+
+        std::vector<uint32_t> short_values = {0};
+        REQUIRE_THROWS_AS(ParallelPrimitives::radix_sort(keys, short_values), std::invalid_argument);
+    }
+}
+
+TEST_CASE("ParallelPrimitives: Exclusive Scan")
+{
+    ThreadPool pool(4);
+    std::mt19937 generator(23);
+
+    for (const size_t &count : {size_t(0), size_t(1), size_t(7), size_t(100003)})
+    {
+        std::vector<uint32_t> values(count);
+
+        for (uint32_t &value : values)
+        {
+            value = generator() % 100;
+        }
+
+        std::vector<uint32_t> expected(count);
+        uint32_t running = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            expected[i] = running;
+            running += values[i];
+        }
+
+        REQUIRE(ParallelPrimitives::exclusive_scan(values, pool) == running);
+        REQUIRE(values == expected);
+    }
+}
+
+TEST_CASE("ParallelPrimitives: Compact")
+{
+    ThreadPool pool(4);
+    std::mt19937 generator(29);
+
+    for (const int32_t &percent : {0, 3, 50, 100})
+    {
+        std::vector<uint8_t> flags(90001);
+
+        for (uint8_t &flag : flags)
+        {
+            flag = static_cast<int32_t>(generator() % 100) < percent ? static_cast<uint8_t>(1 + generator() % 255) : 0;
+        }
+
+        std::vector<uint32_t> expected;
+
+        for (size_t i = 0; i < flags.size(); i++)
+        {
+            if (flags[i] != 0)
+            {
+                expected.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        REQUIRE(ParallelPrimitives::compact(flags, pool) == expected);
+    }
+
+    REQUIRE(ParallelPrimitives::compact(std::vector<uint8_t>()).empty());
+}
+
+TEST_CASE("ParallelPrimitives: Histogram")
+{
+    ThreadPool pool(4);
+    std::mt19937 generator(31);
+
+    std::vector<uint32_t> bins(120000);
+    std::vector<uint32_t> expected(37, 0);
+
+    for (uint32_t &bin : bins)
+    {
+        bin = generator() % 37;
+        expected[bin]++;
+    }
+
+    REQUIRE(ParallelPrimitives::histogram(bins, 37, pool) == expected);
+    REQUIRE(ParallelPrimitives::histogram(std::vector<uint32_t>(), 4) == std::vector<uint32_t>(4, 0));
+
+    bins[5000] = 37;
+    REQUIRE_THROWS_AS(ParallelPrimitives::histogram(bins, 37, pool), std::out_of_range);
+}
@@ -0,0 +1,56 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/parallel/thread_pool.hpp>
+#include <cstdint>
+#include <stdexcept>
+
+TEST_CASE("ThreadPool: Parallel For")
+{
+    ThreadPool pool(4);
+
+    SECTION("Every index is visited exactly once")
+    {
+        std::vector<int32_t> visits(10007, 0);
+
+        pool.parallel_for(0, visits.size(), 64, [&visits](const size_t &begin, const size_t &end)
+                          {
+                              for (size_t i = begin; i < end; i++)
+                              {
+                                  visits[i]++;
+                              } });
+
+        for (const int32_t &count : visits)
+        {
+            REQUIRE(count == 1);
+        }
+    }
+
+    SECTION("Empty range does not invoke the function")
+    {
+        bool called = false;
+        pool.parallel_for(5, 5, 1, [&called](const size_t &, const size_t &)
+                          { called = true; });
+        REQUIRE_FALSE(called);
+    }
+
+    SECTION("Nested calls complete")
+    {
+        std::atomic<size_t> total{0};
+
+        pool.parallel_for(0, 8, 1, [&pool, &total](const size_t &, const size_t &)
+                          { pool.parallel_for(0, 100, 10, [&total](const size_t &begin, const size_t &end)
+                                              { total += end - begin; }); });
+
+        REQUIRE(total.load() == 800);
+    }
+
+    SECTION("Exceptions propagate to the caller")
+    {
+        REQUIRE_THROWS_AS(pool.parallel_for(0, 100, 1, [](const size_t &begin, const size_t &)
+                                            {
+                                                if (begin == 42)
+                                                {
+                                                    throw std::runtime_error("failure");
+                                                } }),
+                          std::runtime_error);
+    }
+}
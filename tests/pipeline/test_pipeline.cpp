@@ -0,0 +1,224 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/pipeline/pipeline.hpp>
+#include <cstdint>
+#include <ctime>
+
+namespace
+{
+    PointCloud batch_of(const size_t &count, const float &value)
+    {
+        PointCloud cloud;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            cloud.push_back(Vector4(value, 0.0f, 0.0f));
+        }
+
+        return cloud;
+    }
+
+    size_t drain(Pipeline &pipeline, std::vector<PointBatch> &received);
+
+    size_t finish(Pipeline &pipeline, std::vector<PointBatch> &received)
+    {
+        pipeline.close();
+
+        size_t points = 0;
+
+        while (!pipeline.finished())
+        {
+            points += drain(pipeline, received);
+            std::this_thread::yield();
+        }
+
+        points += drain(pipeline, received);
+        pipeline.stop();
+
+        return points;
+    }
+
+    size_t drain(Pipeline &pipeline, std::vector<PointBatch> &received)
+    {
+        size_t points = 0;
+        PointBatch batch;
+
+        while (pipeline.pop(batch))
+        {
+            points += batch.cloud.size();
+            received.push_back(batch);
+        }
+
+        return points;
+    }
+}
+
+TEST_CASE("SpscRing: Ordering")
+{
+    SpscRing<int32_t> ring(3);
+
+    REQUIRE(ring.capacity() == 4);
+
+    for (int32_t i = 0; i < 4; i++)
+    {
+        *ring.begin_push() = i;
+        ring.commit_push();
+    }
+
+    REQUIRE(ring.full());
+    REQUIRE(ring.begin_push() == nullptr);
+
+    for (int32_t i = 0; i < 4; i++)
+    {
+        REQUIRE(*ring.front() == i);
+        ring.pop();
+    }
+
+    REQUIRE(ring.empty());
+    REQUIRE(ring.front() == nullptr);
+}
+
+TEST_CASE("Pipeline: Blocking Stages")
+{
+    Pipeline pipeline(4, 64);
+
+    pipeline.add_stage("scale", [](PointBatch &batch)
+                       {
+                           for (size_t i = 0; i < batch.cloud.size(); i++)
+                           {
+                               batch.cloud.x()[i] *= 2.0f;
+                           }
+                           return true; },
+                       OverloadPolicy::Block);
+
+    pipeline.add_stage("reject_empty", [](PointBatch &batch)
+                       { return !batch.cloud.empty(); },
+                       OverloadPolicy::Block);
+
+    pipeline.start();
+
+    std::vector<PointBatch> received;
+    size_t points = 0;
+
+    for (int32_t i = 0; i < 50; i++)
+    {
+        PointCloud input = batch_of(i % 5 == 0 ? 0 : 10, static_cast<float>(i));
+
+        while (!pipeline.push(input))
+        {
+            points += drain(pipeline, received);
+        }
+    }
+
+    points += finish(pipeline, received);
+
+    REQUIRE(received.size() == 40);
+    REQUIRE(points == 400);
+
+    for (size_t i = 1; i < received.size(); i++)
+    {
+        REQUIRE(received[i].sequence > received[i - 1].sequence);
+        REQUIRE(received[i].cloud.x()[0] == 2.0f * static_cast<float>(received[i].sequence));
+    }
+
+    REQUIRE(pipeline.statistics(0).processed == 50);
+    REQUIRE(pipeline.statistics(1).rejected == 10);
+}
+
+TEST_CASE("Pipeline: Overload Policies")
+{
+    std::atomic<bool> release{false};
+
+    auto gate = [&release](PointBatch &)
+    {
+        while (!release)
+        {
+            std::this_thread::yield();
+        }
+        return true;
+    };
+
+    auto identity = [](PointBatch &)
+    { return true; };
+
+    SECTION("Drop discards batches when the next ring is full")
+    {
+        Pipeline pipeline(2, 16);
+        pipeline.add_stage("source", identity, OverloadPolicy::Drop);
+        pipeline.add_stage("slow", gate, OverloadPolicy::Block);
+        pipeline.start();
+
+        for (int32_t i = 0; i < 40; i++)
+        {
+            PointCloud input = batch_of(3, 1.0f);
+            pipeline.push(input);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+
+        release = true;
+
+        std::vector<PointBatch> received;
+        finish(pipeline, received);
+
+        const StageStatistics source = pipeline.statistics(0);
+        REQUIRE(source.dropped > 0);
+        REQUIRE(source.processed == 40 - pipeline.rejected_inputs());
+        REQUIRE(received.size() + source.dropped == source.processed);
+    }
+
+    SECTION("Coalesce merges batches without losing points")
+    {
+        Pipeline pipeline(2, 16);
+        pipeline.add_stage("source", identity, OverloadPolicy::Coalesce);
+        pipeline.add_stage("slow", gate, OverloadPolicy::Block);
+        pipeline.start();
+
+        size_t accepted = 0;
+
+        for (int32_t i = 0; i < 40; i++)
+        {
+            PointCloud input = batch_of(3, 1.0f);
+            accepted += pipeline.push(input) ? 3 : 0;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+
+        release = true;
+
+        std::vector<PointBatch> received;
+        REQUIRE(finish(pipeline, received) == accepted);
+        REQUIRE(pipeline.statistics(0).coalesced > 0);
+        REQUIRE(pipeline.statistics(1).mean_latency_us >= 0.0);
+
+        // A batch ages at least as long as the stage spends on it.
+        const StageStatistics slow = pipeline.statistics(1);
+        REQUIRE(slow.mean_age_us >= slow.mean_latency_us);
+        REQUIRE(slow.max_age_us >= slow.max_latency_us);
+    }
+}
+
+TEST_CASE("Pipeline: Idle Stages")
+{
+    Pipeline pipeline(4, 64);
+
+    for (int32_t i = 0; i < 3; i++)
+    {
+        pipeline.add_stage("identity", [](PointBatch &)
+                           { return true; },
+                           OverloadPolicy::Block);
+    }
+
+    pipeline.start();
+
+    // Parked stages should not burn a core each while there is no input.
+    const std::clock_t begin = std::clock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    const double seconds = static_cast<double>(std::clock() - begin) / CLOCKS_PER_SEC;
+
+    REQUIRE(seconds < 0.15);
+
+    PointCloud input = batch_of(10, 1.0f);
+    REQUIRE(pipeline.push(input));
+
+    std::vector<PointBatch> received;
+    REQUIRE(finish(pipeline, received) == 10);
+    REQUIRE(received.size() == 1);
+}
@@ -0,0 +1,99 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/preprocess/deskew.hpp>
+#include <cstdint>
+
+namespace
+{
+    Matrix4 yaw_pose(const float &angle, const float &tx)
+    {
+        Quaternion rotation(0.0f, 0.0f, std::sin(0.5f * angle), std::cos(0.5f * angle));
+        Matrix4 pose = rotation.to_matrix();
+        pose[3] = tx;
+        return pose;
+    }
+
+    PointCloud sweep(const size_t &count)
+    {
+        PointCloud cloud;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const float t = static_cast<float>(i) / static_cast<float>(count - 1);
+            cloud.push_back(Vector4(10.0f * std::cos(6.0f * t), 10.0f * std::sin(6.0f * t), 1.0f), t);
+        }
+
+        return cloud;
+    }
+}
+
+TEST_CASE("Deskew: Pose Interpolation")
+{
+    Matrix4 start;
+    start.identity();
+
+    Deskew deskew(start, yaw_pose(0.4f, 2.0f), 0.0f, 1.0f);
+
+    SECTION("Midpoint pose is halfway in rotation and translation")
+    {
+        Matrix4 pose = deskew.pose_at(0.5f);
+        Matrix4 expected = yaw_pose(0.2f, 1.0f);
+
+        for (int32_t i = 0; i < 16; i++)
+        {
+            REQUIRE(std::abs(pose[i] - expected[i]) < 1e-5f);
+        }
+    }
+
+    SECTION("Timestamps outside the sweep are clamped")
+    {
+        Matrix4 pose = deskew.pose_at(2.0f);
+        REQUIRE(std::abs(pose[3] - 2.0f) < 1e-6f);
+    }
+}
+
+TEST_CASE("Deskew: Apply")
+{
+    Matrix4 start;
+    start.identity();
+
+    PointCloud cloud = sweep(1003);
+    PointCloud original = cloud;
+
+    SECTION("Every point is moved by the pose at its timestamp")
+    {
+        Deskew deskew(start, yaw_pose(0.3f, 1.5f), 0.0f, 1.0f);
+        ThreadPool pool(3);
+        deskew.apply(cloud, pool);
+
+        for (size_t i = 0; i < cloud.size(); i++)
+        {
+            const Vector4 expected = deskew.transform_at(original.timestamps()[i]).transform(original.point(i));
+
+            REQUIRE(std::abs(cloud.x()[i] - expected[0]) < 1e-4f);
+            REQUIRE(std::abs(cloud.y()[i] - expected[1]) < 1e-4f);
+            REQUIRE(std::abs(cloud.z()[i] - expected[2]) < 1e-4f);
+        }
+    }
+
+    SECTION("Trajectory with several keyframes")
+    {
+        Deskew deskew({start, yaw_pose(0.1f, 0.5f), yaw_pose(-0.2f, 1.0f)}, {0.0f, 0.5f, 1.0f});
+        deskew.apply(cloud);
+
+        const size_t last = cloud.size() - 1;
+        const Vector4 end_point = deskew.transform_at(1.0f).transform(original.point(last));
+        REQUIRE(std::abs(cloud.x()[last] - end_point[0]) < 1e-4f);
+        REQUIRE(std::abs(cloud.y()[last] - end_point[1]) < 1e-4f);
+        REQUIRE(std::abs(deskew.transform_at(0.75f).translation()[0] - 0.75f) < 1e-6f);
+    }
+
+    SECTION("Mismatched trajectory is rejected")
+    {
+        REQUIRE_THROWS_AS(Deskew({start}, {0.0f}), std::invalid_argument);
+    }
+
+    SECTION("Reversed sweep times are rejected")
+    {
+        REQUIRE_THROWS_AS(Deskew(start, yaw_pose(0.3f, 1.5f), 1.0f, 0.0f), std::invalid_argument);
+    }
+}
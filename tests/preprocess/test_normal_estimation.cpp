@@ -0,0 +1,37 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/preprocess/normal_estimation.hpp>
+#include <cstdint>
+
+TEST_CASE("NormalEstimation: Plane")
+{
+    PointCloud cloud;
+
+    for (int32_t i = 0; i < 20; i++)
+    {
+        for (int32_t j = 0; j < 20; j++)
+        {
+            const float x = 0.1f * i;
+            const float y = 0.1f * j;
+            cloud.push_back(Vector4(x, y, 0.5f * x + 2.0f));
+        }
+    }
+
+    NormalEstimation(12, Vector4(0.0f, 0.0f, 100.0f)).apply(cloud);
+
+    REQUIRE(cloud.has_normals());
+
+    const Vector4 expected = Vector4(-0.5f, 0.0f, 1.0f, 0.0f).normalized();
+
+    for (size_t i = 0; i < cloud.size(); i++)
+    {
+        REQUIRE(std::abs(Vector4::dot(cloud.normal(i), expected) - 1.0f) < 1e-3f);
+    }
+}
+
+TEST_CASE("NormalEstimation: Smallest Eigenvector")
+{
+    const float diagonal[6] = {3.0f, 0.0f, 0.0f, 0.5f, 0.0f, 2.0f};
+    Vector4 normal = NormalEstimation::smallest_eigenvector(diagonal);
+
+    REQUIRE(std::abs(std::abs(normal.y()) - 1.0f) < 1e-6f);
+}
@@ -0,0 +1,55 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/preprocess/voxel_downsample.hpp>
+#include <cstdint>
+
+TEST_CASE("VoxelDownsample: Apply")
+{
+    PointCloud cloud;
+
+    for (int32_t i = 0; i < 10; i++)
+    {
+        for (int32_t j = 0; j < 10; j++)
+        {
+            cloud.push_back(Vector4(0.1f * i + 0.05f, 0.1f * j + 0.05f, 0.25f));
+        }
+    }
+
+    SECTION("One point per occupied voxel")
+    {
+        PointCloud reduced = VoxelDownsample(0.5f).apply(cloud);
+        REQUIRE(reduced.size() == 4);
+    }
+
+    SECTION("Output is the centroid of each voxel")
+    {
+        PointCloud reduced = VoxelDownsample(2.0f).apply(cloud);
+        REQUIRE(reduced.size() == 1);
+        REQUIRE(std::abs(reduced.x()[0] - 0.5f) < 1e-5f);
+        REQUIRE(std::abs(reduced.y()[0] - 0.5f) < 1e-5f);
+        REQUIRE(std::abs(reduced.z()[0] - 0.25f) < 1e-5f);
+    }
+
+    SECTION("Distant voxels never share a key")
+    {
+        PointCloud distant;
+        distant.push_back(Vector4(0.005f, 0.005f, 0.005f));
+        distant.push_back(Vector4(20971.525f, 0.005f, 0.005f));
+
+        REQUIRE(VoxelDownsample(0.01f).apply(distant).size() == 2);
+    }
+
+    SECTION("Extents wider than a packed key")
+    {
+        PointCloud extreme;
+        extreme.push_back(Vector4(-1e30f, -1e30f, 0.0f));
+        extreme.push_back(Vector4(1e30f, 1e30f, 0.0f));
+        extreme.push_back(Vector4(0.0f, 0.0f, 0.0f));
+        extreme.push_back(Vector4(1e30f, 1e30f, 0.0f));
+
+        PointCloud reduced = VoxelDownsample(1e-6f).apply(extreme);
+        REQUIRE(reduced.size() == 3);
+        REQUIRE(reduced.x()[0] == -1e30f);
+        REQUIRE(reduced.x()[1] == 0.0f);
+        REQUIRE(reduced.x()[2] == 1e30f);
+    }
+}
@@ -0,0 +1,163 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/profiling/profiler.hpp>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    size_t count_events(const char *name)
+    {
+        std::vector<Profiler::Event> events;
+        Profiler::instance().events(events);
+
+        return static_cast<size_t>(std::count_if(events.begin(), events.end(), [&](const Profiler::Event &event)
+                                                 { return std::strcmp(event.name, name) == 0; }));
+    }
+}
+
+TEST_CASE("Profiler: Scopes and counters")
+{
+    Profiler &profiler = Profiler::instance();
+    profiler.reset();
+
+    SECTION("Scoped timers record one event per scope on every thread")
+    {
+        std::vector<std::thread> workers;
+
+        for (int32_t t = 0; t < 4; t++)
+        {
+            workers.emplace_back([]
+                                 {
+                                     for (int32_t i = 0; i < 10; i++)
+                                     {
+                                         ScopedTimer timer("test::worker");
+                                     } });
+        }
+
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        REQUIRE(count_events("test::worker") == 40);
+        REQUIRE(profiler.thread_count() >= 1);
+
+        std::vector<Profiler::ScopeStatistics> statistics;
+        profiler.statistics(statistics);
+
+        const auto found = std::find_if(statistics.begin(), statistics.end(), [](const Profiler::ScopeStatistics &scope)
+                                        { return std::strcmp(scope.name, "test::worker") == 0; });
+
+        REQUIRE(found != statistics.end());
+        REQUIRE(found->calls == 40);
+        REQUIRE(found->maximum <= found->total);
+    }
+
+    SECTION("Counters are summed across threads")
+    {
+        std::vector<std::thread> workers;
+
+        for (int32_t t = 0; t < 3; t++)
+        {
+            workers.emplace_back([]
+                                 {
+                                     Profiler::instance().add(Counter::PointsProcessed, 100);
+                                     Profiler::instance().add(Counter::QueriesIssued, 7); });
+        }
+
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        REQUIRE(profiler.counter(Counter::PointsProcessed) == 300);
+        REQUIRE(profiler.counter(Counter::QueriesIssued) == 21);
+        REQUIRE(profiler.counter(Counter::Allocations) == 0);
+    }
+
+    SECTION("Exited threads hand their state to the next thread")
+    {
+        profiler.add(Counter::Allocations, 1);
+        const size_t before = profiler.thread_count();
+
+        for (int32_t t = 0; t < 50; t++)
+        {
+            std::thread worker([]
+                               {
+                                   ScopedTimer timer("test::short_lived");
+                                   Profiler::instance().add(Counter::PointsProcessed, 3); });
+            worker.join();
+        }
+
+        REQUIRE(profiler.thread_count() <= before + 1);
+        REQUIRE(profiler.counter(Counter::PointsProcessed) == 150);
+        REQUIRE(count_events("test::short_lived") == 50);
+
+        std::vector<Profiler::ScopeStatistics> statistics;
+        profiler.statistics(statistics);
+
+        const auto found = std::find_if(statistics.begin(), statistics.end(), [](const Profiler::ScopeStatistics &scope)
+                                        { return std::strcmp(scope.name, "test::short_lived") == 0; });
+
+        REQUIRE(found != statistics.end());
+        REQUIRE(found->calls == 50);
+    }
+
+    SECTION("The ring keeps only the most recent events")
+    {
+        for (size_t i = 0; i < Profiler::kRingCapacity + 100; i++)
+        {
+            profiler.record("test::ring", i, i + 1);
+        }
+
+        std::vector<Profiler::Event> events;
+        profiler.events(events);
+
+        std::vector<uint64_t> begins;
+
+        for (const Profiler::Event &event : events)
+        {
+            if (std::strcmp(event.name, "test::ring") == 0)
+            {
+                begins.push_back(event.begin);
+            }
+        }
+
+        REQUIRE(begins.size() == Profiler::kRingCapacity);
+        REQUIRE(begins.front() == 100);
+        REQUIRE(begins.back() == Profiler::kRingCapacity + 99);
+    }
+
+    SECTION("Exports name every scope and counter")
+    {
+        profiler.record("test::export", 1000, 3500);
+        profiler.add(Counter::Allocations, 2);
+
+        std::ostringstream trace;
+        profiler.write_chrome_trace(trace);
+
+        REQUIRE(trace.str().find("\"traceEvents\"") != std::string::npos);
+        REQUIRE(trace.str().find("{\"name\":\"test::export\",\"ph\":\"X\"") != std::string::npos);
+        REQUIRE(trace.str().find("\"ts\":1.000,\"dur\":2.500") != std::string::npos);
+        REQUIRE(trace.str().find("\"allocations\":2") != std::string::npos);
+
+        std::ostringstream summary;
+        profiler.write_summary(summary);
+
+        REQUIRE(summary.str().find("test::export") != std::string::npos);
+        REQUIRE(summary.str().find("points_processed") != std::string::npos);
+    }
+
+    SECTION("Reset clears events and counters")
+    {
+        profiler.record("test::reset", 0, 10);
+        profiler.add(Counter::QueriesIssued, 5);
+        profiler.reset();
+
+        REQUIRE(count_events("test::reset") == 0);
+        REQUIRE(profiler.counter(Counter::QueriesIssued) == 0);
+    }
+}
@@ -0,0 +1,161 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/raycast/ray_caster.hpp>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+namespace
+{
+    // Axis-aligned box room centred on the origin, two triangles per face.
+    TriangleMesh box_room(const float &half)
+    {
+        std::vector<Vector4> vertices;
+
+        for (int32_t i = 0; i < 8; i++)
+        {
+            vertices.push_back(Vector4((i & 1) ? half : -half, (i & 2) ? half : -half, (i & 4) ? half : -half));
+        }
+
+        const std::vector<uint32_t> indices = {
+            0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5,
+            0, 4, 5, 0, 5, 1, 2, 3, 7, 2, 7, 6,
+            0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3};
+
+        return TriangleMesh(vertices, indices);
+    }
+
+    float expected_box_range(const Vector4 &direction, const float &half)
+    {
+        float range = std::numeric_limits<float>::max();
+
+        for (int32_t c = 0; c < 3; c++)
+        {
+            if (std::abs(direction[c]) > 1e-6f)
+            {
+                range = std::min(range, half / std::abs(direction[c]));
+            }
+        }
+
+        return range;
+    }
+}
+
+TEST_CASE("RayCaster: Triangle Mesh")
+{
+    TriangleMesh mesh = box_room(5.0f);
+    Bvh bvh(mesh, 2);
+
+    REQUIRE(bvh.size() == mesh.triangle_count());
+
+    RayCaster caster(bvh, 0.1f, 100.0f);
+    PointCloud pattern = RayCaster::spinning_pattern(16, 181, -0.5f, 0.5f);
+
+    Matrix4 pose;
+    pose.identity();
+
+    RayScan scan;
+    ThreadPool pool(3);
+    caster.cast(pose, pattern, scan, pool);
+
+    REQUIRE(scan.points.size() == pattern.size());
+
+    SECTION("Ranges match the analytic box intersection")
+    {
+        for (size_t i = 0; i < pattern.size(); i++)
+        {
+            const Vector4 direction = pattern.point(i);
+
+            REQUIRE(scan.hits[i] >= 0);
+            REQUIRE(std::abs(scan.ranges[i] - expected_box_range(direction, 5.0f)) < 1e-3f);
+            REQUIRE(std::abs(scan.points.x()[i] - direction[0] * scan.ranges[i]) < 1e-3f);
+        }
+    }
+
+    SECTION("Hit ids match the scalar traversal")
+    {
+        for (size_t i = 0; i < pattern.size(); i += 7)
+        {
+            float distance = 100.0f;
+            uint32_t triangle = 0;
+
+            REQUIRE(bvh.intersect(Vector4(0.0f, 0.0f, 0.0f, 1.0f), pattern.point(i), 0.1f, distance, triangle));
+            REQUIRE(std::abs(distance - scan.ranges[i]) < 1e-4f);
+        }
+    }
+
+    SECTION("Translated sensor sees nearer walls")
+    {
+        pose[3] = 4.0f;
+
+        PointCloud forward;
+        forward.push_back(Vector4(1.0f, 0.0f, 0.0f));
+        forward.push_back(Vector4(-1.0f, 0.0f, 0.0f));
+
+        caster.cast(pose, forward, scan, pool);
+
+        REQUIRE(std::abs(scan.ranges[0] - 1.0f) < 1e-4f);
+        REQUIRE(std::abs(scan.ranges[1] - 9.0f) < 1e-4f);
+    }
+
+    SECTION("Rays beyond the maximum range miss")
+    {
+        RayCaster short_caster(bvh, 0.1f, 2.0f);
+        short_caster.cast(pose, pattern, scan, pool);
+
+        for (size_t i = 0; i < pattern.size(); i++)
+        {
+            REQUIRE(scan.hits[i] == -1);
+            REQUIRE(scan.ranges[i] == 0.0f);
+        }
+    }
+}
+
+TEST_CASE("RayCaster: Voxel Map")
+{
+    PointCloud wall;
+
+    for (int32_t y = -40; y <= 40; y++)
+    {
+        for (int32_t z = -40; z <= 40; z++)
+        {
+            wall.push_back(Vector4(10.05f, y * 0.25f, z * 0.25f));
+        }
+    }
+
+    Octree octree(wall, 0.2f);
+    RayCaster caster(octree, 0.5f, 50.0f);
+
+    PointCloud pattern = RayCaster::spinning_pattern(8, 360, -0.3f, 0.3f);
+
+    Matrix4 pose;
+    pose.identity();
+
+    RayScan scan;
+    ThreadPool pool(2);
+    caster.cast(pose, pattern, scan, pool);
+
+    size_t hit_count = 0;
+
+    for (size_t i = 0; i < pattern.size(); i++)
+    {
+        const Vector4 direction = pattern.point(i);
+
+        if (scan.hits[i] < 0)
+        {
+            REQUIRE(scan.ranges[i] == 0.0f);
+            continue;
+        }
+
+        hit_count++;
+
+        const Vector4 hit = wall.point(scan.hits[i]);
+        const float expected_x = direction[0] * scan.ranges[i];
+
+        // The ray enters the voxel holding the hit point, so it lands within one voxel of the wall.
+        REQUIRE(direction[0] > 0.0f);
+        REQUIRE(std::abs(expected_x - 10.05f) < 0.25f);
+        REQUIRE(std::abs(scan.points.y()[i] - hit[1]) < 0.5f);
+    }
+
+    REQUIRE(hit_count > 100);
+}
@@ -0,0 +1,178 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/registration/global_registration.hpp>
+#include <LRE/linalg/quaternion.hpp>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+namespace
+{
+    Vector4 transform_point(const Matrix4 &transform, const Vector4 &point)
+    {
+        return Vector4(transform[0] * point[0] + transform[1] * point[1] + transform[2] * point[2] + transform[3],
+                       transform[4] * point[0] + transform[5] * point[1] + transform[6] * point[2] + transform[7],
+                       transform[8] * point[0] + transform[9] * point[1] + transform[10] * point[2] + transform[11]);
+    }
+
+    Matrix4 ground_truth()
+    {
+        Matrix4 transform = Quaternion::from_axis_angle(Vector4(0.3f, -0.5f, 0.8f, 0.0f).normalized(), 1.1f).to_matrix();
+        transform[3] = 2.5f;
+        transform[7] = -1.0f;
+        transform[11] = 0.75f;
+        return transform;
+    }
+
+    // Correspondences where the first inlier_count pairs obey the ground truth up to small noise.
+    void make_problem(const size_t &count, const size_t &inlier_count, PointCloud &source, PointCloud &target,
+                      std::vector<Correspondence> &correspondences)
+    {
+        std::mt19937 generator(7);
+        std::uniform_real_distribution<float> unit(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> noise(-0.01f, 0.01f);
+
+        const Matrix4 transform = ground_truth();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const Vector4 point(unit(generator), unit(generator), unit(generator));
+            source.push_back(point);
+
+            if (i < inlier_count)
+            {
+                const Vector4 moved = transform_point(transform, point);
+                target.push_back(Vector4(moved[0] + noise(generator), moved[1] + noise(generator), moved[2] + noise(generator)));
+            }
+            else
+            {
+                target.push_back(Vector4(unit(generator), unit(generator), unit(generator)));
+            }
+
+            correspondences.push_back(Correspondence{static_cast<uint32_t>(i), static_cast<uint32_t>(i), 0.0f});
+        }
+    }
+
+    float transform_error(const Matrix4 &a, const Matrix4 &b)
+    {
+        float error = 0.0f;
+
+        for (int32_t i = 0; i < 12; i++)
+        {
+            error = std::max(error, std::abs(a[i] - b[i]));
+        }
+
+        return error;
+    }
+}
+
+TEST_CASE("GlobalRegistration: Closed-form rigid fit")
+{
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<float> unit(-5.0f, 5.0f);
+
+    const Matrix4 transform = ground_truth();
+    std::vector<Vector4> source;
+    std::vector<Vector4> target;
+
+    for (int32_t i = 0; i < 50; i++)
+    {
+        source.push_back(Vector4(unit(generator), unit(generator), unit(generator)));
+        target.push_back(transform_point(transform, source.back()));
+    }
+
+    REQUIRE(transform_error(GlobalRegistration::estimate_rigid(source, target), transform) < 1e-4f);
+
+    SECTION("Weights exclude outliers")
+    {
+        std::vector<uint32_t> indices;
+        std::vector<float> weights;
+
+        target[0] = Vector4(100.0f, 100.0f, 100.0f);
+
+        for (uint32_t i = 0; i < source.size(); i++)
+        {
+            indices.push_back(i);
+            weights.push_back(i == 0 ? 0.0f : 1.0f);
+        }
+
+        const Matrix4 estimate = GlobalRegistration::estimate_rigid(source, target, indices.data(), indices.size(), weights.data());
+        REQUIRE(transform_error(estimate, transform) < 1e-4f);
+    }
+}
+
+TEST_CASE("GlobalRegistration: Robust alignment")
+{
+    PointCloud source;
+    PointCloud target;
+    std::vector<Correspondence> correspondences;
+    make_problem(2000, 800, source, target, correspondences);
+
+    const Matrix4 transform = ground_truth();
+
+    SECTION("RANSAC")
+    {
+        const GlobalRegistration registration(0.05f, RegistrationSolver::Ransac);
+        const RegistrationResult result = registration.align(source, target, correspondences, ThreadPool::shared());
+
+        REQUIRE(transform_error(result.transform, transform) < 0.02f);
+        REQUIRE(result.inliers.size() >= 790);
+        REQUIRE(result.inliers.size() <= 805);
+        REQUIRE(result.inliers.back() < 800);
+        REQUIRE(result.iterations > 0);
+    }
+
+    SECTION("Max clique")
+    {
+        const GlobalRegistration registration(0.05f, RegistrationSolver::MaxClique);
+        const RegistrationResult result = registration.align(source, target, correspondences, ThreadPool::shared());
+
+        REQUIRE(transform_error(result.transform, transform) < 0.02f);
+        REQUIRE(result.inliers.size() >= 790);
+        REQUIRE(std::abs(result.fitness - 0.4f) < 0.01f);
+    }
+
+    SECTION("Too few correspondences")
+    {
+        correspondences.resize(2);
+
+        const RegistrationResult result = GlobalRegistration(0.05f).align(source, target, correspondences, ThreadPool::shared());
+
+        REQUIRE(result.inliers.empty());
+        REQUIRE(result.transform[0] == 1.0f);
+    }
+}
+
+TEST_CASE("GlobalRegistration: Descriptor matching")
+{
+    DescriptorSet source(4, 3);
+    DescriptorSet target(4, 3);
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        for (size_t d = 0; d < 3; d++)
+        {
+            source.row(i)[d] = static_cast<float>(i * 10 + d);
+            target.row(3 - i)[d] = static_cast<float>(i * 10 + d) + 0.1f;
+        }
+    }
+
+    // A duplicate makes target row 3 the nearest neighbour of two source rows.
+    source.row(3)[0] = 0.0f;
+    source.row(3)[1] = 1.0f;
+    source.row(3)[2] = 2.0f;
+
+    std::vector<Correspondence> correspondences;
+
+    GlobalRegistration::match(source, target, false, correspondences, ThreadPool::shared());
+    REQUIRE(correspondences.size() == 4);
+    REQUIRE(correspondences[1].target == 2);
+
+    GlobalRegistration::match(source, target, true, correspondences, ThreadPool::shared());
+    REQUIRE(correspondences.size() == 3);
+
+    for (const Correspondence &correspondence : correspondences)
+    {
+        REQUIRE(correspondence.target == 3 - correspondence.source % 3);
+        REQUIRE(std::abs(correspondence.distance - std::sqrt(0.03f)) < 1e-4f);
+    }
+}
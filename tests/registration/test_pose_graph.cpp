@@ -0,0 +1,260 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/registration/pose_graph.hpp>
+#include <LRE/linalg/quaternion.hpp>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+    Matrix4 make_pose(const Vector4 &axis, const float &angle, const float &x, const float &y, const float &z)
+    {
+        Matrix4 pose = Quaternion::from_axis_angle(axis.normalized(), angle).to_matrix();
+        pose[3] = x;
+        pose[7] = y;
+        pose[11] = z;
+        return pose;
+    }
+
+    Matrix4 rigid_inverse(const Matrix4 &pose)
+    {
+        Matrix4 result;
+        result.identity();
+
+        for (int32_t r = 0; r < 3; r++)
+        {
+            for (int32_t c = 0; c < 3; c++)
+            {
+                result[4 * r + c] = pose[4 * c + r];
+            }
+        }
+
+        for (int32_t r = 0; r < 3; r++)
+        {
+            result[4 * r + 3] = -(result[4 * r] * pose[3] + result[4 * r + 1] * pose[7] + result[4 * r + 2] * pose[11]);
+        }
+
+        return result;
+    }
+
+    // A helix of scan poses; drift is a small rotation applied to every odometry step.
+    void make_trajectory(const size_t &count, std::vector<Matrix4> &truth, std::vector<Matrix4> &odometry)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            const float angle = 0.1f * static_cast<float>(i);
+            truth.push_back(make_pose(Vector4(0.0f, 0.0f, 1.0f, 0.0f), angle, 10.0f * std::cos(angle), 10.0f * std::sin(angle), 0.05f * i));
+        }
+
+        const Matrix4 drift = make_pose(Vector4(1.0f, 1.0f, 0.0f, 0.0f), 0.01f, 0.02f, 0.0f, 0.0f);
+        odometry.push_back(truth[0]);
+
+        for (size_t i = 1; i < count; i++)
+        {
+            odometry.push_back(odometry.back() * (rigid_inverse(truth[i - 1]) * truth[i]) * drift);
+        }
+    }
+
+    float max_translation_error(const PoseGraph &graph, const std::vector<Matrix4> &truth)
+    {
+        float error = 0.0f;
+
+        for (size_t i = 0; i < truth.size(); i++)
+        {
+            for (int32_t k = 3; k < 12; k += 4)
+            {
+                error = std::max(error, std::abs(graph.pose(i)[k] - truth[i][k]));
+            }
+        }
+
+        return error;
+    }
+}
+
+TEST_CASE("BlockCholesky: Sparse solve")
+{
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+
+    const size_t size = 40;
+    const size_t dimension = size * BlockCholesky::kBlock;
+
+    std::vector<std::pair<uint32_t, uint32_t>> couplings;
+
+    for (uint32_t v = 0; v + 1 < size; v++)
+    {
+        couplings.push_back(std::make_pair(v, v + 1));
+    }
+
+    couplings.push_back(std::make_pair(0u, 39u));
+    couplings.push_back(std::make_pair(10u, 30u));
+    couplings.push_back(std::make_pair(5u, 25u));
+
+    BlockCholesky solver;
+    solver.analyze(size, couplings);
+    REQUIRE(solver.size() == size);
+    REQUIRE(solver.block_count() >= size + couplings.size());
+
+    std::vector<double> dense(dimension * dimension, 0.0);
+
+    for (uint32_t v = 0; v < size; v++)
+    {
+        double block[36] = {};
+
+        for (size_t i = 0; i < 6; i++)
+        {
+            block[7 * i] = 20.0;
+        }
+
+        solver.add_diagonal(v, block);
+
+        for (size_t r = 0; r < 6; r++)
+        {
+            dense[(v * 6 + r) * dimension + v * 6 + r] += 20.0;
+        }
+    }
+
+    for (const std::pair<uint32_t, uint32_t> &coupling : couplings)
+    {
+        double block[36];
+
+        for (double &value : block)
+        {
+            value = unit(generator);
+        }
+
+        solver.add(coupling.first, coupling.second, block);
+
+        for (size_t r = 0; r < 6; r++)
+        {
+            for (size_t c = 0; c < 6; c++)
+            {
+                dense[(coupling.first * 6 + r) * dimension + coupling.second * 6 + c] += block[r * 6 + c];
+                dense[(coupling.second * 6 + c) * dimension + coupling.first * 6 + r] += block[r * 6 + c];
+            }
+        }
+    }
+
+    std::vector<double> expected(dimension);
+    std::vector<double> rhs(dimension, 0.0);
+
+    for (double &value : expected)
+    {
+        value = unit(generator);
+    }
+
+    for (size_t r = 0; r < dimension; r++)
+    {
+        for (size_t c = 0; c < dimension; c++)
+        {
+            rhs[r] += dense[r * dimension + c] * expected[c];
+        }
+    }
+
+    REQUIRE(solver.factorize(0.0));
+
+    std::vector<double> solution;
+    solver.solve(rhs, solution);
+
+    for (size_t i = 0; i < dimension; i++)
+    {
+        REQUIRE(std::abs(solution[i] - expected[i]) < 1e-9);
+    }
+
+    SECTION("Unknown coupling")
+    {
+        double block[36] = {};
+        REQUIRE_THROWS_AS(solver.add(0, 20, block), std::invalid_argument);
+    }
+}
+
+TEST_CASE("PoseGraph: Loop closure")
+{
+    std::vector<Matrix4> truth;
+    std::vector<Matrix4> odometry;
+    make_trajectory(120, truth, odometry);
+
+    auto build = [&](PoseGraph &graph, const std::vector<Matrix4> &initial)
+    {
+        for (const Matrix4 &pose : initial)
+        {
+            graph.add_node(pose);
+        }
+
+        for (size_t i = 1; i < truth.size(); i++)
+        {
+            graph.add_edge(i - 1, i, rigid_inverse(truth[i - 1]) * truth[i]);
+        }
+
+        for (size_t i = 0; i + 60 < truth.size(); i += 20)
+        {
+            graph.add_edge(i, i + 60, rigid_inverse(truth[i]) * truth[i + 60]);
+        }
+    };
+
+    SECTION("Levenberg-Marquardt")
+    {
+        PoseGraph graph;
+        build(graph, odometry);
+
+        REQUIRE(max_translation_error(graph, truth) > 1.0f);
+        const double initial = graph.error();
+
+        REQUIRE(graph.optimize(50) > 0);
+        REQUIRE(graph.error() < 1e-6 * initial);
+        REQUIRE(max_translation_error(graph, truth) < 1e-3f);
+    }
+
+    SECTION("Gauss-Newton")
+    {
+        PoseGraph graph(RobustKernel::None, 1.0, PoseGraphMethod::GaussNewton);
+        build(graph, odometry);
+
+        graph.optimize(50);
+        REQUIRE(max_translation_error(graph, truth) < 1e-3f);
+    }
+
+    SECTION("Robust kernel rejects a false loop closure")
+    {
+        const Matrix4 wrong = make_pose(Vector4(0.0f, 1.0f, 0.0f, 0.0f), 0.8f, 5.0f, -3.0f, 2.0f);
+
+        // Starting at the solution isolates how much each cost lets the outlier pull the poses away.
+        PoseGraph plain;
+        build(plain, truth);
+        plain.add_edge(10, 100, wrong);
+        plain.optimize(50);
+
+        PoseGraph robust(RobustKernel::Cauchy, 0.1);
+        build(robust, truth);
+        robust.add_edge(10, 100, wrong);
+        robust.optimize(50);
+
+        REQUIRE(max_translation_error(plain, truth) > 20.0f * max_translation_error(robust, truth));
+        REQUIRE(max_translation_error(robust, truth) < 0.05f);
+    }
+
+    SECTION("Fixed nodes stay in place")
+    {
+        PoseGraph graph;
+        build(graph, odometry);
+        graph.set_fixed(0, true);
+        graph.set_fixed(119, true);
+
+        graph.optimize(50);
+
+        for (int32_t k = 0; k < 16; k++)
+        {
+            REQUIRE(graph.pose(119)[k] == odometry[119][k]);
+        }
+    }
+
+    SECTION("Invalid edges")
+    {
+        PoseGraph graph;
+        build(graph, odometry);
+
+        REQUIRE_THROWS_AS(graph.add_edge(0, 500, truth[0]), std::out_of_range);
+        REQUIRE_THROWS_AS(graph.add_edge(3, 3, truth[0]), std::invalid_argument);
+    }
+}
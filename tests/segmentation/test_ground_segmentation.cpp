@@ -0,0 +1,134 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/segmentation/polar_grid_ground.hpp>
+#include <LRE/segmentation/scan_line_ground.hpp>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+namespace
+{
+    constexpr float kSensorHeight = 1.8f;
+
+    // Flat ground sampled like a spinning sensor, a wall ahead and a canopy overhead; labels mark ground.
+    PointCloud synthetic_scene(std::vector<uint8_t> &labels)
+    {
+        std::mt19937 generator(21);
+        std::normal_distribution<float> noise(0.0f, 0.02f);
+
+        PointCloud cloud;
+        const float pi = 3.14159265358979323846f;
+
+        for (int32_t ring = 0; ring < 24; ring++)
+        {
+            const float elevation = -0.45f + 0.018f * ring;
+
+            for (int32_t column = 0; column < 720; column++)
+            {
+                const float azimuth = 2.0f * pi * column / 720.0f;
+                const float range = kSensorHeight / std::tan(-elevation);
+
+                if (range > 60.0f)
+                {
+                    continue;
+                }
+
+                cloud.push_back(Vector4(range * std::cos(azimuth), range * std::sin(azimuth), -kSensorHeight + noise(generator)));
+                labels.push_back(1);
+            }
+        }
+
+        for (int32_t i = 0; i < 40; i++)
+        {
+            for (int32_t j = 0; j < 25; j++)
+            {
+                cloud.push_back(Vector4(10.0f, -2.0f + 0.1f * i, -1.3f + 0.1f * j));
+                labels.push_back(0);
+
+                cloud.push_back(Vector4(-6.0f + 0.1f * i, 5.0f + 0.1f * j, 2.0f + noise(generator)));
+                labels.push_back(0);
+            }
+        }
+
+        return cloud;
+    }
+
+    void require_accuracy(const std::vector<uint8_t> &labels, const std::vector<uint8_t> &ground)
+    {
+        size_t ground_total = 0;
+        size_t ground_found = 0;
+        size_t obstacle_total = 0;
+        size_t obstacle_as_ground = 0;
+
+        for (size_t i = 0; i < labels.size(); i++)
+        {
+            if (labels[i] == 1)
+            {
+                ground_total++;
+                ground_found += ground[i];
+            }
+            else
+            {
+                obstacle_total++;
+                obstacle_as_ground += ground[i];
+            }
+        }
+
+        REQUIRE(ground_found >= 0.95 * ground_total);
+        REQUIRE(obstacle_as_ground <= 0.05 * obstacle_total);
+    }
+}
+
+TEST_CASE("PolarGridGround: Segmentation")
+{
+    std::vector<uint8_t> labels;
+    PointCloud cloud = synthetic_scene(labels);
+
+    PolarGridGround segmentation(kSensorHeight);
+    ThreadPool pool(3);
+
+    std::vector<uint8_t> ground;
+    segmentation.segment(cloud, ground, pool);
+
+    REQUIRE(ground.size() == cloud.size());
+    require_accuracy(labels, ground);
+
+    SECTION("Plane fit recovers a tilted plane")
+    {
+        PointCloud plane;
+        std::vector<uint32_t> indices;
+
+        for (int32_t i = 0; i < 10; i++)
+        {
+            for (int32_t j = 0; j < 10; j++)
+            {
+                plane.push_back(Vector4(i * 0.5f, j * 0.5f, 0.1f * i * 0.5f - 1.0f));
+                indices.push_back(static_cast<uint32_t>(indices.size()));
+            }
+        }
+
+        Vector4 normal;
+        float offset = 0.0f;
+
+        REQUIRE(PolarGridGround::fit_plane(plane, indices.data(), indices.size(), normal, offset));
+
+        const float length = std::sqrt(1.0f + 0.01f);
+        REQUIRE(std::abs(normal[0] + 0.1f / length) < 1e-4f);
+        REQUIRE(std::abs(normal[2] - 1.0f / length) < 1e-4f);
+        REQUIRE(std::abs(offset - 1.0f / length) < 1e-4f);
+    }
+}
+
+TEST_CASE("ScanLineGround: Segmentation")
+{
+    std::vector<uint8_t> labels;
+    PointCloud cloud = synthetic_scene(labels);
+
+    ScanLineGround segmentation(kSensorHeight);
+    ThreadPool pool(3);
+
+    std::vector<uint8_t> ground;
+    segmentation.segment(cloud, ground, pool);
+
+    REQUIRE(ground.size() == cloud.size());
+    require_accuracy(labels, ground);
+}
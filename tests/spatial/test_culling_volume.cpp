@@ -0,0 +1,192 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/spatial/culling_volume.hpp>
+#include <LRE/linalg/quaternion.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+
+namespace
+{
+    PointCloud random_cloud(const size_t &count)
+    {
+        std::mt19937 generator(11);
+        std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+
+        PointCloud cloud;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            cloud.push_back(Vector4(distribution(generator), distribution(generator), distribution(generator)));
+        }
+
+        return cloud;
+    }
+
+    void check_against(const CullingVolume &volume, const PointCloud &cloud, const std::function<bool(const Vector4 &)> &inside)
+    {
+        std::vector<uint32_t> expected;
+
+        for (uint32_t i = 0; i < cloud.size(); i++)
+        {
+            if (inside(cloud.point(i)))
+            {
+                expected.push_back(i);
+            }
+        }
+
+        REQUIRE(!expected.empty());
+        REQUIRE(expected.size() < cloud.size());
+
+        std::vector<uint32_t> indices;
+        volume.select(cloud, indices);
+        REQUIRE(indices == expected);
+
+        std::vector<uint64_t> bits;
+        volume.mask(cloud, bits);
+        REQUIRE(bits.size() == (cloud.size() + 63) / 64);
+
+        for (uint32_t i = 0; i < cloud.size(); i++)
+        {
+            REQUIRE(((bits[i / 64] >> (i % 64)) & 1) == (inside(cloud.point(i)) ? 1u : 0u));
+        }
+
+        Octree octree(cloud, 0.5f);
+        std::vector<uint32_t> from_octree;
+        volume.select(octree, from_octree);
+        std::sort(from_octree.begin(), from_octree.end());
+        REQUIRE(from_octree == expected);
+    }
+}
+
+TEST_CASE("CullingVolume: Point selection")
+{
+    const PointCloud cloud = random_cloud(20011);
+
+    SECTION("Axis-aligned box")
+    {
+        const CullingVolume volume = CullingVolume::box(Vector4(-2.0f, -5.0f, 0.0f), Vector4(6.0f, 1.0f, 9.5f));
+
+        check_against(volume, cloud, [](const Vector4 &p)
+                      { return p[0] >= -2.0f && p[0] <= 6.0f && p[1] >= -5.0f && p[1] <= 1.0f && p[2] >= 0.0f && p[2] <= 9.5f; });
+    }
+
+    SECTION("Oriented box")
+    {
+        const Quaternion rotation = Quaternion::from_axis_angle(Vector4(1.0f, 2.0f, 0.5f, 0.0f).normalized(), 0.7f);
+        Matrix4 pose = rotation.to_matrix();
+        pose[3] = 1.0f;
+        pose[7] = -2.0f;
+        pose[11] = 3.0f;
+
+        const CullingVolume volume = CullingVolume::oriented_box(pose, Vector4(4.0f, 2.0f, 3.0f));
+
+        check_against(volume, cloud, [&](const Vector4 &p)
+                      {
+                          const Vector4 local(p[0] - 1.0f, p[1] + 2.0f, p[2] - 3.0f, 0.0f);
+                          const float u = pose[0] * local[0] + pose[4] * local[1] + pose[8] * local[2];
+                          const float v = pose[1] * local[0] + pose[5] * local[1] + pose[9] * local[2];
+                          const float w = pose[2] * local[0] + pose[6] * local[1] + pose[10] * local[2];
+                          return std::abs(u) <= 4.0f && std::abs(v) <= 2.0f && std::abs(w) <= 3.0f; });
+    }
+
+    SECTION("Perspective frustum")
+    {
+        const float near = 1.0f;
+        const float far = 9.0f;
+        const float focal = 1.5f;
+
+        Matrix4 projection;
+        projection[0] = focal;
+        projection[5] = focal;
+        projection[10] = (near + far) / (near - far);
+        projection[11] = 2.0f * near * far / (near - far);
+        projection[14] = -1.0f;
+
+        const CullingVolume volume = CullingVolume::frustum(projection);
+        REQUIRE(volume.plane_count() == 6);
+
+        check_against(volume, cloud, [&](const Vector4 &p)
+                      {
+                          const float x = focal * p[0];
+                          const float y = focal * p[1];
+                          const float z = projection[10] * p[2] + projection[11];
+                          const float w = -p[2];
+                          return std::abs(x) <= w && std::abs(y) <= w && std::abs(z) <= w; });
+    }
+
+    SECTION("Raw kernel on a short array")
+    {
+        const float x[5] = {0.0f, 2.0f, 0.5f, -1.0f, 0.25f};
+        const float y[5] = {0.0f, 0.0f, 0.5f, 0.0f, 0.25f};
+        const float z[5] = {0.0f, 0.0f, 0.5f, 0.0f, 0.25f};
+        uint32_t indices[5];
+
+        const CullingVolume volume = CullingVolume::box(Vector4(0.0f, 0.0f, 0.0f), Vector4(1.0f, 1.0f, 1.0f));
+
+        REQUIRE(volume.select(x, y, z, 5, indices) == 3);
+        REQUIRE(indices[0] == 0);
+        REQUIRE(indices[1] == 2);
+        REQUIRE(indices[2] == 4);
+    }
+}
+
+TEST_CASE("CullingVolume: Node classification")
+{
+    const CullingVolume volume = CullingVolume::box(Vector4(0.0f, 0.0f, 0.0f), Vector4(4.0f, 4.0f, 4.0f));
+
+    const float inside_min[3] = {1.0f, 1.0f, 1.0f};
+    const float inside_max[3] = {2.0f, 2.0f, 2.0f};
+    const float outside_min[3] = {5.0f, 1.0f, 1.0f};
+    const float outside_max[3] = {6.0f, 2.0f, 2.0f};
+    const float straddle_min[3] = {3.0f, 1.0f, 1.0f};
+    const float straddle_max[3] = {5.0f, 2.0f, 2.0f};
+
+    REQUIRE(volume.classify(inside_min, inside_max) == CullResult::Inside);
+    REQUIRE(volume.classify(outside_min, outside_max) == CullResult::Outside);
+    REQUIRE(volume.classify(straddle_min, straddle_max) == CullResult::Intersecting);
+
+    SECTION("Planes agree with the box")
+    {
+        const Vector4 planes[6] = {Vector4(1.0f, 0.0f, 0.0f, 0.0f), Vector4(-1.0f, 0.0f, 0.0f, 4.0f),
+                                   Vector4(0.0f, 1.0f, 0.0f, 0.0f), Vector4(0.0f, -1.0f, 0.0f, 4.0f),
+                                   Vector4(0.0f, 0.0f, 1.0f, 0.0f), Vector4(0.0f, 0.0f, -1.0f, 4.0f)};
+        const CullingVolume convex = CullingVolume::convex(planes, 6);
+
+        REQUIRE(convex.classify(inside_min, inside_max) == CullResult::Inside);
+        REQUIRE(convex.classify(outside_min, outside_max) == CullResult::Outside);
+        REQUIRE(convex.classify(straddle_min, straddle_max) == CullResult::Intersecting);
+        REQUIRE_THROWS_AS(CullingVolume::convex(planes, 7), std::invalid_argument);
+    }
+
+    SECTION("Octree nodes inherit their parent result")
+    {
+        const PointCloud cloud = random_cloud(5000);
+        const Octree octree(cloud, 0.5f);
+
+        std::vector<CullResult> results;
+        volume.classify(octree, results);
+        REQUIRE(results.size() == octree.nodes().size());
+
+        size_t inside = 0;
+
+        for (size_t n = 0; n < results.size(); n++)
+        {
+            const Octree::Node &node = octree.nodes()[n];
+
+            if (results[n] == CullResult::Inside)
+            {
+                inside++;
+
+                for (int32_t c = 0; c < 3; c++)
+                {
+                    REQUIRE(node.minimum[c] >= 0.0f);
+                    REQUIRE(node.maximum[c] <= 4.0f);
+                }
+            }
+        }
+
+        REQUIRE(inside > 0);
+        REQUIRE(results[0] == CullResult::Intersecting);
+    }
+}
@@ -0,0 +1,268 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/spatial/incremental_kd_tree.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+namespace
+{
+    PointCloud random_cloud(const size_t &count, const uint32_t &seed, const float &offset)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+
+        PointCloud cloud;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            cloud.push_back(Vector4(distribution(generator) + offset, distribution(generator), distribution(generator)));
+        }
+
+        return cloud;
+    }
+
+    std::vector<float> brute_force(const PointCloud &cloud, const Vector4 &query)
+    {
+        std::vector<float> distances;
+
+        for (size_t i = 0; i < cloud.size(); i++)
+        {
+            Vector4 difference = cloud.point(i) - Vector4(query[0], query[1], query[2], 1.0f);
+            distances.push_back(difference.sqr_magnitude());
+        }
+
+        std::sort(distances.begin(), distances.end());
+        return distances;
+    }
+
+    void require_knn_matches(const IncrementalKdTree &tree, const PointCloud &reference)
+    {
+        std::vector<Vector4> points;
+        std::vector<float> sqr_distances;
+
+        for (int32_t q = 0; q < 20; q++)
+        {
+            Vector4 query(q * 1.5f - 10.0f, 0.5f * q - 5.0f, 3.0f);
+            tree.knn(query, 8, points, sqr_distances);
+
+            std::vector<float> expected = brute_force(reference, query);
+
+            REQUIRE(points.size() == std::min<size_t>(8, reference.size()));
+
+            for (size_t i = 0; i < points.size(); i++)
+            {
+                REQUIRE(std::abs(sqr_distances[i] - expected[i]) < 1e-4f);
+            }
+        }
+    }
+}
+
+TEST_CASE("IncrementalKdTree: Insert And Query")
+{
+    SECTION("Batched inserts match brute force")
+    {
+        IncrementalKdTree tree;
+        PointCloud reference;
+
+        for (uint32_t batch = 0; batch < 10; batch++)
+        {
+            PointCloud cloud = random_cloud(500, batch, batch * 2.0f);
+            REQUIRE(tree.insert(cloud) == cloud.size());
+            reference.append(cloud);
+        }
+
+        tree.wait_for_rebuild();
+
+        REQUIRE(tree.size() == reference.size());
+        require_knn_matches(tree, reference);
+    }
+
+    SECTION("Sorted inserts stay balanced")
+    {
+        IncrementalKdTree tree(0.0f, 256);
+        PointCloud cloud;
+
+        for (int32_t i = 0; i < 4096; i++)
+        {
+            cloud.push_back(Vector4(i * 0.01f, 0.0f, 0.0f));
+        }
+
+        tree.insert(cloud);
+        tree.wait_for_rebuild();
+
+        REQUIRE(tree.size() == cloud.size());
+        REQUIRE(tree.depth() < 40);
+        require_knn_matches(tree, cloud);
+    }
+
+    SECTION("Voxel downsampling keeps one point per voxel")
+    {
+        IncrementalKdTree tree(1.0f);
+        PointCloud cloud;
+
+        cloud.push_back(Vector4(0.1f, 0.1f, 0.1f));
+        cloud.push_back(Vector4(0.45f, 0.5f, 0.55f));
+        cloud.push_back(Vector4(1.5f, 0.5f, 0.5f));
+
+        REQUIRE(tree.insert(cloud) == 2);
+        REQUIRE(tree.size() == 2);
+
+        PointCloud update;
+        update.push_back(Vector4(0.9f, 0.9f, 0.9f));
+        update.push_back(Vector4(1.5f, 0.5f, 0.51f));
+
+        REQUIRE(tree.insert(update) == 0);
+
+        PointCloud closer;
+        closer.push_back(Vector4(0.5f, 0.5f, 0.5f));
+
+        REQUIRE(tree.insert(closer) == 1);
+        REQUIRE(tree.size() == 2);
+
+        std::vector<Vector4> points;
+        tree.box_search(Vector4(0.0f, 0.0f, 0.0f), Vector4(0.99f, 0.99f, 0.99f), points);
+
+        REQUIRE(points.size() == 1);
+        REQUIRE(std::abs(points[0][2] - 0.5f) < 1e-6f);
+    }
+}
+
+TEST_CASE("IncrementalKdTree: Box Delete")
+{
+    IncrementalKdTree tree(0.0f, 512);
+    PointCloud cloud = random_cloud(5000, 11, 0.0f);
+    tree.build(cloud);
+
+    const Vector4 minimum(-10.0f, -10.0f, -10.0f);
+    const Vector4 maximum(0.0f, 10.0f, 10.0f);
+
+    PointCloud reference;
+
+    for (size_t i = 0; i < cloud.size(); i++)
+    {
+        if (cloud.x()[i] > 0.0f)
+        {
+            reference.push_back(cloud.point(i));
+        }
+    }
+
+    REQUIRE(tree.remove_box(minimum, maximum) == cloud.size() - reference.size());
+
+    SECTION("Deleted points are not returned")
+    {
+        tree.wait_for_rebuild();
+
+        REQUIRE(tree.size() == reference.size());
+        require_knn_matches(tree, reference);
+
+        std::vector<Vector4> points;
+        tree.box_search(minimum, maximum, points);
+        REQUIRE(points.empty());
+    }
+
+    SECTION("Inserts during a background rebuild are kept")
+    {
+        PointCloud extra = random_cloud(2000, 12, -5.0f);
+        tree.insert(extra);
+        tree.remove_box(Vector4(-20.0f, -10.0f, -10.0f), Vector4(-14.0f, 10.0f, 10.0f));
+
+        for (size_t i = 0; i < extra.size(); i++)
+        {
+            if (extra.x()[i] > -14.0f)
+            {
+                reference.push_back(extra.point(i));
+            }
+        }
+
+        tree.wait_for_rebuild();
+
+        REQUIRE(tree.size() == reference.size());
+        REQUIRE(tree.points().size() == reference.size());
+        require_knn_matches(tree, reference);
+    }
+}
+
+TEST_CASE("IncrementalKdTree: Log Replay")
+{
+    // Elongated along x, so the root splits near x = 0 and deleting most of x < 0 rebuilds only its left subtree.
+    std::mt19937 generator(13);
+    std::uniform_real_distribution<float> along(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> across(-10.0f, 10.0f);
+
+    PointCloud cloud;
+
+    for (int32_t i = 0; i < 200000; i++)
+    {
+        cloud.push_back(Vector4(along(generator), across(generator), across(generator)));
+    }
+
+    IncrementalKdTree tree(0.0f, 1024);
+    tree.build(cloud);
+    tree.remove_box(Vector4(-40.0f, -10.0f, -10.0f), Vector4(-12.0f, 10.0f, 10.0f));
+
+    // While the left subtree rebuilds: a delete spanning both halves, then inserts inside it on both sides.
+    tree.remove_box(Vector4(-5.0f, -10.0f, -10.0f), Vector4(5.0f, 10.0f, 10.0f));
+
+    PointCloud refill;
+
+    for (int32_t i = 0; i < 200; i++)
+    {
+        refill.push_back(Vector4(-4.0f + 0.04f * i, 0.5f, 0.5f));
+    }
+
+    tree.insert(refill);
+    tree.wait_for_rebuild();
+
+    PointCloud reference;
+
+    for (size_t i = 0; i < cloud.size(); i++)
+    {
+        const float x = cloud.x()[i];
+
+        if (x > -12.0f && (x < -5.0f || x > 5.0f))
+        {
+            reference.push_back(cloud.point(i));
+        }
+    }
+
+    reference.append(refill);
+
+    REQUIRE(tree.size() == reference.size());
+
+    std::vector<Vector4> points;
+    tree.box_search(Vector4(-5.0f, -10.0f, -10.0f), Vector4(5.0f, 10.0f, 10.0f), points);
+    REQUIRE(points.size() == refill.size());
+
+    require_knn_matches(tree, reference);
+}
+
+TEST_CASE("IncrementalKdTree: Delete Above A Rebuild")
+{
+    // Deleting most of x < 5 rebuilds only the root's left subtree; deleting everything then flags just the root.
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+
+    PointCloud cloud;
+
+    for (int32_t i = 0; i < 500000; i++)
+    {
+        cloud.push_back(Vector4(10.0f * distribution(generator), distribution(generator), distribution(generator)));
+    }
+
+    IncrementalKdTree tree(0.0f, 1000);
+    tree.build(cloud);
+    tree.remove_box(Vector4(-1.0f, -1.0f, -1.0f), Vector4(3.5f, 2.0f, 2.0f));
+    tree.remove_box(Vector4(-1.0f, -1.0f, -1.0f), Vector4(20.0f, 2.0f, 2.0f));
+
+    // The insert pushes the root's flag down onto the subtree still being rebuilt.
+    PointCloud single;
+    single.push_back(Vector4(5.0f, 0.5f, 0.5f));
+    tree.insert(single);
+    tree.wait_for_rebuild();
+
+    REQUIRE(tree.size() == 1);
+
+    std::vector<Vector4> points;
+    tree.box_search(Vector4(-1.0f, -1.0f, -1.0f), Vector4(20.0f, 2.0f, 2.0f), points);
+    REQUIRE(points.size() == 1);
+}
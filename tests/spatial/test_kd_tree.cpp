@@ -0,0 +1,110 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/spatial/kd_tree.hpp>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+    PointCloud random_cloud(const size_t &count, const uint32_t &seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+
+        PointCloud cloud;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            cloud.push_back(Vector4(distribution(generator), distribution(generator), distribution(generator)));
+        }
+
+        return cloud;
+    }
+
+    std::vector<float> brute_force(const PointCloud &cloud, const Vector4 &query)
+    {
+        std::vector<float> distances;
+
+        for (size_t i = 0; i < cloud.size(); i++)
+        {
+            Vector4 difference = cloud.point(i) - Vector4(query[0], query[1], query[2], 1.0f);
+            distances.push_back(difference.sqr_magnitude());
+        }
+
+        std::sort(distances.begin(), distances.end());
+        return distances;
+    }
+}
+
+TEST_CASE("KdTree: Nearest Neighbours")
+{
+    PointCloud cloud = random_cloud(3000, 3);
+    KdTree tree(cloud, 8);
+
+    REQUIRE(tree.size() == cloud.size());
+
+    std::vector<uint32_t> indices;
+    std::vector<float> sqr_distances;
+
+    SECTION("kNN matches brute force")
+    {
+        for (int32_t q = 0; q < 20; q++)
+        {
+            Vector4 query(q - 10.0f, 0.5f * q - 5.0f, 3.0f);
+            tree.knn(query, 10, indices, sqr_distances);
+
+            std::vector<float> expected = brute_force(cloud, query);
+
+            REQUIRE(indices.size() == 10);
+
+            for (size_t i = 0; i < 10; i++)
+            {
+                REQUIRE(std::abs(sqr_distances[i] - expected[i]) < 1e-4f);
+                Vector4 difference = cloud.point(indices[i]) - Vector4(query[0], query[1], query[2], 1.0f);
+                REQUIRE(std::abs(difference.sqr_magnitude() - sqr_distances[i]) < 1e-4f);
+            }
+        }
+    }
+
+    SECTION("Radius search matches brute force")
+    {
+        Vector4 query(1.0f, -2.0f, 0.5f);
+        tree.radius(query, 2.5f, indices, sqr_distances);
+
+        std::vector<float> expected = brute_force(cloud, query);
+        size_t inside = std::upper_bound(expected.begin(), expected.end(), 2.5f * 2.5f) - expected.begin();
+
+        REQUIRE(indices.size() == inside);
+    }
+
+    SECTION("Empty tree returns nothing")
+    {
+        KdTree empty;
+        empty.knn(Vector4(), 5, indices, sqr_distances);
+        REQUIRE(indices.empty());
+    }
+}
+
+TEST_CASE("KdTree: Array Validation")
+{
+    const float coordinates[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+    const uint32_t indices[4] = {0, 1, 2, 3};
+    const ArrayView<float> channel(coordinates, 4);
+
+    SECTION("A proper tree is accepted")
+    {
+        const KdTree::Node nodes[3] = {{0, 4, 1, 2, 1.5f, 0}, {0, 2, 0, 0, 0.0f, 0}, {2, 4, 0, 0, 0.0f, 0}};
+        const KdTree tree = KdTree::from_arrays(ArrayView<KdTree::Node>(nodes, 3), channel, channel, channel,
+                                                ArrayView<uint32_t>(indices, 4), 2, nullptr);
+        REQUIRE(tree.size() == 4);
+    }
+
+    SECTION("A child shared by two parents is rejected")
+    {
+        const KdTree::Node nodes[5] = {{0, 4, 1, 2, 1.5f, 0}, {0, 2, 3, 4, 0.5f, 0}, {2, 4, 3, 4, 2.5f, 0},
+                                       {0, 1, 0, 0, 0.0f, 0}, {1, 2, 0, 0, 0.0f, 0}};
+        REQUIRE_THROWS_AS(KdTree::from_arrays(ArrayView<KdTree::Node>(nodes, 5), channel, channel, channel,
+                                              ArrayView<uint32_t>(indices, 4), 2, nullptr),
+                          std::invalid_argument);
+    }
+}
@@ -0,0 +1,75 @@
+#include <catch2/catch_all.hpp>
+#include <LRE/spatial/octree.hpp>
+#include <cstdint>
+#include <random>
+
+TEST_CASE("Octree: Construction")
+{
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<float> distribution(-4.0f, 4.0f);
+
+    PointCloud cloud;
+
+    for (int32_t i = 0; i < 2000; i++)
+    {
+        cloud.push_back(Vector4(distribution(generator), distribution(generator), distribution(generator)));
+    }
+
+    Octree octree(cloud, 0.5f);
+
+    REQUIRE(octree.size() == cloud.size());
+
+    SECTION("Leaves are single voxels containing their points")
+    {
+        size_t covered = 0;
+
+        for (const Octree::Node &node : octree.nodes())
+        {
+            if (node.child_mask != 0)
+            {
+                continue;
+            }
+
+            for (int32_t c = 0; c < 3; c++)
+            {
+                REQUIRE(std::abs(node.maximum[c] - node.minimum[c] - 0.5f) < 1e-4f);
+            }
+
+            for (uint32_t i = node.begin; i < node.end; i++)
+            {
+                const float point[3] = {octree.x()[i], octree.y()[i], octree.z()[i]};
+
+                for (int32_t c = 0; c < 3; c++)
+                {
+                    REQUIRE(point[c] >= node.minimum[c]);
+                    REQUIRE(point[c] <= node.maximum[c]);
+                }
+            }
+
+            covered += node.end - node.begin;
+        }
+
+        REQUIRE(covered == cloud.size());
+    }
+
+    SECTION("Point lookup finds the owning leaf")
+    {
+        for (size_t i = 0; i < cloud.size(); i += 97)
+        {
+            const int32_t leaf = octree.find_leaf(cloud.point(i));
+            REQUIRE(leaf >= 0);
+
+            const Octree::Node &node = octree.nodes()[leaf];
+            bool found = false;
+
+            for (uint32_t j = node.begin; j < node.end; j++)
+            {
+                found = found || octree.indices()[j] == i;
+            }
+
+            REQUIRE(found);
+        }
+
+        REQUIRE(octree.find_leaf(Vector4(100.0f, 0.0f, 0.0f)) == -1);
+    }
+}